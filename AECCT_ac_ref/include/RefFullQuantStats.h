@@ -59,7 +59,9 @@ struct RefFullQuantStats {
   RefFp16PathStats fp16;
 };
 
-inline RefFullQuantStats g_ref_full_quant_stats{};
+// Per-thread accumulator: pattern-sweep workers each collect their own counters and the
+// caller merges them back in pattern order (see merge_ref_full_quant_stats).
+inline thread_local RefFullQuantStats g_ref_full_quant_stats{};
 
 static inline void reset_ref_full_quant_stats() {
   g_ref_full_quant_stats = RefFullQuantStats{};
@@ -69,8 +71,7 @@ static inline RefFullQuantStats get_ref_full_quant_stats() {
   return g_ref_full_quant_stats;
 }
 
-static inline void add_ref_full_quant_stats(const RefFullQuantStats& delta) {
-  RefFullQuantStats& s = g_ref_full_quant_stats;
+static inline void merge_ref_full_quant_stats(RefFullQuantStats& s, const RefFullQuantStats& delta) {
   s.int_linear.int8_clamp_count += delta.int_linear.int8_clamp_count;
   s.int_linear.int16_overflow_count += delta.int_linear.int16_overflow_count;
   s.int_linear.dequant_restore_count += delta.int_linear.dequant_restore_count;
@@ -119,4 +120,8 @@ static inline void add_ref_full_quant_stats(const RefFullQuantStats& delta) {
   }
 }
 
+static inline void add_ref_full_quant_stats(const RefFullQuantStats& delta) {
+  merge_ref_full_quant_stats(g_ref_full_quant_stats, delta);
+}
+
 } // namespace aecct_ref
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace aecct_ref {
+
+// Pattern sweep scheduler.
+// Workers pull fixed-size chunks from one shared counter until the range is drained, so
+// a slow chunk never idles the other threads. fn(chunk_idx, offset, count) must only
+// touch pattern slots [offset, offset + count).
+static constexpr int kSweepChunkPatterns = 8;
+
+static inline int sweep_chunk_count(int pattern_count) {
+  return (pattern_count + kSweepChunkPatterns - 1) / kSweepChunkPatterns;
+}
+
+template <typename ChunkFn>
+static void run_pattern_sweep(int pattern_count, int threads, ChunkFn fn) {
+  const int chunk_count = sweep_chunk_count(pattern_count);
+  const int worker_count = std::min(threads, chunk_count);
+  std::atomic<int> next_chunk{0};
+  auto worker = [&]() {
+    for (;;) {
+      const int chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= chunk_count) {
+        return;
+      }
+      const int offset = chunk * kSweepChunkPatterns;
+      fn(chunk, offset, std::min(kSweepChunkPatterns, pattern_count - offset));
+    }
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(static_cast<std::size_t>(worker_count));
+  for (int t = 0; t < worker_count; ++t) {
+    pool.emplace_back(worker);
+  }
+  for (std::thread& th : pool) {
+    th.join();
+  }
+}
+
+} // namespace aecct_ref
@@ -1224,35 +1224,49 @@ static void quant_linear_75x128_to32(const fp32_ref_t x[TOKENS_T][FF_DIM],
   }
 }
 
-static void build_masks(bool one_ring[TOKENS_T][TOKENS_T],
-                        bool second_ring[TOKENS_T][TOKENS_T]) {
-  bool src[TOKENS_T][TOKENS_T];
-  for (int i = 0; i < TOKENS_T; ++i) {
-    for (int j = 0; j < TOKENS_T; ++j) {
-      src[i][j] = (w_src_mask[i * TOKENS_T + j].to_int() != 0);
-    }
-  }
+// Allowed-key bitmaps per query row, ring 0 = one_ring, ring 1 = second_ring
+// (bit b of word c = key 32 * c + b). src_mask is a compile-time tensor, so the
+// bitmaps are built once and shared by every infer_step0 call.
+static constexpr int MASK_ROW_WORDS = (TOKENS_T + 31) / 32;
 
+struct RefAttnMaskBitmap {
+  uint32_t row[2][TOKENS_T][MASK_ROW_WORDS];
+};
+
+static RefAttnMaskBitmap build_mask_bitmap() {
+  RefAttnMaskBitmap bmp{};
   for (int i = 0; i < TOKENS_T; ++i) {
     for (int j = 0; j < TOKENS_T; ++j) {
-      const bool is_v_i = (i < VAR_N);
-      const bool is_v_j = (j < VAR_N);
-
-      if (is_v_i && is_v_j) {
-        one_ring[i][j] = true;
-        second_ring[i][j] = src[i][j];
-      } else if (is_v_i && !is_v_j) {
-        one_ring[i][j] = src[i][j];
-        second_ring[i][j] = true;
-      } else if (!is_v_i && is_v_j) {
-        one_ring[i][j] = src[i][j];
-        second_ring[i][j] = true;
-      } else {
-        one_ring[i][j] = true;
-        second_ring[i][j] = src[i][j];
+      // src_mask masks a pair only within its ring: one_ring drops same-type pairs
+      // outright, second_ring drops cross-type pairs outright.
+      const bool masked = (w_src_mask[i * TOKENS_T + j].to_int() != 0);
+      const bool same_type = ((i < VAR_N) == (j < VAR_N));
+      const bool one_ring_keep = !same_type && !masked;
+      const bool second_ring_keep = same_type && !masked;
+      const uint32_t bit = 1u << (j & 31);
+      if (one_ring_keep) {
+        bmp.row[0][i][j >> 5] |= bit;
+      }
+      if (second_ring_keep) {
+        bmp.row[1][i][j >> 5] |= bit;
       }
     }
   }
+  return bmp;
+}
+
+static const RefAttnMaskBitmap& ref_attn_mask_bitmap() {
+  static const RefAttnMaskBitmap bmp = build_mask_bitmap();
+  return bmp;
+}
+
+static inline int ref_ctz32(uint32_t x) {
+  int n = 0;
+  while ((x & 1u) == 0u) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
 }
 
 // SOFTMAX_APPROX_BEGIN
@@ -1294,8 +1308,7 @@ static inline void online_softmax_update(
 static void attention_block(const fp32_ref_t q[TOKENS_T][D_MODEL],
                             const fp32_ref_t k[TOKENS_T][D_MODEL],
                             const fp32_ref_t v[TOKENS_T][D_MODEL],
-                            const bool one_ring[TOKENS_T][TOKENS_T],
-                            const bool second_ring[TOKENS_T][TOKENS_T],
+                            const RefAttnMaskBitmap& mask_bmp,
                             const RefRunConfig& run_cfg,
                             RefFullQuantStats* stats,
                             fp32_ref_t scores[HEADS][TOKENS_T][TOKENS_T],
@@ -1307,7 +1320,8 @@ static void attention_block(const fp32_ref_t q[TOKENS_T][D_MODEL],
 
   for (int h = 0; h < HEADS; ++h) {
     for (int i = 0; i < TOKENS_T; ++i) {
-      const bool (*mask)[TOKENS_T] = (h < 4) ? one_ring : second_ring;
+      const int ring = (h < 4) ? 0 : 1;
+      const uint32_t* keep_words = mask_bmp.row[ring][i];
       const int base = h * D_HEAD;
       bool has_valid = false;
       bool online_init = false;
@@ -1318,33 +1332,37 @@ static void attention_block(const fp32_ref_t q[TOKENS_T][D_MODEL],
         acc_vec[dh] = fp32_ref_t(0.0f);
       }
 
+      // Masked keys keep -inf/0 in the trace tensors; only bitmap keys are visited,
+      // in ascending order so the online softmax matches a masked dense scan.
       for (int j = 0; j < TOKENS_T; ++j) {
-        if (mask[i][j]) {
-          scores[h][i][j] = neg_inf;
-          probs[h][i][j] = fp32_ref_t(0.0f);
-          continue;
-        }
+        scores[h][i][j] = neg_inf;
+        probs[h][i][j] = fp32_ref_t(0.0f);
+      }
 
-        has_valid = true;
-        fp32_ref_t dot = fp32_ref_t(0.0f);
-        for (int dh = 0; dh < D_HEAD; ++dh) {
-          dot += q[i][base + dh] * k[j][base + dh];
+      for (int c = 0; c < MASK_ROW_WORDS; ++c) {
+        for (uint32_t keep = keep_words[c]; keep != 0u; keep &= (keep - 1u)) {
+          const int j = c * 32 + ref_ctz32(keep);
+          has_valid = true;
+          fp32_ref_t dot = fp32_ref_t(0.0f);
+          for (int dh = 0; dh < D_HEAD; ++dh) {
+            dot += q[i][base + dh] * k[j][base + dh];
+          }
+          const fp32_ref_t score = stress_roundtrip_e4m3(
+            dot * inv_sqrt_dh,
+            run_cfg,
+            RefFragGroup::G4_SOFTMAX_NEIGHBORHOOD,
+            stats,
+            "attention_score");
+          scores[h][i][j] = score;
+          online_softmax_update(
+            online_init,
+            score,
+            &v[j][base],
+            online_max,
+            online_sumexp,
+            acc_vec
+          );
         }
-        const fp32_ref_t score = stress_roundtrip_e4m3(
-          dot * inv_sqrt_dh,
-          run_cfg,
-          RefFragGroup::G4_SOFTMAX_NEIGHBORHOOD,
-          stats,
-          "attention_score");
-        scores[h][i][j] = score;
-        online_softmax_update(
-          online_init,
-          score,
-          &v[j][base],
-          online_max,
-          online_sumexp,
-          acc_vec
-        );
       }
 
       if (!has_valid) {
@@ -1357,24 +1375,23 @@ static void attention_block(const fp32_ref_t q[TOKENS_T][D_MODEL],
       const fp32_ref_t inv_sumexp = ref_softmax_rcp_lut(online_sumexp);
 
       // Trace-only probability materialization from final online state.
-      for (int j = 0; j < TOKENS_T; ++j) {
-        if (mask[i][j]) {
-          probs[h][i][j] = fp32_ref_t(0.0f);
-          continue;
+      for (int c = 0; c < MASK_ROW_WORDS; ++c) {
+        for (uint32_t keep = keep_words[c]; keep != 0u; keep &= (keep - 1u)) {
+          const int j = c * 32 + ref_ctz32(keep);
+          const fp32_ref_t w = stress_roundtrip_e4m3(
+            ref_softmax_exp_lut(scores[h][i][j] - online_max),
+            run_cfg,
+            RefFragGroup::G4_SOFTMAX_NEIGHBORHOOD,
+            stats,
+            "softmax_weight"
+          );
+          probs[h][i][j] = stress_roundtrip_e4m3(
+            w * inv_sumexp,
+            run_cfg,
+            RefFragGroup::G4_SOFTMAX_NEIGHBORHOOD,
+            stats,
+            "softmax_prob");
         }
-        const fp32_ref_t w = stress_roundtrip_e4m3(
-          ref_softmax_exp_lut(scores[h][i][j] - online_max),
-          run_cfg,
-          RefFragGroup::G4_SOFTMAX_NEIGHBORHOOD,
-          stats,
-          "softmax_weight"
-        );
-        probs[h][i][j] = stress_roundtrip_e4m3(
-          w * inv_sumexp,
-          run_cfg,
-          RefFragGroup::G4_SOFTMAX_NEIGHBORHOOD,
-          stats,
-          "softmax_prob");
       }
 
       for (int dh = 0; dh < D_HEAD; ++dh) {
@@ -1410,8 +1427,7 @@ static void run_layer(const int layer_idx,
                       const RefRunConfig& run_cfg,
                       RefFullQuantStats* stats,
                       const fp32_ref_t x_in[TOKENS_T][D_MODEL],
-                      const bool one_ring[TOKENS_T][TOKENS_T],
-                      const bool second_ring[TOKENS_T][TOKENS_T],
+                      const RefAttnMaskBitmap& mask_bmp,
                       fp32_ref_t q_out[TOKENS_T][D_MODEL],
                       fp32_ref_t k_out[TOKENS_T][D_MODEL],
                       fp32_ref_t v_out[TOKENS_T][D_MODEL],
@@ -1536,8 +1552,7 @@ static void run_layer(const int layer_idx,
   attention_block(q_out,
                   k_out,
                   v_out,
-                  one_ring,
-                  second_ring,
+                  mask_bmp,
                   run_cfg,
                   stats,
                   attn_scores,
@@ -1713,9 +1728,7 @@ void RefModel::infer_step0(const RefModelIO& io) const {
       to_string(run_cfg_.algo_variant));
   }
 
-  bool one_ring[TOKENS_T][TOKENS_T];
-  bool second_ring[TOKENS_T][TOKENS_T];
-  build_masks(one_ring, second_ring);
+  const RefAttnMaskBitmap& mask_bmp = ref_attn_mask_bitmap();
   RefFullQuantStats local_stats{};
 
   for (int b = 0; b < B; ++b) {
@@ -1749,8 +1762,8 @@ void RefModel::infer_step0(const RefModelIO& io) const {
       node_feature[VAR_N + c] = (parity == 0) ? fp32_ref_t(1.0f) : fp32_ref_t(-1.0f);
     }
 
-    static fp32_ref_t preproc_x[TOKENS_T][D_MODEL];
-    static fp32_ref_t prelayer_x[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t preproc_x[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t prelayer_x[TOKENS_T][D_MODEL];
     for (int t = 0; t < TOKENS_T; ++t) {
       for (int k = 0; k < 24; ++k) {
         preproc_x[t][k] = stress_roundtrip_e4m3_g5_sub(
@@ -1791,27 +1804,26 @@ void RefModel::infer_step0(const RefModelIO& io) const {
     dump_2d<TOKENS_T, D_MODEL>(dump, "preproc_x", preproc_x);
     dump_2d<TOKENS_T, D_MODEL>(dump, "prelayer_x", prelayer_x);
 
-    static fp32_ref_t layer0_q[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer0_k[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer0_v[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer0_scores[HEADS][TOKENS_T][TOKENS_T];
-    static fp32_ref_t layer0_probs[HEADS][TOKENS_T][TOKENS_T];
-    static fp32_ref_t layer0_ctx[HEADS][TOKENS_T][D_HEAD];
-    static fp32_ref_t layer0_attn_out[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer0_ln_in[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer0_ln_out[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer0_ffn1[TOKENS_T][FF_DIM];
-    static fp32_ref_t layer0_act[TOKENS_T][FF_DIM];
-    static fp32_ref_t layer0_ffn2[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer0_ffn_ln_out[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer0_q[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer0_k[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer0_v[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer0_scores[HEADS][TOKENS_T][TOKENS_T];
+    static thread_local fp32_ref_t layer0_probs[HEADS][TOKENS_T][TOKENS_T];
+    static thread_local fp32_ref_t layer0_ctx[HEADS][TOKENS_T][D_HEAD];
+    static thread_local fp32_ref_t layer0_attn_out[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer0_ln_in[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer0_ln_out[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer0_ffn1[TOKENS_T][FF_DIM];
+    static thread_local fp32_ref_t layer0_act[TOKENS_T][FF_DIM];
+    static thread_local fp32_ref_t layer0_ffn2[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer0_ffn_ln_out[TOKENS_T][D_MODEL];
 
     run_layer(0,
               b,
               run_cfg_,
               &local_stats,
               prelayer_x,
-              one_ring,
-              second_ring,
+              mask_bmp,
               layer0_q,
               layer0_k,
               layer0_v,
@@ -1840,7 +1852,7 @@ void RefModel::infer_step0(const RefModelIO& io) const {
     dump_2d<TOKENS_T, D_MODEL>(dump, "layer0_ffn2_out", layer0_ffn2);
     dump_2d<TOKENS_T, D_MODEL>(dump, "layer0_ffn_ln_out", layer0_ffn_ln_out);
 
-    static fp32_ref_t mid_norm[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t mid_norm[TOKENS_T][D_MODEL];
     apply_layernorm_tokens(layer0_ffn_ln_out,
                            w_decoder_norm2_weight,
                            w_decoder_norm2_bias,
@@ -1862,27 +1874,26 @@ void RefModel::infer_step0(const RefModelIO& io) const {
       }
     }
 
-    static fp32_ref_t layer1_q[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer1_k[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer1_v[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer1_scores[HEADS][TOKENS_T][TOKENS_T];
-    static fp32_ref_t layer1_probs[HEADS][TOKENS_T][TOKENS_T];
-    static fp32_ref_t layer1_ctx[HEADS][TOKENS_T][D_HEAD];
-    static fp32_ref_t layer1_attn_out[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer1_ln_in[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer1_ln_out[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer1_ffn1[TOKENS_T][FF_DIM];
-    static fp32_ref_t layer1_act[TOKENS_T][FF_DIM];
-    static fp32_ref_t layer1_ffn2[TOKENS_T][D_MODEL];
-    static fp32_ref_t layer1_ffn_ln_out[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer1_q[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer1_k[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer1_v[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer1_scores[HEADS][TOKENS_T][TOKENS_T];
+    static thread_local fp32_ref_t layer1_probs[HEADS][TOKENS_T][TOKENS_T];
+    static thread_local fp32_ref_t layer1_ctx[HEADS][TOKENS_T][D_HEAD];
+    static thread_local fp32_ref_t layer1_attn_out[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer1_ln_in[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer1_ln_out[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer1_ffn1[TOKENS_T][FF_DIM];
+    static thread_local fp32_ref_t layer1_act[TOKENS_T][FF_DIM];
+    static thread_local fp32_ref_t layer1_ffn2[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t layer1_ffn_ln_out[TOKENS_T][D_MODEL];
 
     run_layer(1,
               b,
               run_cfg_,
               &local_stats,
               mid_norm,
-              one_ring,
-              second_ring,
+              mask_bmp,
               layer1_q,
               layer1_k,
               layer1_v,
@@ -1912,7 +1923,7 @@ void RefModel::infer_step0(const RefModelIO& io) const {
     dump_2d<TOKENS_T, D_MODEL>(dump, "layer1_ffn_ln_out", layer1_ffn_ln_out);
 
     // Logical name: endLN_out, kept in end_norm for trace compatibility.
-    static fp32_ref_t end_norm[TOKENS_T][D_MODEL];
+    static thread_local fp32_ref_t end_norm[TOKENS_T][D_MODEL];
     apply_layernorm_tokens(layer1_ffn_ln_out,
                            w_decoder_norm_weight,
                            w_decoder_norm_bias,
@@ -1935,8 +1946,8 @@ void RefModel::infer_step0(const RefModelIO& io) const {
     }
 
     // Logical name: s_t (token-wise FinalEmbedding scalar), trace tensor name kept stable.
-    static fp32_ref_t final_node_logits[TOKENS_T][1];
-    static fp32_ref_t out_fc_in[1][TOKENS_T];
+    static thread_local fp32_ref_t final_node_logits[TOKENS_T][1];
+    static thread_local fp32_ref_t out_fc_in[1][TOKENS_T];
     for (int t = 0; t < TOKENS_T; ++t) {
       fp32_ref_t acc = fp32_ref_t(static_cast<float>(w_oned_final_embed_0_bias[0]));
       for (int i = 0; i < D_MODEL; ++i) {
@@ -1990,8 +2001,8 @@ void RefModel::infer_step0(const RefModelIO& io) const {
       }
     }
 
-    static fp32_ref_t final_logits[1][VAR_N];
-    static fp32_ref_t final_x_pred[VAR_N];
+    static thread_local fp32_ref_t final_logits[1][VAR_N];
+    static thread_local fp32_ref_t final_x_pred[VAR_N];
     for (int n = 0; n < VAR_N; ++n) {
       fp32_ref_t acc = fp32_ref_t(static_cast<float>(w_out_fc_bias[n]));
       for (int t = 0; t < TOKENS_T; ++t) {
@@ -10,6 +10,7 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -17,6 +18,7 @@
 #include "../include/RefE4M3Helpers.h"
 #include "../include/RefFullQuantStats.h"
 #include "../include/RefModel.h"
+#include "../include/RefPatternSweep.h"
 #include "../include/RefPrecisionMode.h"
 
 #include "input_y_step0.h"
@@ -108,6 +110,7 @@ struct CliOptions {
   int pattern_index;
   int pattern_begin;
   int pattern_count;
+  int threads;
   int topk;
   bool summary_only;
   bool ln_debug;
@@ -410,6 +413,7 @@ static void print_usage() {
   std::printf("  --mode compare|baseline|experiment|eval-baseline|eval-experiment|eval-compare|explore\n");
   std::printf("  --pattern N\n");
   std::printf("  --pattern-begin N --pattern-count M\n");
+  std::printf("  --threads N (0 = hardware concurrency)\n");
   std::printf("  --topk K\n");
   std::printf("  --stage S0|S1|S2|S3|S4\n");
   std::printf("  --precision-exp baseline_fp32|generic_e4m3_finalhead|full_e4m3_nonlinear_stress|generic_e4m3_frag_bisect|generic_e4m3_except_g5|generic_e4m3_g5_g4|generic_e4m3_g5_g1|generic_e4m3_g5_g3|generic_e4m3_g5_g2|generic_e4m3_g2_embed_only|generic_e4m3_g2_spe_only|generic_e4m3_g2_preproc_assembly|generic_e4m3_g2_prelayer_handoff|int8_fixedexp_zone3_embed_g2|int8_fixedexp_zone4_embed_g2|fp16_replace_fp32_global\n");
@@ -632,6 +636,7 @@ static CliParseResult parse_cli(int argc, char** argv, CliOptions& opts) {
   opts.pattern_index = -1;
   opts.pattern_begin = -1;
   opts.pattern_count = -1;
+  opts.threads = 1;
   opts.topk = 5;
   opts.summary_only = false;
   opts.ln_debug = false;
@@ -689,6 +694,14 @@ static CliParseResult parse_cli(int argc, char** argv, CliOptions& opts) {
       opts.pattern_count = std::atoi(argv[++i]);
       continue;
     }
+    if (std::strcmp(arg, "--threads") == 0) {
+      if (i + 1 >= argc) {
+        std::printf("Missing value after --threads\n");
+        return CliParseResult::ERROR;
+      }
+      opts.threads = std::atoi(argv[++i]);
+      continue;
+    }
     if (std::strcmp(arg, "--topk") == 0) {
       if (i + 1 >= argc) {
         std::printf("Missing value after --topk\n");
@@ -808,6 +821,20 @@ static CliParseResult parse_cli(int argc, char** argv, CliOptions& opts) {
     std::printf("--topk must be > 0\n");
     return CliParseResult::ERROR;
   }
+  if (opts.threads < 0) {
+    std::printf("--threads must be >= 0\n");
+    return CliParseResult::ERROR;
+  }
+  if (opts.threads == 0) {
+    const unsigned hw = std::thread::hardware_concurrency();
+    opts.threads = (hw > 0U) ? static_cast<int>(hw) : 1;
+  }
+  if (opts.threads > 1 &&
+      (opts.ln_debug || opts.ln_var_debug || opts.ln_input_debug || opts.ln_upstream_debug)) {
+    // LN debug traces are process-global and recorded in call order.
+    std::printf("[info] LN debug tracing forces --threads 1\n");
+    opts.threads = 1;
+  }
   if (!ln_mode_exp_set) {
     opts.experiment_ln_mode = opts.ln_mode;
   }
@@ -938,7 +965,7 @@ static std::size_t compute_x_pred_match_count(
 }
 
 static void run_ref_single_pattern(
-  aecct_ref::RefModel& model,
+  const aecct_ref::RefModel& model,
   int pattern_index,
   int n_vars,
   RefRunOutputs& out
@@ -966,27 +993,55 @@ static void run_ref_single_pattern(
 }
 
 static void run_ref_batch(
-  aecct_ref::RefModel& model,
+  const aecct_ref::RefModel& model,
   const PatternRange& range,
   int n_vars,
   std::vector<double>& logits,
   std::vector<aecct_ref::bit1_t>& x_pred,
-  double* out_finalhead_s_t
+  double* out_finalhead_s_t,
+  int threads
 ) {
   const int run_b = range.count;
   const std::size_t logits_count = static_cast<std::size_t>(run_b * n_vars);
   logits.assign(logits_count, 0.0);
   x_pred.assign(logits_count, aecct_ref::bit1_t(0));
 
-  aecct_ref::RefModelIO io{};
-  io.input_y = nullptr;
-  io.input_y_fp32 = &trace_input_y_step0_tensor[range.begin * n_vars];
-  io.out_logits = logits.data();
-  io.out_x_pred = x_pred.data();
-  io.out_finalhead_s_t = out_finalhead_s_t;
-  io.B = run_b;
-  io.N = n_vars;
-  model.infer_step0(io);
+  if (threads <= 1 || aecct_ref::sweep_chunk_count(run_b) <= 1) {
+    aecct_ref::RefModelIO io{};
+    io.input_y = nullptr;
+    io.input_y_fp32 = &trace_input_y_step0_tensor[range.begin * n_vars];
+    io.out_logits = logits.data();
+    io.out_x_pred = x_pred.data();
+    io.out_finalhead_s_t = out_finalhead_s_t;
+    io.B = run_b;
+    io.N = n_vars;
+    model.infer_step0(io);
+    return;
+  }
+
+  // Each chunk owns a disjoint output slice and its own quant-stat delta. Deltas are
+  // merged here in chunk order, which reproduces the serial counters and first-hit blocks.
+  std::vector<aecct_ref::RefFullQuantStats> chunk_stats(
+    static_cast<std::size_t>(aecct_ref::sweep_chunk_count(run_b)));
+  aecct_ref::run_pattern_sweep(run_b, threads, [&](int chunk, int offset, int count) {
+    const std::size_t word_offset = static_cast<std::size_t>(offset * n_vars);
+    aecct_ref::RefModelIO io{};
+    io.input_y = nullptr;
+    io.input_y_fp32 = &trace_input_y_step0_tensor[(range.begin + offset) * n_vars];
+    io.out_logits = logits.data() + word_offset;
+    io.out_x_pred = x_pred.data() + word_offset;
+    io.out_finalhead_s_t = (out_finalhead_s_t != nullptr)
+      ? (out_finalhead_s_t + static_cast<std::size_t>(offset * 75))
+      : nullptr;
+    io.B = count;
+    io.N = n_vars;
+    aecct_ref::reset_ref_full_quant_stats();
+    model.infer_step0(io);
+    chunk_stats[static_cast<std::size_t>(chunk)] = aecct_ref::get_ref_full_quant_stats();
+  });
+  for (const aecct_ref::RefFullQuantStats& delta : chunk_stats) {
+    aecct_ref::add_ref_full_quant_stats(delta);
+  }
 }
 
 static inline aecct_ref::ref_fp32_t sign_fp32_local(aecct_ref::ref_fp32_t x) {
@@ -3229,7 +3284,8 @@ static bool run_stage_compare_eval_snapshot(
     n_vars,
     baseline_logits_batch,
     baseline_x_pred_batch,
-    baseline_finalhead_s_t.data()
+    baseline_finalhead_s_t.data(),
+    opts.threads
   );
   out.perf.baseline_model_s = elapsed_sec(t0, now_tp());
 
@@ -3405,10 +3461,29 @@ static int run_single_mode(
   GoldenAggregateMetrics agg{};
   init_golden_aggregate(agg);
 
+  // Threaded runs precompute every pattern, then report/aggregate in pattern order below.
+  std::vector<RefRunOutputs> swept_runs;
+  if (opts.threads > 1 && range.count > 1) {
+    swept_runs.resize(static_cast<std::size_t>(range.count));
+    aecct_ref::run_pattern_sweep(range.count, opts.threads, [&](int, int offset, int count) {
+      for (int i = 0; i < count; ++i) {
+        run_ref_single_pattern(
+          model,
+          range.begin + offset + i,
+          n_vars,
+          swept_runs[static_cast<std::size_t>(offset + i)]);
+      }
+    });
+  }
+
   for (int off = 0; off < range.count; ++off) {
     const int p = range.begin + off;
     RefRunOutputs run{};
-    run_ref_single_pattern(model, p, n_vars, run);
+    if (swept_runs.empty()) {
+      run_ref_single_pattern(model, p, n_vars, run);
+    } else {
+      run = swept_runs[static_cast<std::size_t>(off)];
+    }
     if (range.count == 1) {
       print_vs_golden_summary(tag, run);
     } else {
@@ -3487,6 +3562,7 @@ int main(int argc, char** argv) {
   std::printf("  frag_group     : %s\n", aecct_ref::to_string(opts.frag_group));
   std::printf("  algo_variant   : %s\n", aecct_ref::to_string(opts.algo_variant));
   std::printf("  pattern_range  : begin=%d count=%d\n", range.begin, range.count);
+  std::printf("  threads        : %d\n", opts.threads);
   std::printf("  topk           : %d\n", opts.topk);
   std::printf("  summary_only   : %d\n", opts.summary_only ? 1 : 0);
   std::printf("  ln_debug       : %d\n", opts.ln_debug ? 1 : 0);
@@ -3747,7 +3823,8 @@ int main(int argc, char** argv) {
       N,
       baseline_logits_batch,
       baseline_x_pred_batch,
-      experiment_use_reconstruct ? baseline_finalhead_s_t.data() : nullptr
+      experiment_use_reconstruct ? baseline_finalhead_s_t.data() : nullptr,
+      opts.threads
     );
     perf.baseline_model_s = elapsed_sec(t_baseline_start, now_tp());
 
@@ -3782,7 +3859,8 @@ int main(int argc, char** argv) {
           N,
           experiment_logits_batch,
           experiment_x_pred_batch,
-          nullptr
+          nullptr,
+          opts.threads
         );
       }
       experiment_full_stats = aecct_ref::get_ref_full_quant_stats();
@@ -4032,7 +4110,8 @@ int main(int argc, char** argv) {
     N,
     baseline_logits_batch,
     baseline_x_pred_batch,
-    experiment_use_reconstruct ? baseline_finalhead_s_t.data() : nullptr
+    experiment_use_reconstruct ? baseline_finalhead_s_t.data() : nullptr,
+    opts.threads
   );
   perf.baseline_model_s = elapsed_sec(t_baseline_start, now_tp());
   if (enable_ln_trace) {
@@ -4078,7 +4157,8 @@ int main(int argc, char** argv) {
       N,
       experiment_logits_batch,
       experiment_x_pred_batch,
-      nullptr
+      nullptr,
+      opts.threads
     );
   }
   experiment_full_stats = aecct_ref::get_ref_full_quant_stats();
@@ -33,6 +33,8 @@ namespace aecct {
     OP_READ_MEM    = 0x07,
     OP_DEBUG_CFG   = 0x08,
     OP_SET_W_BASE  = 0x09,
+    OP_INFER_BATCH = 0x0A, // arg0=[15:0] count, [16] overlap; then count x INFER payloads
+    OP_LOAD_W_EX   = 0x0B, // arg0=PARAM stream flags (Top.h LOAD_W_ARG_*); then as LOAD_W
 
     OP_SOFT_RESET  = 0x7F  // implemented (spell v11.7.2)
   };
@@ -43,7 +45,8 @@ namespace aecct {
     ST_CFG_RX,       // cfg receive phase
     ST_PARAM_RX,     // param/weight receive phase
     ST_INFER_RX,     // infer input receive phase
-    ST_HALTED        // debug halt placeholder
+    ST_HALTED,       // debug halt placeholder
+    ST_INFER_OVL     // overlapped infer: input receive while a codeword computes
   };
 
   // -------------------- Phase id --------------------
@@ -75,7 +78,8 @@ namespace aecct {
     ERR_PARAM_BASE_ALIGN,
     ERR_MEM_RANGE,
     ERR_BITPACK_PAD,
-    ERR_DBG_HALT
+    ERR_DBG_HALT,
+    ERR_PARAM_TERNARY_CODE   // strict LOAD_W: reserved 0b10 code in a ternary payload
   };
 
   // -------------------- ctrl word pack/unpack helpers --------------------
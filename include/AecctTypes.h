@@ -4,6 +4,11 @@
 #include <ac_channel.h>
 #include <ac_int.h>
 
+#include "HostRingChannel.h"
+
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(ac_int<16, false>);
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(ac_int<32, false>);
+
 namespace aecct {
 
 typedef ac_int<16, false> u16_t;
@@ -28,6 +28,17 @@ static inline uint32_t mask_u32(unsigned w) {
     return (1u << w) - 1u;
 }
 
+// Count trailing zeros of a non-zero word (5-step binary search, no intrinsics).
+static inline uint32_t ctz_u32(uint32_t x) {
+    uint32_t n = 0u;
+    if ((x & 0x0000FFFFu) == 0u) { n += 16u; x >>= 16; }
+    if ((x & 0x000000FFu) == 0u) { n += 8u; x >>= 8; }
+    if ((x & 0x0000000Fu) == 0u) { n += 4u; x >>= 4; }
+    if ((x & 0x00000003u) == 0u) { n += 2u; x >>= 2; }
+    if ((x & 0x00000001u) == 0u) { n += 1u; }
+    return n;
+}
+
 static inline fp32_t fp32_from_bits(const u32_t& bits) {
     fp32_t v;
     ac_int<32, true> raw = (ac_int<32, true>)bits;
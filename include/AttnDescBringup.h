@@ -16,6 +16,13 @@ namespace aecct {
 
     static_assert((ATTN_D_MODEL % ATTN_N_HEADS) == 0u, "ATTN_D_MODEL must be divisible by ATTN_N_HEADS");
 
+    // Phase-B heads processed concurrently by the fused engine（1/2/4/8；build-time knob）
+#ifndef AECCT_ATTN_PHASEB_HEAD_PAR
+#define AECCT_ATTN_PHASEB_HEAD_PAR 1
+#endif
+    static const unsigned ATTN_PHASEB_HEAD_PAR = (unsigned)AECCT_ATTN_PHASEB_HEAD_PAR;
+    static_assert((ATTN_N_HEADS % ATTN_PHASEB_HEAD_PAR) == 0u, "ATTN_N_HEADS must be divisible by ATTN_PHASEB_HEAD_PAR");
+
     enum AttnStageMode : unsigned {
         ATTN_STAGE_QKV = 1u,     // M9a: Q/K/V (+ quant checkpoints)
         ATTN_STAGE_SCORES = 2u,  // M9b: score/softmax + pre/post concat
@@ -48,20 +55,20 @@ namespace aecct {
     static const unsigned ATTN_X_IN_BASE_WORD_DEFAULT = (unsigned)LN_X_OUT_BASE_WORD_DEFAULT;
     static const unsigned ATTN_OUT_BASE_WORD_DEFAULT = (unsigned)sram_map::X_PAGE0_BASE_W;
 
-    // Q/K 優先放 SCRATCH，其他暫存放 W_REGION（M9 bring-up 先對齊 checkpoint）
+    // Q/K 優先放 SCRATCH，其他暫存放 SCR_WORK（不覆蓋 W_REGION 的 PARAM image）
     static const unsigned ATTN_Q_BASE_WORD_DEFAULT = (unsigned)sram_map::BASE_SCR_K_W;
     static const unsigned ATTN_K_BASE_WORD_DEFAULT = (unsigned)sram_map::BASE_SCR_V_W;
-    static const unsigned ATTN_V_BASE_WORD_DEFAULT = (unsigned)sram_map::W_REGION_BASE;
+    static const unsigned ATTN_V_BASE_WORD_DEFAULT = (unsigned)sram_map::BASE_SCR_WORK_W;
 
-    static const unsigned ATTN_SCORE_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + ATTN_TENSOR_WORDS * 1u);
-    static const unsigned ATTN_SOFTMAX_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + ATTN_TENSOR_WORDS * 2u);
-    static const unsigned ATTN_PRE_CONCAT_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + ATTN_TENSOR_WORDS * 3u);
-    static const unsigned ATTN_POST_CONCAT_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + ATTN_TENSOR_WORDS * 4u);
+    static const unsigned ATTN_SCORE_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + ATTN_TENSOR_WORDS * 1u);
+    static const unsigned ATTN_SOFTMAX_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + ATTN_TENSOR_WORDS * 2u);
+    static const unsigned ATTN_PRE_CONCAT_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + ATTN_TENSOR_WORDS * 3u);
+    static const unsigned ATTN_POST_CONCAT_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + ATTN_TENSOR_WORDS * 4u);
 
-    static const unsigned ATTN_Q_ACT_Q_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + ATTN_TENSOR_WORDS * 5u);
-    static const unsigned ATTN_K_ACT_Q_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + ATTN_TENSOR_WORDS * 6u);
-    static const unsigned ATTN_V_ACT_Q_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + ATTN_TENSOR_WORDS * 7u);
-    static const unsigned ATTN_Q_SX_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + ATTN_TENSOR_WORDS * 8u);
+    static const unsigned ATTN_Q_ACT_Q_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + ATTN_TENSOR_WORDS * 5u);
+    static const unsigned ATTN_K_ACT_Q_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + ATTN_TENSOR_WORDS * 6u);
+    static const unsigned ATTN_V_ACT_Q_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + ATTN_TENSOR_WORDS * 7u);
+    static const unsigned ATTN_Q_SX_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + ATTN_TENSOR_WORDS * 8u);
 
     static inline AttnScratch default_attn_scratch() {
         AttnScratch sc;
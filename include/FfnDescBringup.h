@@ -60,14 +60,14 @@ namespace aecct {
 
     static const unsigned FFN_X_IN_BASE_WORD_DEFAULT = (unsigned)ATTN_OUT_BASE_WORD_DEFAULT;
 
-    // W1/relu ?閬?9600 words嚗??W_REGION嚗2/add2 ?曉 SCRATCH嚗N output ??X_PAGE1
-    static const unsigned FFN_W1_OUT_BASE_WORD_DEFAULT = (unsigned)sram_map::W_REGION_BASE;
-    static const unsigned FFN_RELU_OUT_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + FFN_W1_OUT_WORDS);
+    // W1/ReLU outputs (T x D_FFN each) in SCR_WORK, W2/add2 in SCR_K/SCR_V, LN output to X_PAGE1
+    static const unsigned FFN_W1_OUT_BASE_WORD_DEFAULT = (unsigned)sram_map::BASE_SCR_WORK_W;
+    static const unsigned FFN_RELU_OUT_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + FFN_W1_OUT_WORDS);
     static const unsigned FFN_W2_OUT_BASE_WORD_DEFAULT = (unsigned)sram_map::BASE_SCR_K_W;
     static const unsigned FFN_ADD2_BASE_WORD_DEFAULT = (unsigned)sram_map::BASE_SCR_V_W;
     static const unsigned FFN_LN_OUT_BASE_WORD_DEFAULT = (unsigned)sram_map::X_PAGE1_BASE_W;
 
-    static const unsigned FFN_LN_GAMMA_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + FFN_W1_OUT_WORDS + FFN_W1_OUT_WORDS);
+    static const unsigned FFN_LN_GAMMA_BASE_WORD_DEFAULT = (unsigned)(sram_map::BASE_SCR_WORK_W + FFN_W1_OUT_WORDS + FFN_W1_OUT_WORDS);
     static const unsigned FFN_LN_BETA_BASE_WORD_DEFAULT = (unsigned)(FFN_LN_GAMMA_BASE_WORD_DEFAULT + FFN_D_MODEL);
 
     static inline FfnScratch default_ffn_scratch() {
@@ -0,0 +1,143 @@
+#pragma once
+// Host-only ring-buffer channel (opt-in with AECCT_HOST_RING_CHANNEL on non-synthesis
+// builds). ac_channel keeps every element in a std::deque, which allocates a block
+// per few hundred elements and chases block pointers on every read. HostRingChannel
+// keeps the elements in one power-of-two array indexed by masked head / tail
+// counters; it only allocates when the channel outgrows its capacity (doubling, so
+// a steady-state stream never allocates). Semantics match ac_channel's unbounded
+// host FIFO: nb_write always succeeds, read / peek of an empty channel assert,
+// operator[] indexes from the head.
+//
+// AECCT_HOST_RING_CHANNEL_SPECIALIZE(T) replaces ac_channel<T> with the ring
+// version. It must appear before the first use of ac_channel<T>; AecctTypes.h does
+// this for ctrl_ch_t / data_ch_t and PreprocTransportTypes.h for the Preproc packets.
+
+#include <ac_channel.h>
+
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_RING_CHANNEL)
+
+#include <cassert>
+#include <cstdint>
+
+#ifndef AECCT_HOST_RING_CHANNEL_DEPTH
+#define AECCT_HOST_RING_CHANNEL_DEPTH 1024u
+#endif
+
+namespace aecct {
+
+static_assert((AECCT_HOST_RING_CHANNEL_DEPTH & (AECCT_HOST_RING_CHANNEL_DEPTH - 1u)) == 0u,
+    "AECCT_HOST_RING_CHANNEL_DEPTH must be a power of two");
+
+template<typename T>
+class HostRingChannel {
+public:
+    typedef T element_type;
+
+    HostRingChannel() : buf_(0), cap_(0u), head_(0u), tail_(0u), size_calls_(0) {
+        grow(AECCT_HOST_RING_CHANNEL_DEPTH);
+    }
+    ~HostRingChannel() { delete[] buf_; }
+
+    T read() {
+        assert(head_ != tail_ && "read from empty channel");
+        return buf_[(head_++) & (cap_ - 1u)];
+    }
+    void read(T& t) { t = read(); }
+    bool nb_read(T& t) {
+        if (head_ == tail_) {
+            return false;
+        }
+        t = buf_[(head_++) & (cap_ - 1u)];
+        return true;
+    }
+
+    T peek() {
+        assert(head_ != tail_ && "peek from empty channel");
+        return buf_[head_ & (cap_ - 1u)];
+    }
+    void peek(T& t) { t = peek(); }
+    bool nb_peek(T& t) {
+        if (head_ == tail_) {
+            return false;
+        }
+        t = buf_[head_ & (cap_ - 1u)];
+        return true;
+    }
+
+    void write(const T& t) {
+        if ((tail_ - head_) == cap_) {
+            grow(cap_ << 1);
+        }
+        buf_[(tail_++) & (cap_ - 1u)] = t;
+    }
+    bool nb_write(const T& t) {
+        ++size_calls_;
+        write(t);
+        return true;
+    }
+
+    unsigned int size() {
+        ++size_calls_;
+        return (unsigned int)(tail_ - head_);
+    }
+    bool empty() { return head_ == tail_; }
+    bool available(unsigned int k) const { return (tail_ - head_) >= (uint32_t)k; }
+    void reset() { head_ = tail_ = 0u; }
+    unsigned int debug_size() const { return (unsigned int)(tail_ - head_); }
+    const T& operator[](unsigned int pos) const { return buf_[(head_ + pos) & (cap_ - 1u)]; }
+    int get_size_call_count() {
+        const int n = size_calls_;
+        size_calls_ = 0;
+        return n;
+    }
+    uint32_t capacity() const { return cap_; }
+
+private:
+    // Re-linearize into a larger array; head_ restarts at 0.
+    void grow(uint32_t new_cap) {
+        T* nb = new T[new_cap];
+        const uint32_t n = tail_ - head_;
+        for (uint32_t i = 0u; i < n; ++i) {
+            nb[i] = buf_[(head_ + i) & (cap_ - 1u)];
+        }
+        delete[] buf_;
+        buf_ = nb;
+        cap_ = new_cap;
+        head_ = 0u;
+        tail_ = n;
+    }
+
+    HostRingChannel(const HostRingChannel&);
+    HostRingChannel& operator=(const HostRingChannel&);
+
+    T* buf_;
+    uint32_t cap_;
+    uint32_t head_;
+    uint32_t tail_;
+    int size_calls_;
+};
+
+} // namespace aecct
+
+// Variadic so template-ids with commas (ac_int<32, false>) pass as one argument.
+#define AECCT_HOST_RING_CHANNEL_SPECIALIZE(...) \
+    template<> \
+    class ac_channel<__VA_ARGS__> : public aecct::HostRingChannel<__VA_ARGS__> { \
+    public: \
+        ac_channel() {} \
+        explicit ac_channel(int init) { \
+            for (int i = init; i > 0; --i) { this->write(__VA_ARGS__()); } \
+        } \
+        ac_channel(int init, __VA_ARGS__ val) { \
+            for (int i = init; i > 0; --i) { this->write(val); } \
+        } \
+    private: \
+        ac_channel(const ac_channel&); \
+        ac_channel& operator=(const ac_channel&); \
+    }
+
+#else
+
+#define AECCT_HOST_RING_CHANNEL_SPECIALIZE(...) static_assert(true, "")
+
+#endif
@@ -14,9 +14,40 @@ static const unsigned LN_X_TOTAL_WORDS = (unsigned)(LN_TOKEN_COUNT * LN_D_MODEL)
 // 1.0e-5 in IEEE754 binary32.
 static const u32_t LN_EPS_BITS = (u32_t)0x3727C5ACu;
 
+// 1/sqrt(var + eps) per token (build-time knob AECCT_LN_INV_SQRT_MODE).
+enum LayerNormInvSqrtMode : unsigned {
+    LN_INV_SQRT_FP32 = 0u,     // fp32 sqrt, then fp32 divide (reference path)
+    LN_INV_SQRT_LUT = 1u,      // LayerNormInvSqrtLut.h seed only: no sqrt, no divide
+    LN_INV_SQRT_LUT_NR1 = 2u   // LUT seed + one Newton-Raphson step (multiplies only)
+};
+
+#ifndef AECCT_LN_INV_SQRT_MODE
+#define AECCT_LN_INV_SQRT_MODE 0
+#endif
+static const unsigned LN_INV_SQRT_MODE = (unsigned)AECCT_LN_INV_SQRT_MODE;
+static_assert(LN_INV_SQRT_MODE <= (unsigned)LN_INV_SQRT_LUT_NR1, "AECCT_LN_INV_SQRT_MODE must be 0, 1 or 2");
+
+// Per-token mean/variance path, carried in LayerNormCfg::mode
+// (build-time default for Top/TransformerLayer callers: AECCT_LN_MODE).
+enum LayerNormMode : unsigned {
+    LN_MODE_TWO_PASS = 0u,    // fp32 sum/sumsq, X row read again for normalize (reference path)
+    LN_MODE_SUM_SUMSQ = 1u    // X row read once into registers, quant_acc_t sum/sumsq
+};
+
+#ifndef AECCT_LN_MODE
+#define AECCT_LN_MODE 0
+#endif
+static const unsigned LN_MODE_DEFAULT = (unsigned)AECCT_LN_MODE;
+static_assert(LN_MODE_DEFAULT <= (unsigned)LN_MODE_SUM_SUMSQ, "AECCT_LN_MODE must be 0 or 1");
+
 static const unsigned LN_X_IN_BASE_WORD_DEFAULT = (unsigned)sram_map::X_PAGE0_BASE_W;
 static const unsigned LN_X_OUT_BASE_WORD_DEFAULT = (unsigned)sram_map::X_PAGE1_BASE_W;
-static const unsigned LN_GAMMA_BASE_WORD_DEFAULT = (unsigned)sram_map::W_REGION_BASE;
-static const unsigned LN_BETA_BASE_WORD_DEFAULT = (unsigned)(sram_map::W_REGION_BASE + LN_D_MODEL);
+// Mid/end LN gamma/beta copies sit past the FFN W1/ReLU tensors and FFN LN affine in SCR_WORK.
+static const unsigned LN_GAMMA_BASE_WORD_DEFAULT =
+    (unsigned)(sram_map::BASE_SCR_WORK_W + 2u * LN_TOKEN_COUNT * (unsigned)D_FFN + 2u * LN_D_MODEL);
+static const unsigned LN_BETA_BASE_WORD_DEFAULT = (unsigned)(LN_GAMMA_BASE_WORD_DEFAULT + LN_D_MODEL);
+// Pre-layer LN affine words are read in place from the active PARAM image (offsets from its base).
+static const unsigned LN_PRE_GAMMA_PARAM_OFFSET_WORDS = 0u;
+static const unsigned LN_PRE_BETA_PARAM_OFFSET_WORDS = (unsigned)LN_D_MODEL;
 
 } // namespace aecct
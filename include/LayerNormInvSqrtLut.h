@@ -0,0 +1,81 @@
+#pragma once
+// AUTO-GENERATED by tools/gen_ref_lut.py --target layernorm
+// LayerNorm 1/sqrt seed LUT. x = m * 2^(2k), m in [1, 4); index is
+// {exponent parity, top LN_INV_SQRT_LUT_MANT_BITS mantissa bits}; entry is the
+// minimax 1/sqrt(m) of the bin as IEEE754 binary32 bits.
+
+#include <cstdint>
+
+namespace aecct {
+
+static const unsigned LN_INV_SQRT_LUT_MANT_BITS = 8u;
+static const unsigned LN_INV_SQRT_LUT_SIZE = 512u;
+
+static const uint32_t kLnInvSqrtLutBits[512] = {
+    0x3F7FC020u, 0x3F7F40DFu, 0x3F7EC25Bu, 0x3F7E4492u, 0x3F7DC784u, 0x3F7D4B2Du, 0x3F7CCF8Cu, 0x3F7C549Fu,
+    0x3F7BDA65u, 0x3F7B60DCu, 0x3F7AE802u, 0x3F7A6FD6u, 0x3F79F856u, 0x3F798180u, 0x3F790B53u, 0x3F7895CEu,
+    0x3F7820EEu, 0x3F77ACB2u, 0x3F77391Au, 0x3F76C622u, 0x3F7653CAu, 0x3F75E211u, 0x3F7570F5u, 0x3F750074u,
+    0x3F74908Du, 0x3F74213Fu, 0x3F73B289u, 0x3F734468u, 0x3F72D6DDu, 0x3F7269E5u, 0x3F71FD7Fu, 0x3F7191A9u,
+    0x3F712664u, 0x3F70BBADu, 0x3F705183u, 0x3F6FE7E5u, 0x3F6F7ED2u, 0x3F6F1649u, 0x3F6EAE48u, 0x3F6E46CEu,
+    0x3F6DDFDAu, 0x3F6D796Cu, 0x3F6D1381u, 0x3F6CAE19u, 0x3F6C4933u, 0x3F6BE4CDu, 0x3F6B80E7u, 0x3F6B1D7Fu,
+    0x3F6ABA95u, 0x3F6A5827u, 0x3F69F635u, 0x3F6994BDu, 0x3F6933BFu, 0x3F68D339u, 0x3F68732Au, 0x3F681392u,
+    0x3F67B46Fu, 0x3F6755C1u, 0x3F66F787u, 0x3F6699C0u, 0x3F663C6Au, 0x3F65DF86u, 0x3F658311u, 0x3F65270Cu,
+    0x3F64CB75u, 0x3F64704Cu, 0x3F64158Fu, 0x3F63BB3Eu, 0x3F636158u, 0x3F6307DCu, 0x3F62AEC9u, 0x3F62561Fu,
+    0x3F61FDDDu, 0x3F61A601u, 0x3F614E8Cu, 0x3F60F77Cu, 0x3F60A0D1u, 0x3F604A89u, 0x3F5FF4A5u, 0x3F5F9F23u,
+    0x3F5F4A03u, 0x3F5EF543u, 0x3F5EA0E4u, 0x3F5E4CE5u, 0x3F5DF944u, 0x3F5DA601u, 0x3F5D531Cu, 0x3F5D0093u,
+    0x3F5CAE67u, 0x3F5C5C96u, 0x3F5C0B1Fu, 0x3F5BBA03u, 0x3F5B6940u, 0x3F5B18D6u, 0x3F5AC8C4u, 0x3F5A790Au,
+    0x3F5A29A7u, 0x3F59DA99u, 0x3F598BE2u, 0x3F593D80u, 0x3F58EF72u, 0x3F58A1B8u, 0x3F585451u, 0x3F58073Du,
+    0x3F57BA7Cu, 0x3F576E0Bu, 0x3F5721ECu, 0x3F56D61Eu, 0x3F568A9Fu, 0x3F563F6Fu, 0x3F55F48Fu, 0x3F55A9FDu,
+    0x3F555FB8u, 0x3F5515C1u, 0x3F54CC16u, 0x3F5482B8u, 0x3F5439A5u, 0x3F53F0DEu, 0x3F53A861u, 0x3F53602Eu,
+    0x3F531845u, 0x3F52D0A6u, 0x3F52894Fu, 0x3F524240u, 0x3F51FB79u, 0x3F51B4F9u, 0x3F516EC0u, 0x3F5128CDu,
+    0x3F50E321u, 0x3F509DBAu, 0x3F505897u, 0x3F5013BAu, 0x3F4FCF20u, 0x3F4F8ACAu, 0x3F4F46B8u, 0x3F4F02E8u,
+    0x3F4EBF5Au, 0x3F4E7C0Fu, 0x3F4E3905u, 0x3F4DF63Cu, 0x3F4DB3B4u, 0x3F4D716Cu, 0x3F4D2F64u, 0x3F4CED9Cu,
+    0x3F4CAC13u, 0x3F4C6AC8u, 0x3F4C29BCu, 0x3F4BE8EEu, 0x3F4BA85Du, 0x3F4B6809u, 0x3F4B27F3u, 0x3F4AE818u,
+    0x3F4AA87Au, 0x3F4A6918u, 0x3F4A29F0u, 0x3F49EB04u, 0x3F49AC53u, 0x3F496DDBu, 0x3F492F9Eu, 0x3F48F19Au,
+    0x3F48B3CFu, 0x3F48763Du, 0x3F4838E4u, 0x3F47FBC3u, 0x3F47BEDAu, 0x3F478228u, 0x3F4745ADu, 0x3F47096Au,
+    0x3F46CD5Du, 0x3F469186u, 0x3F4655E5u, 0x3F461A79u, 0x3F45DF43u, 0x3F45A442u, 0x3F456976u, 0x3F452EDEu,
+    0x3F44F47Au, 0x3F44BA49u, 0x3F44804Cu, 0x3F444683u, 0x3F440CECu, 0x3F43D388u, 0x3F439A56u, 0x3F436156u,
+    0x3F432887u, 0x3F42EFEBu, 0x3F42B77Fu, 0x3F427F44u, 0x3F42473Au, 0x3F420F60u, 0x3F41D7B6u, 0x3F41A03Cu,
+    0x3F4168F2u, 0x3F4131D7u, 0x3F40FAEAu, 0x3F40C42Du, 0x3F408D9Eu, 0x3F40573Du, 0x3F40210Au, 0x3F3FEB05u,
+    0x3F3FB52Eu, 0x3F3F7F83u, 0x3F3F4A06u, 0x3F3F14B5u, 0x3F3EDF91u, 0x3F3EAA99u, 0x3F3E75CDu, 0x3F3E412Du,
+    0x3F3E0CB8u, 0x3F3DD86Fu, 0x3F3DA450u, 0x3F3D705Du, 0x3F3D3C94u, 0x3F3D08F5u, 0x3F3CD581u, 0x3F3CA237u,
+    0x3F3C6F16u, 0x3F3C3C1Fu, 0x3F3C0951u, 0x3F3BD6ACu, 0x3F3BA430u, 0x3F3B71DCu, 0x3F3B3FB1u, 0x3F3B0DAEu,
+    0x3F3ADBD3u, 0x3F3AAA20u, 0x3F3A7895u, 0x3F3A4731u, 0x3F3A15F4u, 0x3F39E4DEu, 0x3F39B3EEu, 0x3F398326u,
+    0x3F395283u, 0x3F392207u, 0x3F38F1B1u, 0x3F38C181u, 0x3F389176u, 0x3F386190u, 0x3F3831D0u, 0x3F380235u,
+    0x3F37D2BFu, 0x3F37A36Du, 0x3F377440u, 0x3F374537u, 0x3F371652u, 0x3F36E791u, 0x3F36B8F4u, 0x3F368A7Bu,
+    0x3F365C24u, 0x3F362DF1u, 0x3F35FFE1u, 0x3F35D1F4u, 0x3F35A42Au, 0x3F357682u, 0x3F3548FDu, 0x3F351B99u,
+    0x3F34D7C9u, 0x3F347DCDu, 0x3F342457u, 0x3F33CB66u, 0x3F3372F8u, 0x3F331B0Cu, 0x3F32C3A1u, 0x3F326CB5u,
+    0x3F321648u, 0x3F31C058u, 0x3F316AE3u, 0x3F3115EAu, 0x3F30C16Au, 0x3F306D63u, 0x3F3019D3u, 0x3F2FC6B9u,
+    0x3F2F7414u, 0x3F2F21E4u, 0x3F2ED027u, 0x3F2E7EDCu, 0x3F2E2E01u, 0x3F2DDD97u, 0x3F2D8D9Cu, 0x3F2D3E0Fu,
+    0x3F2CEEEEu, 0x3F2CA03Au, 0x3F2C51F1u, 0x3F2C0412u, 0x3F2BB69Cu, 0x3F2B698Fu, 0x3F2B1CE8u, 0x3F2AD0A9u,
+    0x3F2A84CEu, 0x3F2A3959u, 0x3F29EE47u, 0x3F29A399u, 0x3F29594Cu, 0x3F290F61u, 0x3F28C5D6u, 0x3F287CABu,
+    0x3F2833DFu, 0x3F27EB71u, 0x3F27A360u, 0x3F275BABu, 0x3F271452u, 0x3F26CD55u, 0x3F2686B1u, 0x3F264067u,
+    0x3F25FA75u, 0x3F25B4DCu, 0x3F256F9Au, 0x3F252AAEu, 0x3F24E618u, 0x3F24A1D7u, 0x3F245DEBu, 0x3F241A53u,
+    0x3F23D70Eu, 0x3F23941Bu, 0x3F23517Au, 0x3F230F2Au, 0x3F22CD2Bu, 0x3F228B7Bu, 0x3F224A1Bu, 0x3F22090Au,
+    0x3F21C846u, 0x3F2187D0u, 0x3F2147A7u, 0x3F2107CAu, 0x3F20C838u, 0x3F2088F2u, 0x3F2049F6u, 0x3F200B44u,
+    0x3F1FCCDCu, 0x3F1F8EBCu, 0x3F1F50E4u, 0x3F1F1354u, 0x3F1ED60Bu, 0x3F1E9909u, 0x3F1E5C4Du, 0x3F1E1FD7u,
+    0x3F1DE3A5u, 0x3F1DA7B8u, 0x3F1D6C0Fu, 0x3F1D30AAu, 0x3F1CF588u, 0x3F1CBAA8u, 0x3F1C800Au, 0x3F1C45AEu,
+    0x3F1C0B93u, 0x3F1BD1B9u, 0x3F1B981Eu, 0x3F1B5EC4u, 0x3F1B25A9u, 0x3F1AECCCu, 0x3F1AB42Eu, 0x3F1A7BCEu,
+    0x3F1A43ABu, 0x3F1A0BC5u, 0x3F19D41Cu, 0x3F199CAFu, 0x3F19657Du, 0x3F192E87u, 0x3F18F7CCu, 0x3F18C14Cu,
+    0x3F188B05u, 0x3F1854F8u, 0x3F181F25u, 0x3F17E98Au, 0x3F17B428u, 0x3F177EFEu, 0x3F174A0Cu, 0x3F171551u,
+    0x3F16E0CDu, 0x3F16AC80u, 0x3F167869u, 0x3F164488u, 0x3F1610DCu, 0x3F15DD66u, 0x3F15AA24u, 0x3F157717u,
+    0x3F15443Eu, 0x3F151199u, 0x3F14DF27u, 0x3F14ACE8u, 0x3F147ADCu, 0x3F144902u, 0x3F14175Au, 0x3F13E5E5u,
+    0x3F13B4A0u, 0x3F13838Du, 0x3F1352AAu, 0x3F1321F8u, 0x3F12F176u, 0x3F12C124u, 0x3F129102u, 0x3F12610Fu,
+    0x3F12314Au, 0x3F1201B5u, 0x3F11D24Du, 0x3F11A314u, 0x3F117408u, 0x3F11452Au, 0x3F11167Au, 0x3F10E7F6u,
+    0x3F10B99Eu, 0x3F108B73u, 0x3F105D74u, 0x3F102FA1u, 0x3F1001FAu, 0x3F0FD47Eu, 0x3F0FA72Cu, 0x3F0F7A06u,
+    0x3F0F4D0Au, 0x3F0F2038u, 0x3F0EF390u, 0x3F0EC712u, 0x3F0E9ABDu, 0x3F0E6E91u, 0x3F0E428Eu, 0x3F0E16B4u,
+    0x3F0DEB03u, 0x3F0DBF7Au, 0x3F0D9418u, 0x3F0D68DFu, 0x3F0D3DCDu, 0x3F0D12E2u, 0x3F0CE81Eu, 0x3F0CBD81u,
+    0x3F0C930Bu, 0x3F0C68BBu, 0x3F0C3E91u, 0x3F0C148Cu, 0x3F0BEAAEu, 0x3F0BC0F5u, 0x3F0B9761u, 0x3F0B6DF3u,
+    0x3F0B44A9u, 0x3F0B1B84u, 0x3F0AF283u, 0x3F0AC9A6u, 0x3F0AA0EDu, 0x3F0A7858u, 0x3F0A4FE7u, 0x3F0A2799u,
+    0x3F09FF6Eu, 0x3F09D766u, 0x3F09AF81u, 0x3F0987BEu, 0x3F09601Eu, 0x3F0938A0u, 0x3F091143u, 0x3F08EA09u,
+    0x3F08C2F0u, 0x3F089BF9u, 0x3F087523u, 0x3F084E6Eu, 0x3F0827DAu, 0x3F080166u, 0x3F07DB13u, 0x3F07B4E1u,
+    0x3F078ECEu, 0x3F0768DCu, 0x3F074309u, 0x3F071D56u, 0x3F06F7C2u, 0x3F06D24Eu, 0x3F06ACF9u, 0x3F0687C2u,
+    0x3F0662ABu, 0x3F063DB2u, 0x3F0618D8u, 0x3F05F41Bu, 0x3F05CF7Du, 0x3F05AAFDu, 0x3F05869Bu, 0x3F056256u,
+    0x3F053E2Fu, 0x3F051A25u, 0x3F04F639u, 0x3F04D269u, 0x3F04AEB7u, 0x3F048B21u, 0x3F0467A7u, 0x3F04444Au,
+    0x3F042109u, 0x3F03FDE5u, 0x3F03DADCu, 0x3F03B7EFu, 0x3F03951Eu, 0x3F037269u, 0x3F034FCFu, 0x3F032D50u,
+    0x3F030AECu, 0x3F02E8A3u, 0x3F02C676u, 0x3F02A462u, 0x3F02826Au, 0x3F02608Cu, 0x3F023EC8u, 0x3F021D1Eu,
+    0x3F01FB8Fu, 0x3F01DA19u, 0x3F01B8BDu, 0x3F01977Bu, 0x3F017652u, 0x3F015543u, 0x3F01344Du, 0x3F011370u,
+    0x3F00F2ACu, 0x3F00D201u, 0x3F00B16Fu, 0x3F0090F6u, 0x3F007095u, 0x3F00504Cu, 0x3F00301Cu, 0x3F001004u
+};
+
+} // namespace aecct
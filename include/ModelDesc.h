@@ -32,10 +32,24 @@ enum CfgFieldOrder : uint32_t {
   // 0: x_pred only, 1: logits only, 2: none (suppress normal infer outputs)
   CFG_OUT_MODE = 10,
 
-  // Reserved (future compatibility)
-  CFG_RESERVED0 = 11,
+  // Optional datapath features (CfgFeatureBit); 0 = baseline datapath.
+  CFG_FEATURES = 11,
+  CFG_RESERVED0 = CFG_FEATURES,  // legacy name (word 11 was reserved, always 0)
 };
 
+// CFG_FEATURES bits. Undefined bits must be 0 (CFG_RX fails with ERR_CFG_ILLEGAL).
+enum CfgFeatureBit : uint32_t {
+  CFG_FEAT_ATTN_SPARSE      = 1u << 0,  // Phase-B walks src_mask key lists (CSR)
+  CFG_FEAT_ATTN_MASK_BITMAP = 1u << 1,  // Phase-B AE/AF gated by per-ring key bitmaps
+  CFG_FEAT_ATTN_FUSED       = 1u << 2,  // Phase-B score+softmax+V in one pass
+  CFG_FEAT_INFER_EARLY_EXIT = 1u << 3,  // zero-syndrome codewords bypass the decoder
+  CFG_FEAT_LN_QKV_FUSED     = 1u << 4,  // layer tail feeds the managed layer's Q/K/V per token
+};
+
+static const uint32_t CFG_FEATURES_DEFINED_MASK =
+  CFG_FEAT_ATTN_SPARSE | CFG_FEAT_ATTN_MASK_BITMAP | CFG_FEAT_ATTN_FUSED |
+  CFG_FEAT_INFER_EARLY_EXIT | CFG_FEAT_LN_QKV_FUSED;
+
 static const uint32_t EXP_LEN_CFG_WORDS = 12;
 
 struct ModelDescRegs {
@@ -53,7 +67,7 @@ struct ModelDescRegs {
   uint32_t enable_lpe_token;
 
   uint32_t out_mode;
-  uint32_t reserved0;
+  uint32_t reserved0;        // CFG_FEATURES
 };
 
 // Preset derived from provided files:
@@ -75,6 +89,6 @@ static inline ModelDescRegs modeldesc_preset_bch_n63_k51_ndec2_d32_h8() {
   r.enable_lpe_token = 1;
 
   r.out_mode = 0; // default: x_pred only (can override via SET_OUTMODE)
-  r.reserved0 = 0;
+  r.reserved0 = 0; // baseline datapath, no optional features
   return r;
 }
@@ -18,10 +18,11 @@
 //
 // Notes:
 // - X_WORK is the only baseline shared working area.
-// - SCR_K / SCR_V / FINAL_SCALAR are SCRATCH sub-regions.
+// - SCR_K / SCR_V / FINAL_SCALAR / ATTN_CSR / ATTN_RING_BITMAP / WORK are SCRATCH sub-regions.
 // - [compat] X_PAGE0 / X_PAGE1 names remain aliases; they are not a separate
 //   baseline taxonomy in this step.
 // - No dedicated DEBUG SRAM region (D1 debug is "halt + READ_MEM").
+// - IO_REGION holds only the overlapped-INFER input ping/pong pages.
 // - [legacy] Separate BIAS/WEIGHT regions are still exposed for compatibility.
 // ============================================================
 
@@ -66,6 +67,7 @@ enum SramRegion : uint8_t {
   REG_X_PAGE1 = 1,
   REG_SCRATCH = 2,
   REG_W_REGION = 3,
+  REG_IO_REGION = 4,
   REG_INVALID = 255
 };
 
@@ -97,6 +99,9 @@ static const uint32_t X_PAGE1_WORDS  = SIZE_X_PONG_W;
 // SCR_K: fp32 [N_NODES, D_MODEL]
 // SCR_V: fp32 [N_NODES, D_MODEL]
 // SCR_FINAL_SCALAR: fp32 [N_NODES]
+// SCR_ATTN_CSR: per-ring src_mask key lists, built at LOAD_W completion
+// SCR_ATTN_RING_BITMAP: per-ring allowed-key bitmaps, built at LOAD_W completion
+// SCR_WORK: per-layer attention / FFN / LayerNorm intermediates
 static const uint32_t BASE_SCRATCH_W = BASE_X_PONG_W + SIZE_X_PONG_W;
 
 static const uint32_t BASE_SCR_K_W = align_up_words(BASE_SCRATCH_W, ALIGN_WORDS);
@@ -114,8 +119,43 @@ static const uint32_t SCR_FINAL_SCALAR_BASE_W = BASE_SCR_FINAL_SCALAR_W;
 static const uint32_t SCR_FINAL_SCALAR_WORDS = SIZE_SCR_FINAL_SCALAR_W;
 static const uint32_t SCR_FINAL_SCALAR_BASE = SCR_FINAL_SCALAR_BASE_W;
 
+// SCR_ATTN_CSR: one CSR per attention ring (one-ring, second-ring).
+// Each ring holds row_ptr[N_NODES + 1] followed by key indices packed 4 x u8 per word.
+static const uint32_t ATTN_CSR_RINGS = 2u;
+static const uint32_t ATTN_CSR_KEYS_PER_WORD = 4u;
+static const uint32_t ATTN_CSR_ROW_PTR_WORDS = N_NODES + 1u;
+static const uint32_t ATTN_CSR_COL_WORDS =
+  (N_NODES * N_NODES + ATTN_CSR_KEYS_PER_WORD - 1u) / ATTN_CSR_KEYS_PER_WORD;
+static const uint32_t ATTN_CSR_RING_WORDS = ATTN_CSR_ROW_PTR_WORDS + ATTN_CSR_COL_WORDS;
+
+static const uint32_t BASE_SCR_ATTN_CSR_W =
+  align_up_words(BASE_SCR_FINAL_SCALAR_W + SIZE_SCR_FINAL_SCALAR_W, ALIGN_WORDS);
+static const uint32_t SIZE_SCR_ATTN_CSR_W =
+  align_up_words(ATTN_CSR_RINGS * ATTN_CSR_RING_WORDS, ALIGN_WORDS);
+
+// SCR_ATTN_RING_BITMAP: allowed keys of each query row per ring, one bit per key
+// (bit b of word c = key 32 * c + b), so the bitmap AE/AF pair loads one word per 32 keys.
+static const uint32_t ATTN_RING_BITMAP_ROW_WORDS = (N_NODES + 31u) / 32u;
+static const uint32_t ATTN_RING_BITMAP_RING_WORDS = N_NODES * ATTN_RING_BITMAP_ROW_WORDS;
+
+static const uint32_t BASE_SCR_ATTN_RING_BITMAP_W = BASE_SCR_ATTN_CSR_W + SIZE_SCR_ATTN_CSR_W;
+static const uint32_t SIZE_SCR_ATTN_RING_BITMAP_W =
+  align_up_words(ATTN_CSR_RINGS * ATTN_RING_BITMAP_RING_WORDS, ALIGN_WORDS);
+
+// SCR_WORK: attention V / score / softmax / concat / act-quant tensors (9 x [N_NODES, D_MODEL]),
+// then reused by FFN W1_OUT / RELU_OUT (2 x [N_NODES, D_FFN]) plus FFN and mid/end LayerNorm gamma/beta.
+// Attention, FFN and LayerNorm of one layer run back to back, so they share the span.
+// Kept out of W_REGION so PARAM images survive INFER.
+static const uint32_t SCR_WORK_ATTN_WORDS = 9u * WORDS_X_FP32;
+static const uint32_t SCR_WORK_FFN_WORDS = 2u * N_NODES * D_FFN + 4u * D_MODEL;
+
+static const uint32_t BASE_SCR_WORK_W =
+  align_up_words(BASE_SCR_ATTN_RING_BITMAP_W + SIZE_SCR_ATTN_RING_BITMAP_W, ALIGN_WORDS);
+static const uint32_t SIZE_SCR_WORK_W = align_up_words(
+  (SCR_WORK_ATTN_WORDS > SCR_WORK_FFN_WORDS) ? SCR_WORK_ATTN_WORDS : SCR_WORK_FFN_WORDS, ALIGN_WORDS);
+
 static const uint32_t SIZE_SCRATCH_W =
-  (BASE_SCR_FINAL_SCALAR_W + SIZE_SCR_FINAL_SCALAR_W) - BASE_SCRATCH_W;
+  (BASE_SCR_WORK_W + SIZE_SCR_WORK_W) - BASE_SCRATCH_W;
 
 // ----------------------------
 // [legacy] BIAS region (fp32 words)
@@ -138,24 +178,67 @@ static const uint32_t SIZE_W_W = align_up_words(EXP_LEN_W_WORDS, ALIGN_WORDS);
 // ----------------------------
 // Unified PARAM stream is written starting at runtime param_base_word.
 // SET_W_BASE must range-check param_base_word against this allowed region.
+//
+// W_REGION holds PARAM_SLOT_COUNT resident PARAM images back to back. Slot 0 is
+// the legacy BIAS/WEIGHT image at PARAM_BASE_DEFAULT; slot k starts
+// k * PARAM_SLOT_WORDS later. INFER only reads W_REGION, so every slot stays
+// resident across INFER.
+#ifndef AECCT_PARAM_SLOT_COUNT
+#define AECCT_PARAM_SLOT_COUNT 1
+#endif
+static const uint32_t PARAM_SLOT_COUNT = AECCT_PARAM_SLOT_COUNT;
+static const uint32_t PARAM_SLOT_WORDS = (SIZE_BIAS_W + SIZE_W_W);
+static_assert((PARAM_SLOT_COUNT >= 1u) && (PARAM_SLOT_COUNT <= 32u), "PARAM_SLOT_COUNT must be 1..32");
+
 static const uint32_t W_REGION_BASE  = BASE_BIAS_W;
-static const uint32_t W_REGION_WORDS = (SIZE_BIAS_W + SIZE_W_W);
+static const uint32_t W_REGION_WORDS = PARAM_SLOT_WORDS * PARAM_SLOT_COUNT;
 
 // Suggested default for TB bring-up (if no special placement is needed).
 static const uint32_t PARAM_BASE_DEFAULT = W_REGION_BASE;
 
+constexpr uint32_t param_slot_base_w(uint32_t slot) {
+  return W_REGION_BASE + slot * PARAM_SLOT_WORDS;
+}
+
+// ----------------------------
+// PARAM_SLOT_TABLE (Top-written, READ_MEM-visible)
+// ----------------------------
+// word 0: PARAM_SLOT_COUNT
+// word 1: populated bitmap (bit k = slot k holds a committed LOAD_W image)
+// word 2: active slot (PARAM_SLOT_COUNT when param_base_word is not a slot base)
+// word 3: reserved (0)
+// then per slot k: [4 + 2k] = slot base word, [5 + 2k] = LOAD_W checksum (0 when empty)
+static const uint32_t PARAM_SLOT_TABLE_HDR_WORDS = 4u;
+static const uint32_t PARAM_SLOT_TABLE_ENTRY_WORDS = 2u;
+static const uint32_t BASE_PARAM_SLOT_TABLE_W = W_REGION_BASE + W_REGION_WORDS;
+static const uint32_t SIZE_PARAM_SLOT_TABLE_W = align_up_words(
+  PARAM_SLOT_TABLE_HDR_WORDS + PARAM_SLOT_TABLE_ENTRY_WORDS * PARAM_SLOT_COUNT, ALIGN_WORDS);
+
 // ----------------------------
 // END / sizing
 // ----------------------------
-static const uint32_t END_W = BASE_W_W + SIZE_W_W;
+static const uint32_t END_W = BASE_PARAM_SLOT_TABLE_W + SIZE_PARAM_SLOT_TABLE_W;
+
+// ----------------------------
+// IO_REGION (INFER input staging ping-pong)
+// ----------------------------
+// Single-shot INFER stays channel-oriented and stages y in SCRATCH.
+// Overlapped INFER lands codeword N+1 in one IO page while codeword N is
+// computed from the other; X_WORK pages are both live during the layer loop.
+static const uint32_t IO_IN_PAGE_WORDS = align_up_words(EXP_LEN_INFER_IN_WORDS, ALIGN_WORDS);
 
-// IO_REGION is channel-oriented in current bring-up path, so SRAM window is
-// kept as an empty placeholder for taxonomy completeness.
 static const uint32_t IO_REGION_BASE_W = END_W;
-static const uint32_t IO_REGION_WORDS = 0;
+
+static const uint32_t BASE_IO_IN_PING_W = IO_REGION_BASE_W;
+static const uint32_t SIZE_IO_IN_PING_W = IO_IN_PAGE_WORDS;
+
+static const uint32_t BASE_IO_IN_PONG_W = BASE_IO_IN_PING_W + SIZE_IO_IN_PING_W;
+static const uint32_t SIZE_IO_IN_PONG_W = IO_IN_PAGE_WORDS;
+
+static const uint32_t IO_REGION_WORDS = SIZE_IO_IN_PING_W + SIZE_IO_IN_PONG_W;
 
 // Minimum required SRAM depth (words) for this memory map.
-static const uint32_t SRAM_WORDS_MIN_REQUIRED = END_W;
+static const uint32_t SRAM_WORDS_MIN_REQUIRED = IO_REGION_BASE_W + IO_REGION_WORDS;
 
 // NOTE: Your actual SRAM depth may be larger.
 // For TB bring-up, you may set SRAM_WORDS_TOTAL = SRAM_WORDS_MIN_REQUIRED.
@@ -173,6 +256,7 @@ static inline SramRegion region_of_addr(uint32_t addr_w) {
   if (in_range(addr_w, X_PAGE1_BASE_W, X_PAGE1_WORDS)) return REG_X_PAGE1;
   if (in_range(addr_w, BASE_SCRATCH_W, SIZE_SCRATCH_W)) return REG_SCRATCH;
   if (in_range(addr_w, W_REGION_BASE, W_REGION_WORDS)) return REG_W_REGION;
+  if (in_range(addr_w, IO_REGION_BASE_W, IO_REGION_WORDS)) return REG_IO_REGION;
   return REG_INVALID;
 }
 
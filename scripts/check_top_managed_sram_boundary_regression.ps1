@@ -139,7 +139,7 @@ Require-Regex -Text $topText -Pattern '(?ms)static\s+inline\s+bool\s+infer_contr
 Require-Regex -Text $topText -Pattern '(?ms)static\s+inline\s+void\s+infer_contract_arm_for_op_infer\s*\(\s*TopRegs&\s+regs\s*\)' -Reason "infer_contract_arm_for_op_infer helper missing"
 Require-Regex -Text $topText -Pattern '(?ms)else\s+if\s*\(\s*op\s*==\s*\(uint8_t\)OP_INFER\s*\)[\s\S]*?infer_contract_arm_for_op_infer\s*\(\s*regs\s*\)\s*;[\s\S]*?infer_metadata_surface\s*\(\s*regs\s*\)[\s\S]*?ingest_meta_span_in_sram\s*\(\s*infer_meta\s*,\s*\(uint32_t\)INFER_IN_WORDS_EXPECTED\s*\)' -Reason "OP_INFER entry must validate infer ingest via metadata surface helper"
 Require-Regex -Text $topText -Pattern '(?ms)else\s+if\s*\(\s*op\s*==\s*\(uint8_t\)OP_INFER\s*\)[\s\S]*?if\s*\(\s*!ingest_meta_span_in_sram\s*\(\s*infer_meta\s*,\s*\(uint32_t\)INFER_IN_WORDS_EXPECTED\s*\)\s*\)\s*\{\s*ctrl_rsp\.write\s*\(\s*pack_ctrl_rsp_err\s*\(\s*\(uint8_t\)ERR_MEM_RANGE\s*\)\s*\)\s*;[\s\S]*?\}\s*else\s*\{\s*regs\.state\s*=\s*ST_INFER_RX\s*;\s*ctrl_rsp\.write\s*\(\s*pack_ctrl_rsp_ok\s*\(\s*\(uint8_t\)OP_INFER\s*\)\s*\)\s*;' -Reason "OP_INFER preflight reject/accept response contract missing"
-Require-Regex -Text $topText -Pattern '(?ms)else\s+if\s*\(\s*op\s*==\s*\(uint8_t\)OP_LOAD_W\s*\)[\s\S]*?param_ingest_span_legal\s*\(\s*regs\s*\)' -Reason "OP_LOAD_W must validate span via metadata harmonized helper"
+Require-Regex -Text $topText -Pattern '(?ms)else\s+if\s*\(\s*op\s*==\s*\(uint8_t\)OP_LOAD_W\s*(\|\|\s*op\s*==\s*\(uint8_t\)OP_LOAD_W_EX\s*)?\)[\s\S]*?param_ingest_span_legal\s*\(\s*regs\s*\)' -Reason "OP_LOAD_W / OP_LOAD_W_EX must validate span via metadata harmonized helper"
 Require-Regex -Text $topText -Pattern '(?ms)if\s*\(\s*op\s*==\s*\(uint8_t\)OP_CFG_COMMIT\s*\)\s*\{[\s\S]*?ingest_commit_diag_error\s*\([\s\S]*?RX_CFG[\s\S]*?ERR_CFG_LEN_MISMATCH' -Reason "CFG commit-time diagnostics must use harmonized helper and mismatch mapping"
 Require-Regex -Text $topText -Pattern '(?ms)param_ingest_one_word[\s\S]*?ingest_commit_diag_and_record\s*\(\s*regs\.accepted_commit_record\s*,[\s\S]*?RX_PARAM[\s\S]*?ERR_PARAM_LEN_MISMATCH' -Reason "PARAM commit-time diagnostics + accepted record harmonization missing"
 Require-Regex -Text $topText -Pattern '(?ms)infer_ingest_one_word[\s\S]*?ingest_commit_diag_and_record\s*\(\s*regs\.accepted_commit_record\s*,[\s\S]*?RX_INFER' -Reason "INFER commit-time diagnostics + accepted record harmonization missing"
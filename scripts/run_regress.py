@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""Build and run every tb/*.cpp testbench in parallel and report per-TB results.
+
+Each TB is its own job: compile with the README include set, then run the
+executable from the repo root (TBs read and write repo-relative paths such as
+gen/ternary_p11c_export.json). Jobs run on a pool of --jobs workers, so builds
+and runs of different TBs overlap; TBs that produce files other TBs read
+(PRODUCER_TBS) finish before the rest are scheduled. Results (status, build/run wall time, log paths) go to
+report.json and report.csv under --out-dir.
+
+With --baseline, each TB is compared against a stored report: a TB that passed
+in the baseline and no longer passes, or whose run time grew by more than
+--slowdown (ratio) and --min-delta (seconds), is flagged as a regression.
+--update-baseline writes the current report to the baseline path instead.
+"""
+
+from __future__ import annotations
+
+import argparse
+import csv
+import json
+import os
+import re
+import shlex
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+
+INCLUDE_DIRS = (
+    ".",
+    "include",
+    "src",
+    "data/weights",
+    "data/trace",
+    "AECCT_ac_ref/include",
+)
+# Vendor headers go in with -isystem so warnings stay on repo code only.
+SYSTEM_INCLUDE_DIRS = ("third_party/ac_types",)
+# Design loops carry labels for the HLS directives; the host build never jumps to them.
+DEFAULT_CXXFLAGS = "-std=c++20 -O1 -Wall -Wextra -Wno-unused-label"
+# TB -> repo file it writes for other TBs; run ahead of the pool.
+PRODUCER_TBS = {
+    "tb_ternary_export_p11c": "gen/ternary_p11c_export.json",
+}
+REPORT_FIELDS = ("name", "status", "build_s", "run_s", "exit_code", "build_log", "run_log")
+
+STATUS_PASS = "PASS"
+STATUS_FAIL = "FAIL"
+STATUS_TIMEOUT = "TIMEOUT"
+STATUS_BUILD_FAIL = "BUILD_FAIL"
+
+
+def discover_tbs(repo: Path, pattern: str | None) -> list[Path]:
+    rx = re.compile(pattern) if pattern else None
+    tbs = []
+    for path in sorted((repo / "tb").glob("*.cpp")):
+        if rx is None or rx.search(path.stem):
+            tbs.append(path)
+    return tbs
+
+
+def build_command(repo: Path, cxx: str, cxxflags: str, src: Path, exe: Path) -> list[str]:
+    cmd = [cxx] + shlex.split(cxxflags)
+    for inc in INCLUDE_DIRS:
+        if (repo / inc).is_dir():
+            cmd += ["-I", inc]
+    for inc in SYSTEM_INCLUDE_DIRS:
+        if (repo / inc).is_dir():
+            cmd += ["-isystem", inc]
+    cmd += [src.relative_to(repo).as_posix(), "-o", str(exe)]
+    return cmd
+
+
+def run_one(repo: Path, out_dir: Path, args: argparse.Namespace, src: Path) -> dict:
+    name = src.stem
+    exe = out_dir / "bin" / name
+    build_log = out_dir / "logs" / f"{name}.build.log"
+    run_log = out_dir / "logs" / f"{name}.run.log"
+    result = {
+        "name": name,
+        "status": STATUS_BUILD_FAIL,
+        "build_s": 0.0,
+        "run_s": 0.0,
+        "exit_code": None,
+        "build_log": build_log.as_posix(),
+        "run_log": "",
+    }
+
+    t0 = time.monotonic()
+    with build_log.open("w", encoding="utf-8") as log:
+        proc = subprocess.run(
+            build_command(repo, args.cxx, args.cxxflags, src, exe),
+            cwd=repo,
+            stdout=log,
+            stderr=subprocess.STDOUT,
+        )
+    result["build_s"] = round(time.monotonic() - t0, 3)
+    if proc.returncode != 0:
+        result["exit_code"] = proc.returncode
+        return result
+
+    result["run_log"] = run_log.as_posix()
+    t0 = time.monotonic()
+    with run_log.open("w", encoding="utf-8") as log:
+        try:
+            proc = subprocess.run(
+                [str(exe.resolve())],
+                cwd=repo,
+                stdout=log,
+                stderr=subprocess.STDOUT,
+                timeout=args.timeout,
+            )
+            result["exit_code"] = proc.returncode
+            result["status"] = STATUS_PASS if proc.returncode == 0 else STATUS_FAIL
+        except subprocess.TimeoutExpired:
+            result["status"] = STATUS_TIMEOUT
+    result["run_s"] = round(time.monotonic() - t0, 3)
+    return result
+
+
+def write_report(out_dir: Path, results: list[dict], wall_s: float) -> None:
+    report = {"wall_s": round(wall_s, 3), "results": results}
+    (out_dir / "report.json").write_text(json.dumps(report, indent=2) + "\n", encoding="utf-8")
+    with (out_dir / "report.csv").open("w", encoding="utf-8", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=REPORT_FIELDS)
+        writer.writeheader()
+        for row in results:
+            writer.writerow(row)
+
+
+def load_baseline(path: Path) -> dict[str, dict]:
+    data = json.loads(path.read_text(encoding="utf-8"))
+    return {row["name"]: row for row in data.get("results", [])}
+
+
+def find_regressions(
+    results: list[dict],
+    baseline: dict[str, dict],
+    slowdown: float,
+    min_delta: float,
+) -> list[str]:
+    findings = []
+    for row in results:
+        base = baseline.get(row["name"])
+        if base is None:
+            continue
+        if base["status"] == STATUS_PASS and row["status"] != STATUS_PASS:
+            findings.append(f"{row['name']}: status {base['status']} -> {row['status']}")
+            continue
+        if row["status"] != STATUS_PASS or base["status"] != STATUS_PASS:
+            continue
+        base_s = float(base["run_s"])
+        run_s = float(row["run_s"])
+        if run_s > base_s * slowdown and (run_s - base_s) > min_delta:
+            findings.append(f"{row['name']}: run time {base_s:.2f}s -> {run_s:.2f}s")
+    return findings
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--repo-root", default=".")
+    parser.add_argument("--out-dir", default="build/regress")
+    parser.add_argument("--jobs", "-j", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--filter", default=None, help="regex on TB name (file stem)")
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "g++"))
+    parser.add_argument("--cxxflags", default=DEFAULT_CXXFLAGS)
+    parser.add_argument("--timeout", type=float, default=600.0, help="per-TB run timeout in seconds")
+    parser.add_argument("--baseline", default=None, help="stored report.json to compare against")
+    parser.add_argument("--update-baseline", action="store_true")
+    parser.add_argument("--slowdown", type=float, default=1.25, help="run time ratio that counts as a regression")
+    parser.add_argument("--min-delta", type=float, default=0.5, help="ignore run time growth below this many seconds")
+    args = parser.parse_args()
+
+    repo = Path(args.repo_root).resolve()
+    out_dir = Path(args.out_dir)
+    if not out_dir.is_absolute():
+        out_dir = repo / out_dir
+    (out_dir / "bin").mkdir(parents=True, exist_ok=True)
+    (out_dir / "logs").mkdir(parents=True, exist_ok=True)
+
+    tbs = discover_tbs(repo, args.filter)
+    if not tbs:
+        print("FAIL: run_regress: no testbench matched")
+        return 1
+
+    producers = [src for src in tbs if src.stem in PRODUCER_TBS]
+    consumers = [src for src in tbs if src.stem not in PRODUCER_TBS]
+
+    t0 = time.monotonic()
+    results = []
+    with ThreadPoolExecutor(max_workers=max(1, args.jobs)) as pool:
+        for stage in (producers, consumers):
+            futures = [pool.submit(run_one, repo, out_dir, args, src) for src in stage]
+            for future in futures:
+                row = future.result()
+                results.append(row)
+                print(f"{row['status']:<10} {row['name']} build={row['build_s']:.1f}s run={row['run_s']:.1f}s", flush=True)
+    results.sort(key=lambda row: row["name"])
+    wall_s = time.monotonic() - t0
+    write_report(out_dir, results, wall_s)
+
+    counts: dict[str, int] = {}
+    for row in results:
+        counts[row["status"]] = counts.get(row["status"], 0) + 1
+    summary = " ".join(f"{k}={counts[k]}" for k in sorted(counts))
+    print(f"run_regress: {len(results)} TBs in {wall_s:.1f}s ({summary}); report in {out_dir.as_posix()}")
+
+    if args.baseline:
+        baseline_path = Path(args.baseline)
+        if args.update_baseline:
+            baseline_path.parent.mkdir(parents=True, exist_ok=True)
+            baseline_path.write_text((out_dir / "report.json").read_text(encoding="utf-8"), encoding="utf-8")
+            print(f"PASS: run_regress (baseline updated: {baseline_path.as_posix()})")
+            return 0
+        if not baseline_path.is_file():
+            print(f"FAIL: run_regress: missing baseline {baseline_path.as_posix()}")
+            return 1
+        findings = find_regressions(results, load_baseline(baseline_path), args.slowdown, args.min_delta)
+        if findings:
+            print("FAIL: run_regress")
+            for item in findings:
+                print(item)
+            return 1
+        print("PASS: run_regress")
+        return 0
+
+    if counts.get(STATUS_PASS, 0) != len(results):
+        print("FAIL: run_regress")
+        for row in results:
+            if row["status"] != STATUS_PASS:
+                print(f"{row['name']}: {row['status']}")
+        return 1
+    print("PASS: run_regress")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,179 @@
+#pragma once
+// Host-only SRAM image (compiled out under __SYNTHESIS__).
+// HostSramImage is a SramView over SRAM_WORDS_TOTAL words that lives either in a
+// caller-owned buffer (e.g. top_sram()) or in a file mapped MAP_SHARED, so block
+// entry points templated on SramView and Top itself (top_sram_bind) can run on it
+// directly. TBs snapshot / diff / restore word ranges between phases with one
+// call each, and a file-backed image is a checkpoint: host_sram_image_sync
+// flushes it and reopening the file resumes from the same SRAM state.
+// The file holds the host u32_t array as-is (not a packed 4-byte word dump), so a
+// checkpoint is only portable between builds with the same ac_int layout.
+// File mapping is POSIX only; on other hosts host_sram_image_open_file fails.
+
+#ifndef __SYNTHESIS__
+
+#include <cstdint>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "AecctTypes.h"
+#include "gen/SramMap.h"
+
+namespace aecct {
+
+    struct HostSramImage {
+        u32_t* words;
+        uint32_t word_count;
+        int fd;            // >= 0 when file-backed
+        bool mapped;
+
+        u32_t& operator[](uint32_t addr) { return words[addr]; }
+        const u32_t& operator[](uint32_t addr) const { return words[addr]; }
+    };
+
+    static inline void host_sram_image_clear(HostSramImage& img) {
+        img.words = 0;
+        img.word_count = 0u;
+        img.fd = -1;
+        img.mapped = false;
+    }
+
+    // View an existing buffer (no ownership).
+    static inline bool host_sram_image_attach(HostSramImage& img, u32_t* buffer, uint32_t word_count) {
+        host_sram_image_clear(img);
+        if (buffer == 0 || word_count == 0u) {
+            return false;
+        }
+        img.words = buffer;
+        img.word_count = word_count;
+        return true;
+    }
+
+    // Map path as a SRAM_WORDS_TOTAL image. A new or short file is zero-extended;
+    // an existing image keeps its contents (checkpoint resume).
+    static inline bool host_sram_image_open_file(HostSramImage& img, const char* path) {
+        host_sram_image_clear(img);
+#if !defined(_WIN32)
+        if (path == 0) {
+            return false;
+        }
+        const uint64_t bytes = (uint64_t)sram_map::SRAM_WORDS_TOTAL * sizeof(u32_t);
+        const int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || ((uint64_t)st.st_size < bytes && ::ftruncate(fd, (off_t)bytes) != 0)) {
+            ::close(fd);
+            return false;
+        }
+        void* p = ::mmap(0, (size_t)bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        img.words = static_cast<u32_t*>(p);
+        img.word_count = sram_map::SRAM_WORDS_TOTAL;
+        img.fd = fd;
+        img.mapped = true;
+        return true;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    // Flush a file-backed image; a buffer view has nothing to flush.
+    static inline bool host_sram_image_sync(const HostSramImage& img) {
+#if !defined(_WIN32)
+        if (img.mapped) {
+            return ::msync(img.words, (size_t)img.word_count * sizeof(u32_t), MS_SYNC) == 0;
+        }
+#endif
+        return img.words != 0;
+    }
+
+    static inline void host_sram_image_close(HostSramImage& img) {
+#if !defined(_WIN32)
+        if (img.mapped) {
+            ::munmap(img.words, (size_t)img.word_count * sizeof(u32_t));
+            ::close(img.fd);
+        }
+#endif
+        host_sram_image_clear(img);
+    }
+
+    static inline bool host_sram_image_range_ok(const HostSramImage& img, uint32_t base, uint32_t words) {
+        return img.words != 0 && base <= img.word_count && words <= (img.word_count - base);
+    }
+
+    // Copy [base, base + words) from src to dst at the same addresses.
+    static inline bool host_sram_image_copy(
+        HostSramImage& dst,
+        const HostSramImage& src,
+        uint32_t base,
+        uint32_t words
+    ) {
+        if (!host_sram_image_range_ok(dst, base, words) || !host_sram_image_range_ok(src, base, words)) {
+            return false;
+        }
+        std::memmove(static_cast<void*>(&dst.words[base]), static_cast<const void*>(&src.words[base]),
+            (size_t)words * sizeof(u32_t));
+        return true;
+    }
+
+    static inline bool host_sram_image_snapshot(
+        HostSramImage& snap,
+        const HostSramImage& live,
+        uint32_t base,
+        uint32_t words
+    ) {
+        return host_sram_image_copy(snap, live, base, words);
+    }
+
+    static inline bool host_sram_image_restore(
+        HostSramImage& live,
+        const HostSramImage& snap,
+        uint32_t base,
+        uint32_t words
+    ) {
+        return host_sram_image_copy(live, snap, base, words);
+    }
+
+    // Number of differing words in [base, base + words); first_diff receives the
+    // lowest differing address (base + words when equal). Returns words + 1 on a
+    // bad range.
+    static inline uint32_t host_sram_image_diff(
+        const HostSramImage& a,
+        const HostSramImage& b,
+        uint32_t base,
+        uint32_t words,
+        uint32_t* first_diff = 0
+    ) {
+        if (first_diff != 0) {
+            *first_diff = base + words;
+        }
+        if (!host_sram_image_range_ok(a, base, words) || !host_sram_image_range_ok(b, base, words)) {
+            return words + 1u;
+        }
+        uint32_t diffs = 0u;
+        for (uint32_t i = base; i < base + words; ++i) {
+            if (a.words[i] != b.words[i]) {
+                if (diffs == 0u && first_diff != 0) {
+                    *first_diff = i;
+                }
+                ++diffs;
+            }
+        }
+        return diffs;
+    }
+
+} // namespace aecct
+
+#endif // __SYNTHESIS__
@@ -0,0 +1,164 @@
+#pragma once
+// Streaming LOAD_W checker.
+// Each PARAM word is checked against its kParamMeta segment as it arrives, so a
+// bad image is known when the last word lands instead of after a second pass:
+// - BITPACK segments: padding above valid_bits in the last word must be zero.
+// - Ternary payload words: no reserved 0b10 code in any valid slot.
+// A rotate-add checksum covers the whole stream in order. When a row-mask cache
+// is supplied, ternary payload words and inv_s_w carriers are expanded into it in
+// the same pass.
+
+#include <cstdint>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "AecctUtil.h"
+#include "gen/ModelShapes.h"
+#include "gen/WeightStreamOrder.h"
+#include "blocks/TernaryLinearLive.h"
+
+namespace aecct {
+
+// Segments tile the PARAM stream back to back, so one cursor tracks them.
+static inline constexpr bool param_stream_segments_contiguous() {
+    uint32_t next = 0u;
+    for (uint32_t p = 0u; p < PARAM_COUNT; ++p) {
+        if (kParamMeta[p].offset_w != next || kParamMeta[p].len_w == 0u) {
+            return false;
+        }
+        next = kParamMeta[p].offset_w + kParamMeta[p].len_w;
+    }
+    return next <= EXP_LEN_PARAM_WORDS;
+}
+
+static_assert(param_stream_segments_contiguous(), "kParamMeta segments must tile the PARAM stream");
+
+// Quant-linear matrix whose ternary payload (or inv_s_w carrier) is param_id;
+// QUANT_LINEAR_MATRIX_COUNT when none.
+static inline constexpr uint32_t param_stream_ternary_matrix(uint32_t param_id) {
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        if (kQuantLinearMeta[m].weight_param_id == param_id) {
+            return m;
+        }
+    }
+    return (uint32_t)QUANT_LINEAR_MATRIX_COUNT;
+}
+
+static inline constexpr uint32_t param_stream_inv_sw_matrix(uint32_t param_id) {
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        if (kQuantLinearMeta[m].inv_sw_param_id == param_id) {
+            return m;
+        }
+    }
+    return (uint32_t)QUANT_LINEAR_MATRIX_COUNT;
+}
+
+struct ParamStreamCheckState {
+    u32_t seg_idx;
+    u32_t checksum;
+    u32_t pad_error_count;
+    u32_t ternary_error_count;
+    u32_t first_error_word;
+    u32_t first_error_code;   // ErrCode of the first violation (strict-mode commit status)
+    bool error;
+    bool matrix_bad[QUANT_LINEAR_MATRIX_COUNT];
+};
+
+static inline void param_stream_check_clear(ParamStreamCheckState& s) {
+    s.seg_idx = 0;
+    s.checksum = 0;
+    s.pad_error_count = 0;
+    s.ternary_error_count = 0;
+    s.first_error_word = 0;
+    s.first_error_code = (u32_t)ERR_OK;
+    s.error = false;
+    PARAM_STREAM_CHECK_CLEAR_MATRIX_LOOP: for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        s.matrix_bad[m] = false;
+    }
+}
+
+// Rotate-left-5 then add; order sensitive, one adder per word.
+static inline u32_t param_stream_checksum_step(u32_t checksum, u32_t word) {
+    const uint32_t c = (uint32_t)checksum.to_uint();
+    return (u32_t)(((c << 5) | (c >> 27)) + (uint32_t)word.to_uint());
+}
+
+// Reserved-code lanes of a ternary word: one bit per 2-bit slot holding 0b10.
+static inline uint32_t param_stream_ternary_rsvd_lanes(uint32_t word) {
+    return (word >> 1) & ~word & 0x55555555u;
+}
+
+static inline void param_stream_check_flag(ParamStreamCheckState& s, uint32_t idx, ErrCode err) {
+    if (!s.error) {
+        s.first_error_word = (u32_t)idx;
+        s.first_error_code = (u32_t)err;
+    }
+    s.error = true;
+}
+
+// Consume PARAM word idx (stream order). row_cache may be null.
+static inline void param_stream_check_word(
+    ParamStreamCheckState& s,
+    uint32_t idx,
+    u32_t word_bits,
+    TernaryRowMaskCache* row_cache
+) {
+    s.checksum = param_stream_checksum_step(s.checksum, word_bits);
+
+    uint32_t seg = (uint32_t)s.seg_idx.to_uint();
+    if (seg < PARAM_COUNT && idx >= (kParamMeta[seg].offset_w + kParamMeta[seg].len_w)) {
+        ++seg;
+        s.seg_idx = (u32_t)seg;
+    }
+    if (seg >= PARAM_COUNT) {
+        return;
+    }
+    const ParamMeta meta = kParamMeta[seg];
+    const uint32_t rel = idx - meta.offset_w;
+    const uint32_t word = (uint32_t)word_bits.to_uint();
+
+    if (meta.dtype == (uint32_t)PARAM_DTYPE_BITPACK && (rel + 1u) == meta.len_w) {
+        if ((word & ~mask_u32(meta.valid_bits)) != 0u) {
+            s.pad_error_count = s.pad_error_count + 1;
+            param_stream_check_flag(s, idx, ERR_BITPACK_PAD);
+        }
+        return;
+    }
+
+    const uint32_t m = param_stream_ternary_matrix(meta.id);
+    if (m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT) {
+        const QuantLinearMeta qmeta = kQuantLinearMeta[m];
+        if (rel >= qmeta.payload_words_2b) {
+            return;
+        }
+        const uint32_t valid_in_word = ((rel + 1u) == qmeta.payload_words_2b) ? qmeta.last_word_valid_count : 16u;
+        if ((param_stream_ternary_rsvd_lanes(word) & mask_u32(valid_in_word * 2u)) != 0u) {
+            s.ternary_error_count = s.ternary_error_count + 1;
+            s.matrix_bad[m] = true;
+            param_stream_check_flag(s, idx, ERR_PARAM_TERNARY_CODE);
+        }
+        if (row_cache != 0) {
+            ternary_row_mask_cache_ingest_word(*row_cache, m, rel, word_bits);
+        }
+        return;
+    }
+
+    const uint32_t inv_m = param_stream_inv_sw_matrix(meta.id);
+    if (row_cache != 0 && ternary_row_mask_cached(inv_m) && rel == 0u) {
+        row_cache->inv_sw_bits[inv_m] = word_bits;
+    }
+}
+
+// Commit a streamed row-mask cache: a matrix is valid unless a reserved code was seen.
+static inline void param_stream_row_cache_commit(
+    const ParamStreamCheckState& s,
+    TernaryRowMaskCache& cache,
+    u32_t param_base_word
+) {
+    cache.param_base_word = param_base_word;
+    PARAM_STREAM_ROW_CACHE_COMMIT_LOOP: for (uint32_t m = 0u; m < TERNARY_ROW_MASK_CACHED_MATRIX_COUNT; ++m) {
+        cache.matrix_valid[m] = !s.matrix_bad[m];
+    }
+}
+
+} // namespace aecct
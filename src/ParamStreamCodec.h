@@ -0,0 +1,114 @@
+#pragma once
+// Compressed LOAD_W stream (opt-in, param_stream_compressed_enable).
+// The wire carries packets; each starts with one header word:
+//   [31:30] kind, [29:0] count = PARAM words the packet expands to (>= 1).
+// - RAW : count literal words follow.
+// - RUN : one word follows and is repeated count times (zero padding, flat tensors).
+// - HI16: ceil(count / 2) words follow; each carries two PARAM words as their upper
+//         16 bits (low half zero), first in [15:0], second in [31:16]. Lossless for
+//         words whose low half is already zero; bf16 when the encoder rounds.
+// The decoder produces at most one PARAM word per step, so Top keeps its single
+// SRAM write per cycle; RUN and the second HI16 half are produced without input.
+
+#include <cstdint>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+
+namespace aecct {
+
+enum ParamPacketKind : uint32_t {
+    PARAM_PKT_RAW = 0u,
+    PARAM_PKT_RUN = 1u,
+    PARAM_PKT_HI16 = 2u,
+    PARAM_PKT_RSVD = 3u
+};
+
+static const uint32_t PARAM_PKT_COUNT_BITS = 30u;
+static const uint32_t PARAM_PKT_COUNT_MAX = (1u << PARAM_PKT_COUNT_BITS) - 1u;
+
+static inline uint32_t pack_param_packet_header(uint32_t kind, uint32_t count) {
+    return ((kind & 0x3u) << PARAM_PKT_COUNT_BITS) | (count & PARAM_PKT_COUNT_MAX);
+}
+
+struct ParamStreamDecodeState {
+    u32_t kind;
+    u32_t remaining;   // PARAM words still owed by the current packet; 0 = expect header
+    u32_t run_word;
+    bool run_loaded;   // RUN word received; the rest of the packet needs no input
+    u32_t hi_word;     // upper half of the last HI16 carrier, pending when hi_pending
+    bool hi_pending;
+    u32_t wire_words;  // words consumed from data_in, headers included
+};
+
+static inline void param_stream_decode_clear(ParamStreamDecodeState& d) {
+    d.kind = (u32_t)PARAM_PKT_RAW;
+    d.remaining = 0;
+    d.run_word = 0;
+    d.run_loaded = false;
+    d.hi_word = 0;
+    d.hi_pending = false;
+    d.wire_words = 0;
+}
+
+// True when the next PARAM word needs no data_in word.
+static inline bool param_stream_decode_pending(const ParamStreamDecodeState& d) {
+    return d.hi_pending || (d.run_loaded && ((uint32_t)d.remaining.to_uint() != 0u));
+}
+
+static inline u32_t param_stream_decode_emit_pending(ParamStreamDecodeState& d) {
+    d.remaining = d.remaining - 1;
+    if (d.hi_pending) {
+        d.hi_pending = false;
+        return d.hi_word;
+    }
+    return d.run_word;
+}
+
+// Consume one data_in word. Returns ERR_OK and sets emitted when out_word holds the
+// next PARAM word; a header emits nothing. words_left bounds the packet count.
+static inline uint8_t param_stream_decode_input(
+    ParamStreamDecodeState& d,
+    u32_t in_word,
+    uint32_t words_left,
+    u32_t& out_word,
+    bool& emitted
+) {
+    emitted = false;
+    d.wire_words = d.wire_words + 1;
+    const uint32_t w = (uint32_t)in_word.to_uint();
+    if ((uint32_t)d.remaining.to_uint() == 0u) {
+        const uint32_t kind = w >> PARAM_PKT_COUNT_BITS;
+        const uint32_t count = w & PARAM_PKT_COUNT_MAX;
+        if (kind == (uint32_t)PARAM_PKT_RSVD || count == 0u) {
+            return (uint8_t)ERR_BAD_ARG;
+        }
+        if (count > words_left) {
+            return (uint8_t)ERR_PARAM_LEN_MISMATCH;
+        }
+        d.kind = (u32_t)kind;
+        d.remaining = (u32_t)count;
+        d.run_loaded = false;
+        return (uint8_t)ERR_OK;
+    }
+
+    const uint32_t kind = (uint32_t)d.kind.to_uint();
+    d.remaining = d.remaining - 1;
+    if (kind == (uint32_t)PARAM_PKT_RUN) {
+        d.run_word = in_word;
+        d.run_loaded = true;
+        out_word = in_word;
+    } else if (kind == (uint32_t)PARAM_PKT_HI16) {
+        out_word = (u32_t)(w << 16);
+        if ((uint32_t)d.remaining.to_uint() != 0u) {
+            d.hi_word = (u32_t)(w & 0xFFFF0000u);
+            d.hi_pending = true;
+        }
+    } else {
+        out_word = in_word;
+    }
+    emitted = true;
+    return (uint8_t)ERR_OK;
+}
+
+} // namespace aecct
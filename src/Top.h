@@ -4,6 +4,7 @@
 // Header-only Top integration contract for FSM dispatch and runtime paths.
 // One command is consumed per top() call from ctrl_cmd.
 // CFG/PARAM/INFER payload words are consumed from data_in in their RX states.
+// Overlapped INFER_BATCH also advances one compute stage per call in INFER_OVL.
 // HALTED emits ERR + metadata to data_out; READ_MEM is gated by legal states.
 #include "AecctTypes.h"
 #include "AecctUtil.h"
@@ -25,8 +26,14 @@
 #include "blocks/AttnPhaseATopManagedQ.h"
 #include "blocks/AttnPhaseBTopManagedQkScore.h"
 #include "blocks/AttnPhaseBTopManagedSoftmaxOut.h"
+#include "blocks/AttnPhaseBSparseMask.h"
+#include "blocks/AttnPhaseBFusedScoreSoftmax.h"
 #include "blocks/TransformerLayer.h"
 #include "blocks/FinalHead.h"
+#include "ParamStreamCheck.h"
+#include "ParamStreamCodec.h"
+#include "TopPerfModel.h"
+#include "HostSramImage.h"
 #include <cstdint>
 
 namespace aecct {
@@ -56,6 +63,24 @@ namespace aecct {
     static const unsigned FINAL_XPRED_BASE_WORD = (unsigned)(sram_map::BASE_SCRATCH_W + OUT_WORDS_LOGITS);
     static const unsigned INIT_WORDS = 64;
     static const unsigned DBG_META1_LEN_WORDS = 16u;
+    // OP_INFER_BATCH: codewords per batch tile. Top-fed weight words shared by
+    // every codeword of a tile are fetched from W_REGION once per tile.
+    static const unsigned INFER_BATCH_TILE_CODEWORDS = 8u;
+    static const unsigned INFER_BATCH_MAX_CODEWORDS = 0xFFFFu;
+    // OP_INFER_BATCH arg0: [15:0]=codeword count, [16]=overlap ingest with compute.
+    static const unsigned INFER_BATCH_ARG_COUNT_MASK = 0xFFFFu;
+    static const unsigned INFER_BATCH_ARG_OVERLAP_BIT = 16u;
+    // Overlapped INFER: RX words drained per call while a compute stage is in flight.
+    // Every stage outlasts one input page at one data_in word per cycle, so a whole
+    // page may land during a single stage.
+    static const unsigned INFER_OVL_RX_WORDS_PER_STAGE = (unsigned)sram_map::IO_IN_PAGE_WORDS;
+    // OP_LOAD_W_EX arg0: PARAM stream flags for this LOAD_W; undefined bits must be 0.
+    // OP_LOAD_W is OP_LOAD_W_EX with arg0 = 0.
+    static const unsigned LOAD_W_ARG_STRICT_BIT = 0u;   // reject a bad image at commit
+    static const unsigned LOAD_W_ARG_REPACK_BIT = 1u;   // fill w_row_cache from the stream
+    static const unsigned LOAD_W_ARG_COMPRESSED_BIT = 2u; // ParamStreamCodec.h packets on data_in
+    static const unsigned LOAD_W_ARG_DEFINED_MASK =
+        (1u << LOAD_W_ARG_STRICT_BIT) | (1u << LOAD_W_ARG_REPACK_BIT) | (1u << LOAD_W_ARG_COMPRESSED_BIT);
 
     enum DebugAction : unsigned {
         DBG_ACTION_CLEAR = 0u,
@@ -80,7 +105,8 @@ namespace aecct {
         CFG_IDX_ENABLE_LPE = (unsigned)CFG_ENABLE_LPE,
         CFG_IDX_ENABLE_LPE_TOKEN = (unsigned)CFG_ENABLE_LPE_TOKEN,
         CFG_IDX_OUT_MODE = (unsigned)CFG_OUT_MODE,
-        CFG_IDX_RESERVED0 = (unsigned)CFG_RESERVED0
+        CFG_IDX_RESERVED0 = (unsigned)CFG_RESERVED0,
+        CFG_IDX_FEATURES = (unsigned)CFG_FEATURES
     };
 
     enum RegionId : unsigned {
@@ -98,6 +124,16 @@ namespace aecct {
         RX_INFER = 3
     };
 
+    // Overlapped INFER compute stage; one stage advances per top() call while
+    // RX keeps filling the other IO input page.
+    enum InferOvlStage : unsigned {
+        OVL_STAGE_IDLE = 0u,
+        OVL_STAGE_PREPROC = 1u,
+        OVL_STAGE_LAYERNORM = 2u,
+        OVL_STAGE_LAYER_LOOP = 3u,
+        OVL_STAGE_FINAL_HEAD = 4u
+    };
+
     static const unsigned MEM_REQ_SLOTS = (unsigned)REQ_ID_COUNT;
 
     struct MemArbRegs {
@@ -353,6 +389,85 @@ namespace aecct {
         AcceptedCommitMetadataRecord accepted_commit_record;
         // Local mirror for INFER payload debug/probe only; not a shared-SRAM owner contract.
         u32_t infer_input_shadow[INFER_IN_WORDS_EXPECTED];
+        // OP_INFER_BATCH session state and per-tile top-fed LN affine words.
+        bool infer_batch_active;
+        u32_t infer_batch_count;
+        u32_t infer_batch_done_count;
+        bool infer_batch_ln_affine_valid;
+        u32_t infer_batch_ln_affine_fetch_count;
+        u32_t infer_batch_ln_gamma_words[LN_D_MODEL];
+        u32_t infer_batch_ln_beta_words[LN_D_MODEL];
+        // Layer runs of a batch whose FFN weight/bias words were consumed in place from W_REGION.
+        u32_t infer_batch_ffn_inplace_count;
+        // Overlapped INFER: IO input page ping/pong and the in-flight compute slot.
+        bool infer_ovl_enable;
+        u32_t infer_ovl_rx_page;
+        bool infer_ovl_rx_full;
+        u32_t infer_ovl_rx_codeword_count;
+        u32_t infer_ovl_stage;
+        InferIngestContract infer_ovl_compute_contract;
+        u32_t infer_ovl_launch_count;
+        u32_t infer_ovl_rx_overlapped_word_count;
+        u32_t infer_ovl_rx_stall_count;
+        // Ternary rows pre-decoded at LOAD_W completion; consumed by layer-0 Q/K/V.
+        TernaryRowMaskCache w_row_cache;
+        u32_t w_row_cache_build_count;
+        // Streaming LOAD_W check (segment padding, ternary codebook, checksum); always tracked.
+        // Strict mode rejects a bad image at commit and blocks INFER until the next good
+        // LOAD_W; repack mode fills w_row_cache from the stream instead of at commit.
+        // Both are latched per LOAD_W from the OP_LOAD_W_EX flags (LOAD_W_ARG_*).
+        ParamStreamCheckState param_check;
+        u32_t param_rx_opcode;
+        bool param_stream_check_enable;
+        bool param_stream_repack_enable;
+        bool param_image_rejected;
+        u32_t param_stream_repack_count;
+        // Compressed LOAD_W stream (ParamStreamCodec.h packets); opt-in per LOAD_W
+        // (LOAD_W_ARG_COMPRESSED_BIT), the decoded words take the same write / check path
+        // as a raw stream.
+        bool param_stream_compressed_enable;
+        ParamStreamDecodeState param_decode;
+        // Resident PARAM slots (sram_map::PARAM_SLOT_*). A committed LOAD_W at a slot base
+        // populates that slot; SET_W_BASE onto a populated slot reselects it and restores
+        // its latches without re-streaming. Mirrored to PARAM_SLOT_TABLE for READ_MEM.
+        u32_t param_slot_active;
+        bool param_slot_valid[sram_map::PARAM_SLOT_COUNT];
+        u32_t param_slot_checksum[sram_map::PARAM_SLOT_COUNT];
+        u32_t param_slot_mask_bits[sram_map::PARAM_SLOT_COUNT][SRC_MASK_WORDS_BITPACK];
+        u32_t param_slot_syndrome_h[sram_map::PARAM_SLOT_COUNT][H_WORDS_BITPACK];
+        u32_t param_slot_select_count;
+        // src_mask key lists (SCR_ATTN_CSR) built at LOAD_W completion; sparse Phase-B is opt-in
+        // (CFG_FEAT_ATTN_SPARSE).
+        bool attn_sparse_enable;
+        bool attn_mask_csr_valid;
+        u32_t attn_mask_csr_nnz[sram_map::ATTN_CSR_RINGS];
+        u32_t attn_mask_csr_slot;
+        u32_t attn_sparse_token_count;
+        // src_mask bitpack latched at LOAD_W completion for the bitmap AE/AF pair; opt-in
+        // (CFG_FEAT_ATTN_MASK_BITMAP).
+        bool attn_mask_bitmap_enable;
+        bool attn_mask_bits_valid;
+        u32_t attn_mask_bits_words[SRC_MASK_WORDS_BITPACK];
+        // Per-ring allowed-key bitmaps (SCR_ATTN_RING_BITMAP) expanded from the latched bitpack.
+        bool attn_ring_bitmap_valid;
+        u32_t attn_bitmap_token_count;
+        // Fused Phase-B (score + softmax + V in one pass, no score row in SRAM); opt-in
+        // (CFG_FEAT_ATTN_FUSED).
+        bool attn_fused_enable;
+        u32_t attn_fused_token_count;
+        // Fused layer tail (residual + LN (+ mid LN) -> next managed layer Q/K/V per token); opt-in
+        // (CFG_FEAT_LN_QKV_FUSED). Only the boundary into the managed-attention target layer
+        // fuses, so with the default target (layer 0) the enable has no effect.
+        bool ln_qkv_fused_enable;
+        u32_t ln_qkv_fused_layer_count;
+        // Zero-syndrome INFER early exit (hard decision of y is already a codeword); opt-in
+        // (CFG_FEAT_INFER_EARLY_EXIT).
+        // H is latched at LOAD_W completion, so the syndrome check reads no W_REGION words.
+        bool infer_early_exit_enable;
+        bool infer_syndrome_h_valid;
+        u32_t infer_syndrome_h_words[H_WORDS_BITPACK];
+        bool infer_ovl_early_exit;
+        u32_t infer_early_exit_count;
         bool p11ac_mainline_path_taken;
         bool p11ac_fallback_taken;
         bool p11ad_mainline_q_path_taken;
@@ -453,6 +568,11 @@ namespace aecct {
         u32_t cfg_out_len_x_pred;
         u32_t cfg_out_len_logits;
 
+        // Layer-loop scratch: X snapshot taken after the mid layer, replayed through
+        // mid-LN at the end of the loop. Written before read on every run, so
+        // clear() leaves it alone.
+        u32_t mid_snapshot[LN_X_TOTAL_WORDS];
+
         void clear() {
             state = ST_IDLE;
             rx_state = RX_NONE;
@@ -471,6 +591,72 @@ namespace aecct {
             for (unsigned i = 0; i < INFER_IN_WORDS_EXPECTED; ++i) {
                 infer_input_shadow[i] = 0;
             }
+            infer_batch_active = false;
+            infer_batch_count = 0;
+            infer_batch_done_count = 0;
+            infer_batch_ln_affine_valid = false;
+            infer_batch_ln_affine_fetch_count = 0;
+            for (unsigned c = 0; c < (unsigned)LN_D_MODEL; ++c) {
+                infer_batch_ln_gamma_words[c] = 0;
+                infer_batch_ln_beta_words[c] = 0;
+            }
+            infer_batch_ffn_inplace_count = 0;
+            infer_ovl_enable = false;
+            infer_ovl_rx_page = 0;
+            infer_ovl_rx_full = false;
+            infer_ovl_rx_codeword_count = 0;
+            infer_ovl_stage = (u32_t)OVL_STAGE_IDLE;
+            clear_infer_ingest_contract(infer_ovl_compute_contract);
+            infer_ovl_launch_count = 0;
+            infer_ovl_rx_overlapped_word_count = 0;
+            infer_ovl_rx_stall_count = 0;
+            ternary_row_mask_cache_clear(w_row_cache);
+            w_row_cache_build_count = 0;
+            param_stream_check_clear(param_check);
+            param_rx_opcode = (u32_t)OP_LOAD_W;
+            param_stream_check_enable = false;
+            param_stream_repack_enable = false;
+            param_image_rejected = false;
+            param_stream_repack_count = 0;
+            param_stream_compressed_enable = false;
+            param_stream_decode_clear(param_decode);
+            param_slot_active = (u32_t)sram_map::PARAM_SLOT_COUNT;
+            for (uint32_t k = 0u; k < sram_map::PARAM_SLOT_COUNT; ++k) {
+                param_slot_valid[k] = false;
+                param_slot_checksum[k] = 0;
+                for (uint32_t i = 0u; i < (uint32_t)SRC_MASK_WORDS_BITPACK; ++i) {
+                    param_slot_mask_bits[k][i] = 0;
+                }
+                for (uint32_t i = 0u; i < (uint32_t)H_WORDS_BITPACK; ++i) {
+                    param_slot_syndrome_h[k][i] = 0;
+                }
+            }
+            param_slot_select_count = 0;
+            attn_sparse_enable = false;
+            attn_mask_csr_valid = false;
+            for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+                attn_mask_csr_nnz[r] = 0;
+            }
+            attn_mask_csr_slot = (u32_t)sram_map::PARAM_SLOT_COUNT;
+            attn_sparse_token_count = 0;
+            attn_mask_bitmap_enable = false;
+            attn_mask_bits_valid = false;
+            attn_ring_bitmap_valid = false;
+            for (uint32_t i = 0u; i < (uint32_t)SRC_MASK_WORDS_BITPACK; ++i) {
+                attn_mask_bits_words[i] = 0;
+            }
+            attn_bitmap_token_count = 0;
+            attn_fused_enable = false;
+            attn_fused_token_count = 0;
+            ln_qkv_fused_enable = false;
+            ln_qkv_fused_layer_count = 0;
+            infer_early_exit_enable = false;
+            infer_syndrome_h_valid = false;
+            for (uint32_t i = 0u; i < (uint32_t)H_WORDS_BITPACK; ++i) {
+                infer_syndrome_h_words[i] = 0;
+            }
+            infer_ovl_early_exit = false;
+            infer_early_exit_count = 0;
             p11ac_mainline_path_taken = false;
             p11ac_fallback_taken = false;
             p11ad_mainline_q_path_taken = false;
@@ -569,44 +755,84 @@ namespace aecct {
         }
     };
 
-    static inline TopRegs& top_regs() {
-        static TopRegs regs;
-        return regs;
+    // One decoder instance: Top registers (layer-loop scratch included), the
+    // physical SRAM backing store and the internal input staging FIFO.
+    // top(ctx, ...) runs on an explicit context, so a host harness can simulate
+    // independent decoders side by side, one thread per context. The 4-channel
+    // top(...) drives top_context(), the process-wide default instance that the
+    // top_peek_* helpers observe.
+    // A context starts zeroed like the default one (static storage or
+    // value-initialized new TopContext()); SOFT_RESET brings it to ST_IDLE.
+    // The in_fifo functional C++ model does not rely on finite depth; concrete
+    // depth is configured later by Catapult/HLS constraints.
+    struct TopContext {
+        TopRegs regs;
+        u32_t sram[sram_map::SRAM_WORDS_TOTAL];
+        data_ch_t in_fifo;
+#ifndef __SYNTHESIS__
+        // Host-only: an external SRAM image (HostSramImage) replacing sram; null
+        // selects the built-in backing store.
+        u32_t* sram_binding;
+#endif
+    };
+
+    static inline TopContext& top_context() {
+        static TopContext ctx;
+        return ctx;
     }
 
-    // Single physical SRAM backing store.
-    static inline u32_t* top_sram() {
-        static u32_t sram[sram_map::SRAM_WORDS_TOTAL];
-        return sram;
+    static inline TopRegs& top_regs() { return top_context().regs; }
+
+    // SRAM the context's Top runs on.
+    static inline u32_t* top_context_sram(TopContext& ctx) {
+#ifndef __SYNTHESIS__
+        if (ctx.sram_binding != 0) {
+            return ctx.sram_binding;
+        }
+#endif
+        return ctx.sram;
     }
 
-    // Internal input staging FIFO.
-    // Functional C++ model does not rely on finite depth; concrete depth is
-    // configured later by Catapult/HLS constraints.
-    static inline data_ch_t& top_in_fifo() {
-        static data_ch_t in_fifo;
-        return in_fifo;
+    // Single physical SRAM backing store of the default context.
+    static inline u32_t* top_sram() { return top_context_sram(top_context()); }
+
+#ifndef __SYNTHESIS__
+    // Bind a context to a full-size image; the image must outlive the binding.
+    static inline bool top_sram_bind(TopContext& ctx, HostSramImage& img) {
+        if (img.words == 0 || img.word_count != sram_map::SRAM_WORDS_TOTAL) {
+            return false;
+        }
+        ctx.sram_binding = img.words;
+        return true;
     }
 
-    static inline bool top_data_nb_read(data_ch_t& data_in, u32_t& word) {
-        if (top_in_fifo().nb_read(word)) {
+    static inline void top_sram_unbind(TopContext& ctx) { ctx.sram_binding = 0; }
+
+    static inline bool top_sram_bind(HostSramImage& img) { return top_sram_bind(top_context(), img); }
+    static inline void top_sram_unbind() { top_sram_unbind(top_context()); }
+#endif
+
+    static inline data_ch_t& top_in_fifo() { return top_context().in_fifo; }
+
+    static inline bool top_data_nb_read(data_ch_t& in_fifo, data_ch_t& data_in, u32_t& word) {
+        if (in_fifo.nb_read(word)) {
             return true;
         }
         u32_t staged;
         if (!data_in.nb_read(staged)) {
             return false;
         }
-        top_in_fifo().write(staged);
-        return top_in_fifo().nb_read(word);
+        in_fifo.write(staged);
+        return in_fifo.nb_read(word);
     }
 
-    static inline u32_t top_data_read(data_ch_t& data_in) {
+    static inline u32_t top_data_read(data_ch_t& in_fifo, data_ch_t& data_in) {
         u32_t word;
-        if (top_in_fifo().nb_read(word)) {
+        if (in_fifo.nb_read(word)) {
             return word;
         }
-        top_in_fifo().write(data_in.read());
-        return top_in_fifo().read();
+        in_fifo.write(data_in.read());
+        return in_fifo.read();
     }
 
     // TB debug peek helpers for observing Top-owned runtime state.
@@ -670,6 +896,48 @@ namespace aecct {
     static inline bool top_peek_infer_mid_valid() { return top_regs().infer_mid_valid; }
     static inline u32_t top_peek_infer_logits_base_word() { return top_regs().infer_logits_base_word; }
     static inline u32_t top_peek_infer_xpred_base_word() { return top_regs().infer_xpred_base_word; }
+    static inline bool top_peek_infer_batch_active() { return top_regs().infer_batch_active; }
+    static inline u32_t top_peek_infer_batch_count() { return top_regs().infer_batch_count; }
+    static inline u32_t top_peek_infer_batch_done_count() { return top_regs().infer_batch_done_count; }
+    static inline u32_t top_peek_infer_batch_ln_affine_fetch_count() {
+        return top_regs().infer_batch_ln_affine_fetch_count;
+    }
+    static inline u32_t top_peek_infer_batch_ffn_inplace_count() {
+        return top_regs().infer_batch_ffn_inplace_count;
+    }
+    static inline bool top_peek_infer_ovl_enable() { return top_regs().infer_ovl_enable; }
+    static inline u32_t top_peek_infer_ovl_rx_page() { return top_regs().infer_ovl_rx_page; }
+    static inline u32_t top_peek_infer_ovl_stage() { return top_regs().infer_ovl_stage; }
+    static inline u32_t top_peek_infer_ovl_launch_count() { return top_regs().infer_ovl_launch_count; }
+    static inline u32_t top_peek_infer_ovl_rx_overlapped_word_count() {
+        return top_regs().infer_ovl_rx_overlapped_word_count;
+    }
+    static inline u32_t top_peek_infer_ovl_rx_stall_count() { return top_regs().infer_ovl_rx_stall_count; }
+    static inline const TernaryRowMaskCache& top_peek_w_row_cache() { return top_regs().w_row_cache; }
+    static inline u32_t top_peek_w_row_cache_build_count() { return top_regs().w_row_cache_build_count; }
+    static inline const ParamStreamCheckState& top_peek_param_check() { return top_regs().param_check; }
+    static inline bool top_peek_param_image_rejected() { return top_regs().param_image_rejected; }
+    static inline u32_t top_peek_param_stream_repack_count() { return top_regs().param_stream_repack_count; }
+    static inline u32_t top_peek_param_stream_wire_words() { return top_regs().param_decode.wire_words; }
+    static inline u32_t top_peek_param_slot_active() { return top_regs().param_slot_active; }
+    static inline bool top_peek_param_slot_valid(uint32_t slot) {
+        return (slot < sram_map::PARAM_SLOT_COUNT) ? top_regs().param_slot_valid[slot] : false;
+    }
+    static inline u32_t top_peek_param_slot_checksum(uint32_t slot) {
+        return (slot < sram_map::PARAM_SLOT_COUNT) ? top_regs().param_slot_checksum[slot] : (u32_t)0u;
+    }
+    static inline u32_t top_peek_param_slot_select_count() { return top_regs().param_slot_select_count; }
+    static inline bool top_peek_attn_mask_csr_valid() { return top_regs().attn_mask_csr_valid; }
+    static inline u32_t top_peek_attn_mask_csr_nnz(uint32_t ring) {
+        return (ring < sram_map::ATTN_CSR_RINGS) ? top_regs().attn_mask_csr_nnz[ring] : (u32_t)0u;
+    }
+    static inline u32_t top_peek_attn_sparse_token_count() { return top_regs().attn_sparse_token_count; }
+    static inline bool top_peek_attn_mask_bits_valid() { return top_regs().attn_mask_bits_valid; }
+    static inline bool top_peek_attn_ring_bitmap_valid() { return top_regs().attn_ring_bitmap_valid; }
+    static inline u32_t top_peek_attn_bitmap_token_count() { return top_regs().attn_bitmap_token_count; }
+    static inline u32_t top_peek_attn_fused_token_count() { return top_regs().attn_fused_token_count; }
+    static inline u32_t top_peek_ln_qkv_fused_layer_count() { return top_regs().ln_qkv_fused_layer_count; }
+    static inline u32_t top_peek_infer_early_exit_count() { return top_regs().infer_early_exit_count; }
     static inline bool top_peek_p11ac_mainline_path_taken() { return top_regs().p11ac_mainline_path_taken; }
     static inline bool top_peek_p11ac_fallback_taken() { return top_regs().p11ac_fallback_taken; }
     static inline bool top_peek_p11ad_mainline_q_path_taken() { return top_regs().p11ad_mainline_q_path_taken; }
@@ -812,6 +1080,7 @@ namespace aecct {
         if (state == ST_CFG_RX) { return RX_CFG; }
         if (state == ST_PARAM_RX) { return RX_PARAM; }
         if (state == ST_INFER_RX) { return RX_INFER; }
+        if (state == ST_INFER_OVL) { return RX_INFER; }
         return RX_NONE;
     }
 
@@ -893,6 +1162,61 @@ namespace aecct {
         clear_infer_ingest_contract(regs.infer_ingest_contract);
     }
 
+    static inline void infer_batch_session_clear(TopRegs& regs) {
+        regs.infer_batch_active = false;
+        regs.infer_batch_count = 0;
+        regs.infer_batch_done_count = 0;
+        regs.infer_batch_ln_affine_valid = false;
+        regs.infer_batch_ln_affine_fetch_count = 0;
+        regs.infer_batch_ffn_inplace_count = 0;
+        regs.infer_ovl_enable = false;
+        regs.infer_ovl_rx_page = 0;
+        regs.infer_ovl_rx_full = false;
+        regs.infer_ovl_rx_codeword_count = 0;
+        regs.infer_ovl_stage = (u32_t)OVL_STAGE_IDLE;
+        clear_infer_ingest_contract(regs.infer_ovl_compute_contract);
+        regs.infer_ovl_launch_count = 0;
+        regs.infer_ovl_rx_overlapped_word_count = 0;
+        regs.infer_ovl_rx_stall_count = 0;
+    }
+
+    // Drops batch/overlap bookkeeping when an INFER session ends in ERR.
+    static inline void infer_batch_abort(TopRegs& regs) {
+        regs.infer_batch_active = false;
+        regs.infer_ovl_enable = false;
+        regs.infer_ovl_rx_full = false;
+        regs.infer_ovl_stage = (u32_t)OVL_STAGE_IDLE;
+    }
+
+    static inline bool is_valid_infer_batch_count(uint32_t count) {
+        return (count != 0u) && (count <= (uint32_t)INFER_BATCH_MAX_CODEWORDS);
+    }
+
+    static inline uint32_t infer_batch_arg_count(uint32_t arg) {
+        return arg & (uint32_t)INFER_BATCH_ARG_COUNT_MASK;
+    }
+
+    static inline bool infer_batch_arg_overlap(uint32_t arg) {
+        return ((arg >> INFER_BATCH_ARG_OVERLAP_BIT) & 1u) != 0u;
+    }
+
+    static inline bool is_valid_infer_batch_arg(uint32_t arg) {
+        return ((arg >> (INFER_BATCH_ARG_OVERLAP_BIT + 1u)) == 0u) &&
+            is_valid_infer_batch_count(infer_batch_arg_count(arg));
+    }
+
+    static inline bool is_valid_load_w_arg(uint32_t arg) {
+        return (arg & ~LOAD_W_ARG_DEFINED_MASK) == 0u;
+    }
+
+    static inline bool load_w_arg_bit(uint32_t arg, unsigned bit) {
+        return ((arg >> bit) & 1u) != 0u;
+    }
+
+    static inline uint32_t infer_ovl_page_base_word(uint32_t page) {
+        return (page == 0u) ? (uint32_t)sram_map::BASE_IO_IN_PING_W : (uint32_t)sram_map::BASE_IO_IN_PONG_W;
+    }
+
     static inline uint32_t infer_expected_words(const TopRegs& regs) {
         const IngestMetadataSurface meta = infer_metadata_surface(regs);
         return ingest_meta_expected_words(meta, (uint32_t)INFER_IN_WORDS_EXPECTED);
@@ -922,6 +1246,14 @@ namespace aecct {
         );
     }
 
+    // Arms INFER ingest into the current overlapped RX page.
+    static inline void infer_ovl_arm_rx_page(TopRegs& regs) {
+        infer_session_clear(regs);
+        infer_contract_arm_for_op_infer(regs);
+        regs.infer_ingest_contract.in_base_word =
+            (u32_t)infer_ovl_page_base_word((uint32_t)regs.infer_ovl_rx_page.to_uint());
+    }
+
     static inline const u32_t* infer_label_words_view(const TopRegs& regs, const u32_t* sram) {
         const uint32_t base = infer_input_base_word(regs);
         return &sram[base];
@@ -956,6 +1288,46 @@ namespace aecct {
         return (begin >= region_begin) && (end_excl <= region_end);
     }
 
+    // INFER scratch defaults must stay inside SCR_WORK so every PARAM slot survives INFER.
+    static_assert((ATTN_Q_SX_BASE_WORD_DEFAULT + ATTN_TENSOR_WORDS) <=
+        (sram_map::BASE_SCR_WORK_W + sram_map::SIZE_SCR_WORK_W), "attention scratch overruns SCR_WORK");
+    static_assert((FFN_LN_BETA_BASE_WORD_DEFAULT + FFN_D_MODEL) <=
+        (sram_map::BASE_SCR_WORK_W + sram_map::SIZE_SCR_WORK_W), "FFN scratch overruns SCR_WORK");
+    static_assert((LN_BETA_BASE_WORD_DEFAULT + LN_D_MODEL) <=
+        (sram_map::BASE_SCR_WORK_W + sram_map::SIZE_SCR_WORK_W), "LayerNorm scratch overruns SCR_WORK");
+
+    // Slot index of w_base_word, or PARAM_SLOT_COUNT when it is not a slot base.
+    static inline uint32_t param_slot_of_base(uint32_t w_base_word) {
+        if (w_base_word < sram_map::W_REGION_BASE) {
+            return sram_map::PARAM_SLOT_COUNT;
+        }
+        const uint32_t rel = w_base_word - sram_map::W_REGION_BASE;
+        const uint32_t slot = rel / sram_map::PARAM_SLOT_WORDS;
+        if ((rel % sram_map::PARAM_SLOT_WORDS) != 0u || slot >= sram_map::PARAM_SLOT_COUNT) {
+            return sram_map::PARAM_SLOT_COUNT;
+        }
+        return slot;
+    }
+
+    // Mirror slot state into PARAM_SLOT_TABLE so the host can READ_MEM it.
+    static inline void param_slot_table_publish(const TopRegs& regs, u32_t* sram) {
+        const uint32_t base = sram_map::BASE_PARAM_SLOT_TABLE_W;
+        uint32_t populated = 0u;
+        PARAM_SLOT_TABLE_ENTRY_LOOP: for (uint32_t k = 0u; k < sram_map::PARAM_SLOT_COUNT; ++k) {
+            if (regs.param_slot_valid[k]) {
+                populated |= (1u << k);
+            }
+            const uint32_t entry = base + sram_map::PARAM_SLOT_TABLE_HDR_WORDS +
+                k * sram_map::PARAM_SLOT_TABLE_ENTRY_WORDS;
+            sram[entry] = (u32_t)sram_map::param_slot_base_w(k);
+            sram[entry + 1u] = regs.param_slot_valid[k] ? regs.param_slot_checksum[k] : (u32_t)0u;
+        }
+        sram[base] = (u32_t)sram_map::PARAM_SLOT_COUNT;
+        sram[base + 1u] = (u32_t)populated;
+        sram[base + 2u] = regs.param_slot_active;
+        sram[base + 3u] = (u32_t)0u;
+    }
+
     static inline bool param_ingest_span_legal(const TopRegs& regs) {
         const IngestMetadataSurface meta = param_metadata_surface(regs);
         const bool in_sram = ingest_meta_span_in_sram(meta, (uint32_t)PARAM_WORDS_EXPECTED);
@@ -1012,10 +1384,11 @@ namespace aecct {
 
     static inline bool handle_debug_cfg_idle(
         TopRegs& regs,
+        data_ch_t& in_fifo,
         ac_channel<ac_int<16, false> >& ctrl_rsp,
         ac_channel<ac_int<32, false> >& data_in
     ) {
-        u32_t dbg_word_in = top_data_read(data_in);
+        u32_t dbg_word_in = top_data_read(in_fifo, data_in);
         uint32_t dbg_word = (uint32_t)dbg_word_in.to_uint();
         uint32_t action = dbg_get_action(dbg_word);
         uint32_t trigger_sel = dbg_get_trigger_sel(dbg_word);
@@ -1051,10 +1424,11 @@ namespace aecct {
 
     static inline bool handle_debug_cfg_halted(
         TopRegs& regs,
+        data_ch_t& in_fifo,
         ac_channel<ac_int<16, false> >& ctrl_rsp,
         ac_channel<ac_int<32, false> >& data_in
     ) {
-        u32_t dbg_word_in = top_data_read(data_in);
+        u32_t dbg_word_in = top_data_read(in_fifo, data_in);
         uint32_t dbg_word = (uint32_t)dbg_word_in.to_uint();
         uint32_t action = dbg_get_action(dbg_word);
 
@@ -1080,10 +1454,14 @@ namespace aecct {
 
     static inline void soft_reset_all(TopRegs& regs, u32_t* sram) {
         regs.clear();
+#ifndef __SYNTHESIS__
+        top_perf_reset();
+#endif
         init_region_prefix(sram, sram_map::X_PAGE0_BASE_W, sram_map::X_PAGE0_WORDS, (unsigned)REG_X0);
         init_region_prefix(sram, sram_map::X_PAGE1_BASE_W, sram_map::X_PAGE1_WORDS, (unsigned)REG_X1);
         init_region_prefix(sram, sram_map::BASE_SCRATCH_W, sram_map::SIZE_SCRATCH_W, (unsigned)REG_SCR);
         init_region_prefix(sram, sram_map::W_REGION_BASE, sram_map::W_REGION_WORDS, (unsigned)REG_W);
+        param_slot_table_publish(regs, sram);
     }
 
     static inline bool cfg_validate_minimal(const TopRegs& regs) {
@@ -1109,6 +1487,9 @@ namespace aecct {
         if (d_ffn == 0u) { return false; }
         if (n_layers == 0u) { return false; }
 
+        const uint32_t features = (uint32_t)regs.cfg_words[CFG_IDX_FEATURES].to_uint();
+        if ((features & ~CFG_FEATURES_DEFINED_MASK) != 0u) { return false; }
+
         return true;
     }
 
@@ -1123,10 +1504,21 @@ namespace aecct {
         regs.cfg_d_lpe = regs.cfg_words[CFG_IDX_ENABLE_LPE];
         regs.cfg_n_layers = regs.cfg_words[CFG_IDX_N_LAYERS];
         regs.cfg_out_len_x_pred = regs.cfg_words[CFG_IDX_OUT_MODE];
-        regs.cfg_out_len_logits = regs.cfg_words[CFG_IDX_RESERVED0];
+        regs.cfg_out_len_logits = 0;
+        // CFG_FEATURES opt-ins; the LOAD_W-built tables they consume are gated separately.
+        const uint32_t features = (uint32_t)regs.cfg_words[CFG_IDX_FEATURES].to_uint();
+        regs.attn_sparse_enable = (features & (uint32_t)CFG_FEAT_ATTN_SPARSE) != 0u;
+        regs.attn_mask_bitmap_enable = (features & (uint32_t)CFG_FEAT_ATTN_MASK_BITMAP) != 0u;
+        regs.attn_fused_enable = (features & (uint32_t)CFG_FEAT_ATTN_FUSED) != 0u;
+        regs.infer_early_exit_enable = (features & (uint32_t)CFG_FEAT_INFER_EARLY_EXIT) != 0u;
+        regs.ln_qkv_fused_enable = (features & (uint32_t)CFG_FEAT_LN_QKV_FUSED) != 0u;
     }
 
-    static inline void cfg_ingest_one_word(TopRegs& regs, ac_channel<ac_int<32, false> >& data_in) {
+    static inline void cfg_ingest_one_word(
+        TopRegs& regs,
+        data_ch_t& in_fifo,
+        ac_channel<ac_int<32, false> >& data_in
+    ) {
         if (regs.cfg_ready) { return; }
         const IngestMetadataSurface meta = cfg_metadata_surface(regs);
         const unsigned expected_words =
@@ -1134,7 +1526,7 @@ namespace aecct {
         if (!ingest_meta_owner_matches_rx(meta, RX_CFG)) { return; }
 
         u32_t w;
-        if (!top_data_nb_read(data_in, w)) { return; }
+        if (!top_data_nb_read(in_fifo, data_in, w)) { return; }
 
         unsigned idx = (unsigned)regs.cfg_count.to_uint();
         if (idx < expected_words) {
@@ -1146,8 +1538,139 @@ namespace aecct {
         }
     }
 
+    // Committed LOAD_W: expand the Q/K/V ternary rows once so INFER consumes whole rows.
+    // Repack mode already expanded them while the words streamed in.
+    static inline void param_commit_build_row_cache(TopRegs& regs, const u32_t* sram) {
+        if (regs.param_stream_repack_enable) {
+            param_stream_row_cache_commit(regs.param_check, regs.w_row_cache, regs.w_base_word);
+            regs.param_stream_repack_count = regs.param_stream_repack_count + 1;
+            return;
+        }
+        ternary_row_mask_cache_build(regs.w_row_cache, sram, regs.w_base_word);
+        regs.w_row_cache_build_count = regs.w_row_cache_build_count + 1;
+    }
+
+    // Committed LOAD_W: compress src_mask into per-ring key lists for sparse Phase-B.
+    static inline void param_commit_build_attn_mask_csr(TopRegs& regs, u32_t* sram) {
+        regs.attn_mask_csr_valid = attn_mask_csr_build(
+            sram, regs.w_base_word, (u32_t)sram_map::BASE_SCR_ATTN_CSR_W, regs.attn_mask_csr_nnz);
+        regs.attn_mask_csr_slot = regs.attn_mask_csr_valid ?
+            regs.param_slot_active : (u32_t)sram_map::PARAM_SLOT_COUNT;
+    }
+
+    // Committed LOAD_W: keep the src_mask bitpack for the bitmap AE/AF pair.
+    static inline void param_commit_latch_attn_mask_bits(TopRegs& regs, const u32_t* sram) {
+        const uint32_t mask_base = (uint32_t)regs.w_base_word.to_uint() +
+            kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+        PARAM_COMMIT_ATTN_MASK_BITS_LOOP: for (uint32_t i = 0u; i < (uint32_t)SRC_MASK_WORDS_BITPACK; ++i) {
+            regs.attn_mask_bits_words[i] = sram[mask_base + i];
+        }
+        regs.attn_mask_bits_valid = true;
+    }
+
+    // Expand the latched bitpack into SCR_ATTN_RING_BITMAP for the bitmap AE/AF pair.
+    static inline void param_build_attn_ring_bitmap(TopRegs& regs, u32_t* sram) {
+        regs.attn_ring_bitmap_valid = regs.attn_mask_bits_valid && attn_mask_ring_bitmap_build(
+            sram, regs.attn_mask_bits_words, (u32_t)sram_map::BASE_SCR_ATTN_RING_BITMAP_W);
+    }
+
+    // Committed LOAD_W: keep the parity-check rows for the zero-syndrome early exit.
+    static inline void param_commit_latch_syndrome_h(TopRegs& regs, const u32_t* sram) {
+        const uint32_t h_base = (uint32_t)regs.w_base_word.to_uint() +
+            kParamMeta[kWeightIdToParamId[(uint32_t)BCH_H_BITPACK]].offset_w;
+        PARAM_COMMIT_SYNDROME_H_LOOP: for (uint32_t i = 0u; i < (uint32_t)H_WORDS_BITPACK; ++i) {
+            regs.infer_syndrome_h_words[i] = sram[h_base + i];
+        }
+        regs.infer_syndrome_h_valid = true;
+    }
+
+    // A LOAD_W at w_base_word overwrites every slot its span touches.
+    static inline void param_slot_invalidate_span(TopRegs& regs, uint32_t w_base_word) {
+        const uint32_t end_excl = w_base_word + (uint32_t)PARAM_WORDS_EXPECTED;
+        PARAM_SLOT_INVALIDATE_LOOP: for (uint32_t k = 0u; k < sram_map::PARAM_SLOT_COUNT; ++k) {
+            const uint32_t slot_begin = sram_map::param_slot_base_w(k);
+            const uint32_t slot_end = slot_begin + sram_map::PARAM_SLOT_WORDS;
+            if (w_base_word < slot_end && slot_begin < end_excl) {
+                regs.param_slot_valid[k] = false;
+                regs.param_slot_checksum[k] = 0;
+            }
+        }
+    }
+
+    // Committed LOAD_W at a slot base: record the image and keep its latches for reselect.
+    static inline void param_slot_commit(TopRegs& regs) {
+        const uint32_t slot = (uint32_t)regs.param_slot_active.to_uint();
+        if (slot >= sram_map::PARAM_SLOT_COUNT) {
+            return;
+        }
+        regs.param_slot_valid[slot] = true;
+        regs.param_slot_checksum[slot] = regs.param_check.checksum;
+        PARAM_SLOT_COMMIT_MASK_LOOP: for (uint32_t i = 0u; i < (uint32_t)SRC_MASK_WORDS_BITPACK; ++i) {
+            regs.param_slot_mask_bits[slot][i] = regs.attn_mask_bits_words[i];
+        }
+        PARAM_SLOT_COMMIT_H_LOOP: for (uint32_t i = 0u; i < (uint32_t)H_WORDS_BITPACK; ++i) {
+            regs.param_slot_syndrome_h[slot][i] = regs.infer_syndrome_h_words[i];
+        }
+    }
+
+    // SET_W_BASE target changed: reselect a populated slot, otherwise drop latches that
+    // describe another image. The row-mask cache is keyed by param_base_word and the
+    // CSR by attn_mask_csr_slot, so neither is rebuilt here; the ring bitmaps are
+    // re-expanded from the restored bitpack.
+    static inline void param_slot_select(TopRegs& regs, u32_t* sram, uint32_t w_base_word) {
+        const uint32_t slot = param_slot_of_base(w_base_word);
+        regs.param_slot_active = (u32_t)slot;
+        if (slot < sram_map::PARAM_SLOT_COUNT && regs.param_slot_valid[slot]) {
+            PARAM_SLOT_SELECT_MASK_LOOP: for (uint32_t i = 0u; i < (uint32_t)SRC_MASK_WORDS_BITPACK; ++i) {
+                regs.attn_mask_bits_words[i] = regs.param_slot_mask_bits[slot][i];
+            }
+            PARAM_SLOT_SELECT_H_LOOP: for (uint32_t i = 0u; i < (uint32_t)H_WORDS_BITPACK; ++i) {
+                regs.infer_syndrome_h_words[i] = regs.param_slot_syndrome_h[slot][i];
+            }
+            regs.attn_mask_bits_valid = true;
+            regs.infer_syndrome_h_valid = true;
+            param_build_attn_ring_bitmap(regs, sram);
+            regs.attn_mask_csr_valid = ((uint32_t)regs.attn_mask_csr_slot.to_uint() == slot);
+            regs.param_image_rejected = false;
+            regs.param_slot_select_count = regs.param_slot_select_count + 1;
+            return;
+        }
+        regs.attn_mask_bits_valid = false;
+        regs.attn_ring_bitmap_valid = false;
+        regs.infer_syndrome_h_valid = false;
+        regs.attn_mask_csr_valid = false;
+    }
+
+    // Next PARAM word of a compressed LOAD_W: from the open RUN / HI16 packet when one is
+    // pending, otherwise from data_in. Headers consume a step without producing a word;
+    // a malformed header aborts the transaction.
+    static inline bool param_ingest_decode_word(
+        TopRegs& regs,
+        data_ch_t& in_fifo,
+        ac_channel<ac_int<16, false> >& ctrl_rsp,
+        ac_channel<ac_int<32, false> >& data_in,
+        uint32_t words_left,
+        u32_t& out_word
+    ) {
+        if (param_stream_decode_pending(regs.param_decode)) {
+            out_word = param_stream_decode_emit_pending(regs.param_decode);
+            return true;
+        }
+        u32_t in_word;
+        if (!top_data_nb_read(in_fifo, data_in, in_word)) { return false; }
+        bool emitted = false;
+        const uint8_t diag = param_stream_decode_input(regs.param_decode, in_word, words_left, out_word, emitted);
+        if (diag != (uint8_t)ERR_OK) {
+            regs.state = ST_IDLE;
+            ctrl_rsp.write(pack_ctrl_rsp_err(diag));
+            return false;
+        }
+        return emitted;
+    }
+
     static inline void param_ingest_one_word(
         TopRegs& regs,
+        data_ch_t& in_fifo,
         ac_channel<ac_int<32, false> >& data_in,
         ac_channel<ac_int<16, false> >& ctrl_rsp,
         ac_channel<ac_int<32, false> >& data_out,
@@ -1176,7 +1699,7 @@ namespace aecct {
                 false
             );
             if (commit_diag == (uint8_t)ERR_OK) {
-                ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)OP_LOAD_W));
+                ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)regs.param_rx_opcode.to_uint()));
             }
             else {
                 ctrl_rsp.write(pack_ctrl_rsp_err(commit_diag));
@@ -1185,12 +1708,17 @@ namespace aecct {
         }
 
         u32_t w;
-        if (!top_data_nb_read(data_in, w)) { return; }
+        if (regs.param_stream_compressed_enable) {
+            if (!param_ingest_decode_word(regs, in_fifo, ctrl_rsp, data_in, expected_words - idx, w)) { return; }
+        }
+        else if (!top_data_nb_read(in_fifo, data_in, w)) { return; }
 
         uint32_t base = (uint32_t)regs.w_base_word.to_uint();
         uint32_t addr = base + idx;
         sram[addr] = w;
         regs.param_count = regs.param_count + 1;
+        param_stream_check_word(regs.param_check, idx, w,
+            regs.param_stream_repack_enable ? &regs.w_row_cache : 0);
 
         // HALT when debug trigger matches the k-th LOAD_W word.
         if (regs.debug_armed &&
@@ -1205,7 +1733,7 @@ namespace aecct {
             // LOAD_W transaction complete.
             regs.state = ST_IDLE;
             const IngestMetadataSurface done_meta = param_metadata_surface(regs);
-            const uint8_t commit_diag = ingest_commit_diag_and_record(
+            uint8_t commit_diag = ingest_commit_diag_and_record(
                 regs.accepted_commit_record,
                 done_meta,
                 RX_PARAM,
@@ -1215,8 +1743,25 @@ namespace aecct {
                 (u32_t)0u,
                 false
             );
+            // Strict mode: a padding or codebook violation anywhere rejects the image.
+            if (commit_diag == (uint8_t)ERR_OK && regs.param_stream_check_enable && regs.param_check.error) {
+                clear_accepted_commit_metadata_record(regs.accepted_commit_record);
+                regs.param_image_rejected = true;
+                commit_diag = (uint8_t)regs.param_check.first_error_code.to_uint();
+            }
             if (commit_diag == (uint8_t)ERR_OK) {
-                ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)OP_LOAD_W));
+                regs.param_image_rejected = false;
+                param_commit_build_row_cache(regs, sram);
+                param_commit_build_attn_mask_csr(regs, sram);
+                param_commit_latch_attn_mask_bits(regs, sram);
+                param_build_attn_ring_bitmap(regs, sram);
+                param_commit_latch_syndrome_h(regs, sram);
+                param_slot_commit(regs);
+                param_slot_table_publish(regs, sram);
+                ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)regs.param_rx_opcode.to_uint()));
+                if (regs.param_stream_check_enable) {
+                    data_out.write(regs.param_check.checksum);
+                }
             }
             else {
                 ctrl_rsp.write(pack_ctrl_rsp_err(commit_diag));
@@ -1224,27 +1769,32 @@ namespace aecct {
         }
     }
 
-    static inline void run_preproc_block(TopRegs& regs, u32_t* sram) {
+    // Preproc consumes the INFER payload described by in_contract; overlapped INFER
+    // passes its in-flight compute contract while the live ingest contract keeps filling.
+    static inline void run_preproc_block(TopRegs& regs, u32_t* sram, InferIngestContract& in_contract) {
         PreprocCfg cfg;
-        uint32_t infer_in_words = (uint32_t)regs.infer_ingest_contract.len_words_valid.to_uint();
+        uint32_t infer_in_words = (uint32_t)in_contract.len_words_valid.to_uint();
         if (infer_in_words == 0u) {
-            infer_in_words = infer_expected_words(regs);
+            infer_in_words = (uint32_t)in_contract.len_words_expected.to_uint();
+            if (infer_in_words == 0u) {
+                infer_in_words = (uint32_t)INFER_IN_WORDS_EXPECTED;
+            }
         }
         cfg.infer_in_words = (u32_t)infer_in_words;
         cfg.x_out_words = (u32_t)X_OUT_WORDS_EXPECTED;
-        const u32_t in_base_word = regs.infer_ingest_contract.in_base_word;
+        const u32_t in_base_word = in_contract.in_base_word;
         infer_refresh_preproc_ranges(
-            regs.infer_ingest_contract,
+            in_contract,
             (uint32_t)cfg.x_out_words.to_uint()
         );
 
         PreprocBlockContract& contract = regs.preproc_contract;
         clear_preproc_contract(contract);
         contract.start = true;
-        contract.phase_id = regs.infer_ingest_contract.phase_id;
+        contract.phase_id = in_contract.phase_id;
         contract.x_work_base_word = (u32_t)X_OUT_BASE_WORD;
-        contract.token_range = regs.infer_ingest_contract.token_range;
-        contract.tile_range = regs.infer_ingest_contract.tile_range;
+        contract.token_range = in_contract.token_range;
+        contract.tile_range = in_contract.tile_range;
 
         // Preproc top-fed preload is a compatibility bridge; Top still owns ingest policy.
         u32_t topfed_in_payload[PREPROC_IN_WORDS_EXPECTED];
@@ -1270,13 +1820,18 @@ namespace aecct {
             topfed_in_payload
         );
         contract.done = true;
+#ifndef __SYNTHESIS__
+        top_perf_account_preproc(infer_in_words, (uint32_t)cfg.x_out_words.to_uint());
+#endif
+    }
+
+    static inline void run_preproc_block(TopRegs& regs, u32_t* sram) {
+        run_preproc_block(regs, sram, regs.infer_ingest_contract);
     }
 
     static inline void run_layernorm_block(TopRegs& regs, u32_t* sram) {
-        LayerNormCfg cfg;
-        cfg.token_count = (u32_t)LN_TOKEN_COUNT;
-        cfg.d_model = (u32_t)LN_D_MODEL;
-        cfg.eps_bits = LN_EPS_BITS;
+        const LayerNormCfg cfg = make_layernorm_cfg(
+            (u32_t)LN_TOKEN_COUNT, (u32_t)LN_D_MODEL, LN_EPS_BITS, (u32_t)LN_MODE_DEFAULT);
 
         LayerNormBlockContract& contract = regs.layernorm_contract;
         clear_layernorm_contract(contract);
@@ -1284,8 +1839,8 @@ namespace aecct {
         // Compatibility note: this pre-layernorm path currently shares END_LN phase id.
         contract.phase_id = PHASE_END_LN;
         contract.x_work_base_word = (u32_t)LN_X_IN_BASE_WORD;
-        contract.gamma_base_word = (u32_t)LN_GAMMA_BASE_WORD;
-        contract.beta_base_word = (u32_t)LN_BETA_BASE_WORD;
+        contract.gamma_base_word = (u32_t)(regs.w_base_word + (u32_t)LN_PRE_GAMMA_PARAM_OFFSET_WORDS);
+        contract.beta_base_word = (u32_t)(regs.w_base_word + (u32_t)LN_PRE_BETA_PARAM_OFFSET_WORDS);
 
         uint32_t token_count = (uint32_t)cfg.token_count.to_uint();
         uint32_t d_model = (uint32_t)cfg.d_model.to_uint();
@@ -1309,9 +1864,27 @@ namespace aecct {
         if (affine_words > (uint32_t)LN_D_MODEL) {
             affine_words = (uint32_t)LN_D_MODEL;
         }
-        TOPFED_LN_AFFINE_PRELOAD_LOOP: for (uint32_t c = 0u; c < affine_words; ++c) {
-            topfed_gamma_words[c] = sram[gamma_base + c];
-            topfed_beta_words[c] = sram[beta_base + c];
+        if (regs.infer_batch_active) {
+            // Batched INFER: affine words are fetched once per batch tile and
+            // replayed from Top registers for the remaining codewords of the tile.
+            if (!regs.infer_batch_ln_affine_valid) {
+                TOPFED_LN_AFFINE_BATCH_FETCH_LOOP: for (uint32_t c = 0u; c < affine_words; ++c) {
+                    regs.infer_batch_ln_gamma_words[c] = sram[gamma_base + c];
+                    regs.infer_batch_ln_beta_words[c] = sram[beta_base + c];
+                }
+                regs.infer_batch_ln_affine_valid = true;
+                regs.infer_batch_ln_affine_fetch_count = regs.infer_batch_ln_affine_fetch_count + 1;
+            }
+            TOPFED_LN_AFFINE_BATCH_REPLAY_LOOP: for (uint32_t c = 0u; c < affine_words; ++c) {
+                topfed_gamma_words[c] = regs.infer_batch_ln_gamma_words[c];
+                topfed_beta_words[c] = regs.infer_batch_ln_beta_words[c];
+            }
+        }
+        else {
+            TOPFED_LN_AFFINE_PRELOAD_LOOP: for (uint32_t c = 0u; c < affine_words; ++c) {
+                topfed_gamma_words[c] = sram[gamma_base + c];
+                topfed_beta_words[c] = sram[beta_base + c];
+            }
         }
 
         // Top-owned dispatch: Top builds the contract and block consumes this window.
@@ -1325,6 +1898,10 @@ namespace aecct {
             topfed_beta_words
         );
         contract.done = true;
+#ifndef __SYNTHESIS__
+        // Pre-layer LN carries the END_LN contract id but is charged to the preproc phase.
+        top_perf_account_layernorm((unsigned)PHASE_PREPROC, token_count, d_model);
+#endif
     }
 
     static inline CfgRegs build_layer_cfg(const TopRegs& regs) {
@@ -1368,7 +1945,8 @@ namespace aecct {
         u32_t phase_entry_probe_x_words_valid = (u32_t)0u,
         u32_t* phase_entry_probe_visible = 0,
         u32_t* phase_entry_probe_owner_ok = 0,
-        u32_t* phase_entry_probe_compare_ok = 0
+        u32_t* phase_entry_probe_compare_ok = 0,
+        const TernaryRowMaskCache* row_cache = 0
     ) {
         AttnCfg attn_cfg;
         attn_cfg.token_count = (u32_t)ATTN_TOKEN_COUNT;
@@ -1397,7 +1975,8 @@ namespace aecct {
             phase_entry_probe_x_words_valid,
             phase_entry_probe_visible,
             phase_entry_probe_owner_ok,
-            phase_entry_probe_compare_ok
+            phase_entry_probe_compare_ok,
+            row_cache
         );
     }
 
@@ -1414,7 +1993,8 @@ namespace aecct {
         u32_t phase_entry_probe_x_words_valid = (u32_t)0u,
         u32_t* phase_entry_probe_visible = 0,
         u32_t* phase_entry_probe_owner_ok = 0,
-        u32_t* phase_entry_probe_compare_ok = 0
+        u32_t* phase_entry_probe_compare_ok = 0,
+        const TernaryRowMaskCache* row_cache = 0
     ) {
         AttnCfg attn_cfg;
         attn_cfg.token_count = (u32_t)ATTN_TOKEN_COUNT;
@@ -1443,10 +2023,42 @@ namespace aecct {
             phase_entry_probe_x_words_valid,
             phase_entry_probe_visible,
             phase_entry_probe_owner_ok,
-            phase_entry_probe_compare_ok
+            phase_entry_probe_compare_ok,
+            row_cache
         );
     }
 
+    // Row-cache entries for the Top-managed Q/KV mainlines (no phase-entry probe).
+    template<typename SramView>
+    static inline bool run_p11ad_layer0_top_managed_q(
+        SramView&& sram,
+        const CfgRegs& cfg,
+        u32_t x_in_base_word,
+        const LayerScratch& sc,
+        const LayerParamBase& pb,
+        bool& fallback_taken,
+        const TernaryRowMaskCache& row_cache
+    ) {
+        return run_p11ad_layer0_top_managed_q(
+            sram, cfg, x_in_base_word, sc, pb, fallback_taken,
+            (u32_t)0u, 0, (u32_t)0u, 0, 0, 0, &row_cache);
+    }
+
+    template<typename SramView>
+    static inline bool run_p11ac_layer0_top_managed_kv(
+        SramView&& sram,
+        const CfgRegs& cfg,
+        u32_t x_in_base_word,
+        const LayerScratch& sc,
+        const LayerParamBase& pb,
+        bool& fallback_taken,
+        const TernaryRowMaskCache& row_cache
+    ) {
+        return run_p11ac_layer0_top_managed_kv(
+            sram, cfg, x_in_base_word, sc, pb, fallback_taken,
+            (u32_t)0u, 0, (u32_t)0u, 0, 0, 0, &row_cache);
+    }
+
     template<typename SramView>
     static inline bool run_p11ae_layer0_top_managed_qk_score(
         SramView&& sram,
@@ -1656,6 +2268,119 @@ namespace aecct {
         );
     }
 
+    static inline AttnCfg top_attn_sparse_cfg(const CfgRegs& cfg) {
+        AttnCfg attn_cfg;
+        uint32_t d_model = (uint32_t)cfg.d_model.to_uint();
+        uint32_t n_heads = (uint32_t)cfg.n_heads.to_uint();
+        if (d_model == 0u) { d_model = (uint32_t)ATTN_D_MODEL; }
+        if (n_heads == 0u) { n_heads = (uint32_t)ATTN_N_HEADS; }
+        if (n_heads == 0u) { n_heads = 1u; }
+        if ((d_model % n_heads) != 0u) { n_heads = 1u; }
+        attn_cfg.token_count = (u32_t)ATTN_TOKEN_COUNT;
+        attn_cfg.d_model = (u32_t)d_model;
+        attn_cfg.n_heads = (u32_t)n_heads;
+        attn_cfg.d_head = (u32_t)(d_model / n_heads);
+        return attn_cfg;
+    }
+
+    // Sparse AE/AF over SCR_ATTN_CSR; only reachable while attn_mask_csr_valid holds.
+    template<typename SramView>
+    static inline bool run_attn_sparse_qk_score(
+        SramView&& sram,
+        const CfgRegs& cfg,
+        const LayerScratch& sc,
+        u32_t token_idx,
+        bool& fallback_taken,
+        u32_t* visited_keys = 0
+    ) {
+        const bool ok = attn_phaseb_sparse_qk_score(
+            sram, top_attn_sparse_cfg(cfg), sc.attn, token_idx, (u32_t)sram_map::BASE_SCR_ATTN_CSR_W,
+            visited_keys);
+        fallback_taken = !ok;
+        return ok;
+    }
+
+    template<typename SramView>
+    static inline bool run_attn_sparse_softmax_out(
+        SramView&& sram,
+        const CfgRegs& cfg,
+        const LayerScratch& sc,
+        u32_t token_idx,
+        bool& fallback_taken,
+        u32_t* visited_keys = 0
+    ) {
+        const bool ok = attn_phaseb_sparse_softmax_out(
+            sram, top_attn_sparse_cfg(cfg), sc.attn, token_idx, sc.attn_out_base_word,
+            (u32_t)sram_map::BASE_SCR_ATTN_CSR_W, visited_keys);
+        fallback_taken = !ok;
+        return ok;
+    }
+
+    // Bitmap AE/AF over SCR_ATTN_RING_BITMAP; only reachable while attn_ring_bitmap_valid holds.
+    template<typename SramView>
+    static inline bool run_attn_bitmap_qk_score(
+        SramView&& sram,
+        const CfgRegs& cfg,
+        const LayerScratch& sc,
+        u32_t token_idx,
+        bool& fallback_taken,
+        u32_t* visited_keys = 0
+    ) {
+        const bool ok = attn_phaseb_ring_bitmap_qk_score(
+            sram, top_attn_sparse_cfg(cfg), sc.attn, token_idx, (u32_t)sram_map::BASE_SCR_ATTN_RING_BITMAP_W,
+            visited_keys);
+        fallback_taken = !ok;
+        return ok;
+    }
+
+    template<typename SramView>
+    static inline bool run_attn_bitmap_softmax_out(
+        SramView&& sram,
+        const CfgRegs& cfg,
+        const LayerScratch& sc,
+        u32_t token_idx,
+        bool& fallback_taken,
+        u32_t* visited_keys = 0
+    ) {
+        const bool ok = attn_phaseb_ring_bitmap_softmax_out(
+            sram, top_attn_sparse_cfg(cfg), sc.attn, token_idx, sc.attn_out_base_word,
+            (u32_t)sram_map::BASE_SCR_ATTN_RING_BITMAP_W, visited_keys);
+        fallback_taken = !ok;
+        return ok;
+    }
+
+    // Fused AE+AF; walks the CSR key lists when the sparse gate is also in effect.
+    // ATTN_PHASEB_HEAD_PAR heads share each key step.
+    template<typename SramView>
+    static inline bool run_attn_fused_score_softmax_out(
+        SramView&& sram,
+        const CfgRegs& cfg,
+        const LayerScratch& sc,
+        u32_t token_idx,
+        bool use_key_csr,
+        bool& fallback_taken,
+        u32_t* visited_keys = 0,
+        u32_t* key_steps = 0
+    ) {
+        const bool ok = attn_phaseb_fused_score_softmax_out<ATTN_PHASEB_HEAD_PAR>(
+            sram, top_attn_sparse_cfg(cfg), sc.attn, token_idx, sc.attn_out_base_word,
+            use_key_csr, (u32_t)sram_map::BASE_SCR_ATTN_CSR_W, visited_keys, key_steps);
+        fallback_taken = !ok;
+        return ok;
+    }
+
+    static inline void top_mid_or_end_norm_param_bases(
+        bool is_mid_norm,
+        uint32_t param_base_word,
+        uint32_t& norm_w_base,
+        uint32_t& norm_b_base
+    ) {
+        const uint32_t norm_w_id = is_mid_norm ? 65u : 64u;
+        const uint32_t norm_b_id = is_mid_norm ? 17u : 16u;
+        norm_w_base = param_base_word + kParamMeta[norm_w_id].offset_w;
+        norm_b_base = param_base_word + kParamMeta[norm_b_id].offset_w;
+    }
+
     static inline void load_mid_or_end_norm_params(
         bool is_mid_norm,
         u32_t* sram,
@@ -1664,10 +2389,9 @@ namespace aecct {
         uint32_t beta_base,
         uint32_t d_model
     ) {
-        const uint32_t norm_w_id = is_mid_norm ? 65u : 64u;
-        const uint32_t norm_b_id = is_mid_norm ? 17u : 16u;
-        const uint32_t norm_w_base = param_base_word + kParamMeta[norm_w_id].offset_w;
-        const uint32_t norm_b_base = param_base_word + kParamMeta[norm_b_id].offset_w;
+        uint32_t norm_w_base = 0u;
+        uint32_t norm_b_base = 0u;
+        top_mid_or_end_norm_param_bases(is_mid_norm, param_base_word, norm_w_base, norm_b_base);
 
         TOP_NORM_PARAM_COPY_LOOP: for (uint32_t c = 0; c < d_model; ++c) {
             sram[gamma_base + c] = sram[norm_w_base + c];
@@ -1694,6 +2418,26 @@ namespace aecct {
         );
     }
 
+    static inline void top_fill_mid_or_end_layernorm_contract(
+        bool is_mid_norm,
+        uint32_t d_model,
+        u32_t x_in_base_word,
+        uint32_t gamma_base,
+        uint32_t beta_base,
+        LayerNormBlockContract& contract
+    ) {
+        clear_layernorm_contract(contract);
+        contract.start = true;
+        contract.phase_id = is_mid_norm ? PHASE_MID_LN : PHASE_END_LN;
+        contract.x_work_base_word = x_in_base_word;
+        contract.gamma_base_word = (u32_t)gamma_base;
+        contract.beta_base_word = (u32_t)beta_base;
+        contract.token_range = make_token_range((u32_t)0u, (u32_t)LN_TOKEN_COUNT);
+        const uint32_t tile_count =
+            attn_top_managed_tile_count(d_model, (uint32_t)ATTN_TOP_MANAGED_WORK_TILE_WORDS);
+        contract.tile_range = make_tile_range((u32_t)0u, (u32_t)tile_count);
+    }
+
     static inline void run_mid_or_end_layernorm(
         bool is_mid_norm,
         const CfgRegs& cfg_regs,
@@ -1710,24 +2454,13 @@ namespace aecct {
         uint32_t beta_base = (uint32_t)LN_BETA_BASE_WORD;
         load_mid_or_end_norm_params(is_mid_norm, sram, (uint32_t)param_base_word.to_uint(), gamma_base, beta_base, d_model);
 
-        LayerNormCfg ln_cfg;
-        ln_cfg.token_count = (u32_t)LN_TOKEN_COUNT;
-        ln_cfg.d_model = (u32_t)d_model;
-        ln_cfg.eps_bits = LN_EPS_BITS;
+        const LayerNormCfg ln_cfg = make_layernorm_cfg(
+            (u32_t)LN_TOKEN_COUNT, (u32_t)d_model, LN_EPS_BITS, (u32_t)LN_MODE_DEFAULT);
 
         LayerNormBlockContract local_contract;
         LayerNormBlockContract& contract =
             (top_owned_contract != 0) ? *top_owned_contract : local_contract;
-        clear_layernorm_contract(contract);
-        contract.start = true;
-        contract.phase_id = is_mid_norm ? PHASE_MID_LN : PHASE_END_LN;
-        contract.x_work_base_word = x_in_base_word;
-        contract.gamma_base_word = (u32_t)gamma_base;
-        contract.beta_base_word = (u32_t)beta_base;
-        contract.token_range = make_token_range((u32_t)0u, (u32_t)LN_TOKEN_COUNT);
-        const uint32_t tile_count =
-            attn_top_managed_tile_count(d_model, (uint32_t)ATTN_TOP_MANAGED_WORK_TILE_WORDS);
-        contract.tile_range = make_tile_range((u32_t)0u, (u32_t)tile_count);
+        top_fill_mid_or_end_layernorm_contract(is_mid_norm, d_model, x_in_base_word, gamma_base, beta_base, contract);
 
         LayerNormBlockCoreWindow<u32_t*>(
             sram,
@@ -1737,6 +2470,81 @@ namespace aecct {
             contract
         );
         contract.done = true;
+#ifndef __SYNTHESIS__
+        top_perf_account_layernorm((unsigned)contract.phase_id, (uint32_t)LN_TOKEN_COUNT, d_model);
+#endif
+    }
+
+    // Layers whose Q/K/V and Phase-B run on the Top-managed path. The p11bc target
+    // layer always does; any Phase-B or fused-tail CFG feature extends it to every
+    // layer, because AttnLayer0 neither applies src_mask nor exposes a Q/K/V seam.
+    static inline bool top_layer_takes_managed_attention(
+        const TopRegs& regs,
+        uint32_t lid,
+        uint32_t managed_attn_target_layer
+    ) {
+        if (lid == managed_attn_target_layer) {
+            return true;
+        }
+        return regs.attn_sparse_enable || regs.attn_mask_bitmap_enable ||
+            regs.attn_fused_enable || regs.ln_qkv_fused_enable;
+    }
+
+    // Fused layer tail request for layer lid: only when the next layer takes the
+    // managed-attention path, so its ternary Q/K/V builders are what the fused
+    // tail replaces. Other layers keep Q/K/V inside AttnLayer0.
+    static inline TransformerLayerNextQkvFuseDesc top_make_ln_qkv_fuse_desc(
+        TopRegs& regs,
+        uint32_t lid,
+        uint32_t n_layers,
+        int mid_index,
+        uint32_t managed_attn_target_layer,
+        u32_t layer_x_in_base
+    ) {
+        TransformerLayerNextQkvFuseDesc desc = make_transformer_layer_next_qkv_fuse_desc();
+        if (!regs.ln_qkv_fused_enable || lid + 1u >= n_layers ||
+            !top_layer_takes_managed_attention(regs, lid + 1u, managed_attn_target_layer)) {
+            return desc;
+        }
+        desc.enable = true;
+        if ((int)lid == mid_index) {
+            // Mid LN output lands where the split path puts it: this layer's input page.
+            uint32_t mid_gamma_base = 0u;
+            uint32_t mid_beta_base = 0u;
+            top_mid_or_end_norm_param_bases(
+                true, (uint32_t)regs.w_base_word.to_uint(), mid_gamma_base, mid_beta_base);
+            desc.mid_norm_enable = true;
+            desc.mid_gamma_base_word = (u32_t)mid_gamma_base;
+            desc.mid_beta_base_word = (u32_t)mid_beta_base;
+            desc.mid_x_out_base_word = layer_x_in_base;
+            desc.mid_snapshot = regs.mid_snapshot;
+        }
+        desc.next_param_base_word = make_layer_param_base(regs.w_base_word, (u32_t)(lid + 1u)).param_base_word;
+        desc.row_cache = &regs.w_row_cache;
+        return desc;
+    }
+
+    // Mid LN already ran inside the fused tail: latch the same contract/perf the split path would.
+    static inline void top_commit_fused_mid_layernorm(
+        const CfgRegs& cfg_regs,
+        u32_t mid_x_in_base_word,
+        const TransformerLayerNextQkvFuseDesc& fuse,
+        LayerNormBlockContract& contract
+    ) {
+        uint32_t d_model = (uint32_t)cfg_regs.d_model.to_uint();
+        if (d_model == 0u) { d_model = (uint32_t)LN_D_MODEL; }
+        top_fill_mid_or_end_layernorm_contract(
+            true,
+            d_model,
+            mid_x_in_base_word,
+            (uint32_t)fuse.mid_gamma_base_word.to_uint(),
+            (uint32_t)fuse.mid_beta_base_word.to_uint(),
+            contract
+        );
+        contract.done = true;
+#ifndef __SYNTHESIS__
+        top_perf_account_layernorm((unsigned)contract.phase_id, (uint32_t)LN_TOKEN_COUNT, d_model, true);
+#endif
     }
 
     // Top-side representative helper for FFN seam assembly.
@@ -1907,6 +2715,42 @@ namespace aecct {
         );
     }
 
+    // Batched INFER: the FFN W1/W2 weight and bias words stay resident in W_REGION for
+    // the whole batch, so the top-fed descriptor points at them in place and the layer
+    // skips its per-codeword staging copy. SCR_WORK keeps all scratch out of W_REGION.
+    static inline void top_batch_ffn_bind_in_place(
+        TopRegs& regs,
+        u32_t* sram,
+        const LayerParamBase& pb,
+        u32_t layer_id,
+        TransformerLayerFfnTopfedHandoffDesc& ffn_topfed_handoff_desc
+    ) {
+        const uint32_t lid = (uint32_t)layer_id.to_uint();
+        if (!regs.infer_batch_active || lid >= (uint32_t)N_LAYERS) {
+            return;
+        }
+        // A Top-fed FFN payload from the local-only handoff keeps priority.
+        if (ffn_topfed_handoff_desc.topfed_w1_weight_words != 0 ||
+            ffn_topfed_handoff_desc.topfed_w2_weight_words != 0) {
+            return;
+        }
+        const bool use_layer1 = (lid != 0u);
+        const uint32_t param_base = (uint32_t)pb.param_base_word.to_uint();
+        ffn_topfed_handoff_desc.topfed_w1_weight_words =
+            &sram[param_base + kParamMeta[use_layer1 ? 56u : 36u].offset_w];
+        ffn_topfed_handoff_desc.topfed_w1_weight_words_valid = (u32_t)FFN_W1_WEIGHT_WORDS;
+        ffn_topfed_handoff_desc.topfed_w1_bias_words =
+            &sram[param_base + kParamMeta[use_layer1 ? 12u : 4u].offset_w];
+        ffn_topfed_handoff_desc.topfed_w1_bias_words_valid = (u32_t)FFN_W1_BIAS_WORDS;
+        ffn_topfed_handoff_desc.topfed_w2_weight_words =
+            &sram[param_base + kParamMeta[use_layer1 ? 59u : 39u].offset_w];
+        ffn_topfed_handoff_desc.topfed_w2_weight_words_valid = (u32_t)FFN_W2_WEIGHT_WORDS;
+        ffn_topfed_handoff_desc.topfed_w2_bias_words =
+            &sram[param_base + kParamMeta[use_layer1 ? 13u : 5u].offset_w];
+        ffn_topfed_handoff_desc.topfed_w2_bias_words_valid = (u32_t)FFN_W2_BIAS_WORDS;
+        regs.infer_batch_ffn_inplace_count = regs.infer_batch_ffn_inplace_count + 1;
+    }
+
     static inline u32_t top_lid0_local_only_attn_out_fixed_payload_word(uint32_t word_index) {
         return (u32_t)(0xA7000000u + word_index);
     }
@@ -2255,7 +3099,9 @@ namespace aecct {
             make_transformer_layer_ffn_topfed_handoff_desc(),
         bool attn_out_topfed_payload_enable = false,
         const u32_t* attn_out_topfed_payload_words = 0,
-        u32_t attn_out_topfed_payload_words_valid = (u32_t)0u
+        u32_t attn_out_topfed_payload_words_valid = (u32_t)0u,
+        TransformerLayerNextQkvFuseDesc* next_qkv_fuse = 0,
+        bool qkv_from_fused_tail = false
     ) {
         // Resolve compatibility shell policy at Top before dispatch.
         const bool attn_compat_shell_enable = top_should_enable_attn_compat_shell(
@@ -2284,8 +3130,23 @@ namespace aecct {
             attn_out_topfed_payload_enable,
             attn_out_topfed_payload_words,
             attn_out_topfed_payload_words_valid,
-            attn_compat_shell_enable
+            attn_compat_shell_enable,
+            0,
+            next_qkv_fuse
         );
+#ifndef __SYNTHESIS__
+        top_perf_account_layer(
+            (uint32_t)layer_id.to_uint(),
+            (uint32_t)ATTN_TOKEN_COUNT,
+            (uint32_t)cfg.d_model.to_uint(),
+            (uint32_t)cfg.n_heads.to_uint(),
+            (uint32_t)cfg.d_ffn.to_uint(),
+            next_qkv_fuse != 0 && next_qkv_fuse->done,
+            qkv_from_fused_tail,
+            score_prebuilt_from_top_managed,
+            out_prebuilt_from_top_managed
+        );
+#endif
     }
 
     template<uint32_t SRAM_WORDS>
@@ -2306,7 +3167,9 @@ namespace aecct {
             make_transformer_layer_ffn_topfed_handoff_desc(),
         bool attn_out_topfed_payload_enable = false,
         const u32_t* attn_out_topfed_payload_words = 0,
-        u32_t attn_out_topfed_payload_words_valid = (u32_t)0u
+        u32_t attn_out_topfed_payload_words_valid = (u32_t)0u,
+        TransformerLayerNextQkvFuseDesc* next_qkv_fuse = 0,
+        bool qkv_from_fused_tail = false
     ) {
         // Same policy seam for the array-window bridge entry.
         const bool attn_compat_shell_enable = top_should_enable_attn_compat_shell(
@@ -2335,8 +3198,23 @@ namespace aecct {
             attn_out_topfed_payload_enable,
             attn_out_topfed_payload_words,
             attn_out_topfed_payload_words_valid,
-            attn_compat_shell_enable
+            attn_compat_shell_enable,
+            0,
+            next_qkv_fuse
+        );
+#ifndef __SYNTHESIS__
+        top_perf_account_layer(
+            (uint32_t)layer_id.to_uint(),
+            (uint32_t)ATTN_TOKEN_COUNT,
+            (uint32_t)cfg.d_model.to_uint(),
+            (uint32_t)cfg.n_heads.to_uint(),
+            (uint32_t)cfg.d_ffn.to_uint(),
+            next_qkv_fuse != 0 && next_qkv_fuse->done,
+            qkv_from_fused_tail,
+            score_prebuilt_from_top_managed,
+            out_prebuilt_from_top_managed
         );
+#endif
     }
 
     // Top-level layer orchestration boundary.
@@ -2372,7 +3250,7 @@ namespace aecct {
         u32_t x_in_base = (u32_t)LN_X_OUT_BASE_WORD;
         u32_t x_out_base = alternate_x_page(x_in_base);
         bool mid_valid = false;
-        static u32_t mid_snapshot[LN_X_TOTAL_WORDS];
+        u32_t* mid_snapshot = regs.mid_snapshot;
         regs.p11ac_mainline_path_taken = false;
         regs.p11ac_fallback_taken = false;
         regs.p11ad_mainline_q_path_taken = false;
@@ -2437,6 +3315,7 @@ namespace aecct {
         regs.p11bb_lid_nonzero_qkscore_wq_handoff_fallback_seen_count = 0;
 
         // Top-layer loop is the ownership seam: Top decides layer policy, blocks consume it.
+        bool next_layer_qkv_prebuilt = false;
         TOP_LAYER_ORCHESTRATION_LOOP: for (uint32_t lid = 0; lid < n_layers; ++lid) {
             if (lid0_local_only_qkscore_mask_handoff_enable) {
                 regs.p11ay_qkscore_mask_handoff_gate_taken_count =
@@ -2461,39 +3340,52 @@ namespace aecct {
             bool kv_prebuilt_from_top_managed = false;
             bool score_prebuilt_from_top_managed = false;
             bool out_prebuilt_from_top_managed = false;
-            const bool is_managed_attention_layer = (lid == managed_attn_target_layer);
+            const bool is_managed_attention_layer =
+                top_layer_takes_managed_attention(regs, lid, managed_attn_target_layer);
 
-            // P11AC mainline wiring is intentionally scoped to one
-            // local-only managed-attention target layer per run.
+            // P11AC mainline wiring is scoped to the managed-attention target
+            // layer, or to every layer once a Phase-B or fused-tail CFG feature is on.
             if (is_managed_attention_layer) {
                 regs.p11bc_managed_attention_gate_taken_count =
                     regs.p11bc_managed_attention_gate_taken_count + (u32_t)1u;
                 regs.p11bc_managed_attention_last_layer_id = (u32_t)lid;
                 // Managed prebuilds are allowed only on the selected target layer.
                 // Fallback meaning is established and latched here for reviewer evidence.
-                bool q_fallback_taken = true;
-                q_prebuilt_from_top_managed = run_p11ad_layer0_top_managed_q(
-                    sram,
-                    cfg,
-                    x_in_base,
-                    sc,
-                    pb,
-                    q_fallback_taken
-                );
-                regs.p11ad_mainline_q_path_taken = q_prebuilt_from_top_managed;
-                regs.p11ad_q_fallback_taken = q_fallback_taken;
-
-                bool fallback_taken = true;
-                kv_prebuilt_from_top_managed = run_p11ac_layer0_top_managed_kv(
-                    sram,
-                    cfg,
-                    x_in_base,
-                    sc,
-                    pb,
-                    fallback_taken
-                );
-                regs.p11ac_mainline_path_taken = kv_prebuilt_from_top_managed;
-                regs.p11ac_fallback_taken = fallback_taken;
+                if (next_layer_qkv_prebuilt) {
+                    // Previous layer's fused tail already wrote Q/K/V (+ act_q, q_sx) for this layer.
+                    q_prebuilt_from_top_managed = true;
+                    kv_prebuilt_from_top_managed = true;
+                    regs.p11ad_mainline_q_path_taken = true;
+                    regs.p11ad_q_fallback_taken = false;
+                    regs.p11ac_mainline_path_taken = true;
+                    regs.p11ac_fallback_taken = false;
+                } else {
+                    bool q_fallback_taken = true;
+                    q_prebuilt_from_top_managed = run_p11ad_layer0_top_managed_q(
+                        sram,
+                        cfg,
+                        x_in_base,
+                        sc,
+                        pb,
+                        q_fallback_taken,
+                        regs.w_row_cache
+                    );
+                    regs.p11ad_mainline_q_path_taken = q_prebuilt_from_top_managed;
+                    regs.p11ad_q_fallback_taken = q_fallback_taken;
+
+                    bool fallback_taken = true;
+                    kv_prebuilt_from_top_managed = run_p11ac_layer0_top_managed_kv(
+                        sram,
+                        cfg,
+                        x_in_base,
+                        sc,
+                        pb,
+                        fallback_taken,
+                        regs.w_row_cache
+                    );
+                    regs.p11ac_mainline_path_taken = kv_prebuilt_from_top_managed;
+                    regs.p11ac_fallback_taken = fallback_taken;
+                }
 
                 bool ae_mainline_score_path_taken = true;
                 bool af_mainline_softmax_output_path_taken = true;
@@ -2508,9 +3400,27 @@ namespace aecct {
                 // AE/AF mainline is only legal after both AD(Q) and AC(KV) prebuilds succeed.
                 if (q_prebuilt_from_top_managed && kv_prebuilt_from_top_managed) {
                     const uint32_t token_count = (uint32_t)ATTN_TOKEN_COUNT;
+                    const bool attn_sparse_for_layer = regs.attn_sparse_enable && regs.attn_mask_csr_valid;
+                    const bool attn_bitmap_for_layer = regs.attn_mask_bitmap_enable && regs.attn_ring_bitmap_valid;
+                    const bool attn_fused_for_layer = regs.attn_fused_enable;
+#ifndef __SYNTHESIS__
+                    const AttnCfg perf_cfg = top_attn_sparse_cfg(cfg);
+                    const uint32_t perf_dense_pairs = token_count * (uint32_t)perf_cfg.n_heads.to_uint();
+                    const uint32_t perf_csr_index_words = 2u * (uint32_t)perf_cfg.n_heads.to_uint();
+                    const uint32_t perf_bitmap_index_words =
+                        (uint32_t)sram_map::ATTN_CSR_RINGS * (uint32_t)sram_map::ATTN_RING_BITMAP_ROW_WORDS;
+                    TopPerfAttnTally perf_attn;
+                    perf_attn.clear();
+#endif
                     TOP_P11AEAF_TOKEN_LOOP: for (uint32_t t = 0u; t < token_count; ++t) {
                         bool score_fallback_taken = true;
                         bool score_mainline_taken = false;
+                        bool fused_taken = false;
+                        // Key counts reported by the fused/bitmap/sparse seams (perf model only).
+                        bool score_keys_counted = false;
+                        u32_t visited_keys = (u32_t)0u;
+                        u32_t key_steps = (u32_t)0u;
+                        u32_t softmax_visited_keys = (u32_t)0u;
                         // Compatibility handoff priority for AE: mask family -> WQ probe -> QSRC probe -> KVSCAN probe.
                         if (lid0_local_only_qkscore_mask_handoff_enable && is_managed_attention_layer) {
                             bool warmup_fallback_taken = true;
@@ -2708,6 +3618,39 @@ namespace aecct {
                                 phase_entry_probe_k_words,
                                 phase_entry_probe_words_valid
                             );
+                        } else if (attn_fused_for_layer) {
+                            score_mainline_taken = run_attn_fused_score_softmax_out(
+                                sram,
+                                cfg,
+                                sc,
+                                (u32_t)t,
+                                attn_sparse_for_layer,
+                                score_fallback_taken,
+                                &visited_keys,
+                                &key_steps
+                            );
+                            fused_taken = score_mainline_taken;
+                            score_keys_counted = true;
+                        } else if (attn_bitmap_for_layer) {
+                            score_mainline_taken = run_attn_bitmap_qk_score(
+                                sram,
+                                cfg,
+                                sc,
+                                (u32_t)t,
+                                score_fallback_taken,
+                                &visited_keys
+                            );
+                            score_keys_counted = true;
+                        } else if (attn_sparse_for_layer) {
+                            score_mainline_taken = run_attn_sparse_qk_score(
+                                sram,
+                                cfg,
+                                sc,
+                                (u32_t)t,
+                                score_fallback_taken,
+                                &visited_keys
+                            );
+                            score_keys_counted = true;
                         } else {
                             score_mainline_taken = run_p11ae_layer0_top_managed_qk_score(
                                 sram,
@@ -2722,21 +3665,87 @@ namespace aecct {
                             af_mainline_softmax_output_path_taken = false;
                             break;
                         }
-
-                        bool softmax_out_fallback_taken = true;
-                        const bool softmax_out_mainline_taken =
-                            run_p11af_layer0_top_managed_softmax_out(
-                                sram,
-                                cfg,
-                                sc,
-                                (u32_t)t,
-                                softmax_out_fallback_taken
-                            );
+#ifndef __SYNTHESIS__
+                        // Charge the seam actually taken (branch order: fused, bitmap, sparse);
+                        // CSR walks read two row_ptr words per head and one col word per key.
+                        if (!score_keys_counted) {
+                            top_perf_tally_score(perf_attn, perf_dense_pairs, 0u);
+                        } else if (fused_taken) {
+                            const uint32_t keys = (uint32_t)visited_keys.to_uint();
+                            top_perf_tally_fused(perf_attn, keys,
+                                attn_sparse_for_layer ? perf_csr_index_words + keys : 0u,
+                                (uint32_t)key_steps.to_uint());
+                        } else if (attn_bitmap_for_layer) {
+                            top_perf_tally_score(perf_attn, (uint32_t)visited_keys.to_uint(), perf_bitmap_index_words);
+                        } else {
+                            const uint32_t keys = (uint32_t)visited_keys.to_uint();
+                            top_perf_tally_score(perf_attn, keys, perf_csr_index_words + keys);
+                        }
+#endif
+
+                        // The fused engine already produced the attention output row.
+                        bool softmax_out_fallback_taken = !fused_taken;
+                        bool softmax_out_mainline_taken = fused_taken;
+                        if (!fused_taken) {
+                            // Bitmap/sparse AF only read unmasked keys, which every AE variant has scored.
+                            softmax_out_mainline_taken = attn_bitmap_for_layer ?
+                                run_attn_bitmap_softmax_out(
+                                    sram,
+                                    cfg,
+                                    sc,
+                                    (u32_t)t,
+                                    softmax_out_fallback_taken,
+                                    &softmax_visited_keys
+                                ) :
+                                attn_sparse_for_layer ?
+                                run_attn_sparse_softmax_out(
+                                    sram,
+                                    cfg,
+                                    sc,
+                                    (u32_t)t,
+                                    softmax_out_fallback_taken,
+                                    &softmax_visited_keys
+                                ) :
+                                run_p11af_layer0_top_managed_softmax_out(
+                                    sram,
+                                    cfg,
+                                    sc,
+                                    (u32_t)t,
+                                    softmax_out_fallback_taken
+                                );
+                        }
                         if (!softmax_out_mainline_taken || softmax_out_fallback_taken) {
                             af_mainline_softmax_output_path_taken = false;
                             break;
                         }
+#ifndef __SYNTHESIS__
+                        if (!fused_taken) {
+                            const uint32_t keys = (uint32_t)softmax_visited_keys.to_uint();
+                            if (attn_bitmap_for_layer) {
+                                top_perf_tally_softmax(perf_attn, keys, perf_bitmap_index_words);
+                            } else if (attn_sparse_for_layer) {
+                                top_perf_tally_softmax(perf_attn, keys, perf_csr_index_words + keys);
+                            } else {
+                                top_perf_tally_softmax(perf_attn, perf_dense_pairs, 0u);
+                            }
+                        }
+#endif
+                        if (attn_bitmap_for_layer && !fused_taken) {
+                            regs.attn_bitmap_token_count = regs.attn_bitmap_token_count + (u32_t)1u;
+                        } else if (attn_sparse_for_layer) {
+                            regs.attn_sparse_token_count = regs.attn_sparse_token_count + (u32_t)1u;
+                        }
+                        if (fused_taken) {
+                            regs.attn_fused_token_count = regs.attn_fused_token_count + (u32_t)1u;
+                        }
                     }
+#ifndef __SYNTHESIS__
+                    top_perf_commit_attn_tally(
+                        (lid == 0u) ? (unsigned)PHASE_LAYER0 : (unsigned)PHASE_LAYER1,
+                        perf_attn,
+                        (uint32_t)perf_cfg.d_model.to_uint(),
+                        (uint32_t)perf_cfg.n_heads.to_uint());
+#endif
                 } else {
                     ae_mainline_score_path_taken = false;
                     af_mainline_softmax_output_path_taken = false;
@@ -2835,7 +3844,7 @@ namespace aecct {
                 d_model
             );
 
-            const TransformerLayerFfnTopfedHandoffDesc ffn_topfed_handoff_desc =
+            TransformerLayerFfnTopfedHandoffDesc ffn_topfed_handoff_desc =
                 top_make_runloop_lid0_local_only_ffn_handoff_desc(
                     cfg,
                     (u32_t)lid,
@@ -2861,6 +3870,9 @@ namespace aecct {
                     regs.p11av_ffn_handoff_fallback_seen_count + (u32_t)1u;
             }
 
+            // Batched INFER: FFN weights are read in place from W_REGION.
+            top_batch_ffn_bind_in_place(regs, sram, pb, (u32_t)lid, ffn_topfed_handoff_desc);
+
             bool attn_out_topfed_payload_enable_for_layer = false;
             const u32_t* attn_out_topfed_payload_words_for_layer = 0;
             u32_t attn_out_topfed_payload_words_valid_for_layer = (u32_t)0u;
@@ -2929,6 +3941,11 @@ namespace aecct {
                 }
             }
             // Dispatch boundary: policy and handoff descriptors are handed off, not reinterpreted.
+            // Fused tail only when the next layer runs managed attention (its Q/K/V builders are replaced).
+            TransformerLayerNextQkvFuseDesc next_qkv_fuse = top_make_ln_qkv_fuse_desc(
+                regs, lid, n_layers, mid_index, managed_attn_target_layer, x_in_base);
+            const bool qkv_from_fused_tail = next_layer_qkv_prebuilt;
+            next_layer_qkv_prebuilt = false;
             top_dispatch_transformer_layer(
                 sram,
                 cfg,
@@ -2945,27 +3962,40 @@ namespace aecct {
                 ffn_topfed_handoff_desc,
                 attn_out_topfed_payload_enable_for_layer,
                 attn_out_topfed_payload_words_for_layer,
-                attn_out_topfed_payload_words_valid_for_layer
+                attn_out_topfed_payload_words_valid_for_layer,
+                next_qkv_fuse.enable ? &next_qkv_fuse : 0,
+                qkv_from_fused_tail
             );
+            if (next_qkv_fuse.done) {
+                regs.ln_qkv_fused_layer_count = regs.ln_qkv_fused_layer_count + (u32_t)1u;
+                next_layer_qkv_prebuilt = next_qkv_fuse.qkv_done;
+            }
 
             x_in_base = x_out_base;
             x_out_base = alternate_x_page(x_in_base);
 
             if ((int)lid == mid_index) {
                 // mid LN must be out-of-place: current_x -> other_x
-                run_mid_or_end_layernorm(
-                    true,
-                    cfg,
-                    sram,
-                    regs.w_base_word,
-                    x_in_base,
-                    x_out_base,
-                    &regs.layernorm_contract
-                );
-                x_in_base = x_out_base;
-                x_out_base = alternate_x_page(x_in_base);
+                if (next_qkv_fuse.done && next_qkv_fuse.mid_norm_enable) {
+                    // Fused tail already wrote the mid LN output page and snapshot.
+                    top_commit_fused_mid_layernorm(cfg, x_in_base, next_qkv_fuse, regs.layernorm_contract);
+                    x_in_base = x_out_base;
+                    x_out_base = alternate_x_page(x_in_base);
+                } else {
+                    run_mid_or_end_layernorm(
+                        true,
+                        cfg,
+                        sram,
+                        regs.w_base_word,
+                        x_in_base,
+                        x_out_base,
+                        &regs.layernorm_contract
+                    );
+                    x_in_base = x_out_base;
+                    x_out_base = alternate_x_page(x_in_base);
 
-                copy_x_words(mid_snapshot, &sram[(uint32_t)x_in_base.to_uint()], (uint32_t)LN_X_TOTAL_WORDS);
+                    copy_x_words(mid_snapshot, &sram[(uint32_t)x_in_base.to_uint()], (uint32_t)LN_X_TOTAL_WORDS);
+                }
                 mid_valid = true;
             }
         }
@@ -3024,7 +4054,7 @@ namespace aecct {
         u32_t x_in_base = (u32_t)LN_X_OUT_BASE_WORD;
         u32_t x_out_base = alternate_x_page(x_in_base);
         bool mid_valid = false;
-        static u32_t mid_snapshot[LN_X_TOTAL_WORDS];
+        u32_t* mid_snapshot = regs.mid_snapshot;
         regs.p11ac_mainline_path_taken = false;
         regs.p11ac_fallback_taken = false;
         regs.p11ad_mainline_q_path_taken = false;
@@ -3089,6 +4119,7 @@ namespace aecct {
         regs.p11bb_lid_nonzero_qkscore_wq_handoff_fallback_seen_count = 0;
 
         // AN runloop keeps the same ownership seam: Top selects policy, blocks consume descriptors.
+        bool next_layer_qkv_prebuilt = false;
         TOP_LAYER_ORCHESTRATION_AN_LOOP: for (uint32_t lid = 0; lid < n_layers; ++lid) {
             if (lid0_local_only_qkscore_mask_handoff_enable) {
                 regs.p11ay_qkscore_mask_handoff_gate_taken_count =
@@ -3113,35 +4144,48 @@ namespace aecct {
             bool kv_prebuilt_from_top_managed = false;
             bool score_prebuilt_from_top_managed = false;
             bool out_prebuilt_from_top_managed = false;
-            const bool is_managed_attention_layer = (lid == managed_attn_target_layer);
+            const bool is_managed_attention_layer =
+                top_layer_takes_managed_attention(regs, lid, managed_attn_target_layer);
 
             if (is_managed_attention_layer) {
                 regs.p11bc_managed_attention_gate_taken_count =
                     regs.p11bc_managed_attention_gate_taken_count + (u32_t)1u;
                 regs.p11bc_managed_attention_last_layer_id = (u32_t)lid;
-                bool q_fallback_taken = true;
-                q_prebuilt_from_top_managed = run_p11ad_layer0_top_managed_q(
-                    sram,
-                    cfg,
-                    x_in_base,
-                    sc,
-                    pb,
-                    q_fallback_taken
-                );
-                regs.p11ad_mainline_q_path_taken = q_prebuilt_from_top_managed;
-                regs.p11ad_q_fallback_taken = q_fallback_taken;
-
-                bool fallback_taken = true;
-                kv_prebuilt_from_top_managed = run_p11ac_layer0_top_managed_kv(
-                    sram,
-                    cfg,
-                    x_in_base,
-                    sc,
-                    pb,
-                    fallback_taken
-                );
-                regs.p11ac_mainline_path_taken = kv_prebuilt_from_top_managed;
-                regs.p11ac_fallback_taken = fallback_taken;
+                if (next_layer_qkv_prebuilt) {
+                    // Previous layer's fused tail already wrote Q/K/V (+ act_q, q_sx) for this layer.
+                    q_prebuilt_from_top_managed = true;
+                    kv_prebuilt_from_top_managed = true;
+                    regs.p11ad_mainline_q_path_taken = true;
+                    regs.p11ad_q_fallback_taken = false;
+                    regs.p11ac_mainline_path_taken = true;
+                    regs.p11ac_fallback_taken = false;
+                } else {
+                    bool q_fallback_taken = true;
+                    q_prebuilt_from_top_managed = run_p11ad_layer0_top_managed_q(
+                        sram,
+                        cfg,
+                        x_in_base,
+                        sc,
+                        pb,
+                        q_fallback_taken,
+                        regs.w_row_cache
+                    );
+                    regs.p11ad_mainline_q_path_taken = q_prebuilt_from_top_managed;
+                    regs.p11ad_q_fallback_taken = q_fallback_taken;
+
+                    bool fallback_taken = true;
+                    kv_prebuilt_from_top_managed = run_p11ac_layer0_top_managed_kv(
+                        sram,
+                        cfg,
+                        x_in_base,
+                        sc,
+                        pb,
+                        fallback_taken,
+                        regs.w_row_cache
+                    );
+                    regs.p11ac_mainline_path_taken = kv_prebuilt_from_top_managed;
+                    regs.p11ac_fallback_taken = fallback_taken;
+                }
 
                 bool ae_mainline_score_path_taken = true;
                 bool af_mainline_softmax_output_path_taken = true;
@@ -3156,9 +4200,27 @@ namespace aecct {
                 // Score/softmax mainline is entered only when both Q and KV prebuilds are valid.
                 if (q_prebuilt_from_top_managed && kv_prebuilt_from_top_managed) {
                     const uint32_t token_count = (uint32_t)ATTN_TOKEN_COUNT;
+                    const bool attn_sparse_for_layer = regs.attn_sparse_enable && regs.attn_mask_csr_valid;
+                    const bool attn_bitmap_for_layer = regs.attn_mask_bitmap_enable && regs.attn_ring_bitmap_valid;
+                    const bool attn_fused_for_layer = regs.attn_fused_enable;
+#ifndef __SYNTHESIS__
+                    const AttnCfg perf_cfg = top_attn_sparse_cfg(cfg);
+                    const uint32_t perf_dense_pairs = token_count * (uint32_t)perf_cfg.n_heads.to_uint();
+                    const uint32_t perf_csr_index_words = 2u * (uint32_t)perf_cfg.n_heads.to_uint();
+                    const uint32_t perf_bitmap_index_words =
+                        (uint32_t)sram_map::ATTN_CSR_RINGS * (uint32_t)sram_map::ATTN_RING_BITMAP_ROW_WORDS;
+                    TopPerfAttnTally perf_attn;
+                    perf_attn.clear();
+#endif
                     TOP_P11AEAF_AN_TOKEN_LOOP: for (uint32_t t = 0u; t < token_count; ++t) {
                         bool score_fallback_taken = true;
                         bool score_mainline_taken = false;
+                        bool fused_taken = false;
+                        // Key counts reported by the fused/bitmap/sparse seams (perf model only).
+                        bool score_keys_counted = false;
+                        u32_t visited_keys = (u32_t)0u;
+                        u32_t key_steps = (u32_t)0u;
+                        u32_t softmax_visited_keys = (u32_t)0u;
                         // Compatibility handoff selection order is intentional for AE ownership visibility.
                         if (lid0_local_only_qkscore_mask_handoff_enable && is_managed_attention_layer) {
                             bool warmup_fallback_taken = true;
@@ -3356,6 +4418,39 @@ namespace aecct {
                                 phase_entry_probe_k_words,
                                 phase_entry_probe_words_valid
                             );
+                        } else if (attn_fused_for_layer) {
+                            score_mainline_taken = run_attn_fused_score_softmax_out(
+                                sram,
+                                cfg,
+                                sc,
+                                (u32_t)t,
+                                attn_sparse_for_layer,
+                                score_fallback_taken,
+                                &visited_keys,
+                                &key_steps
+                            );
+                            fused_taken = score_mainline_taken;
+                            score_keys_counted = true;
+                        } else if (attn_bitmap_for_layer) {
+                            score_mainline_taken = run_attn_bitmap_qk_score(
+                                sram,
+                                cfg,
+                                sc,
+                                (u32_t)t,
+                                score_fallback_taken,
+                                &visited_keys
+                            );
+                            score_keys_counted = true;
+                        } else if (attn_sparse_for_layer) {
+                            score_mainline_taken = run_attn_sparse_qk_score(
+                                sram,
+                                cfg,
+                                sc,
+                                (u32_t)t,
+                                score_fallback_taken,
+                                &visited_keys
+                            );
+                            score_keys_counted = true;
                         } else {
                             score_mainline_taken = run_p11ae_layer0_top_managed_qk_score(
                                 sram,
@@ -3370,21 +4465,87 @@ namespace aecct {
                             af_mainline_softmax_output_path_taken = false;
                             break;
                         }
-
-                        bool softmax_out_fallback_taken = true;
-                        const bool softmax_out_mainline_taken =
-                            run_p11af_layer0_top_managed_softmax_out(
-                                sram,
-                                cfg,
-                                sc,
-                                (u32_t)t,
-                                softmax_out_fallback_taken
-                            );
+#ifndef __SYNTHESIS__
+                        // Charge the seam actually taken (branch order: fused, bitmap, sparse);
+                        // CSR walks read two row_ptr words per head and one col word per key.
+                        if (!score_keys_counted) {
+                            top_perf_tally_score(perf_attn, perf_dense_pairs, 0u);
+                        } else if (fused_taken) {
+                            const uint32_t keys = (uint32_t)visited_keys.to_uint();
+                            top_perf_tally_fused(perf_attn, keys,
+                                attn_sparse_for_layer ? perf_csr_index_words + keys : 0u,
+                                (uint32_t)key_steps.to_uint());
+                        } else if (attn_bitmap_for_layer) {
+                            top_perf_tally_score(perf_attn, (uint32_t)visited_keys.to_uint(), perf_bitmap_index_words);
+                        } else {
+                            const uint32_t keys = (uint32_t)visited_keys.to_uint();
+                            top_perf_tally_score(perf_attn, keys, perf_csr_index_words + keys);
+                        }
+#endif
+
+                        // The fused engine already produced the attention output row.
+                        bool softmax_out_fallback_taken = !fused_taken;
+                        bool softmax_out_mainline_taken = fused_taken;
+                        if (!fused_taken) {
+                            // Bitmap/sparse AF only read unmasked keys, which every AE variant has scored.
+                            softmax_out_mainline_taken = attn_bitmap_for_layer ?
+                                run_attn_bitmap_softmax_out(
+                                    sram,
+                                    cfg,
+                                    sc,
+                                    (u32_t)t,
+                                    softmax_out_fallback_taken,
+                                    &softmax_visited_keys
+                                ) :
+                                attn_sparse_for_layer ?
+                                run_attn_sparse_softmax_out(
+                                    sram,
+                                    cfg,
+                                    sc,
+                                    (u32_t)t,
+                                    softmax_out_fallback_taken,
+                                    &softmax_visited_keys
+                                ) :
+                                run_p11af_layer0_top_managed_softmax_out(
+                                    sram,
+                                    cfg,
+                                    sc,
+                                    (u32_t)t,
+                                    softmax_out_fallback_taken
+                                );
+                        }
                         if (!softmax_out_mainline_taken || softmax_out_fallback_taken) {
                             af_mainline_softmax_output_path_taken = false;
                             break;
                         }
+#ifndef __SYNTHESIS__
+                        if (!fused_taken) {
+                            const uint32_t keys = (uint32_t)softmax_visited_keys.to_uint();
+                            if (attn_bitmap_for_layer) {
+                                top_perf_tally_softmax(perf_attn, keys, perf_bitmap_index_words);
+                            } else if (attn_sparse_for_layer) {
+                                top_perf_tally_softmax(perf_attn, keys, perf_csr_index_words + keys);
+                            } else {
+                                top_perf_tally_softmax(perf_attn, perf_dense_pairs, 0u);
+                            }
+                        }
+#endif
+                        if (attn_bitmap_for_layer && !fused_taken) {
+                            regs.attn_bitmap_token_count = regs.attn_bitmap_token_count + (u32_t)1u;
+                        } else if (attn_sparse_for_layer) {
+                            regs.attn_sparse_token_count = regs.attn_sparse_token_count + (u32_t)1u;
+                        }
+                        if (fused_taken) {
+                            regs.attn_fused_token_count = regs.attn_fused_token_count + (u32_t)1u;
+                        }
                     }
+#ifndef __SYNTHESIS__
+                    top_perf_commit_attn_tally(
+                        (lid == 0u) ? (unsigned)PHASE_LAYER0 : (unsigned)PHASE_LAYER1,
+                        perf_attn,
+                        (uint32_t)perf_cfg.d_model.to_uint(),
+                        (uint32_t)perf_cfg.n_heads.to_uint());
+#endif
                 } else {
                     ae_mainline_score_path_taken = false;
                     af_mainline_softmax_output_path_taken = false;
@@ -3483,7 +4644,7 @@ namespace aecct {
                 d_model
             );
 
-            const TransformerLayerFfnTopfedHandoffDesc ffn_topfed_handoff_desc =
+            TransformerLayerFfnTopfedHandoffDesc ffn_topfed_handoff_desc =
                 top_make_runloop_lid0_local_only_ffn_handoff_desc(
                     cfg,
                     (u32_t)lid,
@@ -3509,6 +4670,9 @@ namespace aecct {
                     regs.p11av_ffn_handoff_fallback_seen_count + (u32_t)1u;
             }
 
+            // Batched INFER: FFN weights are read in place from W_REGION.
+            top_batch_ffn_bind_in_place(regs, sram, pb, (u32_t)lid, ffn_topfed_handoff_desc);
+
             bool attn_out_topfed_payload_enable_for_layer = false;
             const u32_t* attn_out_topfed_payload_words_for_layer = 0;
             u32_t attn_out_topfed_payload_words_valid_for_layer = (u32_t)0u;
@@ -3576,6 +4740,11 @@ namespace aecct {
                 }
             }
             // Dispatch boundary: pass policy and descriptors through without changing ownership rules.
+            // Fused tail only when the next layer runs managed attention (its Q/K/V builders are replaced).
+            TransformerLayerNextQkvFuseDesc next_qkv_fuse = top_make_ln_qkv_fuse_desc(
+                regs, lid, n_layers, mid_index, managed_attn_target_layer, x_in_base);
+            const bool qkv_from_fused_tail = next_layer_qkv_prebuilt;
+            next_layer_qkv_prebuilt = false;
             top_dispatch_transformer_layer_top_managed_attn_bridge(
                 sram,
                 cfg,
@@ -3592,26 +4761,39 @@ namespace aecct {
                 ffn_topfed_handoff_desc,
                 attn_out_topfed_payload_enable_for_layer,
                 attn_out_topfed_payload_words_for_layer,
-                attn_out_topfed_payload_words_valid_for_layer
+                attn_out_topfed_payload_words_valid_for_layer,
+                next_qkv_fuse.enable ? &next_qkv_fuse : 0,
+                qkv_from_fused_tail
             );
+            if (next_qkv_fuse.done) {
+                regs.ln_qkv_fused_layer_count = regs.ln_qkv_fused_layer_count + (u32_t)1u;
+                next_layer_qkv_prebuilt = next_qkv_fuse.qkv_done;
+            }
 
             x_in_base = x_out_base;
             x_out_base = alternate_x_page(x_in_base);
 
             if ((int)lid == mid_index) {
-                run_mid_or_end_layernorm(
-                    true,
-                    cfg,
-                    sram,
-                    regs.w_base_word,
-                    x_in_base,
-                    x_out_base,
-                    &regs.layernorm_contract
-                );
-                x_in_base = x_out_base;
-                x_out_base = alternate_x_page(x_in_base);
+                if (next_qkv_fuse.done && next_qkv_fuse.mid_norm_enable) {
+                    // Fused tail already wrote the mid LN output page and snapshot.
+                    top_commit_fused_mid_layernorm(cfg, x_in_base, next_qkv_fuse, regs.layernorm_contract);
+                    x_in_base = x_out_base;
+                    x_out_base = alternate_x_page(x_in_base);
+                } else {
+                    run_mid_or_end_layernorm(
+                        true,
+                        cfg,
+                        sram,
+                        regs.w_base_word,
+                        x_in_base,
+                        x_out_base,
+                        &regs.layernorm_contract
+                    );
+                    x_in_base = x_out_base;
+                    x_out_base = alternate_x_page(x_in_base);
 
-                copy_x_words(mid_snapshot, &sram[(uint32_t)x_in_base.to_uint()], (uint32_t)LN_X_TOTAL_WORDS);
+                    copy_x_words(mid_snapshot, &sram[(uint32_t)x_in_base.to_uint()], (uint32_t)LN_X_TOTAL_WORDS);
+                }
                 mid_valid = true;
             }
         }
@@ -3685,7 +4867,8 @@ namespace aecct {
     static inline bool run_infer_pipeline_finalize(
         TopRegs& regs,
         u32_t* sram,
-        ac_channel<ac_int<32, false> >& data_out
+        ac_channel<ac_int<32, false> >& data_out,
+        const u32_t* y_words
     ) {
         HeadParamBase hp = make_head_param_base(regs.w_base_word);
         const u32_t outmode = regs.outmode;
@@ -3723,7 +4906,7 @@ namespace aecct {
             sram,
             layer_cfg,
             regs.infer_final_x_base_word,
-            infer_label_words_view(regs, sram),
+            y_words,
             regs.infer_logits_base_word,
             regs.infer_xpred_base_word,
             hp,
@@ -3734,15 +4917,92 @@ namespace aecct {
         );
         contract.done = true;
         const uint32_t mode = (uint32_t)outmode.to_uint();
+#ifndef __SYNTHESIS__
+        top_perf_account_final_head(
+            token_end - token_begin,
+            (uint32_t)EXP_LEN_OUT_LOGITS_WORDS,
+            (mode == (uint32_t)FINAL_HEAD_OUTMODE_XPRED) ? (uint32_t)OUT_WORDS_X_PRED :
+            (mode == (uint32_t)FINAL_HEAD_OUTMODE_LOGITS) ? (uint32_t)OUT_WORDS_LOGITS : 0u
+        );
+#endif
         return (mode == (uint32_t)FINAL_HEAD_OUTMODE_XPRED) ||
             (mode == (uint32_t)FINAL_HEAD_OUTMODE_LOGITS);
     }
 
+    static inline bool run_infer_pipeline_finalize(
+        TopRegs& regs,
+        u32_t* sram,
+        ac_channel<ac_int<32, false> >& data_out
+    ) {
+        return run_infer_pipeline_finalize(regs, sram, data_out, infer_label_words_view(regs, sram));
+    }
+
+    // True when the hard decision of y satisfies every BCH_H_BITPACK check row.
+    static inline bool infer_syndrome_is_zero(const u32_t* h_words, const u32_t* y_words) {
+        bool y_hard[CODE_N];
+        INFER_SYNDROME_HARD_LOOP: for (uint32_t v = 0u; v < (uint32_t)CODE_N; ++v) {
+            y_hard[v] = (fp32_from_bits(y_words[v]) < fp32_zero());
+        }
+        INFER_SYNDROME_CHECK_LOOP: for (uint32_t c = 0u; c < (uint32_t)CODE_C; ++c) {
+            uint32_t parity = 0u;
+            INFER_SYNDROME_VAR_LOOP: for (uint32_t v = 0u; v < (uint32_t)CODE_N; ++v) {
+                const uint32_t bit = c * (uint32_t)CODE_N + v;
+                const uint32_t h_word = (uint32_t)h_words[bit >> 5].to_uint();
+                if (((h_word >> (bit & 31u)) & 1u) != 0u && y_hard[v]) {
+                    parity ^= 1u;
+                }
+            }
+            if (parity != 0u) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static inline bool infer_early_exit_check(const TopRegs& regs, const u32_t* y_words) {
+        if (!regs.infer_early_exit_enable || !regs.infer_syndrome_h_valid) {
+            return false;
+        }
+        return infer_syndrome_is_zero(regs.infer_syndrome_h_words, y_words);
+    }
+
+    // Early-exit write-back: logits = |y| and x_pred = hard(y), which is exactly what
+    // FinalHead's sign test yields for those logits. Top streams them per outmode.
+    static inline void run_infer_early_exit(TopRegs& regs, u32_t* sram, const u32_t* y_words) {
+        const uint32_t logits_base = (uint32_t)regs.infer_logits_base_word.to_uint();
+        const uint32_t xpred_base = (uint32_t)regs.infer_xpred_base_word.to_uint();
+        TOP_EARLY_EXIT_WRITEBACK_LOOP: for (uint32_t c = 0u; c < (uint32_t)OUT_WORDS_LOGITS; ++c) {
+            const u32_t y_bits = y_words[c];
+            sram[logits_base + c] = (u32_t)((uint32_t)y_bits.to_uint() & 0x7FFFFFFFu);
+            if (c < (uint32_t)OUT_WORDS_X_PRED) {
+                const bool hard = (fp32_from_bits(y_bits) < fp32_zero());
+                sram[xpred_base + c] = hard ? bits_from_fp32(fp32_one()) : bits_from_fp32(fp32_zero());
+            }
+        }
+        regs.infer_mid_valid = false;
+        regs.infer_early_exit_count = regs.infer_early_exit_count + 1;
+#ifndef __SYNTHESIS__
+        const uint32_t mode = (uint32_t)regs.outmode.to_uint();
+        top_perf_account_early_exit(
+            (uint32_t)INFER_IN_WORDS_EXPECTED,
+            (uint32_t)H_WORDS_BITPACK,
+            (uint32_t)OUT_WORDS_LOGITS,
+            (mode == (uint32_t)FINAL_HEAD_OUTMODE_XPRED) ? (uint32_t)OUT_WORDS_X_PRED :
+            (mode == (uint32_t)FINAL_HEAD_OUTMODE_LOGITS) ? (uint32_t)OUT_WORDS_LOGITS : 0u
+        );
+#endif
+    }
+
     static inline bool run_infer_pipeline(
         TopRegs& regs,
         u32_t* sram,
         ac_channel<ac_int<32, false> >& data_out
     ) {
+        const u32_t* y_words = infer_label_words_view(regs, sram);
+        if (infer_early_exit_check(regs, y_words)) {
+            run_infer_early_exit(regs, sram, y_words);
+            return false;
+        }
         run_preproc_block(regs, sram);
         run_layernorm_block(regs, sram);
         run_pipeline_transformer_layer_loop_with_local_ffn_handoff(regs, sram);
@@ -3791,8 +5051,80 @@ namespace aecct {
         }
     }
 
+    // Counts one finished batch codeword. Returns true (after DONE) on the last one.
+    static inline bool infer_batch_retire_codeword(
+        TopRegs& regs,
+        ac_channel<ac_int<16, false> >& ctrl_rsp
+    ) {
+        regs.infer_batch_done_count = regs.infer_batch_done_count + 1;
+        const uint32_t done_count = (uint32_t)regs.infer_batch_done_count.to_uint();
+        if (done_count >= (uint32_t)regs.infer_batch_count.to_uint()) {
+            regs.infer_batch_active = false;
+            regs.infer_ovl_enable = false;
+            regs.state = ST_IDLE;
+            ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)OP_INFER_BATCH));
+            return true;
+        }
+
+        // Next batch tile re-fetches its top-fed weight words on first use.
+        if ((done_count % (uint32_t)INFER_BATCH_TILE_CODEWORDS) == 0u) {
+            regs.infer_batch_ln_affine_valid = false;
+        }
+        return false;
+    }
+
+    // Closes one accepted INFER payload after its outputs were streamed.
+    // Single INFER returns to IDLE with DONE(OP_INFER). Batched INFER re-arms the
+    // ingest contract for the next codeword without a response and emits a single
+    // DONE(OP_INFER_BATCH) after the last codeword of the batch.
+    static inline void infer_close_codeword(
+        TopRegs& regs,
+        ac_channel<ac_int<16, false> >& ctrl_rsp
+    ) {
+        if (!regs.infer_batch_active) {
+            regs.state = ST_IDLE;
+            ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)OP_INFER));
+            return;
+        }
+
+        if (infer_batch_retire_codeword(regs, ctrl_rsp)) {
+            return;
+        }
+        infer_session_clear(regs);
+        infer_contract_arm_for_op_infer(regs);
+        regs.state = ST_INFER_RX;
+    }
+
+    // Hands the just-received RX page to the overlapped compute slot and flips
+    // RX to the other IO input page. Compute then advances one stage per call.
+    static inline void infer_ovl_launch(TopRegs& regs) {
+        regs.infer_ovl_compute_contract = regs.infer_ingest_contract;
+        regs.infer_ovl_stage = (u32_t)OVL_STAGE_PREPROC;
+        regs.infer_ovl_launch_count = regs.infer_ovl_launch_count + 1;
+        regs.infer_ovl_rx_full = false;
+        regs.infer_ovl_rx_page = (u32_t)(1u - (uint32_t)regs.infer_ovl_rx_page.to_uint());
+        if ((uint32_t)regs.infer_ovl_rx_codeword_count.to_uint() < (uint32_t)regs.infer_batch_count.to_uint()) {
+            infer_ovl_arm_rx_page(regs);
+        }
+        regs.state = ST_INFER_OVL;
+    }
+
+    // Accepted INFER payload in overlapped mode: launch now if compute is idle,
+    // otherwise hold the full page until the in-flight codeword retires.
+    static inline void infer_ovl_rx_page_done(TopRegs& regs) {
+        regs.infer_ovl_rx_codeword_count = regs.infer_ovl_rx_codeword_count + 1;
+        if ((uint32_t)regs.infer_ovl_stage.to_uint() == (uint32_t)OVL_STAGE_IDLE) {
+            infer_ovl_launch(regs);
+        }
+        else {
+            regs.infer_ovl_rx_full = true;
+            regs.state = ST_INFER_OVL;
+        }
+    }
+
     static inline void infer_ingest_one_word(
         TopRegs& regs,
+        data_ch_t& in_fifo,
         ac_channel<ac_int<32, false> >& data_in,
         ac_channel<ac_int<16, false> >& ctrl_rsp,
         ac_channel<ac_int<32, false> >& data_out,
@@ -3803,6 +5135,7 @@ namespace aecct {
             ingest_meta_expected_words(meta, (uint32_t)INFER_IN_WORDS_EXPECTED);
         if (!ingest_meta_owner_matches_rx(meta, RX_INFER)) {
             regs.state = ST_IDLE;
+            infer_batch_abort(regs);
             ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_STATE));
             return;
         }
@@ -3821,21 +5154,26 @@ namespace aecct {
                 true
             );
             if (commit_diag != (uint8_t)ERR_OK) {
+                infer_batch_abort(regs);
                 ctrl_rsp.write(pack_ctrl_rsp_err(commit_diag));
                 return;
             }
 
             regs.infer_ingest_contract.done = true;
+            if (regs.infer_ovl_enable) {
+                infer_ovl_rx_page_done(regs);
+                return;
+            }
             const bool finalhead_streamed = run_infer_pipeline(regs, sram, data_out);
             if (!finalhead_streamed) {
                 infer_emit_outmode_payload(regs, data_out, sram);
             }
-            ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)OP_INFER));
+            infer_close_codeword(regs, ctrl_rsp);
             return;
         }
 
         u32_t w;
-        if (!top_data_nb_read(data_in, w)) { return; }
+        if (!top_data_nb_read(in_fifo, data_in, w)) { return; }
 
         infer_store_one_word(regs, sram, idx, w);
         regs.input_count = regs.input_count + 1;
@@ -3854,22 +5192,119 @@ namespace aecct {
             );
             if (commit_diag != (uint8_t)ERR_OK) {
                 regs.state = ST_IDLE;
+                infer_batch_abort(regs);
                 ctrl_rsp.write(pack_ctrl_rsp_err(commit_diag));
                 return;
             }
 
             regs.infer_ingest_contract.done = true;
+            if (regs.infer_ovl_enable) {
+                infer_ovl_rx_page_done(regs);
+                return;
+            }
             const bool finalhead_streamed = run_infer_pipeline(regs, sram, data_out);
             if (!finalhead_streamed) {
                 infer_emit_outmode_payload(regs, data_out, sram);
             }
-            regs.state = ST_IDLE;
-            ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)OP_INFER));
+            infer_close_codeword(regs, ctrl_rsp);
+        }
+    }
+
+    // Advances the in-flight overlapped codeword by one compute stage. FinalHead
+    // streams its payload, then the held RX page (if any) is launched at once.
+    static inline void infer_ovl_step_compute(
+        TopRegs& regs,
+        ac_channel<ac_int<16, false> >& ctrl_rsp,
+        ac_channel<ac_int<32, false> >& data_out,
+        u32_t* sram
+    ) {
+        const uint32_t stage = (uint32_t)regs.infer_ovl_stage.to_uint();
+        const uint32_t y_base = (uint32_t)regs.infer_ovl_compute_contract.in_base_word.to_uint();
+        if (stage == (uint32_t)OVL_STAGE_PREPROC) {
+            // A zero-syndrome codeword goes straight to the output stage.
+            regs.infer_ovl_early_exit = infer_early_exit_check(regs, &sram[y_base]);
+            if (regs.infer_ovl_early_exit) {
+                regs.infer_ovl_stage = (u32_t)OVL_STAGE_FINAL_HEAD;
+                return;
+            }
+            run_preproc_block(regs, sram, regs.infer_ovl_compute_contract);
+            regs.infer_ovl_stage = (u32_t)OVL_STAGE_LAYERNORM;
+            return;
         }
+        if (stage == (uint32_t)OVL_STAGE_LAYERNORM) {
+            run_layernorm_block(regs, sram);
+            regs.infer_ovl_stage = (u32_t)OVL_STAGE_LAYER_LOOP;
+            return;
+        }
+        if (stage == (uint32_t)OVL_STAGE_LAYER_LOOP) {
+            run_pipeline_transformer_layer_loop_with_local_ffn_handoff(regs, sram);
+            regs.infer_ovl_stage = (u32_t)OVL_STAGE_FINAL_HEAD;
+            return;
+        }
+        if (stage != (uint32_t)OVL_STAGE_FINAL_HEAD) {
+            return;
+        }
+
+        bool finalhead_streamed = false;
+        if (regs.infer_ovl_early_exit) {
+            run_infer_early_exit(regs, sram, &sram[y_base]);
+            regs.infer_ovl_early_exit = false;
+        } else {
+            finalhead_streamed = run_infer_pipeline_finalize(regs, sram, data_out, &sram[y_base]);
+        }
+        if (!finalhead_streamed) {
+            infer_emit_outmode_payload(regs, data_out, sram);
+        }
+        regs.infer_ovl_stage = (u32_t)OVL_STAGE_IDLE;
+        if (infer_batch_retire_codeword(regs, ctrl_rsp)) {
+            return;
+        }
+        if (regs.infer_ovl_rx_full) {
+            infer_ovl_launch(regs);
+        }
+        else {
+            regs.state = ST_INFER_RX;
+        }
+    }
+
+    // ST_INFER_OVL service: drain the RX words already waiting on data_in (up to
+    // INFER_OVL_RX_WORDS_PER_STAGE) into the free IO input page, then advance the
+    // in-flight codeword by one compute stage in the same call.
+    static inline void infer_ovl_service(
+        TopRegs& regs,
+        data_ch_t& in_fifo,
+        ac_channel<ac_int<32, false> >& data_in,
+        ac_channel<ac_int<16, false> >& ctrl_rsp,
+        ac_channel<ac_int<32, false> >& data_out,
+        u32_t* sram
+    ) {
+        if ((uint32_t)regs.infer_ovl_rx_codeword_count.to_uint() < (uint32_t)regs.infer_batch_count.to_uint()) {
+            if (regs.infer_ovl_rx_full) {
+                regs.infer_ovl_rx_stall_count = regs.infer_ovl_rx_stall_count + 1;
+            }
+            else {
+                INFER_OVL_RX_DRAIN_LOOP: for (uint32_t n = 0u; n < (uint32_t)INFER_OVL_RX_WORDS_PER_STAGE; ++n) {
+                    const uint32_t words_before = (uint32_t)regs.input_count.to_uint();
+                    infer_ingest_one_word(regs, in_fifo, data_in, ctrl_rsp, data_out, sram);
+                    if (regs.state != ST_INFER_OVL) {
+                        return;
+                    }
+                    if ((uint32_t)regs.input_count.to_uint() == words_before && !regs.infer_ovl_rx_full) {
+                        break;
+                    }
+                    regs.infer_ovl_rx_overlapped_word_count = regs.infer_ovl_rx_overlapped_word_count + 1;
+                    if (regs.infer_ovl_rx_full) {
+                        break;
+                    }
+                }
+            }
+        }
+        infer_ovl_step_compute(regs, ctrl_rsp, data_out, sram);
     }
 
     static inline void handle_read_mem(
         TopRegs& regs,
+        data_ch_t& in_fifo,
         ac_channel<ac_int<16, false> >& ctrl_rsp,
         ac_channel<ac_int<32, false> >& data_in,
         ac_channel<ac_int<32, false> >& data_out,
@@ -3877,8 +5312,8 @@ namespace aecct {
     ) {
         // Debug read-back path owned by Top. This does not transfer SRAM ownership.
         // READ_MEM payload: addr_word then len_words, both in u32 words.
-        u32_t addr_word_in = top_data_read(data_in);
-        u32_t len_words_in = top_data_read(data_in);
+        u32_t addr_word_in = top_data_read(in_fifo, data_in);
+        u32_t len_words_in = top_data_read(in_fifo, data_in);
 
         MemReq req = make_empty_mem_req();
         req.valid = true;
@@ -3919,15 +5354,17 @@ namespace aecct {
     // 1) ST_IDLE command decode
     // 2) RX-state payload ingestion (CFG / PARAM / INFER)
     // 3) HALTED / READ_MEM / debug side paths
+    // All state lives in ctx; nothing here touches top_context().
     static inline void top(
+        TopContext& ctx,
         ac_channel<ac_int<16, false> >& ctrl_cmd,
         ac_channel<ac_int<16, false> >& ctrl_rsp,
         ac_channel<ac_int<32, false> >& data_in,
         ac_channel<ac_int<32, false> >& data_out
     ) {
-        TopRegs& regs = top_regs();
-        u32_t* sram = top_sram();
-        (void)top_in_fifo(); // Ensure in_fifo exists in Top contract.
+        TopRegs& regs = ctx.regs;
+        u32_t* sram = top_context_sram(ctx);
+        data_ch_t& in_fifo = ctx.in_fifo;
         (void)mem_arb_grant_one(regs); // Deterministic arbiter stub step.
         refresh_receiver_state(regs);
 
@@ -3954,7 +5391,7 @@ namespace aecct {
                     ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_STATE));
                 }
                 else if (op == (uint8_t)OP_SET_W_BASE) {
-                    u32_t w_base_in = top_data_read(data_in);
+                    u32_t w_base_in = top_data_read(in_fifo, data_in);
                     uint32_t w_base_word = (uint32_t)w_base_in.to_uint();
 
                     if (!is_param_base_in_w_region(w_base_word)) {
@@ -3964,26 +5401,55 @@ namespace aecct {
                         ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_PARAM_BASE_ALIGN));
                     }
                     else {
+                        if (!regs.w_base_set || w_base_word != (uint32_t)regs.w_base_word.to_uint()) {
+                            param_slot_select(regs, sram, w_base_word);
+                            param_slot_table_publish(regs, sram);
+                        }
                         regs.w_base_set = true;
                         regs.w_base_word = w_base_in;
                         ctrl_rsp.write(pack_ctrl_rsp_ok((uint8_t)OP_SET_W_BASE));
                     }
                 }
-                else if (op == (uint8_t)OP_LOAD_W) {
+                else if (op == (uint8_t)OP_LOAD_W || op == (uint8_t)OP_LOAD_W_EX) {
+                    // LOAD_W_EX payload: flags word, then the PARAM stream.
+                    uint32_t arg = 0u;
+                    if (op == (uint8_t)OP_LOAD_W_EX) {
+                        arg = (uint32_t)top_data_read(in_fifo, data_in).to_uint();
+                    }
                     if (!regs.w_base_set) {
                         ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_STATE));
                     }
+                    else if (!is_valid_load_w_arg(arg)) {
+                        ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_ARG));
+                    }
                     else if (!param_ingest_span_legal(regs)) {
                         ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_MEM_RANGE));
                     }
                     else {
+                        regs.param_rx_opcode = (u32_t)op;
+                        regs.param_stream_check_enable = load_w_arg_bit(arg, LOAD_W_ARG_STRICT_BIT);
+                        regs.param_stream_repack_enable = load_w_arg_bit(arg, LOAD_W_ARG_REPACK_BIT);
+                        regs.param_stream_compressed_enable = load_w_arg_bit(arg, LOAD_W_ARG_COMPRESSED_BIT);
                         regs.state = ST_PARAM_RX;
                         param_session_clear(regs);
-                        ctrl_rsp.write(pack_ctrl_rsp_ok((uint8_t)OP_LOAD_W));
+                        param_stream_check_clear(regs.param_check);
+                        param_stream_decode_clear(regs.param_decode);
+                        if (regs.param_stream_repack_enable) {
+                            ternary_row_mask_cache_clear(regs.w_row_cache);
+                        } else {
+                            ternary_row_mask_cache_invalidate(regs.w_row_cache);
+                        }
+                        regs.attn_mask_csr_valid = false;
+                        regs.attn_mask_bits_valid = false;
+                        regs.attn_ring_bitmap_valid = false;
+                        regs.infer_syndrome_h_valid = false;
+                        param_slot_invalidate_span(regs, (uint32_t)regs.w_base_word.to_uint());
+                        param_slot_table_publish(regs, sram);
+                        ctrl_rsp.write(pack_ctrl_rsp_ok(op));
                     }
                 }
                 else if (op == (uint8_t)OP_SET_OUTMODE) {
-                    u32_t outmode_in = top_data_read(data_in);
+                    u32_t outmode_in = top_data_read(in_fifo, data_in);
                     uint32_t outmode = (uint32_t)outmode_in.to_uint();
                     if (!is_valid_outmode(outmode)) {
                         ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_ARG));
@@ -3994,10 +5460,11 @@ namespace aecct {
                     }
                 }
                 else if (op == (uint8_t)OP_INFER) {
-                    if (!regs.cfg_ready) {
+                    if (!regs.cfg_ready || regs.param_image_rejected) {
                         ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_STATE));
                     }
                     else {
+                        infer_batch_session_clear(regs);
                         infer_session_clear(regs);
                         infer_contract_arm_for_op_infer(regs);
                         const IngestMetadataSurface infer_meta = infer_metadata_surface(regs);
@@ -4009,11 +5476,43 @@ namespace aecct {
                         }
                     }
                 }
+                else if (op == (uint8_t)OP_INFER_BATCH) {
+                    // INFER_BATCH payload: arg word, then count x INFER payloads.
+                    u32_t arg_in = top_data_read(in_fifo, data_in);
+                    uint32_t arg = (uint32_t)arg_in.to_uint();
+                    if (!regs.cfg_ready || regs.param_image_rejected) {
+                        ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_STATE));
+                    }
+                    else if (!is_valid_infer_batch_arg(arg)) {
+                        ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_ARG));
+                    }
+                    else {
+                        infer_batch_session_clear(regs);
+                        regs.infer_ovl_enable = infer_batch_arg_overlap(arg);
+                        if (regs.infer_ovl_enable) {
+                            infer_ovl_arm_rx_page(regs);
+                        }
+                        else {
+                            infer_session_clear(regs);
+                            infer_contract_arm_for_op_infer(regs);
+                        }
+                        const IngestMetadataSurface infer_meta = infer_metadata_surface(regs);
+                        if (!ingest_meta_span_in_sram(infer_meta, (uint32_t)INFER_IN_WORDS_EXPECTED)) {
+                            infer_batch_abort(regs);
+                            ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_MEM_RANGE));
+                        } else {
+                            regs.infer_batch_active = true;
+                            regs.infer_batch_count = (u32_t)infer_batch_arg_count(arg);
+                            regs.state = ST_INFER_RX;
+                            ctrl_rsp.write(pack_ctrl_rsp_ok((uint8_t)OP_INFER_BATCH));
+                        }
+                    }
+                }
                 else if (op == (uint8_t)OP_READ_MEM) {
-                    handle_read_mem(regs, ctrl_rsp, data_in, data_out, sram);
+                    handle_read_mem(regs, in_fifo, ctrl_rsp, data_in, data_out, sram);
                 }
                 else if (op == (uint8_t)OP_DEBUG_CFG) {
-                    handle_debug_cfg_idle(regs, ctrl_rsp, data_in);
+                    handle_debug_cfg_idle(regs, in_fifo, ctrl_rsp, data_in);
                 }
                 else {
                     ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_UNIMPL));
@@ -4075,7 +5574,7 @@ namespace aecct {
                     ctrl_rsp.write(pack_ctrl_rsp_err((uint8_t)ERR_BAD_STATE));
                 }
             }
-            else if (regs.state == ST_INFER_RX) {
+            else if (regs.state == ST_INFER_RX || regs.state == ST_INFER_OVL) {
                 if (op == (uint8_t)OP_SOFT_RESET) {
                     soft_reset_all(regs, sram);
                     ctrl_rsp.write(pack_ctrl_rsp_done((uint8_t)OP_SOFT_RESET));
@@ -4089,10 +5588,10 @@ namespace aecct {
             }
             else if (regs.state == ST_HALTED) {
                 if (op == (uint8_t)OP_READ_MEM) {
-                    handle_read_mem(regs, ctrl_rsp, data_in, data_out, sram);
+                    handle_read_mem(regs, in_fifo, ctrl_rsp, data_in, data_out, sram);
                 }
                 else if (op == (uint8_t)OP_DEBUG_CFG) {
-                    handle_debug_cfg_halted(regs, ctrl_rsp, data_in);
+                    handle_debug_cfg_halted(regs, in_fifo, ctrl_rsp, data_in);
                 }
                 else if (op == (uint8_t)OP_SOFT_RESET) {
                     soft_reset_all(regs, sram);
@@ -4112,16 +5611,29 @@ namespace aecct {
         else {
             // No command this cycle: service one payload word for the active RX state.
             if (regs.state == ST_CFG_RX && !regs.cfg_ready) {
-                cfg_ingest_one_word(regs, data_in);
+                cfg_ingest_one_word(regs, in_fifo, data_in);
             }
             else if (regs.state == ST_PARAM_RX) {
-                param_ingest_one_word(regs, data_in, ctrl_rsp, data_out, sram);
+                param_ingest_one_word(regs, in_fifo, data_in, ctrl_rsp, data_out, sram);
             }
             else if (regs.state == ST_INFER_RX) {
-                infer_ingest_one_word(regs, data_in, ctrl_rsp, data_out, sram);
+                infer_ingest_one_word(regs, in_fifo, data_in, ctrl_rsp, data_out, sram);
+            }
+            else if (regs.state == ST_INFER_OVL) {
+                infer_ovl_service(regs, in_fifo, data_in, ctrl_rsp, data_out, sram);
             }
         }
         refresh_receiver_state(regs);
     }
 
+    // Default-instance entrypoint: the external 4-channel contract on top_context().
+    static inline void top(
+        ac_channel<ac_int<16, false> >& ctrl_cmd,
+        ac_channel<ac_int<16, false> >& ctrl_rsp,
+        ac_channel<ac_int<32, false> >& data_in,
+        ac_channel<ac_int<32, false> >& data_out
+    ) {
+        top(top_context(), ctrl_cmd, ctrl_rsp, data_in, data_out);
+    }
+
 } // namespace aecct
@@ -0,0 +1,427 @@
+#pragma once
+// Host-only performance accounting for Top (compiled out under __SYNTHESIS__).
+// Top charges SRAM read/write, MAC, LUT and channel word counts per PhaseId and
+// per attention subphase at each block dispatch. Phase-B (score / softmax / P*V)
+// is charged per query row at the AE/AF seam Top actually took, from the number of
+// (key, head) pairs the kernel visited, so sparse, bitmap and fused paths show up
+// as such; the rest is the logical work of the dispatched shape. TopPerfCostModel
+// turns the counts into approximate cycles so two architectural variants (ports,
+// lanes, overlap, HEAD_PAR) can be compared from one C++ run.
+
+#ifndef __SYNTHESIS__
+
+#include <cstdint>
+#include <cstdio>
+
+#include "AecctProtocol.h"
+
+namespace aecct {
+
+    enum TopPerfSubphase : unsigned {
+        PERF_SUB_BLOCK = 0u,    // whole-block phases: preproc, LN, final head
+        PERF_SUB_Q = 1u,
+        PERF_SUB_K = 2u,
+        PERF_SUB_V = 3u,
+        PERF_SUB_SCORE = 4u,
+        PERF_SUB_SOFTMAX = 5u,  // split AF: softmax and P*V
+        PERF_SUB_OUT = 6u,      // WO projection and attention residual
+        PERF_SUB_FFN = 7u,      // sublayer LN, W1, ReLU, W2 and FFN residual
+        PERF_SUB_FUSED = 8u,    // fused AE+AF: score, online softmax and P*V in one key pass
+        PERF_SUB_COUNT = 9u
+    };
+
+    static const unsigned PERF_PHASE_COUNT = (unsigned)PHASE_FINAL_HEAD + 1u;
+    static const uint32_t PERF_TERNARY_CODES_PER_WORD = 16u;
+
+    struct TopPerfCounts {
+        uint64_t calls;
+        uint64_t sram_rd;
+        uint64_t sram_wr;
+        uint64_t mac;
+        uint64_t lut;
+        uint64_t ch_in;
+        uint64_t ch_out;
+        // Dependent steps (one online-softmax key update each); a latency floor.
+        uint64_t steps;
+
+        void clear() {
+            calls = 0u;
+            sram_rd = 0u;
+            sram_wr = 0u;
+            mac = 0u;
+            lut = 0u;
+            ch_in = 0u;
+            ch_out = 0u;
+            steps = 0u;
+        }
+
+        void add(const TopPerfCounts& o) {
+            calls += o.calls;
+            sram_rd += o.sram_rd;
+            sram_wr += o.sram_wr;
+            mac += o.mac;
+            lut += o.lut;
+            ch_in += o.ch_in;
+            ch_out += o.ch_out;
+            steps += o.steps;
+        }
+    };
+
+    struct TopPerfCounters {
+        TopPerfCounts cell[PERF_PHASE_COUNT][PERF_SUB_COUNT];
+
+        void clear() {
+            for (unsigned p = 0u; p < PERF_PHASE_COUNT; ++p) {
+                for (unsigned s = 0u; s < (unsigned)PERF_SUB_COUNT; ++s) {
+                    cell[p][s].clear();
+                }
+            }
+        }
+    };
+
+    // Throughput per cycle of each resource; zero is treated as one.
+    // overlap_units=true: a subphase costs its slowest resource (fully pipelined units).
+    // overlap_units=false: a subphase costs the sum of all resources (serialized units).
+    // Either way a subphase costs at least its dependent steps.
+    struct TopPerfCostModel {
+        uint32_t sram_rd_ports;
+        uint32_t sram_wr_ports;
+        uint32_t mac_lanes;
+        uint32_t lut_ports;
+        uint32_t ch_in_words_per_cycle;
+        uint32_t ch_out_words_per_cycle;
+        uint32_t call_overhead_cycles;
+        bool overlap_units;
+    };
+
+    // Baseline: single-port SRAM, one MAC lane, one LUT port, one word/cycle channels.
+    static inline TopPerfCostModel make_top_perf_cost_model() {
+        TopPerfCostModel m;
+        m.sram_rd_ports = 1u;
+        m.sram_wr_ports = 1u;
+        m.mac_lanes = 1u;
+        m.lut_ports = 1u;
+        m.ch_in_words_per_cycle = 1u;
+        m.ch_out_words_per_cycle = 1u;
+        m.call_overhead_cycles = 0u;
+        m.overlap_units = true;
+        return m;
+    }
+
+    // One set per host thread, so TopContext instances simulated on separate
+    // threads keep separate counts.
+    static inline TopPerfCounters& top_perf() {
+        static thread_local TopPerfCounters counters;
+        return counters;
+    }
+
+    static inline void top_perf_reset() {
+        top_perf().clear();
+    }
+
+    static inline void top_perf_charge(
+        unsigned phase,
+        TopPerfSubphase sub,
+        uint64_t sram_rd,
+        uint64_t sram_wr,
+        uint64_t mac,
+        uint64_t lut,
+        uint64_t ch_in,
+        uint64_t ch_out
+    ) {
+        if (phase >= PERF_PHASE_COUNT || (unsigned)sub >= (unsigned)PERF_SUB_COUNT) {
+            return;
+        }
+        TopPerfCounts& c = top_perf().cell[phase][(unsigned)sub];
+        c.calls += 1u;
+        c.sram_rd += sram_rd;
+        c.sram_wr += sram_wr;
+        c.mac += mac;
+        c.lut += lut;
+        c.ch_in += ch_in;
+        c.ch_out += ch_out;
+    }
+
+    static inline void top_perf_charge_steps(unsigned phase, TopPerfSubphase sub, uint64_t steps) {
+        if (phase >= PERF_PHASE_COUNT || (unsigned)sub >= (unsigned)PERF_SUB_COUNT) {
+            return;
+        }
+        top_perf().cell[phase][(unsigned)sub].steps += steps;
+    }
+
+    static inline uint64_t top_perf_ceil_div(uint64_t n, uint32_t d) {
+        const uint64_t dd = (d == 0u) ? 1u : (uint64_t)d;
+        return (n + dd - 1u) / dd;
+    }
+
+    static inline uint64_t top_perf_estimate_cycles(const TopPerfCounts& c, const TopPerfCostModel& m) {
+        const uint64_t unit[6] = {
+            top_perf_ceil_div(c.sram_rd, m.sram_rd_ports),
+            top_perf_ceil_div(c.sram_wr, m.sram_wr_ports),
+            top_perf_ceil_div(c.mac, m.mac_lanes),
+            top_perf_ceil_div(c.lut, m.lut_ports),
+            top_perf_ceil_div(c.ch_in, m.ch_in_words_per_cycle),
+            top_perf_ceil_div(c.ch_out, m.ch_out_words_per_cycle)
+        };
+        uint64_t cycles = 0u;
+        for (unsigned i = 0u; i < 6u; ++i) {
+            if (m.overlap_units) {
+                cycles = (unit[i] > cycles) ? unit[i] : cycles;
+            } else {
+                cycles += unit[i];
+            }
+        }
+        if (cycles < c.steps) {
+            cycles = c.steps;
+        }
+        return cycles + c.calls * (uint64_t)m.call_overhead_cycles;
+    }
+
+    static inline TopPerfCounts top_perf_phase_total(const TopPerfCounters& counters, unsigned phase) {
+        TopPerfCounts total;
+        total.clear();
+        if (phase < PERF_PHASE_COUNT) {
+            for (unsigned s = 0u; s < (unsigned)PERF_SUB_COUNT; ++s) {
+                total.add(counters.cell[phase][s]);
+            }
+        }
+        return total;
+    }
+
+    // Subphases inside a phase run back to back, so phase cycles are the sum.
+    static inline uint64_t top_perf_estimate_phase_cycles(
+        const TopPerfCounters& counters,
+        const TopPerfCostModel& m,
+        unsigned phase
+    ) {
+        uint64_t cycles = 0u;
+        if (phase < PERF_PHASE_COUNT) {
+            for (unsigned s = 0u; s < (unsigned)PERF_SUB_COUNT; ++s) {
+                cycles += top_perf_estimate_cycles(counters.cell[phase][s], m);
+            }
+        }
+        return cycles;
+    }
+
+    static inline uint64_t top_perf_estimate_total_cycles(const TopPerfCounters& counters, const TopPerfCostModel& m) {
+        uint64_t cycles = 0u;
+        for (unsigned p = 0u; p < PERF_PHASE_COUNT; ++p) {
+            cycles += top_perf_estimate_phase_cycles(counters, m, p);
+        }
+        return cycles;
+    }
+
+    static inline const char* top_perf_phase_name(unsigned phase) {
+        static const char* const names[PERF_PHASE_COUNT] = {
+            "PREPROC", "LAYER0", "MID_LN", "LAYER1", "END_LN", "FINAL_HEAD"
+        };
+        return (phase < PERF_PHASE_COUNT) ? names[phase] : "?";
+    }
+
+    static inline const char* top_perf_subphase_name(unsigned sub) {
+        static const char* const names[PERF_SUB_COUNT] = {
+            "block", "q", "k", "v", "score", "softmax", "out", "ffn", "fused"
+        };
+        return (sub < (unsigned)PERF_SUB_COUNT) ? names[sub] : "?";
+    }
+
+    static inline void top_perf_print(const TopPerfCounters& counters, const TopPerfCostModel& m) {
+        std::printf("[perf] phase/sub calls sram_rd sram_wr mac lut ch_in ch_out steps est_cycles\n");
+        for (unsigned p = 0u; p < PERF_PHASE_COUNT; ++p) {
+            for (unsigned s = 0u; s < (unsigned)PERF_SUB_COUNT; ++s) {
+                const TopPerfCounts& c = counters.cell[p][s];
+                if (c.calls == 0u) {
+                    continue;
+                }
+                std::printf("[perf] %s/%s %llu %llu %llu %llu %llu %llu %llu %llu %llu\n",
+                    top_perf_phase_name(p), top_perf_subphase_name(s),
+                    (unsigned long long)c.calls, (unsigned long long)c.sram_rd,
+                    (unsigned long long)c.sram_wr, (unsigned long long)c.mac,
+                    (unsigned long long)c.lut, (unsigned long long)c.ch_in,
+                    (unsigned long long)c.ch_out, (unsigned long long)c.steps,
+                    (unsigned long long)top_perf_estimate_cycles(c, m));
+            }
+        }
+        std::printf("[perf] total est_cycles=%llu\n",
+            (unsigned long long)top_perf_estimate_total_cycles(counters, m));
+    }
+
+    // Packed ternary payload words plus the inv_s_w scalar word.
+    static inline uint64_t top_perf_ternary_weight_words(uint32_t rows, uint32_t cols) {
+        return top_perf_ceil_div((uint64_t)rows * cols, PERF_TERNARY_CODES_PER_WORD) + 1u;
+    }
+
+    // INFER payload arrives over data_in; preproc reads it back and writes X_WORK.
+    static inline void top_perf_account_preproc(uint32_t infer_in_words, uint32_t x_out_words) {
+        top_perf_charge((unsigned)PHASE_PREPROC, PERF_SUB_BLOCK,
+            infer_in_words, x_out_words, 0u, 0u, infer_in_words, 0u);
+    }
+
+    // Two passes over X (stats, normalize) plus gamma/beta; mean, variance and affine MACs.
+    // x_in_registers: the rows came from a fused layer tail, so only gamma/beta are read.
+    static inline void top_perf_account_layernorm(
+        unsigned phase,
+        uint32_t tokens,
+        uint32_t d_model,
+        bool x_in_registers = false
+    ) {
+        const uint64_t x = (uint64_t)tokens * d_model;
+        const uint64_t x_reads = x_in_registers ? 0u : 2u * x;
+        top_perf_charge(phase, PERF_SUB_BLOCK, x_reads + 2u * d_model, x, 3u * x, 0u, 0u, 0u);
+    }
+
+    // Phase-B work of one layer, tallied per query row at the seam Top took.
+    // pairs: (key, head) pairs the kernel visited (dense: tokens * n_heads per row).
+    // index_rd: mask words read to enumerate them (CSR row_ptr/col, bitmap rows).
+    // steps: serial online-softmax key updates; HEAD_PAR lanes share one step.
+    struct TopPerfAttnTally {
+        uint64_t score_rows;
+        uint64_t score_pairs;
+        uint64_t score_index_rd;
+        uint64_t softmax_rows;
+        uint64_t softmax_pairs;
+        uint64_t softmax_index_rd;
+        uint64_t fused_rows;
+        uint64_t fused_pairs;
+        uint64_t fused_index_rd;
+        uint64_t fused_steps;
+
+        void clear() {
+            score_rows = 0u;
+            score_pairs = 0u;
+            score_index_rd = 0u;
+            softmax_rows = 0u;
+            softmax_pairs = 0u;
+            softmax_index_rd = 0u;
+            fused_rows = 0u;
+            fused_pairs = 0u;
+            fused_index_rd = 0u;
+            fused_steps = 0u;
+        }
+    };
+
+    static inline void top_perf_tally_score(TopPerfAttnTally& t, uint32_t pairs, uint32_t index_rd) {
+        t.score_rows += 1u;
+        t.score_pairs += pairs;
+        t.score_index_rd += index_rd;
+    }
+
+    static inline void top_perf_tally_softmax(TopPerfAttnTally& t, uint32_t pairs, uint32_t index_rd) {
+        t.softmax_rows += 1u;
+        t.softmax_pairs += pairs;
+        t.softmax_index_rd += index_rd;
+    }
+
+    static inline void top_perf_tally_fused(
+        TopPerfAttnTally& t, uint32_t pairs, uint32_t index_rd, uint32_t steps) {
+        t.fused_rows += 1u;
+        t.fused_pairs += pairs;
+        t.fused_index_rd += index_rd;
+        t.fused_steps += steps;
+    }
+
+    // One call per subphase per layer. Q stays in registers per row and every pair
+    // reads a d_head slice of K (score) and of V (P*V). Split AE writes its scores to
+    // SCR and AF reads them back; fused keeps them in registers. Softmax/P*V writes the
+    // pre-WO head row plus the running max/sum scratch. One exp per pair and one
+    // reciprocal per (row, head). Split AF updates one key per step.
+    static inline void top_perf_commit_attn_tally(
+        unsigned phase,
+        const TopPerfAttnTally& t,
+        uint32_t d_model,
+        uint32_t n_heads
+    ) {
+        const uint64_t d_head = (n_heads == 0u) ? 0u : (uint64_t)(d_model / n_heads);
+        if (t.score_rows != 0u) {
+            top_perf_charge(phase, PERF_SUB_SCORE,
+                t.score_rows * d_model + t.score_pairs * d_head + t.score_index_rd,
+                t.score_pairs, t.score_pairs * d_head, 0u, 0u, 0u);
+        }
+        if (t.softmax_rows != 0u) {
+            top_perf_charge(phase, PERF_SUB_SOFTMAX,
+                t.softmax_pairs + t.softmax_pairs * d_head + t.softmax_index_rd,
+                3u * t.softmax_rows * d_model, t.softmax_pairs * d_head,
+                t.softmax_pairs + t.softmax_rows * n_heads, 0u, 0u);
+            top_perf_charge_steps(phase, PERF_SUB_SOFTMAX, t.softmax_pairs);
+        }
+        if (t.fused_rows != 0u) {
+            top_perf_charge(phase, PERF_SUB_FUSED,
+                t.fused_rows * d_model + 2u * t.fused_pairs * d_head + t.fused_index_rd,
+                3u * t.fused_rows * d_model, 2u * t.fused_pairs * d_head,
+                t.fused_pairs + t.fused_rows * n_heads, 0u, 0u);
+            top_perf_charge_steps(phase, PERF_SUB_FUSED, t.fused_steps);
+        }
+    }
+
+    // attn_score_by_top / attn_softmax_by_top: Top ran that half of Phase-B row by row
+    // and commits its own tally; otherwise the block computed it densely over every
+    // (query, key, head).
+    static inline void top_perf_account_layer(
+        uint32_t layer_id,
+        uint32_t tokens,
+        uint32_t d_model,
+        uint32_t n_heads,
+        uint32_t d_ffn,
+        bool ln_tail_fused = false,
+        bool qkv_x_in_registers = false,
+        bool attn_score_by_top = false,
+        bool attn_softmax_by_top = false
+    ) {
+        const unsigned phase = (layer_id == 0u) ? (unsigned)PHASE_LAYER0 : (unsigned)PHASE_LAYER1;
+        const uint64_t x = (uint64_t)tokens * d_model;
+        const uint64_t h = (uint64_t)tokens * d_ffn;
+        const uint64_t proj_w = top_perf_ternary_weight_words(d_model, d_model);
+        const uint64_t ffn_w =
+            (top_perf_ternary_weight_words(d_ffn, d_model) + d_ffn) +
+            (top_perf_ternary_weight_words(d_model, d_ffn) + d_model);
+
+        // Q/K/V built by the previous layer's fused tail take X from that tail's register row.
+        const uint64_t qkv_x = qkv_x_in_registers ? 0u : x;
+        // Fused tail: the residual sum is not written back and LayerNorm does not re-read it.
+        const uint64_t tail_x_reads = ln_tail_fused ? 0u : 2u * x;
+        const uint64_t tail_x_writes = ln_tail_fused ? 0u : x;
+
+        top_perf_charge(phase, PERF_SUB_Q, qkv_x + proj_w, x, x * d_model, 0u, 0u, 0u);
+        top_perf_charge(phase, PERF_SUB_K, qkv_x + proj_w, x, x * d_model, 0u, 0u, 0u);
+        top_perf_charge(phase, PERF_SUB_V, qkv_x + proj_w, x, x * d_model, 0u, 0u, 0u);
+        TopPerfAttnTally dense;
+        dense.clear();
+        for (uint32_t t = 0u; t < tokens; ++t) {
+            if (!attn_score_by_top) {
+                top_perf_tally_score(dense, tokens * n_heads, 0u);
+            }
+            if (!attn_softmax_by_top) {
+                top_perf_tally_softmax(dense, tokens * n_heads, 0u);
+            }
+        }
+        top_perf_commit_attn_tally(phase, dense, d_model, n_heads);
+        top_perf_charge(phase, PERF_SUB_OUT, x + proj_w + x, 2u * x, x * d_model, 0u, 0u, 0u);
+        top_perf_charge(phase, PERF_SUB_FFN,
+            (tail_x_reads + 2u * d_model) + x + h + h + ffn_w + 2u * x,
+            x + h + h + x + tail_x_writes,
+            3u * x + x * d_ffn + h * d_model,
+            0u, 0u, 0u);
+    }
+
+    // Pass A copies token scalars; pass B reduces OUT_FC per class and streams the outmode payload.
+    static inline void top_perf_account_final_head(uint32_t tokens, uint32_t logits_words, uint32_t out_words) {
+        const uint64_t fc = (uint64_t)logits_words * tokens;
+        top_perf_charge((unsigned)PHASE_FINAL_HEAD, PERF_SUB_BLOCK,
+            tokens + logits_words + fc, tokens + 2u * logits_words, fc, 0u, 0u, out_words);
+    }
+
+    // Zero-syndrome early exit: y plus the H bitpack are read once; logits and x_pred are
+    // written directly and the outmode payload streams without any layer or FinalHead work.
+    static inline void top_perf_account_early_exit(
+        uint32_t infer_in_words,
+        uint32_t h_words,
+        uint32_t logits_words,
+        uint32_t out_words
+    ) {
+        top_perf_charge((unsigned)PHASE_PREPROC, PERF_SUB_BLOCK,
+            infer_in_words + h_words, 2u * (uint64_t)logits_words, 0u, 0u, infer_in_words, out_words);
+    }
+
+} // namespace aecct
+
+#endif // __SYNTHESIS__
@@ -10,6 +10,7 @@
 #include "AecctTypes.h"
 #include "AecctUtil.h"
 #include "AttnDescBringup.h"
+#include "HostSimdMac.h"
 #include "QuantDesc.h"
 #include "SoftmaxApprox.h"
 #include "TernaryLinearLive.h"
@@ -534,6 +535,19 @@ static inline void AttnLayer0CoreWindow(
                     quant_acc_t dot = 0;
                     uint32_t q_row = q_base + t * d_model + head_col_base;
                     uint32_t k_row = k_base + j * d_model + head_col_base;
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+                    if (d_head <= HOST_SIMD_TILE_MAX) {
+                        u32_t simd_q_words[HOST_SIMD_TILE_MAX];
+                        u32_t simd_k_words[HOST_SIMD_TILE_MAX];
+                        for (uint32_t d = 0; d < d_head; ++d) {
+                            simd_q_words[d] = sram[q_row + d];
+                            simd_k_words[d] = sram[k_row + d];
+                        }
+                        score_row[j] = softmax_score_t(
+                            host_simd_dot_act(simd_q_words, simd_k_words, d_head, dot) * inv_sqrt_d_head);
+                        continue;
+                    }
+#endif
                     ATTN_SCORE_DOT_COL_LOOP: for (uint32_t d = 0; d < d_head; ++d) {
                         quant_act_t qv = quant_act_from_bits(sram[q_row + d]);
                         quant_act_t kv = quant_act_from_bits(sram[k_row + d]);
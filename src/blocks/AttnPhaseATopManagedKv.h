@@ -499,7 +499,8 @@ static inline bool attn_phasea_top_managed_kv_mainline(
     u32_t phase_entry_probe_x_words_valid = (u32_t)0u,
     u32_t* phase_entry_probe_visible = 0,
     u32_t* phase_entry_probe_owner_ok = 0,
-    u32_t* phase_entry_probe_compare_ok = 0
+    u32_t* phase_entry_probe_compare_ok = 0,
+    const TernaryRowMaskCache* row_cache = 0
 ) {
     // Mainline posture: start in fallback state and clear probe outputs until validation succeeds.
     fallback_taken = true;
@@ -567,16 +568,25 @@ static inline bool attn_phasea_top_managed_kv_mainline(
     const uint32_t wk_inv_addr = param_base + wk_inv_meta.offset_w;
     const uint32_t wv_inv_addr = param_base + wv_inv_meta.offset_w;
 
+    // Row cache hit: WK/WV rows were decoded once after LOAD_W, so skip the payload fetch.
+    const bool kv_row_cache_hit =
+        (row_cache != 0) &&
+        ternary_row_mask_cache_ready(*row_cache, param_base_word, QLM_L0_WK) &&
+        ternary_row_mask_cache_ready(*row_cache, param_base_word, QLM_L0_WV);
     u32_t wk_payload_words[kTernaryLiveL0WkPayloadWords];
     u32_t wv_payload_words[kTernaryLiveL0WvPayloadWords];
-    for (uint32_t i = 0u; i < wk_meta.payload_words_2b; ++i) {
-        wk_payload_words[i] = sram[wk_payload_base + i];
-    }
-    for (uint32_t i = 0u; i < wv_meta.payload_words_2b; ++i) {
-        wv_payload_words[i] = sram[wv_payload_base + i];
+    u32_t wk_inv_sw_bits = (u32_t)0u;
+    u32_t wv_inv_sw_bits = (u32_t)0u;
+    if (!kv_row_cache_hit) {
+        for (uint32_t i = 0u; i < wk_meta.payload_words_2b; ++i) {
+            wk_payload_words[i] = sram[wk_payload_base + i];
+        }
+        for (uint32_t i = 0u; i < wv_meta.payload_words_2b; ++i) {
+            wv_payload_words[i] = sram[wv_payload_base + i];
+        }
+        wk_inv_sw_bits = sram[wk_inv_addr];
+        wv_inv_sw_bits = sram[wv_inv_addr];
     }
-    const u32_t wk_inv_sw_bits = sram[wk_inv_addr];
-    const u32_t wv_inv_sw_bits = sram[wv_inv_addr];
 
     const uint32_t x_base = (uint32_t)x_in_base_word.to_uint();
     const uint32_t k_base = (uint32_t)sc.k_base_word.to_uint();
@@ -659,7 +669,18 @@ static inline bool attn_phasea_top_managed_kv_mainline(
         u32_t k_out[kTernaryLiveL0WkRows];
         u32_t k_out_act_q[kTernaryLiveL0WkRows];
         u32_t k_out_inv_sw_bits = (u32_t)0u;
-        if (!ternary_live_l0_wk_materialize_row_kernel_split(
+        if (kv_row_cache_hit) {
+            if (!ternary_live_qkv_materialize_row_kernel_cached(
+                    *row_cache,
+                    param_base_word,
+                    QLM_L0_WK,
+                    x_row,
+                    k_out,
+                    k_out_act_q,
+                    k_out_inv_sw_bits)) {
+                return false;
+            }
+        } else if (!ternary_live_l0_wk_materialize_row_kernel_split(
                 x_row,
                 wk_payload_words,
                 wk_inv_sw_bits,
@@ -672,7 +693,18 @@ static inline bool attn_phasea_top_managed_kv_mainline(
         u32_t v_out[kTernaryLiveL0WvRows];
         u32_t v_out_act_q[kTernaryLiveL0WvRows];
         u32_t v_out_inv_sw_bits = (u32_t)0u;
-        if (!ternary_live_l0_wv_materialize_row_kernel_split(
+        if (kv_row_cache_hit) {
+            if (!ternary_live_qkv_materialize_row_kernel_cached(
+                    *row_cache,
+                    param_base_word,
+                    QLM_L0_WV,
+                    x_row,
+                    v_out,
+                    v_out_act_q,
+                    v_out_inv_sw_bits)) {
+                return false;
+            }
+        } else if (!ternary_live_l0_wv_materialize_row_kernel_split(
                 x_row,
                 wv_payload_words,
                 wv_inv_sw_bits,
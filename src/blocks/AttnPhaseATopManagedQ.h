@@ -374,7 +374,8 @@ static inline bool attn_phasea_top_managed_q_mainline(
     u32_t phase_entry_probe_x_words_valid = (u32_t)0u,
     u32_t* phase_entry_probe_visible = 0,
     u32_t* phase_entry_probe_owner_ok = 0,
-    u32_t* phase_entry_probe_compare_ok = 0
+    u32_t* phase_entry_probe_compare_ok = 0,
+    const TernaryRowMaskCache* row_cache = 0
 ) {
     // Mainline posture: fallback is true until every validation and write-back step succeeds.
     fallback_taken = true;
@@ -434,11 +435,17 @@ static inline bool attn_phasea_top_managed_q_mainline(
     const uint32_t wq_payload_base = param_base + wq_payload_meta.offset_w;
     const uint32_t wq_inv_addr = param_base + wq_inv_meta.offset_w;
 
+    // Row cache hit: WQ rows were decoded once after LOAD_W, so skip the payload fetch.
+    const bool wq_row_cache_hit =
+        (row_cache != 0) && ternary_row_mask_cache_ready(*row_cache, param_base_word, QLM_L0_WQ);
     u32_t wq_payload_words[kTernaryLiveL0WqPayloadWords];
-    for (uint32_t i = 0u; i < wq_meta.payload_words_2b; ++i) {
-        wq_payload_words[i] = sram[wq_payload_base + i];
+    u32_t wq_inv_sw_bits = (u32_t)0u;
+    if (!wq_row_cache_hit) {
+        for (uint32_t i = 0u; i < wq_meta.payload_words_2b; ++i) {
+            wq_payload_words[i] = sram[wq_payload_base + i];
+        }
+        wq_inv_sw_bits = sram[wq_inv_addr];
     }
-    const u32_t wq_inv_sw_bits = sram[wq_inv_addr];
 
     const uint32_t x_base = (uint32_t)x_in_base_word.to_uint();
     const uint32_t q_base = (uint32_t)sc.q_base_word.to_uint();
@@ -515,7 +522,18 @@ static inline bool attn_phasea_top_managed_q_mainline(
         u32_t q_out[kTernaryLiveL0WqRows];
         u32_t q_out_act_q[kTernaryLiveL0WqRows];
         u32_t q_out_inv_sw_bits = (u32_t)0u;
-        if (!ternary_live_l0_wq_materialize_row_kernel_split(
+        if (wq_row_cache_hit) {
+            if (!ternary_live_qkv_materialize_row_kernel_cached(
+                    *row_cache,
+                    param_base_word,
+                    QLM_L0_WQ,
+                    x_row,
+                    q_out,
+                    q_out_act_q,
+                    q_out_inv_sw_bits)) {
+                return false;
+            }
+        } else if (!ternary_live_l0_wq_materialize_row_kernel_split(
                 x_row,
                 wq_payload_words,
                 wq_inv_sw_bits,
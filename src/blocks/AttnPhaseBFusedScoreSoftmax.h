@@ -0,0 +1,260 @@
+#pragma once
+// Fused Phase-B engine: QK score + online softmax + V accumulation in one key pass.
+// Each key's score feeds the running max/sum/acc update as soon as it is formed,
+// so the score row never round-trips through SRAM (no AE write-back, no AF
+// re-read). The score is still rounded through the fp32 score word format before
+// softmax conversion, which keeps results bit-exact with the split AE/AF pair.
+// Keys come from the dense token range or, when use_key_csr is set, from the
+// SCR_ATTN_CSR src_mask lists used by the sparse pair.
+
+#include <cstdint>
+
+#include "AecctTypes.h"
+#include "AecctUtil.h"
+#include "AttnDescBringup.h"
+#include "AttnTopManagedPackets.h"
+#include "HostSimdMac.h"
+#include "QuantDesc.h"
+#include "SoftmaxApprox.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "blocks/AttnPhaseBTopManagedQkScore.h"
+#include "blocks/AttnPhaseBSparseMask.h"
+
+namespace aecct {
+
+// Per-head state of one fused lane: query slice, key span and online-softmax state.
+// q_words/running_acc span one head, so HEAD_PAR lanes cost HEAD_PAR * ATTN_D_HEAD words each.
+struct AttnFusedHeadLane {
+    uint32_t head_col_base;
+    uint32_t key_begin;
+    uint32_t key_end;
+    uint32_t col_base;
+    u32_t q_words[ATTN_D_HEAD];
+    softmax_score_t running_max;
+    softmax_sum_t running_l;
+    quant_acc_t running_acc[ATTN_D_HEAD];
+    bool have_state;
+};
+
+// Folds key j into one lane's running max/sum/acc.
+template<typename SramView>
+static inline void attn_phaseb_fused_lane_key(
+    SramView& sram,
+    AttnFusedHeadLane& lane,
+    uint32_t j,
+    uint32_t k_base,
+    uint32_t v_base,
+    uint32_t d_model,
+    uint32_t d_head,
+    uint32_t d_tile_count,
+    const quant_acc_t& inv_sqrt_d_head
+) {
+    const uint32_t tile_words = (uint32_t)ATTN_TOP_MANAGED_WORK_TILE_WORDS;
+    const uint32_t k_row_base = k_base + j * d_model + lane.head_col_base;
+    const uint32_t v_row_base = v_base + j * d_model + lane.head_col_base;
+
+    quant_acc_t dot = quant_acc_t(0);
+    ATTN_FUSED_TILE_DOT_LOOP: for (uint32_t dt = 0u; dt < d_tile_count; ++dt) {
+        const uint32_t tile_offset = dt * tile_words;
+        const uint32_t valid = attn_top_managed_tile_valid_words(d_head, tile_words, dt);
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+        u32_t simd_k_words[ATTN_TOP_MANAGED_WORK_TILE_WORDS];
+        ATTN_FUSED_DOT_COL_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
+            simd_k_words[i] = sram[k_row_base + tile_offset + i];
+        }
+        dot = host_simd_dot_act(&lane.q_words[tile_offset], simd_k_words, valid, dot);
+#else
+        ATTN_FUSED_DOT_COL_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
+            const quant_act_t qv = quant_act_from_bits(lane.q_words[tile_offset + i]);
+            const quant_act_t kv = quant_act_from_bits(sram[k_row_base + tile_offset + i]);
+            dot += quant_acc_t(qv) * quant_acc_t(kv);
+        }
+#endif
+    }
+    // Same rounding as the AE score word, without the SRAM hop.
+    const u32_t score_bits = quant_bits_from_acc(dot * inv_sqrt_d_head);
+    const softmax_score_t score =
+        fp32_from_bits(score_bits).template convert_to_ac_fixed<18, 6, true, AC_RND, AC_SAT>(false);
+
+    if (!lane.have_state) {
+        lane.running_max = score;
+        lane.running_l = softmax_sum_t(1);
+        ATTN_FUSED_INIT_ACC_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+            lane.running_acc[i] = quant_acc_t(quant_act_from_bits(sram[v_row_base + i]));
+        }
+        lane.have_state = true;
+        return;
+    }
+
+    if (score > lane.running_max) {
+        const softmax_x_t old_minus_new = softmax_x_t(lane.running_max - score);
+        const softmax_exp_t alpha = softmax_exp_lut(old_minus_new);
+        lane.running_l = softmax_sum_t(lane.running_l * softmax_sum_t(alpha)) + softmax_sum_t(1);
+        ATTN_FUSED_RENORM_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+            const quant_act_t vv = quant_act_from_bits(sram[v_row_base + i]);
+            lane.running_acc[i] = quant_acc_t(lane.running_acc[i] * quant_acc_t(alpha)) + quant_acc_t(vv);
+        }
+        lane.running_max = score;
+    } else {
+        const softmax_x_t score_minus_old = softmax_x_t(score - lane.running_max);
+        const softmax_exp_t beta = softmax_exp_lut(score_minus_old);
+        lane.running_l += softmax_sum_t(beta);
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+        u32_t simd_v_words[ATTN_D_HEAD];
+        ATTN_FUSED_ACC_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+            simd_v_words[i] = sram[v_row_base + i];
+        }
+        host_simd_axpy_act(lane.running_acc, quant_acc_t(beta), simd_v_words, d_head);
+#else
+        ATTN_FUSED_ACC_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+            const quant_act_t vv = quant_act_from_bits(sram[v_row_base + i]);
+            lane.running_acc[i] += quant_acc_t(beta) * quant_acc_t(vv);
+        }
+#endif
+    }
+}
+
+// HEAD_PAR heads (1/2/4/8) run as lanes of one key pass. Lane l of head group g
+// owns head l * (n_heads / HEAD_PAR) + g, so HEAD_PAR=2 puts the one-ring heads
+// (h < n_heads/2) and the second-ring heads on separate lanes. Unrolling
+// ATTN_FUSED_LANE_LOOP trades area for Phase-B latency; each head keeps its own
+// online-softmax state, so every HEAD_PAR is bit-exact with HEAD_PAR=1.
+// visited_keys counts (key, head) updates; key_steps counts key-loop iterations
+// summed over head groups, i.e. the serial steps the lanes took.
+template<uint32_t HEAD_PAR = 1u, typename SramView>
+static inline bool attn_phaseb_fused_score_softmax_out(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    u32_t attn_out_base_word,
+    bool use_key_csr = false,
+    u32_t csr_base_word = (u32_t)sram_map::BASE_SCR_ATTN_CSR_W,
+    u32_t* visited_keys = 0,
+    u32_t* key_steps_out = 0
+) {
+    static_assert(HEAD_PAR == 1u || HEAD_PAR == 2u || HEAD_PAR == 4u || HEAD_PAR == 8u,
+        "HEAD_PAR must be 1, 2, 4 or 8");
+    uint32_t token_count = (uint32_t)cfg.token_count.to_uint();
+    uint32_t d_model = (uint32_t)cfg.d_model.to_uint();
+    uint32_t n_heads = (uint32_t)cfg.n_heads.to_uint();
+    uint32_t d_head = (uint32_t)cfg.d_head.to_uint();
+    const uint32_t token = (uint32_t)token_idx.to_uint();
+
+    if (token_count == 0u) { token_count = (uint32_t)ATTN_TOKEN_COUNT; }
+    if (d_model == 0u) { d_model = (uint32_t)ATTN_D_MODEL; }
+    if (n_heads == 0u) { n_heads = (uint32_t)ATTN_N_HEADS; }
+    if (n_heads == 0u) { n_heads = 1u; }
+    if (d_head == 0u) { d_head = d_model / n_heads; }
+
+    if (token >= token_count || d_model == 0u || d_head == 0u || d_head > (uint32_t)ATTN_D_HEAD) {
+        return false;
+    }
+    if ((n_heads * d_head) != d_model) {
+        return false;
+    }
+    if ((n_heads % HEAD_PAR) != 0u) {
+        return false;
+    }
+    // CSR geometry is fixed to N_NODES.
+    if (use_key_csr && token_count != N_NODES) {
+        return false;
+    }
+
+    const uint32_t q_row_base = (uint32_t)sc.q_base_word.to_uint() + token * d_model;
+    const uint32_t k_base = (uint32_t)sc.k_base_word.to_uint();
+    const uint32_t v_base = (uint32_t)sc.v_base_word.to_uint();
+    const uint32_t pre_row_base = (uint32_t)sc.pre_concat_base_word.to_uint() + token * d_model;
+    const uint32_t post_row_base = (uint32_t)sc.post_concat_base_word.to_uint() + token * d_model;
+    const uint32_t out_row_base = (uint32_t)attn_out_base_word.to_uint() + token * d_model;
+    const uint32_t csr_base = (uint32_t)csr_base_word.to_uint();
+    const uint32_t tile_words = (uint32_t)ATTN_TOP_MANAGED_WORK_TILE_WORDS;
+    const uint32_t d_tile_count = attn_top_managed_tile_count(d_head, tile_words);
+    const quant_acc_t inv_sqrt_d_head = attn_phaseb_inv_sqrt_d_head(d_head);
+    const uint32_t head_groups = n_heads / HEAD_PAR;
+    uint32_t visited = 0u;
+    uint32_t steps = 0u;
+
+    ATTN_FUSED_HEAD_GROUP_LOOP: for (uint32_t g = 0u; g < head_groups; ++g) {
+        AttnFusedHeadLane lanes[HEAD_PAR];
+        uint32_t key_steps = 0u;
+        ATTN_FUSED_LANE_SETUP_LOOP: for (uint32_t l = 0u; l < HEAD_PAR; ++l) {
+            AttnFusedHeadLane& lane = lanes[l];
+            const uint32_t h = l * head_groups + g;
+            lane.head_col_base = h * d_head;
+            lane.key_begin = 0u;
+            lane.key_end = token_count;
+            lane.col_base = 0u;
+            if (use_key_csr) {
+                const uint32_t ring_base = attn_mask_csr_ring_base_word(
+                    csr_base, attn_mask_csr_ring_from_head_group(attn_phaseb_head_group_id_from_head_idx(h)));
+                lane.col_base = ring_base + sram_map::ATTN_CSR_ROW_PTR_WORDS;
+                if (!attn_mask_csr_row_span(sram, ring_base, token, lane.key_begin, lane.key_end)) {
+                    return false;
+                }
+            }
+            if ((lane.key_end - lane.key_begin) > key_steps) {
+                key_steps = lane.key_end - lane.key_begin;
+            }
+
+            // The query slice stays in registers for the whole key pass.
+            ATTN_FUSED_Q_LOAD_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+                lane.q_words[i] = sram[q_row_base + lane.head_col_base + i];
+            }
+            lane.running_max = softmax_score_t(0);
+            lane.running_l = softmax_sum_t(0);
+            ATTN_FUSED_ACC_CLEAR_LOOP: for (uint32_t i = 0u; i < (uint32_t)ATTN_D_HEAD; ++i) {
+                lane.running_acc[i] = quant_acc_t(0);
+            }
+            lane.have_state = false;
+        }
+
+        steps += key_steps;
+
+        // Lanes step through their key lists together; a CSR lane whose list is
+        // shorter idles for the remaining steps.
+        ATTN_FUSED_KEY_LOOP: for (uint32_t e = 0u; e < key_steps; ++e) {
+            ATTN_FUSED_LANE_LOOP: for (uint32_t l = 0u; l < HEAD_PAR; ++l) {
+                AttnFusedHeadLane& lane = lanes[l];
+                const uint32_t k = lane.key_begin + e;
+                if (k >= lane.key_end) {
+                    continue;
+                }
+                const uint32_t j = use_key_csr ? attn_mask_csr_key(sram, lane.col_base, k) : k;
+                if (j >= token_count) {
+                    return false;
+                }
+                attn_phaseb_fused_lane_key(
+                    sram, lane, j, k_base, v_base, d_model, d_head, d_tile_count, inv_sqrt_d_head);
+                ++visited;
+            }
+        }
+
+        ATTN_FUSED_WRITEBACK_LANE_LOOP: for (uint32_t l = 0u; l < HEAD_PAR; ++l) {
+            const AttnFusedHeadLane& lane = lanes[l];
+            // Dense rows always have state; an empty CSR row writes a zero context.
+            if (!lane.have_state && !use_key_csr) {
+                return false;
+            }
+            const softmax_inv_t inv_l = lane.have_state ? softmax_rcp_lut(lane.running_l) : softmax_inv_t(0);
+            ATTN_FUSED_WRITEBACK_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+                const u32_t out_bits = lane.have_state ?
+                    quant_bits_from_acc(lane.running_acc[i] * quant_acc_t(inv_l)) :
+                    quant_bits_from_acc(quant_acc_t(0));
+                sram[pre_row_base + lane.head_col_base + i] = out_bits;
+                sram[post_row_base + lane.head_col_base + i] = out_bits;
+                sram[out_row_base + lane.head_col_base + i] = out_bits;
+            }
+        }
+    }
+    if (visited_keys != 0) {
+        *visited_keys = (u32_t)visited;
+    }
+    if (key_steps_out != 0) {
+        *key_steps_out = (u32_t)steps;
+    }
+    return true;
+}
+
+} // namespace aecct
@@ -0,0 +1,625 @@
+#pragma once
+// Sparse Phase-B attention over the src_mask key set.
+// Top builds one CSR per attention ring from the PARAM src_mask bitpack at LOAD_W
+// completion (SCR_ATTN_CSR). The sparse AE/AF pair then visits only the unmasked
+// keys of each query row instead of scanning all token_count keys.
+// Ring mapping follows the ref model: head group 0 (rule 1) uses the one-ring
+// mask, head group 1 (rule 2) the second-ring mask. Keys stay in ascending order,
+// so the online softmax update sequence matches a masked dense scan exactly.
+// The bitmap AE/AF pair walks allowed-key words instead (32 keys per word,
+// find-first-set to the next unmasked key). Top latches the bitpack at LOAD_W
+// completion and materializes both ring bitmaps from it (SCR_ATTN_RING_BITMAP) so a query row costs one word
+// load per 32 keys instead of a funnel shift plus ring filter per block.
+
+#include <cstdint>
+
+#include "AecctTypes.h"
+#include "AecctUtil.h"
+#include "AttnDescBringup.h"
+#include "AttnTopManagedPackets.h"
+#include "HostSimdMac.h"
+#include "QuantDesc.h"
+#include "SoftmaxApprox.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "gen/WeightStreamOrder.h"
+#include "blocks/AttnPhaseBTopManagedQkScore.h"
+
+namespace aecct {
+
+static_assert(N_NODES <= 256u, "SCR_ATTN_CSR packs key indices as u8");
+
+static const uint32_t ATTN_MASK_CSR_RING_ONE = 0u;
+static const uint32_t ATTN_MASK_CSR_RING_SECOND = 1u;
+
+static inline uint32_t attn_mask_csr_ring_base_word(uint32_t csr_base_word, uint32_t ring) {
+    return csr_base_word + ring * sram_map::ATTN_CSR_RING_WORDS;
+}
+
+static inline uint32_t attn_mask_csr_ring_from_head_group(u16_t head_group_id) {
+    return (attn_phaseb_rule_id_from_head_group(head_group_id) == (u16_t)1u) ?
+        ATTN_MASK_CSR_RING_ONE : ATTN_MASK_CSR_RING_SECOND;
+}
+
+// src_mask bit set means masked (bit_index = i * N_NODES + j).
+template<typename SramView>
+static inline bool attn_mask_src_bit(const SramView& sram, uint32_t mask_base_word, uint32_t i, uint32_t j) {
+    const uint32_t bit = i * N_NODES + j;
+    const uint32_t word = (uint32_t)sram[mask_base_word + (bit >> 5)].to_uint();
+    return ((word >> (bit & 31u)) & 1u) != 0u;
+}
+
+// One-ring keeps variable<->check pairs, second-ring keeps same-type pairs;
+// both drop pairs masked by src_mask.
+static inline bool attn_mask_ring_allows(uint32_t ring, uint32_t i, uint32_t j) {
+    const bool same_type = ((i < CODE_N) == (j < CODE_N));
+    return (ring == ATTN_MASK_CSR_RING_ONE) ? !same_type : same_type;
+}
+
+// Allowed-key bitmap of query row i for keys j0..j0+31 (bit b = key j0 + b):
+// ring type filter, minus src_mask, minus keys past N_NODES.
+static inline uint32_t attn_mask_bitmap_row_word(const u32_t* mask_words, uint32_t ring, uint32_t i, uint32_t j0) {
+    if (j0 >= N_NODES) {
+        return 0u;
+    }
+    const uint32_t bit = i * N_NODES + j0;
+    const uint32_t w = bit >> 5;
+    const uint32_t sh = bit & 31u;
+    uint32_t masked = (uint32_t)mask_words[w].to_uint() >> sh;
+    if (sh != 0u && (w + 1u) < SRC_MASK_WORDS_BITPACK) {
+        masked |= (uint32_t)mask_words[w + 1u].to_uint() << (32u - sh);
+    }
+    const uint32_t valid = mask_u32(N_NODES - j0);
+    const uint32_t var_keys = (j0 < CODE_N) ? mask_u32(CODE_N - j0) : 0u;
+    const uint32_t same_type = (i < CODE_N) ? var_keys : (valid & ~var_keys);
+    const uint32_t ring_keys = (ring == ATTN_MASK_CSR_RING_ONE) ? (valid & ~same_type) : same_type;
+    return ring_keys & ~masked;
+}
+
+typedef u32_t attn_ring_row_words_t[sram_map::ATTN_CSR_RINGS][sram_map::ATTN_RING_BITMAP_ROW_WORDS];
+
+static inline uint32_t attn_mask_ring_bitmap_row_base_word(uint32_t bitmap_base_word, uint32_t ring, uint32_t i) {
+    return bitmap_base_word + (ring * N_NODES + i) * sram_map::ATTN_RING_BITMAP_ROW_WORDS;
+}
+
+// Build both ring bitmaps from the latched src_mask bitpack.
+template<typename SramView>
+static inline bool attn_mask_ring_bitmap_build(
+    SramView& sram,
+    const u32_t* mask_words,
+    u32_t bitmap_base_word
+) {
+    if (mask_words == 0) {
+        return false;
+    }
+    const uint32_t bitmap_base = (uint32_t)bitmap_base_word.to_uint();
+    ATTN_RING_BITMAP_RING_LOOP: for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        ATTN_RING_BITMAP_ROW_LOOP: for (uint32_t i = 0u; i < N_NODES; ++i) {
+            const uint32_t row_base = attn_mask_ring_bitmap_row_base_word(bitmap_base, r, i);
+            ATTN_RING_BITMAP_WORD_LOOP: for (uint32_t c = 0u; c < sram_map::ATTN_RING_BITMAP_ROW_WORDS; ++c) {
+                sram[row_base + c] = (u32_t)attn_mask_bitmap_row_word(mask_words, r, i, c * 32u);
+            }
+        }
+    }
+    return true;
+}
+
+// Allowed-key words of query row i for both rings, derived from the bitpack.
+static inline void attn_mask_bitmap_row_words_from_mask(
+    const u32_t* mask_words,
+    uint32_t i,
+    attn_ring_row_words_t& row_words
+) {
+    ATTN_BITMAP_ROW_RING_LOOP: for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        ATTN_BITMAP_ROW_WORD_LOOP: for (uint32_t c = 0u; c < sram_map::ATTN_RING_BITMAP_ROW_WORDS; ++c) {
+            row_words[r][c] = (u32_t)attn_mask_bitmap_row_word(mask_words, r, i, c * 32u);
+        }
+    }
+}
+
+// Allowed-key words of query row i for both rings, loaded from SCR_ATTN_RING_BITMAP.
+template<typename SramView>
+static inline void attn_mask_ring_bitmap_row_load(
+    const SramView& sram,
+    uint32_t bitmap_base_word,
+    uint32_t i,
+    attn_ring_row_words_t& row_words
+) {
+    ATTN_RING_BITMAP_LOAD_RING_LOOP: for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        const uint32_t row_base = attn_mask_ring_bitmap_row_base_word(bitmap_base_word, r, i);
+        ATTN_RING_BITMAP_LOAD_WORD_LOOP: for (uint32_t c = 0u; c < sram_map::ATTN_RING_BITMAP_ROW_WORDS; ++c) {
+            row_words[r][c] = sram[row_base + c];
+        }
+    }
+}
+
+template<typename SramView>
+static inline uint32_t attn_mask_csr_key(const SramView& sram, uint32_t col_base_word, uint32_t e) {
+    const uint32_t word = (uint32_t)sram[col_base_word + (e >> 2)].to_uint();
+    return (word >> ((e & 3u) * 8u)) & 0xFFu;
+}
+
+// Build both ring CSRs from the committed PARAM image. nnz_out receives the
+// per-ring unmasked key count when non-null.
+template<typename SramView>
+static inline bool attn_mask_csr_build(
+    SramView& sram,
+    u32_t param_base_word,
+    u32_t csr_base_word,
+    u32_t* nnz_out = 0
+) {
+    const uint32_t mask_base =
+        (uint32_t)param_base_word.to_uint() +
+        kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+    const uint32_t csr_base = (uint32_t)csr_base_word.to_uint();
+
+    ATTN_MASK_CSR_RING_LOOP: for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        const uint32_t ring_base = attn_mask_csr_ring_base_word(csr_base, r);
+        const uint32_t col_base = ring_base + sram_map::ATTN_CSR_ROW_PTR_WORDS;
+        uint32_t nnz = 0u;
+        uint32_t pack = 0u;
+        ATTN_MASK_CSR_ROW_LOOP: for (uint32_t i = 0u; i < N_NODES; ++i) {
+            sram[ring_base + i] = (u32_t)nnz;
+            ATTN_MASK_CSR_KEY_LOOP: for (uint32_t j = 0u; j < N_NODES; ++j) {
+                if (!attn_mask_ring_allows(r, i, j) || attn_mask_src_bit(sram, mask_base, i, j)) {
+                    continue;
+                }
+                const uint32_t lane = nnz & 3u;
+                pack |= (j << (lane * 8u));
+                if (lane == 3u) {
+                    sram[col_base + (nnz >> 2)] = (u32_t)pack;
+                    pack = 0u;
+                }
+                ++nnz;
+            }
+        }
+        sram[ring_base + N_NODES] = (u32_t)nnz;
+        if ((nnz & 3u) != 0u) {
+            sram[col_base + (nnz >> 2)] = (u32_t)pack;
+        }
+        if (nnz_out != 0) {
+            nnz_out[r] = (u32_t)nnz;
+        }
+    }
+    return true;
+}
+
+// Resolve AttnCfg defaults the same way the dense Phase-B mainline does.
+// The CSR geometry is fixed to N_NODES, so other token counts are rejected.
+static inline bool attn_phaseb_sparse_shape(
+    const AttnCfg& cfg,
+    u32_t token_idx,
+    uint32_t& token_count,
+    uint32_t& d_model,
+    uint32_t& n_heads,
+    uint32_t& d_head
+) {
+    token_count = (uint32_t)cfg.token_count.to_uint();
+    d_model = (uint32_t)cfg.d_model.to_uint();
+    n_heads = (uint32_t)cfg.n_heads.to_uint();
+    d_head = (uint32_t)cfg.d_head.to_uint();
+    if (token_count == 0u) { token_count = (uint32_t)ATTN_TOKEN_COUNT; }
+    if (d_model == 0u) { d_model = (uint32_t)ATTN_D_MODEL; }
+    if (n_heads == 0u) { n_heads = (uint32_t)ATTN_N_HEADS; }
+    if (n_heads == 0u) { n_heads = 1u; }
+    if (d_head == 0u) { d_head = d_model / n_heads; }
+
+    if (token_count != N_NODES) { return false; }
+    if ((uint32_t)token_idx.to_uint() >= token_count) { return false; }
+    if (d_model == 0u || d_head == 0u || d_head > (uint32_t)ATTN_D_MODEL) { return false; }
+    if ((n_heads * d_head) != d_model) { return false; }
+    return true;
+}
+
+template<typename SramView>
+static inline bool attn_mask_csr_row_span(
+    const SramView& sram,
+    uint32_t ring_base,
+    uint32_t token,
+    uint32_t& key_begin,
+    uint32_t& key_end
+) {
+    key_begin = (uint32_t)sram[ring_base + token].to_uint();
+    key_end = (uint32_t)sram[ring_base + token + 1u].to_uint();
+    return (key_begin <= key_end) && (key_end <= (N_NODES * N_NODES));
+}
+
+// One QK score word for key row k_row_base against query head slice q_head_base.
+template<typename SramView>
+static inline u32_t attn_phaseb_sparse_key_score(
+    const SramView& sram,
+    uint32_t q_head_base,
+    uint32_t k_row_base,
+    uint32_t d_head,
+    const quant_acc_t& inv_sqrt_d_head
+) {
+    const uint32_t tile_words = (uint32_t)ATTN_TOP_MANAGED_WORK_TILE_WORDS;
+    const uint32_t d_tile_count = attn_top_managed_tile_count(d_head, tile_words);
+    quant_acc_t dot = quant_acc_t(0);
+    ATTN_SPARSE_KEY_TILE_DOT_LOOP: for (uint32_t dt = 0u; dt < d_tile_count; ++dt) {
+        const uint32_t tile_offset = dt * tile_words;
+        const uint32_t valid = attn_top_managed_tile_valid_words(d_head, tile_words, dt);
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+        u32_t simd_q_words[ATTN_TOP_MANAGED_WORK_TILE_WORDS];
+        u32_t simd_k_words[ATTN_TOP_MANAGED_WORK_TILE_WORDS];
+        ATTN_SPARSE_KEY_DOT_COL_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
+            simd_q_words[i] = sram[q_head_base + tile_offset + i];
+            simd_k_words[i] = sram[k_row_base + tile_offset + i];
+        }
+        dot = host_simd_dot_act(simd_q_words, simd_k_words, valid, dot);
+#else
+        ATTN_SPARSE_KEY_DOT_COL_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
+            const quant_act_t qv = quant_act_from_bits(sram[q_head_base + tile_offset + i]);
+            const quant_act_t kv = quant_act_from_bits(sram[k_row_base + tile_offset + i]);
+            dot += quant_acc_t(qv) * quant_acc_t(kv);
+        }
+#endif
+    }
+    return quant_bits_from_acc(dot * inv_sqrt_d_head);
+}
+
+// Online softmax + V update for one unmasked key (ascending key order).
+template<typename SramView>
+static inline void attn_phaseb_sparse_key_softmax_acc(
+    const SramView& sram,
+    u32_t score_bits,
+    uint32_t v_row_base,
+    uint32_t d_head,
+    softmax_score_t& running_max,
+    softmax_sum_t& running_l,
+    quant_acc_t* running_acc,
+    bool& have_state
+) {
+    const fp32_t score_fp = fp32_from_bits(score_bits);
+    const softmax_score_t score =
+        score_fp.template convert_to_ac_fixed<18, 6, true, AC_RND, AC_SAT>(false);
+
+    if (!have_state) {
+        running_max = score;
+        running_l = softmax_sum_t(1);
+        ATTN_SPARSE_AF_INIT_ACC_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+            running_acc[i] = quant_acc_t(quant_act_from_bits(sram[v_row_base + i]));
+        }
+        have_state = true;
+        return;
+    }
+
+    if (score > running_max) {
+        const softmax_x_t old_minus_new = softmax_x_t(running_max - score);
+        const softmax_exp_t alpha = softmax_exp_lut(old_minus_new);
+        running_l = softmax_sum_t(running_l * softmax_sum_t(alpha)) + softmax_sum_t(1);
+        ATTN_SPARSE_AF_RENORM_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+            const quant_act_t vv = quant_act_from_bits(sram[v_row_base + i]);
+            running_acc[i] = quant_acc_t(running_acc[i] * quant_acc_t(alpha)) + quant_acc_t(vv);
+        }
+        running_max = score;
+    } else {
+        const softmax_x_t score_minus_old = softmax_x_t(score - running_max);
+        const softmax_exp_t beta = softmax_exp_lut(score_minus_old);
+        running_l += softmax_sum_t(beta);
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+        u32_t simd_v_words[ATTN_D_MODEL];
+        ATTN_SPARSE_AF_ACC_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+            simd_v_words[i] = sram[v_row_base + i];
+        }
+        host_simd_axpy_act(running_acc, quant_acc_t(beta), simd_v_words, d_head);
+#else
+        ATTN_SPARSE_AF_ACC_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+            const quant_act_t vv = quant_act_from_bits(sram[v_row_base + i]);
+            running_acc[i] += quant_acc_t(beta) * quant_acc_t(vv);
+        }
+#endif
+    }
+}
+
+// Write one head's context slice (zero when the query row has no unmasked key).
+template<typename SramView>
+static inline void attn_phaseb_sparse_head_writeback(
+    SramView& sram,
+    uint32_t row_offset,
+    const AttnScratch& sc,
+    uint32_t attn_out_base_word,
+    uint32_t d_head,
+    const softmax_sum_t& running_l,
+    const quant_acc_t* running_acc,
+    bool have_state
+) {
+    const uint32_t pre_base = (uint32_t)sc.pre_concat_base_word.to_uint() + row_offset;
+    const uint32_t post_base = (uint32_t)sc.post_concat_base_word.to_uint() + row_offset;
+    const uint32_t out_base = attn_out_base_word + row_offset;
+    const softmax_inv_t inv_l = have_state ? softmax_rcp_lut(running_l) : softmax_inv_t(0);
+    ATTN_SPARSE_AF_WRITEBACK_LOOP: for (uint32_t i = 0u; i < d_head; ++i) {
+        const u32_t out_bits = have_state ?
+            quant_bits_from_acc(running_acc[i] * quant_acc_t(inv_l)) :
+            quant_bits_from_acc(quant_acc_t(0));
+        sram[pre_base + i] = out_bits;
+        sram[post_base + i] = out_bits;
+        sram[out_base + i] = out_bits;
+    }
+}
+
+// Sparse AE: score words are written only for CSR keys; masked score slots are
+// left untouched because sparse AF never reads them.
+template<typename SramView>
+static inline bool attn_phaseb_sparse_qk_score(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    u32_t csr_base_word,
+    u32_t* visited_keys = 0
+) {
+    uint32_t token_count, d_model, n_heads, d_head;
+    if (!attn_phaseb_sparse_shape(cfg, token_idx, token_count, d_model, n_heads, d_head)) {
+        return false;
+    }
+    const uint32_t token = (uint32_t)token_idx.to_uint();
+    const uint32_t q_row_base = (uint32_t)sc.q_base_word.to_uint() + token * d_model;
+    const uint32_t k_base = (uint32_t)sc.k_base_word.to_uint();
+    const uint32_t score_base = (uint32_t)sc.score_base_word.to_uint();
+    const uint32_t csr_base = (uint32_t)csr_base_word.to_uint();
+    const quant_acc_t inv_sqrt_d_head = attn_phaseb_inv_sqrt_d_head(d_head);
+    uint32_t visited = 0u;
+
+    ATTN_SPARSE_AE_HEAD_LOOP: for (uint32_t h = 0u; h < n_heads; ++h) {
+        const uint32_t head_col_base = h * d_head;
+        const uint32_t score_head_base = score_base + h * token_count;
+        const uint32_t ring_base = attn_mask_csr_ring_base_word(
+            csr_base, attn_mask_csr_ring_from_head_group(attn_phaseb_head_group_id_from_head_idx(h)));
+        const uint32_t col_base = ring_base + sram_map::ATTN_CSR_ROW_PTR_WORDS;
+        uint32_t key_begin, key_end;
+        if (!attn_mask_csr_row_span(sram, ring_base, token, key_begin, key_end)) {
+            return false;
+        }
+
+        ATTN_SPARSE_AE_KEY_LOOP: for (uint32_t e = key_begin; e < key_end; ++e) {
+            const uint32_t j = attn_mask_csr_key(sram, col_base, e);
+            if (j >= token_count) {
+                return false;
+            }
+            sram[score_head_base + j] = attn_phaseb_sparse_key_score(
+                sram, q_row_base + head_col_base, k_base + j * d_model + head_col_base, d_head, inv_sqrt_d_head);
+            ++visited;
+        }
+    }
+    if (visited_keys != 0) {
+        *visited_keys = (u32_t)visited;
+    }
+    return true;
+}
+
+// Sparse AF: online softmax + V accumulation over CSR keys only. A query row
+// with no unmasked key writes a zero context, matching the ref model.
+template<typename SramView>
+static inline bool attn_phaseb_sparse_softmax_out(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    u32_t attn_out_base_word,
+    u32_t csr_base_word,
+    u32_t* visited_keys = 0
+) {
+    uint32_t token_count, d_model, n_heads, d_head;
+    if (!attn_phaseb_sparse_shape(cfg, token_idx, token_count, d_model, n_heads, d_head)) {
+        return false;
+    }
+    const uint32_t token = (uint32_t)token_idx.to_uint();
+    const uint32_t score_base = (uint32_t)sc.score_base_word.to_uint();
+    const uint32_t v_base = (uint32_t)sc.v_base_word.to_uint();
+    const uint32_t csr_base = (uint32_t)csr_base_word.to_uint();
+    uint32_t visited = 0u;
+
+    ATTN_SPARSE_AF_HEAD_LOOP: for (uint32_t h = 0u; h < n_heads; ++h) {
+        const uint32_t head_col_base = h * d_head;
+        const uint32_t score_head_base = score_base + h * token_count;
+        const uint32_t ring_base = attn_mask_csr_ring_base_word(
+            csr_base, attn_mask_csr_ring_from_head_group(attn_phaseb_head_group_id_from_head_idx(h)));
+        const uint32_t col_base = ring_base + sram_map::ATTN_CSR_ROW_PTR_WORDS;
+        uint32_t key_begin, key_end;
+        if (!attn_mask_csr_row_span(sram, ring_base, token, key_begin, key_end)) {
+            return false;
+        }
+
+        softmax_score_t running_max = softmax_score_t(0);
+        softmax_sum_t running_l = softmax_sum_t(0);
+        quant_acc_t running_acc[ATTN_D_MODEL];
+        ATTN_SPARSE_AF_ACC_CLEAR_LOOP: for (uint32_t i = 0u; i < (uint32_t)ATTN_D_MODEL; ++i) {
+            running_acc[i] = quant_acc_t(0);
+        }
+        bool have_state = false;
+
+        ATTN_SPARSE_AF_KEY_LOOP: for (uint32_t e = key_begin; e < key_end; ++e) {
+            const uint32_t j = attn_mask_csr_key(sram, col_base, e);
+            if (j >= token_count) {
+                return false;
+            }
+            attn_phaseb_sparse_key_softmax_acc(sram, sram[score_head_base + j],
+                v_base + j * d_model + head_col_base, d_head, running_max, running_l, running_acc, have_state);
+            ++visited;
+        }
+
+        attn_phaseb_sparse_head_writeback(sram, token * d_model + head_col_base, sc,
+            (uint32_t)attn_out_base_word.to_uint(), d_head, running_l, running_acc, have_state);
+    }
+    if (visited_keys != 0) {
+        *visited_keys = (u32_t)visited;
+    }
+    return true;
+}
+
+// Bitmap AE over one query row's allowed-key words: same key set and score words as
+// sparse AE. A fully masked 32-key block costs one test; masked pairs get no dot
+// product and no score write.
+template<typename SramView>
+static inline bool attn_phaseb_bitmap_qk_score_row(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    const attn_ring_row_words_t& row_words,
+    u32_t* visited_keys = 0
+) {
+    uint32_t token_count, d_model, n_heads, d_head;
+    if (!attn_phaseb_sparse_shape(cfg, token_idx, token_count, d_model, n_heads, d_head)) {
+        return false;
+    }
+    const uint32_t token = (uint32_t)token_idx.to_uint();
+    const uint32_t q_row_base = (uint32_t)sc.q_base_word.to_uint() + token * d_model;
+    const uint32_t k_base = (uint32_t)sc.k_base_word.to_uint();
+    const uint32_t score_base = (uint32_t)sc.score_base_word.to_uint();
+    const quant_acc_t inv_sqrt_d_head = attn_phaseb_inv_sqrt_d_head(d_head);
+    uint32_t visited = 0u;
+
+    ATTN_BITMAP_AE_HEAD_LOOP: for (uint32_t h = 0u; h < n_heads; ++h) {
+        const uint32_t head_col_base = h * d_head;
+        const uint32_t score_head_base = score_base + h * token_count;
+        const uint32_t ring = attn_mask_csr_ring_from_head_group(attn_phaseb_head_group_id_from_head_idx(h));
+
+        ATTN_BITMAP_AE_BLOCK_LOOP: for (uint32_t j0 = 0u; j0 < token_count; j0 += 32u) {
+            uint32_t allowed = (uint32_t)row_words[ring][j0 >> 5].to_uint();
+            if (allowed == 0u) {
+                continue;
+            }
+            ATTN_BITMAP_AE_KEY_LOOP: for (; allowed != 0u; allowed &= (allowed - 1u)) {
+                const uint32_t j = j0 + ctz_u32(allowed);
+                sram[score_head_base + j] = attn_phaseb_sparse_key_score(
+                    sram, q_row_base + head_col_base, k_base + j * d_model + head_col_base, d_head, inv_sqrt_d_head);
+                ++visited;
+            }
+        }
+    }
+    if (visited_keys != 0) {
+        *visited_keys = (u32_t)visited;
+    }
+    return true;
+}
+
+// Bitmap AF: online softmax + V over the same allowed keys, ascending order.
+template<typename SramView>
+static inline bool attn_phaseb_bitmap_softmax_out_row(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    u32_t attn_out_base_word,
+    const attn_ring_row_words_t& row_words,
+    u32_t* visited_keys = 0
+) {
+    uint32_t token_count, d_model, n_heads, d_head;
+    if (!attn_phaseb_sparse_shape(cfg, token_idx, token_count, d_model, n_heads, d_head)) {
+        return false;
+    }
+    const uint32_t token = (uint32_t)token_idx.to_uint();
+    const uint32_t score_base = (uint32_t)sc.score_base_word.to_uint();
+    const uint32_t v_base = (uint32_t)sc.v_base_word.to_uint();
+    uint32_t visited = 0u;
+
+    ATTN_BITMAP_AF_HEAD_LOOP: for (uint32_t h = 0u; h < n_heads; ++h) {
+        const uint32_t head_col_base = h * d_head;
+        const uint32_t score_head_base = score_base + h * token_count;
+        const uint32_t ring = attn_mask_csr_ring_from_head_group(attn_phaseb_head_group_id_from_head_idx(h));
+
+        softmax_score_t running_max = softmax_score_t(0);
+        softmax_sum_t running_l = softmax_sum_t(0);
+        quant_acc_t running_acc[ATTN_D_MODEL];
+        ATTN_BITMAP_AF_ACC_CLEAR_LOOP: for (uint32_t i = 0u; i < (uint32_t)ATTN_D_MODEL; ++i) {
+            running_acc[i] = quant_acc_t(0);
+        }
+        bool have_state = false;
+
+        ATTN_BITMAP_AF_BLOCK_LOOP: for (uint32_t j0 = 0u; j0 < token_count; j0 += 32u) {
+            uint32_t allowed = (uint32_t)row_words[ring][j0 >> 5].to_uint();
+            if (allowed == 0u) {
+                continue;
+            }
+            ATTN_BITMAP_AF_KEY_LOOP: for (; allowed != 0u; allowed &= (allowed - 1u)) {
+                const uint32_t j = j0 + ctz_u32(allowed);
+                attn_phaseb_sparse_key_softmax_acc(sram, sram[score_head_base + j],
+                    v_base + j * d_model + head_col_base, d_head, running_max, running_l, running_acc, have_state);
+                ++visited;
+            }
+        }
+
+        attn_phaseb_sparse_head_writeback(sram, token * d_model + head_col_base, sc,
+            (uint32_t)attn_out_base_word.to_uint(), d_head, running_l, running_acc, have_state);
+    }
+    if (visited_keys != 0) {
+        *visited_keys = (u32_t)visited;
+    }
+    return true;
+}
+
+// Bitmap AE/AF taking the row words straight from the src_mask bitpack.
+template<typename SramView>
+static inline bool attn_phaseb_bitmap_qk_score(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    const u32_t* mask_words,
+    u32_t* visited_keys = 0
+) {
+    if (mask_words == 0 || (uint32_t)token_idx.to_uint() >= N_NODES) {
+        return false;
+    }
+    attn_ring_row_words_t row_words;
+    attn_mask_bitmap_row_words_from_mask(mask_words, (uint32_t)token_idx.to_uint(), row_words);
+    return attn_phaseb_bitmap_qk_score_row(sram, cfg, sc, token_idx, row_words, visited_keys);
+}
+
+template<typename SramView>
+static inline bool attn_phaseb_bitmap_softmax_out(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    u32_t attn_out_base_word,
+    const u32_t* mask_words,
+    u32_t* visited_keys = 0
+) {
+    if (mask_words == 0 || (uint32_t)token_idx.to_uint() >= N_NODES) {
+        return false;
+    }
+    attn_ring_row_words_t row_words;
+    attn_mask_bitmap_row_words_from_mask(mask_words, (uint32_t)token_idx.to_uint(), row_words);
+    return attn_phaseb_bitmap_softmax_out_row(sram, cfg, sc, token_idx, attn_out_base_word, row_words, visited_keys);
+}
+
+// Bitmap AE/AF over the precomputed SCR_ATTN_RING_BITMAP rows.
+template<typename SramView>
+static inline bool attn_phaseb_ring_bitmap_qk_score(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    u32_t bitmap_base_word,
+    u32_t* visited_keys = 0
+) {
+    if ((uint32_t)token_idx.to_uint() >= N_NODES) {
+        return false;
+    }
+    attn_ring_row_words_t row_words;
+    attn_mask_ring_bitmap_row_load(sram, (uint32_t)bitmap_base_word.to_uint(), (uint32_t)token_idx.to_uint(), row_words);
+    return attn_phaseb_bitmap_qk_score_row(sram, cfg, sc, token_idx, row_words, visited_keys);
+}
+
+template<typename SramView>
+static inline bool attn_phaseb_ring_bitmap_softmax_out(
+    SramView& sram,
+    const AttnCfg& cfg,
+    const AttnScratch& sc,
+    u32_t token_idx,
+    u32_t attn_out_base_word,
+    u32_t bitmap_base_word,
+    u32_t* visited_keys = 0
+) {
+    if ((uint32_t)token_idx.to_uint() >= N_NODES) {
+        return false;
+    }
+    attn_ring_row_words_t row_words;
+    attn_mask_ring_bitmap_row_load(sram, (uint32_t)bitmap_base_word.to_uint(), (uint32_t)token_idx.to_uint(), row_words);
+    return attn_phaseb_bitmap_softmax_out_row(sram, cfg, sc, token_idx, attn_out_base_word, row_words, visited_keys);
+}
+
+} // namespace aecct
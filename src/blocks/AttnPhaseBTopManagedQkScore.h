@@ -8,6 +8,7 @@
 #include "AecctTypes.h"
 #include "AttnDescBringup.h"
 #include "AttnTopManagedPackets.h"
+#include "HostSimdMac.h"
 #include "QuantDesc.h"
 
 namespace aecct {
@@ -168,11 +169,15 @@ static inline bool attn_phaseb_block_qk_dot_consume_emit(
         const uint32_t valid_k = (uint32_t)k_pkt.tile_valid_words.to_uint();
         if (valid_q == 0u || valid_q > (uint32_t)ATTN_TOP_MANAGED_WORK_TILE_WORDS) { return false; }
         if (valid_q != valid_k) { return false; }
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+        dot = host_simd_dot_act(q_pkt.data, k_pkt.data, valid_q, dot);
+#else
         ATTN_P11AE_DOT_COL_LOOP: for (uint32_t i = 0u; i < valid_q; ++i) {
             const quant_act_t qv = quant_act_from_bits(q_pkt.data[i]);
             const quant_act_t kv = quant_act_from_bits(k_pkt.data[i]);
             dot += quant_acc_t(qv) * quant_acc_t(kv);
         }
+#endif
     }
 
     const quant_acc_t scaled = dot * inv_sqrt_d_head;
@@ -470,6 +475,10 @@ static inline bool attn_phaseb_top_managed_qk_score_mainline(
                 if ((tile_offset + tile_valid_words) > d_head) {
                     return false;
                 }
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+                u32_t simd_q_words[ATTN_TOP_MANAGED_WORK_TILE_WORDS];
+                u32_t simd_k_words[ATTN_TOP_MANAGED_WORK_TILE_WORDS];
+#endif
                 ATTN_P11AE_DOT_COL_LOOP: for (uint32_t i = 0u; i < tile_valid_words; ++i) {
                     const bool qsrc_probe_selected =
                         phase_entry_probe_enabled &&
@@ -480,7 +489,6 @@ static inline bool attn_phaseb_top_managed_qk_score_mainline(
                     const u32_t q_word_bits = qsrc_probe_selected ?
                         phase_entry_probe_q_words[i] :
                         sram[q_row_base + head_col_base + tile_offset + i];
-                    const quant_act_t qv = quant_act_from_bits(q_word_bits);
                     const bool kvscan_probe_selected =
                         phase_entry_probe_enabled &&
                         (h == 0u) &&
@@ -490,9 +498,18 @@ static inline bool attn_phaseb_top_managed_qk_score_mainline(
                     const u32_t kv_word_bits = kvscan_probe_selected ?
                         phase_entry_probe_k_words[i] :
                         sram[k_row_base + tile_offset + i];
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+                    simd_q_words[i] = q_word_bits;
+                    simd_k_words[i] = kv_word_bits;
+#else
+                    const quant_act_t qv = quant_act_from_bits(q_word_bits);
                     const quant_act_t kv = quant_act_from_bits(kv_word_bits);
                     dot += quant_acc_t(qv) * quant_acc_t(kv);
+#endif
                 }
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+                dot = host_simd_dot_act(simd_q_words, simd_k_words, tile_valid_words, dot);
+#endif
             }
             const quant_acc_t scaled = dot * inv_sqrt_d_head;
             const uint32_t scaled_bits = (uint32_t)quant_bits_from_acc(scaled).to_uint();
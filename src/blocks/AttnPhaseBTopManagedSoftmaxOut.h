@@ -9,6 +9,7 @@
 #include "AecctUtil.h"
 #include "AttnDescBringup.h"
 #include "AttnTopManagedPackets.h"
+#include "HostSimdMac.h"
 #include "QuantDesc.h"
 #include "SoftmaxApprox.h"
 
@@ -233,10 +234,14 @@ static inline bool attn_phaseb_block_softmax_out_consume_emit(
                 if (valid == 0u || valid > tile_words) { return false; }
                 const uint32_t tile_offset = dt * tile_words;
                 if ((tile_offset + valid) > d_words) { return false; }
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+                host_simd_axpy_act(&running_acc[tile_offset], quant_acc_t(beta), v_pkt.data, valid);
+#else
                 ATTN_P11AF_ACC_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
                     const quant_act_t vv = quant_act_from_bits(v_pkt.data[i]);
                     running_acc[tile_offset + i] += quant_acc_t(beta) * quant_acc_t(vv);
                 }
+#endif
             }
         }
     }
@@ -1068,6 +1073,20 @@ static inline bool attn_phaseb_top_managed_softmax_out_mainline(
                             return false;
                         }
                     }
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+                    u32_t simd_v_words[ATTN_TOP_MANAGED_WORK_TILE_WORDS];
+                    ATTN_P11AF_MAINLINE_ACC_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
+                        if (phase_tile_bridge_family_acc_selected) {
+                            const uint32_t case_idx =
+                                (uint32_t)phase_tile_bridge_family_acc_case_idx;
+                            simd_v_words[i] = phase_tile_bridge_family_v_words[
+                                case_idx * kPhaseTileBridgeFamilyStrideWords + i];
+                        } else {
+                            simd_v_words[i] = sram[v_row_base + tile_offset + i];
+                        }
+                    }
+                    host_simd_axpy_act(&running_acc[tile_offset], quant_acc_t(beta), simd_v_words, valid);
+#else
                     ATTN_P11AF_MAINLINE_ACC_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
                         quant_act_t vv;
                         if (phase_tile_bridge_family_acc_selected) {
@@ -1082,6 +1101,7 @@ static inline bool attn_phaseb_top_managed_softmax_out_mainline(
                         }
                         running_acc[tile_offset + i] += quant_acc_t(beta) * quant_acc_t(vv);
                     }
+#endif
                     if (phase_tile_bridge_family_acc_selected) {
                         const uint32_t case_idx =
                             (uint32_t)phase_tile_bridge_family_acc_case_idx;
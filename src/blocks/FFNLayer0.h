@@ -11,6 +11,7 @@
 #include "AecctTypes.h"
 #include "AttnTopManagedPackets.h"
 #include "FfnDescBringup.h"
+#include "HostSimdMac.h"
 #include "QuantDesc.h"
 #include "gen/WeightStreamOrder.h"
 
@@ -87,12 +88,16 @@ static inline quant_acc_t ffn_block_mac_tile(
     quant_acc_t acc
 ) {
     const uint32_t valid = (uint32_t)meta.tile_valid_words.to_uint();
+#if !defined(__SYNTHESIS__) && defined(AECCT_HOST_SIMD_ENABLE)
+    return host_simd_dot_act(x_tile, w_tile, valid, acc);
+#else
     FFN_BLOCK_MAC_TILE_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
         const quant_act_t xv = quant_act_from_bits(x_tile[i]);
         const quant_w_t wv = quant_act_from_bits(w_tile[i]);
         acc += quant_acc_t(xv) * quant_acc_t(wv);
     }
     return acc;
+#endif
 }
 
 static inline void ffn_block_relu_tile(
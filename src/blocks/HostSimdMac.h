@@ -0,0 +1,256 @@
+#pragma once
+// Host-only integer/SIMD backend for the quant_act_t MAC and softmax-accumulate hot loops.
+// Opt-in with AECCT_HOST_SIMD_ENABLE on non-synthesis builds; synthesis and default host
+// builds keep the scalar ac_fixed loops. Every entrypoint must stay bit-identical to the
+// scalar path, and host_simd_self_check() is the equivalence gate for that contract.
+//
+// Raw formats used here:
+// - quant_act_t ac_fixed<16,6>: int16 raw, 10 fraction bits.
+// - quant_acc_t ac_fixed<32,12>: int32 raw, 20 fraction bits.
+// act * act is exact in acc units, so MAC only has to reproduce AC_SAT clipping.
+
+#include <cstdint>
+
+#include "AecctTypes.h"
+#include "AecctUtil.h"
+#include "QuantDesc.h"
+
+#ifndef __SYNTHESIS__
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace aecct {
+
+static constexpr uint32_t HOST_SIMD_TILE_MAX = 128u;
+static constexpr int64_t HOST_SIMD_ACC_RAW_MAX = 2147483647ll;
+static constexpr int64_t HOST_SIMD_ACC_RAW_MIN = -2147483647ll - 1ll;
+static constexpr int64_t HOST_SIMD_ACT_RAW_MAX = 32767ll;
+static constexpr int64_t HOST_SIMD_ACT_RAW_MIN = -32768ll;
+
+static inline int64_t host_simd_clamp(int64_t v, int64_t lo, int64_t hi) {
+    return (v < lo) ? lo : ((v > hi) ? hi : v);
+}
+
+static inline int64_t host_simd_acc_raw(const quant_acc_t& v) {
+    return (int64_t)v.template slc<32>(0).to_int();
+}
+
+static inline quant_acc_t host_simd_acc_from_raw(int64_t raw) {
+    quant_acc_t v;
+    v.set_slc(0, ac_int<32, true>((int)raw));
+    return v;
+}
+
+// quant_act_from_bits() in integer form: fp32 bits -> round-half-up -> saturate.
+// Returns false for Inf/NaN so callers fall back to the ac_float conversion.
+static inline bool host_simd_act_raw_from_bits(uint32_t bits, int32_t& raw) {
+    const uint32_t exp = (bits >> 23) & 0xFFu;
+    if (exp == 0xFFu) {
+        return false;
+    }
+    const uint32_t man = bits & 0x7FFFFFu;
+    const bool neg = ((bits >> 31) & 1u) != 0u;
+    const int64_t m = (exp == 0u) ? (int64_t)man : (int64_t)(man | 0x800000u);
+    // value * 2^10 == m * 2^shift
+    const int32_t shift = ((exp == 0u) ? 1 : (int32_t)exp) - 150 + 10;
+    int64_t v = 0;
+    if (m == 0) {
+        v = 0;
+    } else if (shift >= 0) {
+        v = (shift > 24) ? (HOST_SIMD_ACT_RAW_MAX + 1) : (m << shift);
+        v = neg ? -v : v;
+    } else {
+        const int32_t rsh = -shift;
+        if (rsh <= 40) {
+            const int64_t sv = neg ? -m : m;
+            v = (sv + ((int64_t)1 << (rsh - 1))) >> rsh;
+        }
+    }
+    raw = (int32_t)host_simd_clamp(v, HOST_SIMD_ACT_RAW_MIN, HOST_SIMD_ACT_RAW_MAX);
+    return true;
+}
+
+static inline bool host_simd_act_raw_tile(const u32_t* bits, uint32_t n, int32_t* raw) {
+    HOST_SIMD_ACT_RAW_TILE_LOOP: for (uint32_t i = 0u; i < n; ++i) {
+        if (!host_simd_act_raw_from_bits((uint32_t)bits[i].to_uint(), raw[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Sum of a[i] * b[i] and of |a[i] * b[i]|; |act * act| <= 2^30 so products fit int32.
+static inline void host_simd_mul_sum(const int32_t* a, const int32_t* b, uint32_t n, int64_t& sum, int64_t& abs_sum) {
+    sum = 0;
+    abs_sum = 0;
+    uint32_t i = 0u;
+#if defined(__AVX2__)
+    __m256i vsum = _mm256_setzero_si256();
+    __m256i vabs = _mm256_setzero_si256();
+    for (; (i + 8u) <= n; i += 8u) {
+        const __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        const __m256i prod = _mm256_mullo_epi32(va, vb);
+        const __m256i pabs = _mm256_abs_epi32(prod);
+        vsum = _mm256_add_epi64(vsum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(prod)));
+        vsum = _mm256_add_epi64(vsum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(prod, 1)));
+        vabs = _mm256_add_epi64(vabs, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(pabs)));
+        vabs = _mm256_add_epi64(vabs, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(pabs, 1)));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, vsum);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_storeu_si256((__m256i*)lanes, vabs);
+    abs_sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; ++i) {
+        const int64_t p = (int64_t)a[i] * (int64_t)b[i];
+        sum += p;
+        abs_sum += (p < 0) ? -p : p;
+    }
+}
+
+// Scalar reference: the exact loop body used by the design blocks.
+static inline quant_acc_t host_simd_dot_act_scalar(const u32_t* a_bits, const u32_t* b_bits, uint32_t n, quant_acc_t acc) {
+    for (uint32_t i = 0u; i < n; ++i) {
+        const quant_act_t av = quant_act_from_bits(a_bits[i]);
+        const quant_act_t bv = quant_act_from_bits(b_bits[i]);
+        acc += quant_acc_t(av) * quant_acc_t(bv);
+    }
+    return acc;
+}
+
+// acc += sum(act(a[i]) * act(b[i])) with per-step AC_SAT. When no partial sum can leave
+// the acc range the products are summed in any order; otherwise clipping is replayed in order.
+static inline quant_acc_t host_simd_dot_act(const u32_t* a_bits, const u32_t* b_bits, uint32_t n, quant_acc_t acc) {
+    int32_t a[HOST_SIMD_TILE_MAX];
+    int32_t b[HOST_SIMD_TILE_MAX];
+    if (n > HOST_SIMD_TILE_MAX ||
+        !host_simd_act_raw_tile(a_bits, n, a) ||
+        !host_simd_act_raw_tile(b_bits, n, b)) {
+        return host_simd_dot_act_scalar(a_bits, b_bits, n, acc);
+    }
+
+    const int64_t acc0 = host_simd_acc_raw(acc);
+    int64_t sum = 0;
+    int64_t abs_sum = 0;
+    host_simd_mul_sum(a, b, n, sum, abs_sum);
+    if ((acc0 + abs_sum) <= HOST_SIMD_ACC_RAW_MAX && (acc0 - abs_sum) >= HOST_SIMD_ACC_RAW_MIN) {
+        return host_simd_acc_from_raw(acc0 + sum);
+    }
+
+    int64_t r = acc0;
+    for (uint32_t i = 0u; i < n; ++i) {
+        r = host_simd_clamp(r + (int64_t)a[i] * (int64_t)b[i], HOST_SIMD_ACC_RAW_MIN, HOST_SIMD_ACC_RAW_MAX);
+    }
+    return host_simd_acc_from_raw(r);
+}
+
+static inline void host_simd_axpy_act_scalar(quant_acc_t* acc, const quant_acc_t& scale, const u32_t* v_bits, uint32_t n) {
+    for (uint32_t i = 0u; i < n; ++i) {
+        const quant_act_t vv = quant_act_from_bits(v_bits[i]);
+        acc[i] += scale * quant_acc_t(vv);
+    }
+}
+
+// acc[i] += scale * act(v[i]). The product carries 40 fraction bits; the += rounds half up
+// to 20 bits and then saturates, matching ac_fixed<32,12,true,AC_RND,AC_SAT> assignment.
+static inline void host_simd_axpy_act(quant_acc_t* acc, const quant_acc_t& scale, const u32_t* v_bits, uint32_t n) {
+    int32_t v[HOST_SIMD_TILE_MAX];
+    if (n > HOST_SIMD_TILE_MAX || !host_simd_act_raw_tile(v_bits, n, v)) {
+        host_simd_axpy_act_scalar(acc, scale, v_bits, n);
+        return;
+    }
+    const int64_t s = host_simd_acc_raw(scale);
+    const int64_t half = (int64_t)1 << 19;
+    HOST_SIMD_AXPY_LOOP: for (uint32_t i = 0u; i < n; ++i) {
+        const int64_t wide = (host_simd_acc_raw(acc[i]) << 20) + ((s * (int64_t)v[i]) << 10);
+        const int64_t r = (wide + half) >> 20;
+        acc[i] = host_simd_acc_from_raw(host_simd_clamp(r, HOST_SIMD_ACC_RAW_MIN, HOST_SIMD_ACC_RAW_MAX));
+    }
+}
+
+static inline uint32_t host_simd_lcg(uint32_t& s) {
+    s = s * 1664525u + 1013904223u;
+    return s;
+}
+
+// Mix of in-range activations, tie-rounding values, saturating magnitudes and denormals.
+// Inf/NaN are excluded: the scalar ac_float conversion asserts on them.
+static inline u32_t host_simd_self_check_word(uint32_t& s) {
+    const uint32_t r = host_simd_lcg(s);
+    const uint32_t sign = (r & 1u) << 31;
+    switch ((r >> 1) & 7u) {
+    case 0u: return (u32_t)(sign | (host_simd_lcg(s) & 0x007FFFFFu));                      // zero/denormal
+    case 1u: return (u32_t)(sign | (0x7F000000u) | (host_simd_lcg(s) & 0x007FFFFFu));      // huge finite
+    case 2u: return (u32_t)(sign | ((120u + (host_simd_lcg(s) % 24u)) << 23) |
+                            ((host_simd_lcg(s) & 0x3Fu) << 12));                            // ties at 2^-11
+    case 3u: return (u32_t)(sign | ((131u + (host_simd_lcg(s) % 12u)) << 23) |
+                            (host_simd_lcg(s) & 0x007FFFFFu));                              // near/over sat
+    default: return (u32_t)(sign | ((110u + (host_simd_lcg(s) % 22u)) << 23) |
+                            (host_simd_lcg(s) & 0x007FFFFFu));                              // typical
+    }
+}
+
+// Equivalence gate against the scalar ac_fixed path. Returns the number of mismatches.
+static inline uint32_t host_simd_self_check(uint32_t seed, uint32_t rounds) {
+    uint32_t s = seed;
+    uint32_t mismatches = 0u;
+
+    // Exponent sweep for the converter, both signs, with the tie bit set and clear.
+    for (uint32_t exp = 0u; exp < 255u; ++exp) {
+        for (uint32_t k = 0u; k < 64u; ++k) {
+            const uint32_t man = (k < 4u) ? (k * 0x00200000u) : (host_simd_lcg(s) & 0x007FFFFFu);
+            const uint32_t bits = ((k & 1u) << 31) | (exp << 23) | man;
+            int32_t raw = 0;
+            if (!host_simd_act_raw_from_bits(bits, raw)) {
+                ++mismatches;
+                continue;
+            }
+            const quant_act_t ref = quant_act_from_bits((u32_t)bits);
+            if ((int64_t)ref.template slc<16>(0).to_int() != (int64_t)raw) {
+                ++mismatches;
+            }
+        }
+    }
+
+    for (uint32_t round = 0u; round < rounds; ++round) {
+        const uint32_t n = 1u + (host_simd_lcg(s) % HOST_SIMD_TILE_MAX);
+        u32_t a[HOST_SIMD_TILE_MAX];
+        u32_t b[HOST_SIMD_TILE_MAX];
+        for (uint32_t i = 0u; i < n; ++i) {
+            a[i] = host_simd_self_check_word(s);
+            b[i] = host_simd_self_check_word(s);
+        }
+        // Start some accumulators close to the rails so both dot branches are exercised.
+        const int64_t acc_seed_raw = (round & 1u) ?
+            (int64_t)(int32_t)host_simd_lcg(s) : (int64_t)((int32_t)host_simd_lcg(s) >> 8);
+        const quant_acc_t acc0 = host_simd_acc_from_raw(acc_seed_raw);
+        const quant_acc_t dot_ref = host_simd_dot_act_scalar(a, b, n, acc0);
+        const quant_acc_t dot_fast = host_simd_dot_act(a, b, n, acc0);
+        if (host_simd_acc_raw(dot_ref) != host_simd_acc_raw(dot_fast)) {
+            ++mismatches;
+        }
+
+        quant_acc_t acc_ref[HOST_SIMD_TILE_MAX];
+        quant_acc_t acc_fast[HOST_SIMD_TILE_MAX];
+        for (uint32_t i = 0u; i < n; ++i) {
+            acc_ref[i] = host_simd_acc_from_raw((int64_t)(int32_t)host_simd_lcg(s) >> (round & 7u));
+            acc_fast[i] = acc_ref[i];
+        }
+        const quant_acc_t scale = host_simd_acc_from_raw((int64_t)(int32_t)host_simd_lcg(s) >> (host_simd_lcg(s) & 15u));
+        host_simd_axpy_act_scalar(acc_ref, scale, b, n);
+        host_simd_axpy_act(acc_fast, scale, b, n);
+        for (uint32_t i = 0u; i < n; ++i) {
+            if (host_simd_acc_raw(acc_ref[i]) != host_simd_acc_raw(acc_fast[i])) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+} // namespace aecct
+
+#endif // __SYNTHESIS__
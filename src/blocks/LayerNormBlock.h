@@ -1,7 +1,10 @@
 #pragma once
 // LayerNorm block with two-pass implementation.
-// Pass 1 accumulates token-wise mean/variance.
+// Pass 1 accumulates token-wise mean/variance; 1/sqrt(var + eps) follows
+// LN_INV_SQRT_MODE (fp32 sqrt + divide, or the LUT seed with optional Newton step).
 // Pass 2 normalizes, applies gamma/beta, and writes back to the caller-selected window.
+// LN_MODE_SUM_SUMSQ (LayerNormCfg::mode) keeps the row in registers after pass 1, so
+// pass 2 does not re-read X, and takes mean/variance from quant_acc_t sum/sumsq.
 // Ownership boundary: caller/Top selects token/tile ranges and owns shared-SRAM policy.
 
 #include <cstdio>
@@ -13,6 +16,7 @@
 #include "AecctUtil.h"
 #include "AttnTopManagedPackets.h"
 #include "LayerNormDesc.h"
+#include "LayerNormInvSqrtLut.h"
 #include "QuantDesc.h"
 
 namespace aecct {
@@ -49,8 +53,24 @@ struct LayerNormCfg {
     u32_t token_count;
     u32_t d_model;
     u32_t eps_bits;
+    // LayerNormMode; defaults to the reference path for callers that never set it.
+    u32_t mode = (u32_t)LN_MODE_TWO_PASS;
 };
 
+static inline LayerNormCfg make_layernorm_cfg(
+    u32_t token_count = (u32_t)0u,
+    u32_t d_model = (u32_t)0u,
+    u32_t eps_bits = (u32_t)0u,
+    u32_t mode = (u32_t)LN_MODE_TWO_PASS
+) {
+    LayerNormCfg cfg;
+    cfg.token_count = token_count;
+    cfg.d_model = d_model;
+    cfg.eps_bits = eps_bits;
+    cfg.mode = mode;
+    return cfg;
+}
+
 struct LayerNormTopManagedTileMeta {
     u16_t phase_id;
     u16_t subphase_id;
@@ -117,6 +137,149 @@ static inline bool layernorm_top_managed_tile_meta_ok(
     return true;
 }
 
+// 1/sqrt(x) seed for normal positive x. With x = m * 2^(2k), m in [1, 4), the LUT
+// holds 1/sqrt(m) and the 2^-k factor is a subtract on the exponent field.
+static inline fp32_t layernorm_inv_sqrt_lut_seed(const fp32_t& x) {
+    const uint32_t x_bits = (uint32_t)bits_from_fp32(x).to_uint();
+    const int32_t e = (int32_t)((x_bits >> 23) & 0xFFu) - 127;
+    const uint32_t odd = (uint32_t)e & 1u;
+    const uint32_t idx =
+        (odd << LN_INV_SQRT_LUT_MANT_BITS) | ((x_bits & 0x007FFFFFu) >> (23u - LN_INV_SQRT_LUT_MANT_BITS));
+    const int32_t k = (e - (int32_t)odd) / 2;
+    const uint32_t seed_bits = kLnInvSqrtLutBits[idx];
+    const uint32_t y_exp = (uint32_t)((int32_t)((seed_bits >> 23) & 0xFFu) - k);
+    return fp32_from_bits((u32_t)((seed_bits & 0x807FFFFFu) | ((y_exp & 0xFFu) << 23)));
+}
+
+// Per-token 1/sqrt(var + eps); MODE is a LayerNormInvSqrtMode.
+template<unsigned MODE>
+static inline fp32_t layernorm_inv_std_mode(const fp32_t& var_plus_eps) {
+    if (MODE == (unsigned)LN_INV_SQRT_FP32) {
+        const fp32_t std_val = var_plus_eps.template sqrt<AC_RND_CONV, false>();
+        return fp32_one().template div<AC_RND_CONV, false>(std_val);
+    }
+    const fp32_t y0 = layernorm_inv_sqrt_lut_seed(var_plus_eps);
+    if (MODE == (unsigned)LN_INV_SQRT_LUT) {
+        return y0;
+    }
+    // y1 = y0 * (1.5 - 0.5 * x * y0 * y0)
+    const fp32_t half = fp32_from_bits((u32_t)0x3F000000u);
+    const fp32_t one_point_five = fp32_from_bits((u32_t)0x3FC00000u);
+    return y0 * (one_point_five - ((half * var_plus_eps) * (y0 * y0)));
+}
+
+static inline fp32_t layernorm_inv_std(const fp32_t& var_plus_eps) {
+    return layernorm_inv_std_mode<LN_INV_SQRT_MODE>(var_plus_eps);
+}
+
+// |dev| < 4 after scaling keeps sumsq <= 16 * LN_D_MODEL inside quant_acc_t.
+static_assert((16u * LN_D_MODEL) < 2048u, "LN_MODE_SUM_SUMSQ sumsq range exceeds quant_acc_t");
+
+// LN_MODE_SUM_SUMSQ row statistics over the register row x_row[0, d_model).
+// Deviations from shift = x_row[0] are scaled by a power of two so the largest lands
+// in (-4, 4), then summed in quant_acc_t. The shift keeps E[x^2] - mean^2 from
+// cancelling on rows with a large common offset, and mean is returned relative to it
+// so normalize also works on deviations; the block scale keeps real activations
+// (|x| well past quant_act_t range) from saturating the accumulators.
+static inline void layernorm_sum_sumsq_stats(
+    const u32_t (&x_row)[LN_D_MODEL],
+    uint32_t d_model,
+    const fp32_t& n_den,
+    fp32_t& shift,
+    fp32_t& mean,
+    fp32_t& var
+) {
+    const fp32_t x0 = fp32_from_bits(x_row[0]);
+    shift = x0;
+    fp32_t dev[LN_D_MODEL];
+    uint32_t e_max = 0u;
+    LAYERNORM_SUM_SUMSQ_DEV_LOOP: for (uint32_t c = 0u; c < (uint32_t)LN_D_MODEL; ++c) {
+        if (c < d_model) {
+            dev[c] = fp32_from_bits(x_row[c]) - x0;
+            const uint32_t e = ((uint32_t)bits_from_fp32(dev[c]).to_uint() >> 23) & 0xFFu;
+            if (e > e_max) { e_max = e; }
+        }
+    }
+
+    mean = fp32_zero();
+    var = fp32_zero();
+    // Constant row (deviations zero or below 2^-125).
+    if (e_max < 2u) {
+        return;
+    }
+    if (e_max > 254u) { e_max = 254u; }
+
+    // |dev| < 2^(e_max - 126): scale by 2^(128 - e_max), undo with 2^(e_max - 128).
+    const fp32_t scale = fp32_from_bits((u32_t)((255u - e_max) << 23));
+    const fp32_t unscale = fp32_from_bits((u32_t)((e_max - 1u) << 23));
+    quant_acc_t sum = 0;
+    quant_acc_t sum_sq = 0;
+    LAYERNORM_SUM_SUMSQ_ACC_LOOP: for (uint32_t c = 0u; c < (uint32_t)LN_D_MODEL; ++c) {
+        if (c < d_model) {
+            const quant_acc_t d_q =
+                (dev[c] * scale).template convert_to_ac_fixed<32, 12, true, AC_RND, AC_SAT>(false);
+            sum += d_q;
+            sum_sq += (d_q * d_q);
+        }
+    }
+
+    const fp32_t mean_s = fp32_t(sum) / n_den;
+    const fp32_t var_s = (fp32_t(sum_sq) / n_den) - (mean_s * mean_s);
+    mean = mean_s * unscale;
+    var = (var_s * unscale) * unscale;
+}
+
+// One LayerNorm row entirely in registers (x_row -> y_row, gamma/beta already latched),
+// for callers that fuse LN into a per-token pipeline. Same arithmetic, in the same
+// order, as one full-window token of LayerNormBlockCoreWindow for cfg.mode.
+static inline void layernorm_row_regs(
+    const u32_t (&x_row)[LN_D_MODEL],
+    const LayerNormCfg& cfg,
+    uint32_t d_model,
+    const u32_t (&gamma)[LN_D_MODEL],
+    const u32_t (&beta)[LN_D_MODEL],
+    u32_t (&y_row)[LN_D_MODEL]
+) {
+    const fp32_t eps = fp32_from_bits(cfg.eps_bits);
+    const bool sum_sumsq = ((uint32_t)cfg.mode.to_uint() == (uint32_t)LN_MODE_SUM_SUMSQ);
+    ac_int<32, true> d_model_i = (ac_int<32, true>)d_model;
+    fp32_t inv_n_den(d_model_i);
+
+    fp32_t mean = fp32_zero();
+    fp32_t var = fp32_zero();
+    fp32_t shift = fp32_zero();
+    if (sum_sumsq) {
+        layernorm_sum_sumsq_stats(x_row, d_model, inv_n_den, shift, mean, var);
+    } else {
+        fp32_t sum_fp = fp32_zero();
+        fp32_t sq_sum_fp = fp32_zero();
+        LAYERNORM_ROW_REGS_SUM_LOOP: for (uint32_t c = 0u; c < (uint32_t)LN_D_MODEL; ++c) {
+            if (c < d_model) {
+                const fp32_t x = fp32_from_bits(x_row[c]);
+                sum_fp += x;
+                sq_sum_fp += (x * x);
+            }
+        }
+        mean = sum_fp / inv_n_den;
+        var = (sq_sum_fp / inv_n_den) - (mean * mean);
+    }
+
+    fp32_t var_plus_eps = var + eps;
+    if (var_plus_eps <= fp32_zero()) {
+        var_plus_eps = eps;
+    }
+    const fp32_t inv_std = layernorm_inv_std(var_plus_eps);
+
+    LAYERNORM_ROW_REGS_AFFINE_LOOP: for (uint32_t c = 0u; c < (uint32_t)LN_D_MODEL; ++c) {
+        if (c < d_model) {
+            const fp32_t x =
+                sum_sumsq ? (fp32_from_bits(x_row[c]) - shift) : fp32_from_bits(x_row[c]);
+            const fp32_t y = ((x - mean) * inv_std) * fp32_from_bits(gamma[c]) + fp32_from_bits(beta[c]);
+            y_row[c] = bits_from_fp32(y);
+        }
+    }
+}
+
 template<typename SramView>
 static inline void LayerNormBlockCoreWindow(
     SramView& sram,
@@ -166,6 +329,12 @@ static inline void LayerNormBlockCoreWindow(
         return;
     }
 
+    // Single-pass mode needs the whole row in registers; partial tile ranges stay two-pass.
+    const bool sum_sumsq =
+        ((uint32_t)cfg.mode.to_uint() == (uint32_t)LN_MODE_SUM_SUMSQ) &&
+        (d_model <= (uint32_t)LN_D_MODEL) &&
+        (tile_begin == 0u) && (tile_end == d_model_tile_count);
+
     const uint32_t phase_id_u32 = (uint32_t)contract.phase_id;
     const uint32_t subphase_id_u32 = (uint32_t)ATTN_SUBPHASE_OUT;
     const bool has_topfed_gamma = (topfed_gamma_words != 0);
@@ -182,6 +351,7 @@ static inline void LayerNormBlockCoreWindow(
 
         fp32_t sum_fp = fp32_zero();
         fp32_t sq_sum_fp = fp32_zero();
+        u32_t x_row[LN_D_MODEL];
 #ifndef __SYNTHESIS__
         // Legacy fixed-point accumulators are retained for P11AI root-cause diagnostics.
         quant_acc_t legacy_sum = 0;
@@ -215,8 +385,12 @@ static inline void LayerNormBlockCoreWindow(
                 const uint32_t c = tile_offset + i;
                 const u32_t x_bits = sram[row_in_base + c];
                 const fp32_t x = fp32_from_bits(x_bits);
-                sum_fp += x;
-                sq_sum_fp += (x * x);
+                if (sum_sumsq) {
+                    x_row[c] = x_bits;
+                } else {
+                    sum_fp += x;
+                    sq_sum_fp += (x * x);
+                }
 #ifndef __SYNTHESIS__
                 const quant_act_t x_q = quant_act_from_bits(x_bits);
                 legacy_sum += x_q;
@@ -242,8 +416,14 @@ static inline void LayerNormBlockCoreWindow(
         ac_int<32, true> d_model_i = (ac_int<32, true>)d_model;
         fp32_t inv_n_den(d_model_i);
 
-        mean = sum_fp / inv_n_den;
-        fp32_t var = (sq_sum_fp / inv_n_den) - (mean * mean);
+        fp32_t var = fp32_zero();
+        fp32_t shift = fp32_zero();
+        if (sum_sumsq) {
+            layernorm_sum_sumsq_stats(x_row, d_model, inv_n_den, shift, mean, var);
+        } else {
+            mean = sum_fp / inv_n_den;
+            var = (sq_sum_fp / inv_n_den) - (mean * mean);
+        }
 #ifndef __SYNTHESIS__
         static bool p11ai_ln_root_cause_logged = false;
         if (!p11ai_ln_root_cause_logged) {
@@ -287,8 +467,7 @@ static inline void LayerNormBlockCoreWindow(
 #endif
             var_plus_eps = eps;
         }
-        const fp32_t std_val = var_plus_eps.template sqrt<AC_RND_CONV, false>();
-        inv_std = fp32_one().template div<AC_RND_CONV, false>(std_val);
+        inv_std = layernorm_inv_std(var_plus_eps);
 
         // Pass-2: normalize + affine writeback, still token-wise and tile-driven.
         LAYERNORM_TOP_MANAGED_PASS2_TILE_LOOP: for (uint32_t dt = tile_begin; dt < tile_end; ++dt) {
@@ -311,7 +490,9 @@ static inline void LayerNormBlockCoreWindow(
 
             LAYERNORM_TOP_MANAGED_PASS2_TILE_STORE_LOOP: for (uint32_t i = 0u; i < valid; ++i) {
                 const uint32_t c = tile_offset + i;
-                const fp32_t x = fp32_from_bits(sram[row_in_base + c]);
+                // Single-pass mode normalizes the registered row as deviations from the shift.
+                const fp32_t x =
+                    sum_sumsq ? (fp32_from_bits(x_row[c]) - shift) : fp32_from_bits(sram[row_in_base + c]);
                 // Affine consume seam: prefer Top-fed gamma/beta words, otherwise read caller SRAM.
                 const u32_t g_bits =
                     (topfed_gamma_words != 0) ? topfed_gamma_words[c] : sram[gamma_base + c];
@@ -450,8 +631,7 @@ static inline void LayerNormBlockCoreWindowDirect(
 #endif
                 var_plus_eps = eps;
             }
-            fp32_t std_val = var_plus_eps.template sqrt<AC_RND_CONV, false>();
-            inv_std = fp32_one().template div<AC_RND_CONV, false>(std_val);
+            inv_std = layernorm_inv_std(var_plus_eps);
         }
 
         for (uint32_t c = 0; c < d_model; ++c) {
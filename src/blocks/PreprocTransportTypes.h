@@ -87,6 +87,18 @@ struct PreprocChannelPilotStats {
     bool metadata_error;
 };
 
+} // namespace aecct
+
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(aecct::PreprocYInPacket);
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(aecct::PreprocHByVarAdjPacket);
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(aecct::PreprocEmbedParamPacket);
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(aecct::PreprocLpeTokenPacket);
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(aecct::PreprocCheckAccReadPacket);
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(aecct::PreprocCheckAccWritePacket);
+AECCT_HOST_RING_CHANNEL_SPECIALIZE(aecct::PreprocXOutPacket);
+
+namespace aecct {
+
 typedef ac_channel<PreprocYInPacket> preproc_y_in_ch_t;
 typedef ac_channel<PreprocHByVarAdjPacket> preproc_h_by_var_adj_ch_t;
 typedef ac_channel<PreprocEmbedParamPacket> preproc_embed_param_ch_t;
@@ -1,5 +1,6 @@
 #pragma once
 // Minimal design-side live ternary consumer helper for QLM_L0_WQ.
+// Also owns the row-mask decode used by the post-LOAD_W ternary row cache.
 
 #include <cstdint>
 
@@ -95,6 +96,174 @@ static inline bool ternary_linear_live_decode_weight(
     return false;
 }
 
+// Row-mask view of one ternary row: bit j of chunk c covers in_idx = c * 32 + j.
+// pos/neg masks are disjoint; a weight with neither bit set is zero.
+static constexpr uint32_t TERNARY_ROW_MASK_CHUNK_COLS = 32u;
+static constexpr uint32_t TERNARY_ROW_MASK_MAX_CHUNKS = 4u;
+
+static inline constexpr uint32_t ternary_row_mask_chunks(uint32_t cols) {
+    return (cols + (TERNARY_ROW_MASK_CHUNK_COLS - 1u)) / TERNARY_ROW_MASK_CHUNK_COLS;
+}
+
+// Only the Q/K/V projections read the row cache (managed Phase-A and the fused layer
+// tail); every layer's Q/K/V uses the QLM_L0_WQ/WK/WV payloads. Those ids lead
+// QuantLinearMatrixId, so the cache holds matrices [0, TERNARY_ROW_MASK_CACHED_MATRIX_COUNT).
+static constexpr uint32_t TERNARY_ROW_MASK_CACHED_MATRIX_COUNT = 3u;
+static_assert((uint32_t)QLM_L0_WQ == 0u && (uint32_t)QLM_L0_WK == 1u && (uint32_t)QLM_L0_WV == 2u,
+    "row cache expects QLM_L0_WQ/WK/WV to be matrices 0..2");
+
+static inline constexpr bool ternary_row_mask_cached(uint32_t matrix_id) {
+    return matrix_id < TERNARY_ROW_MASK_CACHED_MATRIX_COUNT;
+}
+
+// First cache chunk of matrix_id; cached matrices are packed in QuantLinearMatrixId order.
+static inline constexpr uint32_t ternary_row_mask_matrix_base(uint32_t matrix_id) {
+    uint32_t base = 0u;
+    for (uint32_t m = 0u; m < matrix_id && m < TERNARY_ROW_MASK_CACHED_MATRIX_COUNT; ++m) {
+        base += kQuantLinearMeta[m].rows * ternary_row_mask_chunks(kQuantLinearMeta[m].cols);
+    }
+    return base;
+}
+
+static constexpr uint32_t TERNARY_ROW_MASK_TOTAL_CHUNKS =
+    ternary_row_mask_matrix_base(TERNARY_ROW_MASK_CACHED_MATRIX_COUNT);
+
+static inline constexpr bool ternary_row_mask_shapes_fit() {
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        if (ternary_row_mask_chunks(kQuantLinearMeta[m].cols) > TERNARY_ROW_MASK_MAX_CHUNKS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(ternary_row_mask_shapes_fit(), "TERNARY_ROW_MASK_MAX_CHUNKS too small for kQuantLinearMeta cols");
+
+// Expands one packed row into pos/neg masks with one SRAM read per 16 weights.
+// Guards match ternary_linear_live_decode_code for every element of the row.
+static inline bool ternary_linear_live_decode_row_masks(
+    const u32_t* sram,
+    u32_t param_base_word,
+    QuantLinearMatrixId matrix_id,
+    uint32_t out_idx,
+    u32_t out_pos[TERNARY_ROW_MASK_MAX_CHUNKS],
+    u32_t out_neg[TERNARY_ROW_MASK_MAX_CHUNKS]
+) {
+    const QuantLinearMeta meta = ternary_linear_live_meta(matrix_id);
+    if (out_idx >= meta.rows || meta.cols == 0u) {
+        return false;
+    }
+    if (ternary_row_mask_chunks(meta.cols) > TERNARY_ROW_MASK_MAX_CHUNKS) {
+        return false;
+    }
+    const uint32_t row_elem_base = out_idx * meta.cols;
+    if ((row_elem_base + meta.cols) > meta.num_weights) {
+        return false;
+    }
+
+    TERNARY_ROW_DECODE_CLEAR_LOOP: for (uint32_t c = 0u; c < TERNARY_ROW_MASK_MAX_CHUNKS; ++c) {
+        out_pos[c] = (u32_t)0u;
+        out_neg[c] = (u32_t)0u;
+    }
+
+    const uint32_t param_base = (uint32_t)param_base_word.to_uint();
+    const uint32_t payload_base = param_base + kParamMeta[meta.weight_param_id].offset_w;
+    uint32_t word = 0u;
+    uint32_t valid_in_word = 0u;
+    uint32_t pos = 0u;
+    uint32_t neg = 0u;
+    TERNARY_ROW_DECODE_COL_LOOP: for (uint32_t in = 0u; in < meta.cols; ++in) {
+        const uint32_t elem_idx = row_elem_base + in;
+        const uint32_t word_idx = (elem_idx >> 4);
+        const uint32_t slot = (elem_idx & 15u);
+        if (in == 0u || slot == 0u) {
+            if (word_idx >= meta.payload_words_2b) {
+                return false;
+            }
+            valid_in_word = ((word_idx + 1u) == meta.payload_words_2b) ? meta.last_word_valid_count : 16u;
+            if (valid_in_word == 0u || valid_in_word > 16u) {
+                return false;
+            }
+            word = (uint32_t)sram[payload_base + word_idx].to_uint();
+        }
+        if (slot >= valid_in_word) {
+            return false;
+        }
+
+        const uint32_t code = (word >> (slot * 2u)) & 0x3u;
+        const uint32_t bit = (in & (TERNARY_ROW_MASK_CHUNK_COLS - 1u));
+        if (code == (uint32_t)TERNARY_CODE_POS) {
+            pos |= (1u << bit);
+        } else if (code == (uint32_t)TERNARY_CODE_NEG) {
+            neg |= (1u << bit);
+        } else if (code != (uint32_t)TERNARY_CODE_ZERO) {
+            return false;
+        }
+
+        if (bit == (TERNARY_ROW_MASK_CHUNK_COLS - 1u) || (in + 1u) == meta.cols) {
+            const uint32_t chunk = in / TERNARY_ROW_MASK_CHUNK_COLS;
+            out_pos[chunk] = (u32_t)pos;
+            out_neg[chunk] = (u32_t)neg;
+            pos = 0u;
+            neg = 0u;
+        }
+    }
+    return true;
+}
+
+// Multiplier-free ternary accumulate: +x, -x or nothing. Callers walk columns in order
+// so AC_SAT clipping lands exactly where the original x * w MAC clipped.
+static inline void ternary_acc_signed(quant_acc_t& acc, const quant_act_t& x, bool pos, bool neg) {
+    if (pos) {
+        acc += quant_acc_t(x);
+    } else if (neg) {
+        acc -= quant_acc_t(x);
+    }
+}
+
+static inline void ternary_acc_masked(
+    quant_acc_t& acc,
+    const quant_act_t& x,
+    const u32_t pos[TERNARY_ROW_MASK_MAX_CHUNKS],
+    const u32_t neg[TERNARY_ROW_MASK_MAX_CHUNKS],
+    uint32_t in_idx
+) {
+    const uint32_t chunk = in_idx / TERNARY_ROW_MASK_CHUNK_COLS;
+    const uint32_t bit = (in_idx & (TERNARY_ROW_MASK_CHUNK_COLS - 1u));
+    ternary_acc_signed(
+        acc,
+        x,
+        ((((uint32_t)pos[chunk].to_uint()) >> bit) & 1u) != 0u,
+        ((((uint32_t)neg[chunk].to_uint()) >> bit) & 1u) != 0u);
+}
+
+// Row dot-accumulate shared by the SRAM-decoded and cached paths.
+static inline bool ternary_linear_live_row_dot(
+    const u32_t* sram,
+    uint32_t cols,
+    u32_t x_row_base_word,
+    const u32_t pos[TERNARY_ROW_MASK_MAX_CHUNKS],
+    const u32_t neg[TERNARY_ROW_MASK_MAX_CHUNKS],
+    u32_t inv_sw_bits,
+    u32_t& out_q_bits
+) {
+    fp32_t inv_sw_fp = fp32_from_bits(inv_sw_bits);
+    quant_acc_t inv_sw = inv_sw_fp.template convert_to_ac_fixed<32, 12, true, AC_RND, AC_SAT>(false);
+    if (inv_sw == quant_acc_t(0)) {
+        return false;
+    }
+
+    const uint32_t x_base = (uint32_t)x_row_base_word.to_uint();
+    quant_acc_t acc = 0;
+    TERNARY_ROW_DOT_COL_LOOP: for (uint32_t in = 0; in < cols; ++in) {
+        quant_act_t x = quant_act_from_bits(sram[x_base + in]);
+        ternary_acc_masked(acc, x, pos, neg, in);
+    }
+
+    out_q_bits = quant_bits_from_acc(acc / inv_sw);
+    return true;
+}
+
 static inline bool ternary_linear_live_compute_q_elem(
     const u32_t* sram,
     u32_t param_base_word,
@@ -112,27 +281,184 @@ static inline bool ternary_linear_live_compute_q_elem(
         return false;
     }
 
-    fp32_t inv_sw_fp = fp32_from_bits(out_inv_sw_bits);
-    quant_acc_t inv_sw = inv_sw_fp.template convert_to_ac_fixed<32, 12, true, AC_RND, AC_SAT>(false);
-    if (inv_sw == quant_acc_t(0)) {
+    u32_t pos[TERNARY_ROW_MASK_MAX_CHUNKS];
+    u32_t neg[TERNARY_ROW_MASK_MAX_CHUNKS];
+    if (!ternary_linear_live_decode_row_masks(sram, param_base_word, matrix_id, out_idx, pos, neg)) {
         return false;
     }
+    return ternary_linear_live_row_dot(sram, meta.cols, x_row_base_word, pos, neg, out_inv_sw_bits, out_q_bits);
+}
+
+// Pre-decoded ternary rows for the cached Q/K/V matrices, filled once after LOAD_W.
+// Snapshot semantics: entries stay valid for param_base_word until cleared or rebuilt.
+struct TernaryRowMaskCache {
+    u32_t param_base_word;
+    bool matrix_valid[TERNARY_ROW_MASK_CACHED_MATRIX_COUNT];
+    u32_t inv_sw_bits[TERNARY_ROW_MASK_CACHED_MATRIX_COUNT];
+    u32_t pos_mask[TERNARY_ROW_MASK_TOTAL_CHUNKS];
+    u32_t neg_mask[TERNARY_ROW_MASK_TOTAL_CHUNKS];
+};
+
+static inline void ternary_row_mask_cache_clear(TernaryRowMaskCache& cache) {
+    cache.param_base_word = (u32_t)0u;
+    TERNARY_ROW_CACHE_CLEAR_MATRIX_LOOP: for (uint32_t m = 0u; m < TERNARY_ROW_MASK_CACHED_MATRIX_COUNT; ++m) {
+        cache.matrix_valid[m] = false;
+        cache.inv_sw_bits[m] = (u32_t)0u;
+    }
+    TERNARY_ROW_CACHE_CLEAR_CHUNK_LOOP: for (uint32_t i = 0u; i < TERNARY_ROW_MASK_TOTAL_CHUNKS; ++i) {
+        cache.pos_mask[i] = (u32_t)0u;
+        cache.neg_mask[i] = (u32_t)0u;
+    }
+}
 
-    const uint32_t x_base = (uint32_t)x_row_base_word.to_uint();
-    quant_acc_t acc = 0;
-    for (uint32_t in = 0; in < meta.cols; ++in) {
-        quant_w_t w = 0;
-        if (!ternary_linear_live_decode_weight(sram, param_base_word, matrix_id, out_idx, in, w)) {
-            return false;
+// Drops every matrix without touching the mask arrays; a later build refills them.
+static inline void ternary_row_mask_cache_invalidate(TernaryRowMaskCache& cache) {
+    TERNARY_ROW_CACHE_INVALIDATE_LOOP: for (uint32_t m = 0u; m < TERNARY_ROW_MASK_CACHED_MATRIX_COUNT; ++m) {
+        cache.matrix_valid[m] = false;
+    }
+}
+
+static inline bool ternary_row_mask_cache_ready(
+    const TernaryRowMaskCache& cache,
+    u32_t param_base_word,
+    QuantLinearMatrixId matrix_id
+) {
+    if (!ternary_row_mask_cached((uint32_t)matrix_id)) {
+        return false;
+    }
+    return cache.matrix_valid[(uint32_t)matrix_id] &&
+           ((uint32_t)cache.param_base_word.to_uint() == (uint32_t)param_base_word.to_uint());
+}
+
+// Decodes every row of the cached matrices from W_REGION at param_base_word.
+// A matrix whose payload or inv_s_w fails decode stays invalid; returns true only if all decode.
+static inline bool ternary_row_mask_cache_build(
+    TernaryRowMaskCache& cache,
+    const u32_t* sram,
+    u32_t param_base_word
+) {
+    ternary_row_mask_cache_clear(cache);
+    cache.param_base_word = param_base_word;
+    bool all_ok = true;
+    TERNARY_ROW_CACHE_BUILD_MATRIX_LOOP: for (uint32_t m = 0u; m < TERNARY_ROW_MASK_CACHED_MATRIX_COUNT; ++m) {
+        const QuantLinearMatrixId matrix_id = (QuantLinearMatrixId)m;
+        const QuantLinearMeta meta = ternary_linear_live_meta(matrix_id);
+        const uint32_t chunks = ternary_row_mask_chunks(meta.cols);
+        const uint32_t base = ternary_row_mask_matrix_base(m);
+        bool ok = ternary_linear_live_read_inv_sw_bits(sram, param_base_word, matrix_id, cache.inv_sw_bits[m]);
+        TERNARY_ROW_CACHE_BUILD_ROW_LOOP: for (uint32_t r = 0u; r < meta.rows && ok; ++r) {
+            u32_t pos[TERNARY_ROW_MASK_MAX_CHUNKS];
+            u32_t neg[TERNARY_ROW_MASK_MAX_CHUNKS];
+            if (!ternary_linear_live_decode_row_masks(sram, param_base_word, matrix_id, r, pos, neg)) {
+                ok = false;
+                break;
+            }
+            TERNARY_ROW_CACHE_BUILD_CHUNK_LOOP: for (uint32_t c = 0u; c < chunks; ++c) {
+                cache.pos_mask[base + r * chunks + c] = pos[c];
+                cache.neg_mask[base + r * chunks + c] = neg[c];
+            }
         }
-        quant_act_t x = quant_act_from_bits(sram[x_base + in]);
-        acc += quant_acc_t(x) * quant_acc_t(w);
+        cache.matrix_valid[m] = ok;
+        all_ok = all_ok && ok;
     }
+    return all_ok;
+}
 
-    out_q_bits = quant_bits_from_acc(acc / inv_sw);
+static inline constexpr bool ternary_row_mask_cols_word_aligned() {
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        if ((kQuantLinearMeta[m].cols % 16u) != 0u) {
+            return false;
+        }
+    }
     return true;
 }
 
+static_assert(ternary_row_mask_cols_word_aligned(), "streamed row-mask ingest needs cols % 16 == 0");
+
+// Streaming counterpart of ternary_row_mask_cache_build: expands payload word word_idx
+// of matrix_id (16 codes of one row, half of one 32-col chunk) into a cleared cache.
+// Reserved codes leave their bits clear; the caller owns matrix validity.
+// Words of matrices outside the cache are ignored.
+static inline void ternary_row_mask_cache_ingest_word(
+    TernaryRowMaskCache& cache,
+    uint32_t matrix_id,
+    uint32_t word_idx,
+    u32_t word_bits
+) {
+    if (!ternary_row_mask_cached(matrix_id)) {
+        return;
+    }
+    const QuantLinearMeta meta = kQuantLinearMeta[matrix_id];
+    if (word_idx >= meta.payload_words_2b) {
+        return;
+    }
+    const uint32_t elem_idx = word_idx * 16u;
+    const uint32_t row = elem_idx / meta.cols;
+    const uint32_t col = elem_idx % meta.cols;
+    const uint32_t valid_in_word = ((word_idx + 1u) == meta.payload_words_2b) ? meta.last_word_valid_count : 16u;
+    const uint32_t word = (uint32_t)word_bits.to_uint();
+    uint32_t pos = 0u;
+    uint32_t neg = 0u;
+    TERNARY_ROW_CACHE_INGEST_SLOT_LOOP: for (uint32_t slot = 0u; slot < 16u; ++slot) {
+        const uint32_t code = (word >> (slot * 2u)) & 0x3u;
+        if (slot < valid_in_word) {
+            if (code == (uint32_t)TERNARY_CODE_POS) {
+                pos |= (1u << slot);
+            } else if (code == (uint32_t)TERNARY_CODE_NEG) {
+                neg |= (1u << slot);
+            }
+        }
+    }
+    const uint32_t idx = ternary_row_mask_matrix_base(matrix_id) +
+        row * ternary_row_mask_chunks(meta.cols) + col / TERNARY_ROW_MASK_CHUNK_COLS;
+    const uint32_t shift = col & (TERNARY_ROW_MASK_CHUNK_COLS - 1u);
+    cache.pos_mask[idx] = (u32_t)((uint32_t)cache.pos_mask[idx].to_uint() | (pos << shift));
+    cache.neg_mask[idx] = (u32_t)((uint32_t)cache.neg_mask[idx].to_uint() | (neg << shift));
+}
+
+static inline void ternary_row_mask_cache_row(
+    const TernaryRowMaskCache& cache,
+    QuantLinearMatrixId matrix_id,
+    uint32_t out_idx,
+    u32_t out_pos[TERNARY_ROW_MASK_MAX_CHUNKS],
+    u32_t out_neg[TERNARY_ROW_MASK_MAX_CHUNKS]
+) {
+    const QuantLinearMeta meta = ternary_linear_live_meta(matrix_id);
+    const uint32_t chunks = ternary_row_mask_chunks(meta.cols);
+    const uint32_t row_base = ternary_row_mask_matrix_base((uint32_t)matrix_id) + out_idx * chunks;
+    TERNARY_ROW_CACHE_ROW_LOOP: for (uint32_t c = 0u; c < TERNARY_ROW_MASK_MAX_CHUNKS; ++c) {
+        out_pos[c] = (c < chunks) ? cache.pos_mask[row_base + c] : (u32_t)0u;
+        out_neg[c] = (c < chunks) ? cache.neg_mask[row_base + c] : (u32_t)0u;
+    }
+}
+
+// Cached counterpart of ternary_linear_live_compute_q_elem: weights and inv_s_w come
+// from the cache; only the X row is read from SRAM.
+static inline bool ternary_linear_live_compute_q_elem_cached(
+    const TernaryRowMaskCache& cache,
+    const u32_t* sram,
+    u32_t param_base_word,
+    QuantLinearMatrixId matrix_id,
+    u32_t x_row_base_word,
+    uint32_t out_idx,
+    u32_t& out_q_bits,
+    u32_t& out_inv_sw_bits
+) {
+    const QuantLinearMeta meta = ternary_linear_live_meta(matrix_id);
+    if (out_idx >= meta.rows) {
+        return false;
+    }
+    if (!ternary_row_mask_cache_ready(cache, param_base_word, matrix_id)) {
+        return false;
+    }
+    out_inv_sw_bits = cache.inv_sw_bits[(uint32_t)matrix_id];
+
+    u32_t pos[TERNARY_ROW_MASK_MAX_CHUNKS];
+    u32_t neg[TERNARY_ROW_MASK_MAX_CHUNKS];
+    ternary_row_mask_cache_row(cache, matrix_id, out_idx, pos, neg);
+    return ternary_linear_live_row_dot(sram, meta.cols, x_row_base_word, pos, neg, out_inv_sw_bits, out_q_bits);
+}
+
 static inline QuantLinearMeta ternary_linear_live_l0_wq_meta() {
     return ternary_linear_live_meta(QLM_L0_WQ);
 }
@@ -1,7 +1,7 @@
 #pragma once
 // Tiny HLS-oriented leaf kernel family for live ternary QKV row materialization.
 // Input: one X row + matrix-specific packed payload + inv_s_w metadata.
-// Intermediate: metadata guards + ternary decode + row dot-accumulate.
+// Intermediate: metadata guards + ternary decode + multiplier-free row add/subtract.
 // Output: one quantized Q/K/V row + mirrored act_q row + out_inv_sw_bits.
 // Non-ownership boundary: this file does not own SRAM region policy or runtime scheduling.
 
@@ -83,25 +83,28 @@ static inline bool ternary_live_qkv_materialize_row_kernel_impl(
     if (!ternary_linear_live_read_inv_sw_bits(sram, param_base_word, matrix_id, out_inv_sw_bits)) {
         return false;
     }
+    // inv_s_w is per matrix: convert once, then divide once per output element.
+    const fp32_t inv_sw_fp = fp32_from_bits(out_inv_sw_bits);
+    const quant_acc_t inv_sw = inv_sw_fp.template convert_to_ac_fixed<32, 12, true, AC_RND, AC_SAT>(false);
+    if (inv_sw == quant_acc_t(0)) {
+        return false;
+    }
 
+    const uint32_t x_base = (uint32_t)x_row_base_word.to_uint();
     const uint32_t out_base = (uint32_t)out_row_base_word.to_uint();
     const uint32_t out_act_q_base = (uint32_t)out_act_q_row_base_word.to_uint();
     TERNARY_QKV_IMPL_OUT_ROW_LOOP: for (uint32_t out = 0u; out < meta.rows; ++out) {
-        u32_t q_bits = (u32_t)0u;
-        u32_t inv_sw_bits = (u32_t)0u;
-        if (!ternary_linear_live_compute_q_elem(
-                sram,
-                param_base_word,
-                matrix_id,
-                x_row_base_word,
-                out,
-                q_bits,
-                inv_sw_bits)) {
+        u32_t pos[TERNARY_ROW_MASK_MAX_CHUNKS];
+        u32_t neg[TERNARY_ROW_MASK_MAX_CHUNKS];
+        if (!ternary_linear_live_decode_row_masks(sram, param_base_word, matrix_id, out, pos, neg)) {
             return false;
         }
-        if (inv_sw_bits != out_inv_sw_bits) {
-            return false;
+        quant_acc_t acc = 0;
+        TERNARY_QKV_IMPL_IN_COL_LOOP: for (uint32_t in = 0u; in < meta.cols; ++in) {
+            const quant_act_t x = quant_act_from_bits(sram[x_base + in]);
+            ternary_acc_masked(acc, x, pos, neg, in);
         }
+        const u32_t q_bits = quant_bits_from_acc(acc / inv_sw);
         sram[out_base + out] = q_bits;
         sram[out_act_q_base + out] = q_bits;
     }
@@ -172,20 +175,13 @@ static inline bool ternary_live_l0_wq_materialize_row_kernel_split(
             }
             const uint32_t packed = (uint32_t)payload_words[word_idx].to_uint();
             const uint32_t code = (packed >> (slot * 2u)) & 0x3u;
-
-            quant_w_t w = 0;
-            if (code == (uint32_t)TERNARY_CODE_ZERO) {
-                w = quant_w_t(0);
-            } else if (code == (uint32_t)TERNARY_CODE_POS) {
-                w = quant_w_t(1);
-            } else if (code == (uint32_t)TERNARY_CODE_NEG) {
-                w = quant_w_t(-1);
-            } else {
+            if (code == (uint32_t)TERNARY_CODE_RSVD) {
                 return false;
             }
 
             const quant_act_t x = quant_act_from_bits(x_row[in]);
-            acc += quant_acc_t(x) * quant_acc_t(w);
+            ternary_acc_signed(
+                acc, x, code == (uint32_t)TERNARY_CODE_POS, code == (uint32_t)TERNARY_CODE_NEG);
         }
         const u32_t q_bits = quant_bits_from_acc(acc / inv_sw);
         out_row[out] = q_bits;
@@ -256,20 +252,13 @@ static inline bool ternary_live_l0_wk_materialize_row_kernel_split(
             }
             const uint32_t packed = (uint32_t)payload_words[word_idx].to_uint();
             const uint32_t code = (packed >> (slot * 2u)) & 0x3u;
-
-            quant_w_t w = 0;
-            if (code == (uint32_t)TERNARY_CODE_ZERO) {
-                w = quant_w_t(0);
-            } else if (code == (uint32_t)TERNARY_CODE_POS) {
-                w = quant_w_t(1);
-            } else if (code == (uint32_t)TERNARY_CODE_NEG) {
-                w = quant_w_t(-1);
-            } else {
+            if (code == (uint32_t)TERNARY_CODE_RSVD) {
                 return false;
             }
 
             const quant_act_t x = quant_act_from_bits(x_row[in]);
-            acc += quant_acc_t(x) * quant_acc_t(w);
+            ternary_acc_signed(
+                acc, x, code == (uint32_t)TERNARY_CODE_POS, code == (uint32_t)TERNARY_CODE_NEG);
         }
         const u32_t q_bits = quant_bits_from_acc(acc / inv_sw);
         out_row[out] = q_bits;
@@ -340,20 +329,67 @@ static inline bool ternary_live_l0_wv_materialize_row_kernel_split(
             }
             const uint32_t packed = (uint32_t)payload_words[word_idx].to_uint();
             const uint32_t code = (packed >> (slot * 2u)) & 0x3u;
-
-            quant_w_t w = 0;
-            if (code == (uint32_t)TERNARY_CODE_ZERO) {
-                w = quant_w_t(0);
-            } else if (code == (uint32_t)TERNARY_CODE_POS) {
-                w = quant_w_t(1);
-            } else if (code == (uint32_t)TERNARY_CODE_NEG) {
-                w = quant_w_t(-1);
-            } else {
+            if (code == (uint32_t)TERNARY_CODE_RSVD) {
                 return false;
             }
 
             const quant_act_t x = quant_act_from_bits(x_row[in]);
-            acc += quant_acc_t(x) * quant_acc_t(w);
+            ternary_acc_signed(
+                acc, x, code == (uint32_t)TERNARY_CODE_POS, code == (uint32_t)TERNARY_CODE_NEG);
+        }
+        const u32_t q_bits = quant_bits_from_acc(acc / inv_sw);
+        out_row[out] = q_bits;
+        out_act_q_row[out] = q_bits;
+    }
+    return true;
+}
+
+static_assert(kTernaryLiveL0WkRows == kTernaryLiveL0WqRows && kTernaryLiveL0WvRows == kTernaryLiveL0WqRows,
+              "cached QKV row kernel assumes one shared row count");
+static_assert(kTernaryLiveL0WkCols == kTernaryLiveL0WqCols && kTernaryLiveL0WvCols == kTernaryLiveL0WqCols,
+              "cached QKV row kernel assumes one shared col count");
+static_assert(kTernaryLiveL0WqCols <= TERNARY_ROW_MASK_CHUNK_COLS * TERNARY_ROW_MASK_MAX_CHUNKS,
+              "cached QKV row kernel cols exceed row-mask capacity");
+
+// Cached-row QKV kernel: same output contract as the split kernels, but weights and
+// inv_s_w come from a TernaryRowMaskCache filled after LOAD_W instead of packed payload.
+// Caller must check ternary_row_mask_cache_ready() for (param_base_word, matrix_id).
+static inline bool ternary_live_qkv_materialize_row_kernel_cached(
+    const TernaryRowMaskCache& cache,
+    u32_t param_base_word,
+    QuantLinearMatrixId matrix_id,
+    const u32_t x_row[kTernaryLiveL0WqCols],
+    u32_t out_row[kTernaryLiveL0WqRows],
+    u32_t out_act_q_row[kTernaryLiveL0WqRows],
+    u32_t& out_inv_sw_bits
+) {
+    if (matrix_id != QLM_L0_WQ && matrix_id != QLM_L0_WK && matrix_id != QLM_L0_WV) {
+        return false;
+    }
+    const QuantLinearMeta meta = ternary_linear_live_meta(matrix_id);
+    if (meta.rows != kTernaryLiveL0WqRows || meta.cols != kTernaryLiveL0WqCols) {
+        return false;
+    }
+    if (!ternary_row_mask_cache_ready(cache, param_base_word, matrix_id)) {
+        return false;
+    }
+
+    const u32_t inv_sw_bits = cache.inv_sw_bits[(uint32_t)matrix_id];
+    const fp32_t inv_sw_fp = fp32_from_bits(inv_sw_bits);
+    const quant_acc_t inv_sw = inv_sw_fp.template convert_to_ac_fixed<32, 12, true, AC_RND, AC_SAT>(false);
+    if (inv_sw == quant_acc_t(0)) {
+        return false;
+    }
+
+    out_inv_sw_bits = inv_sw_bits;
+    TERNARY_QKV_CACHED_OUT_ROW_LOOP: for (uint32_t out = 0u; out < kTernaryLiveL0WqRows; ++out) {
+        u32_t pos[TERNARY_ROW_MASK_MAX_CHUNKS];
+        u32_t neg[TERNARY_ROW_MASK_MAX_CHUNKS];
+        ternary_row_mask_cache_row(cache, matrix_id, out, pos, neg);
+        quant_acc_t acc = 0;
+        TERNARY_QKV_CACHED_IN_COL_LOOP: for (uint32_t in = 0u; in < kTernaryLiveL0WqCols; ++in) {
+            const quant_act_t x = quant_act_from_bits(x_row[in]);
+            ternary_acc_masked(acc, x, pos, neg, in);
         }
         const u32_t q_bits = quant_bits_from_acc(acc / inv_sw);
         out_row[out] = q_bits;
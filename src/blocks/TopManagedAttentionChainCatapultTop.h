@@ -150,8 +150,26 @@ private:
         sram_[param_base + wq_inv_meta.offset_w] = wq_inv_sw_bits;
         sram_[param_base + wk_inv_meta.offset_w] = wk_inv_sw_bits;
         sram_[param_base + wv_inv_meta.offset_w] = wv_inv_sw_bits;
+        load_identity_norm_gamma_windows(param_base);
         return true;
     }
+
+    // The interface carries no LayerNorm affine, so the layer-0 sublayer norms and the
+    // end norm run as identity (gamma = 1.0, beta left at 0) instead of zeroing every row.
+    void load_identity_norm_gamma_windows(uint32_t param_base) {
+        const uint32_t one_bits = 0x3F800000u;
+        const uint32_t sublayer0_gamma_base =
+            param_base + kParamMeta[kWeightIdToParamId[(uint32_t)DECODER_LAYERS_0_SUBLAYER_0_NORM_WEIGHT]].offset_w;
+        const uint32_t sublayer1_gamma_base =
+            param_base + kParamMeta[kWeightIdToParamId[(uint32_t)DECODER_LAYERS_0_SUBLAYER_1_NORM_WEIGHT]].offset_w;
+        const uint32_t end_gamma_base =
+            param_base + kParamMeta[kWeightIdToParamId[(uint32_t)DECODER_NORM_WEIGHT]].offset_w;
+        LOAD_IDENTITY_NORM_GAMMA_LOOP: for (uint32_t c = 0u; c < (uint32_t)LN_D_MODEL; ++c) {
+            sram_[sublayer0_gamma_base + c] = (u32_t)one_bits;
+            sram_[sublayer1_gamma_base + c] = (u32_t)one_bits;
+            sram_[end_gamma_base + c] = (u32_t)one_bits;
+        }
+    }
 };
 
 } // namespace aecct
@@ -12,6 +12,8 @@
 #include "AecctRanges.h"
 #include "AecctUtil.h"
 #include "AttnLayer0.h"
+#include "AttnPhaseATopManagedKv.h"
+#include "AttnPhaseATopManagedQ.h"
 #include "FFNLayer0.h"
 #include "LayerNormBlock.h"
 #include "LayerNormDesc.h"
@@ -391,6 +393,40 @@ static inline TransformerLayerFfnTopfedHandoffDesc make_transformer_layer_ffn_to
     return desc;
 }
 
+// Optional Top-owned request to fuse this layer's tail with the next layer's Phase-A.
+// When enabled, residual add -> sublayer LayerNorm -> (mid LayerNorm) -> ternary
+// WQ/WK/WV run per token on a register row, replacing the add2 / LayerNorm round trips
+// and the next layer's Top-managed Q and K/V builders. Top reads back done/qkv_done.
+struct TransformerLayerNextQkvFuseDesc {
+    bool enable;
+    bool mid_norm_enable;
+    u32_t mid_gamma_base_word;
+    u32_t mid_beta_base_word;
+    u32_t mid_x_out_base_word;
+    u32_t* mid_snapshot;
+    u32_t next_param_base_word;
+    AttnScratch next_attn;
+    const TernaryRowMaskCache* row_cache;
+    bool done;
+    bool qkv_done;
+};
+
+static inline TransformerLayerNextQkvFuseDesc make_transformer_layer_next_qkv_fuse_desc() {
+    TransformerLayerNextQkvFuseDesc desc;
+    desc.enable = false;
+    desc.mid_norm_enable = false;
+    desc.mid_gamma_base_word = (u32_t)0u;
+    desc.mid_beta_base_word = (u32_t)0u;
+    desc.mid_x_out_base_word = (u32_t)0u;
+    desc.mid_snapshot = 0;
+    desc.next_param_base_word = (u32_t)0u;
+    desc.next_attn = default_attn_scratch();
+    desc.row_cache = 0;
+    desc.done = false;
+    desc.qkv_done = false;
+    return desc;
+}
+
 static inline void transformer_layer_select_topfed_words(
     const u32_t* handoff_words,
     uint32_t handoff_words_valid,
@@ -436,6 +472,215 @@ static inline void load_layer_sublayer1_norm_params(
     }
 }
 
+// Fused layer tail (see TransformerLayerNextQkvFuseDesc). Per token, the attention
+// output and W2 rows are read once; the sum, both LayerNorms and WQ/WK/WV all run on
+// the register row. Rows stay bit-exact with the split path: x_out, mid output and
+// snapshot, then Q/K/V plus act_q mirrors and q_sx exactly as the Top-managed builders.
+// Every source (norm params, WQ/WK/WV payloads) is latched before the first write, and
+// each token reads its row before writing it (W2 output shares Q scratch, add2 shares K).
+// Returns false without touching SRAM when the next-layer Q/K/V path cannot run, so the
+// caller keeps the split path.
+template<typename SramView>
+static inline bool transformer_layer_fused_tail_next_qkv(
+    SramView& sram,
+    const LayerNormCfg& ln_cfg,
+    uint32_t residual_base,
+    uint32_t w2_base,
+    uint32_t x_out_base,
+    uint32_t gamma_base,
+    uint32_t beta_base,
+    TransformerLayerNextQkvFuseDesc& fuse
+) {
+    fuse.done = false;
+    fuse.qkv_done = false;
+    if (!fuse.enable) {
+        return false;
+    }
+    const uint32_t token_count = (uint32_t)ln_cfg.token_count.to_uint();
+    const uint32_t d_model = (uint32_t)ln_cfg.d_model.to_uint();
+    if (token_count == 0u || d_model == 0u || d_model > (uint32_t)LN_D_MODEL ||
+        d_model > (uint32_t)kTernaryLiveL0WqCols) {
+        return false;
+    }
+    const u32_t param_base_word = fuse.next_param_base_word;
+    if ((uint32_t)param_base_word.to_uint() == 0u) {
+        return false;
+    }
+
+    // Same validation chain as the Top-managed Q and K/V builders.
+    const QuantLinearMeta wq_meta = ternary_linear_live_l0_wq_meta();
+    const QuantLinearMeta wk_meta = ternary_linear_live_l0_wk_meta();
+    const QuantLinearMeta wv_meta = ternary_linear_live_l0_wv_meta();
+    if (!attn_phasea_top_managed_q_meta_ok(wq_meta, QLM_L0_WQ, d_model) ||
+        !attn_phasea_top_managed_meta_ok(wk_meta, QLM_L0_WK, d_model) ||
+        !attn_phasea_top_managed_meta_ok(wv_meta, QLM_L0_WV, d_model)) {
+        return false;
+    }
+    if (wq_meta.payload_words_2b > (uint32_t)kTernaryLiveL0WqPayloadWords) {
+        return false;
+    }
+    const ParamMeta wq_payload_meta = kParamMeta[wq_meta.weight_param_id];
+    const ParamMeta wq_inv_meta = kParamMeta[wq_meta.inv_sw_param_id];
+    const ParamMeta wk_payload_meta = kParamMeta[wk_meta.weight_param_id];
+    const ParamMeta wk_inv_meta = kParamMeta[wk_meta.inv_sw_param_id];
+    const ParamMeta wv_payload_meta = kParamMeta[wv_meta.weight_param_id];
+    const ParamMeta wv_inv_meta = kParamMeta[wv_meta.inv_sw_param_id];
+    if (wq_payload_meta.len_w < wq_meta.payload_words_2b || wq_inv_meta.len_w == 0u ||
+        wk_payload_meta.len_w < wk_meta.payload_words_2b || wk_inv_meta.len_w == 0u ||
+        wv_payload_meta.len_w < wv_meta.payload_words_2b || wv_inv_meta.len_w == 0u) {
+        return false;
+    }
+
+    u32_t gamma[LN_D_MODEL];
+    u32_t beta[LN_D_MODEL];
+    u32_t mid_gamma[LN_D_MODEL];
+    u32_t mid_beta[LN_D_MODEL];
+    const uint32_t mid_gamma_base = (uint32_t)fuse.mid_gamma_base_word.to_uint();
+    const uint32_t mid_beta_base = (uint32_t)fuse.mid_beta_base_word.to_uint();
+    TRANSFORMER_LAYER_FUSED_TAIL_NORM_LATCH_LOOP: for (uint32_t c = 0u; c < (uint32_t)LN_D_MODEL; ++c) {
+        if (c < d_model) {
+            gamma[c] = sram[gamma_base + c];
+            beta[c] = sram[beta_base + c];
+            if (fuse.mid_norm_enable) {
+                mid_gamma[c] = sram[mid_gamma_base + c];
+                mid_beta[c] = sram[mid_beta_base + c];
+            }
+        }
+    }
+
+    const uint32_t param_base = (uint32_t)param_base_word.to_uint();
+    const bool q_row_cache_hit =
+        (fuse.row_cache != 0) && ternary_row_mask_cache_ready(*fuse.row_cache, param_base_word, QLM_L0_WQ);
+    const bool kv_row_cache_hit =
+        (fuse.row_cache != 0) &&
+        ternary_row_mask_cache_ready(*fuse.row_cache, param_base_word, QLM_L0_WK) &&
+        ternary_row_mask_cache_ready(*fuse.row_cache, param_base_word, QLM_L0_WV);
+    u32_t wq_payload_words[kTernaryLiveL0WqPayloadWords];
+    u32_t wk_payload_words[kTernaryLiveL0WkPayloadWords];
+    u32_t wv_payload_words[kTernaryLiveL0WvPayloadWords];
+    u32_t wq_inv_sw_bits = (u32_t)0u;
+    u32_t wk_inv_sw_bits = (u32_t)0u;
+    u32_t wv_inv_sw_bits = (u32_t)0u;
+    if (!q_row_cache_hit) {
+        const uint32_t wq_payload_base = param_base + wq_payload_meta.offset_w;
+        TRANSFORMER_LAYER_FUSED_TAIL_WQ_LATCH_LOOP: for (uint32_t i = 0u; i < wq_meta.payload_words_2b; ++i) {
+            wq_payload_words[i] = sram[wq_payload_base + i];
+        }
+        wq_inv_sw_bits = sram[param_base + wq_inv_meta.offset_w];
+    }
+    if (!kv_row_cache_hit) {
+        const uint32_t wk_payload_base = param_base + wk_payload_meta.offset_w;
+        const uint32_t wv_payload_base = param_base + wv_payload_meta.offset_w;
+        TRANSFORMER_LAYER_FUSED_TAIL_WK_LATCH_LOOP: for (uint32_t i = 0u; i < wk_meta.payload_words_2b; ++i) {
+            wk_payload_words[i] = sram[wk_payload_base + i];
+        }
+        TRANSFORMER_LAYER_FUSED_TAIL_WV_LATCH_LOOP: for (uint32_t i = 0u; i < wv_meta.payload_words_2b; ++i) {
+            wv_payload_words[i] = sram[wv_payload_base + i];
+        }
+        wk_inv_sw_bits = sram[param_base + wk_inv_meta.offset_w];
+        wv_inv_sw_bits = sram[param_base + wv_inv_meta.offset_w];
+    }
+
+    const uint32_t mid_x_out_base = (uint32_t)fuse.mid_x_out_base_word.to_uint();
+    const uint32_t q_base = (uint32_t)fuse.next_attn.q_base_word.to_uint();
+    const uint32_t k_base = (uint32_t)fuse.next_attn.k_base_word.to_uint();
+    const uint32_t v_base = (uint32_t)fuse.next_attn.v_base_word.to_uint();
+    const uint32_t q_act_q_base = (uint32_t)fuse.next_attn.q_act_q_base_word.to_uint();
+    const uint32_t k_act_q_base = (uint32_t)fuse.next_attn.k_act_q_base_word.to_uint();
+    const uint32_t v_act_q_base = (uint32_t)fuse.next_attn.v_act_q_base_word.to_uint();
+    const uint32_t q_sx_base = (uint32_t)fuse.next_attn.q_sx_base_word.to_uint();
+    bool qkv_ok = true;
+
+    TRANSFORMER_LAYER_FUSED_TAIL_TOKEN_LOOP: for (uint32_t t = 0u; t < token_count; ++t) {
+        const uint32_t row = t * d_model;
+
+        // Residual add on the register row.
+        u32_t x_row[LN_D_MODEL];
+        TRANSFORMER_LAYER_FUSED_TAIL_RESIDUAL_LOOP: for (uint32_t c = 0u; c < (uint32_t)LN_D_MODEL; ++c) {
+            if (c < d_model) {
+                const fp32_t x = fp32_from_bits(sram[residual_base + row + c]);
+                const fp32_t y = fp32_from_bits(sram[w2_base + row + c]);
+                x_row[c] = bits_from_fp32(x + y);
+            }
+        }
+
+        u32_t y_row[LN_D_MODEL];
+        layernorm_row_regs(x_row, ln_cfg, d_model, gamma, beta, y_row);
+        u32_t mid_row[LN_D_MODEL];
+        if (fuse.mid_norm_enable) {
+            layernorm_row_regs(y_row, ln_cfg, d_model, mid_gamma, mid_beta, mid_row);
+        }
+
+        u32_t qkv_x_row[kTernaryLiveL0WqCols];
+        TRANSFORMER_LAYER_FUSED_TAIL_X_WRITEBACK_LOOP: for (uint32_t c = 0u; c < (uint32_t)kTernaryLiveL0WqCols; ++c) {
+            qkv_x_row[c] = (u32_t)0u;
+            if (c < d_model) {
+                sram[x_out_base + row + c] = y_row[c];
+                qkv_x_row[c] = y_row[c];
+                if (fuse.mid_norm_enable) {
+                    sram[mid_x_out_base + row + c] = mid_row[c];
+                    if (fuse.mid_snapshot != 0) {
+                        fuse.mid_snapshot[row + c] = mid_row[c];
+                    }
+                    qkv_x_row[c] = mid_row[c];
+                }
+            }
+        }
+        if (!qkv_ok) {
+            continue;
+        }
+
+        u32_t q_out[kTernaryLiveL0WqRows];
+        u32_t q_out_act_q[kTernaryLiveL0WqRows];
+        u32_t q_out_inv_sw_bits = (u32_t)0u;
+        u32_t k_out[kTernaryLiveL0WkRows];
+        u32_t k_out_act_q[kTernaryLiveL0WkRows];
+        u32_t k_out_inv_sw_bits = (u32_t)0u;
+        u32_t v_out[kTernaryLiveL0WvRows];
+        u32_t v_out_act_q[kTernaryLiveL0WvRows];
+        u32_t v_out_inv_sw_bits = (u32_t)0u;
+        if (q_row_cache_hit) {
+            qkv_ok = ternary_live_qkv_materialize_row_kernel_cached(
+                *fuse.row_cache, param_base_word, QLM_L0_WQ, qkv_x_row, q_out, q_out_act_q, q_out_inv_sw_bits);
+        } else {
+            qkv_ok = ternary_live_l0_wq_materialize_row_kernel_split(
+                qkv_x_row, wq_payload_words, wq_inv_sw_bits, q_out, q_out_act_q, q_out_inv_sw_bits);
+        }
+        if (qkv_ok && kv_row_cache_hit) {
+            qkv_ok =
+                ternary_live_qkv_materialize_row_kernel_cached(
+                    *fuse.row_cache, param_base_word, QLM_L0_WK, qkv_x_row, k_out, k_out_act_q, k_out_inv_sw_bits) &&
+                ternary_live_qkv_materialize_row_kernel_cached(
+                    *fuse.row_cache, param_base_word, QLM_L0_WV, qkv_x_row, v_out, v_out_act_q, v_out_inv_sw_bits);
+        } else if (qkv_ok) {
+            qkv_ok =
+                ternary_live_l0_wk_materialize_row_kernel_split(
+                    qkv_x_row, wk_payload_words, wk_inv_sw_bits, k_out, k_out_act_q, k_out_inv_sw_bits) &&
+                ternary_live_l0_wv_materialize_row_kernel_split(
+                    qkv_x_row, wv_payload_words, wv_inv_sw_bits, v_out, v_out_act_q, v_out_inv_sw_bits);
+        }
+        if (!qkv_ok) {
+            continue;
+        }
+
+        TRANSFORMER_LAYER_FUSED_TAIL_QKV_WRITEBACK_LOOP: for (uint32_t c = 0u; c < (uint32_t)kTernaryLiveL0WqRows; ++c) {
+            if (c < d_model) {
+                sram[q_base + row + c] = q_out[c];
+                sram[q_act_q_base + row + c] = q_out[c];
+                sram[k_base + row + c] = k_out[c];
+                sram[v_base + row + c] = v_out[c];
+                sram[k_act_q_base + row + c] = k_out[c];
+                sram[v_act_q_base + row + c] = v_out[c];
+            }
+        }
+        sram[q_sx_base] = q_out_inv_sw_bits;
+    }
+
+    fuse.done = true;
+    fuse.qkv_done = qkv_ok;
+    return true;
+}
+
 // P00-011AN/P00-011AO: first deep Attn+FFN boundary bridges for Catapult-facing progress.
 // This variant keeps Attn/FFN first deep entries array-shaped while preserving
 // accepted core compute semantics.
@@ -462,7 +707,8 @@ static inline void TransformerLayerTopManagedAttnBridge(
     const u32_t* attn_out_topfed_payload_words = 0,
     u32_t attn_out_topfed_payload_words_valid = (u32_t)0u,
     bool attn_compat_shell_enable = true,
-    TransformerLayerW2SeamProbe* w2_seam_probe = 0
+    TransformerLayerW2SeamProbe* w2_seam_probe = 0,
+    TransformerLayerNextQkvFuseDesc* next_qkv_fuse = 0
 ) {
     uint32_t d_model = (uint32_t)cfg.d_model.to_uint();
     uint32_t n_heads = (uint32_t)cfg.n_heads.to_uint();
@@ -907,13 +1153,6 @@ static inline void TransformerLayerTopManagedAttnBridge(
     uint32_t w2_base = (uint32_t)sc.ffn.w2_out_base_word.to_uint();
     uint32_t add2_base = (uint32_t)sc.ffn.add2_base_word.to_uint();
     uint32_t words = (uint32_t)FFN_X_WORDS;
-    // Write-back boundary: residual add commits to add2 scratch before LayerNorm.
-    TRANSFORMER_LAYER_FFN_RESIDUAL_ADD_BRIDGE_LOOP: for (uint32_t i = 0; i < words; ++i) {
-        fp32_t x = fp32_from_bits(sram_window[residual_base + i]);
-        fp32_t y = fp32_from_bits(sram_window[w2_base + i]);
-        sram_window[add2_base + i] = bits_from_fp32(x + y);
-    }
-
     uint32_t gamma_base = (uint32_t)sc.ffn.ln_gamma_base_word.to_uint();
     uint32_t beta_base = (uint32_t)sc.ffn.ln_beta_base_word.to_uint();
     if (!sublayer1_norm_preloaded_by_top) {
@@ -928,10 +1167,29 @@ static inline void TransformerLayerTopManagedAttnBridge(
         );
     }
 
-    LayerNormCfg ln_cfg;
-    ln_cfg.token_count = (u32_t)FFN_TOKEN_COUNT;
-    ln_cfg.d_model = (u32_t)d_model;
-    ln_cfg.eps_bits = LN_EPS_BITS;
+    const LayerNormCfg ln_cfg = make_layernorm_cfg(
+        (u32_t)FFN_TOKEN_COUNT, (u32_t)d_model, LN_EPS_BITS, (u32_t)LN_MODE_DEFAULT);
+
+    // Fused tail: Top asked for the next layer's Q/K/V straight from this layer's rows.
+    if (next_qkv_fuse != 0 &&
+        transformer_layer_fused_tail_next_qkv(
+            sram_window,
+            ln_cfg,
+            residual_base,
+            w2_base,
+            (uint32_t)x_out_base_word.to_uint(),
+            gamma_base,
+            beta_base,
+            *next_qkv_fuse)) {
+        return;
+    }
+
+    // Write-back boundary: residual add commits to add2 scratch before LayerNorm.
+    TRANSFORMER_LAYER_FFN_RESIDUAL_ADD_BRIDGE_LOOP: for (uint32_t i = 0; i < words; ++i) {
+        fp32_t x = fp32_from_bits(sram_window[residual_base + i]);
+        fp32_t y = fp32_from_bits(sram_window[w2_base + i]);
+        sram_window[add2_base + i] = bits_from_fp32(x + y);
+    }
 
     LayerNormBlockTopManagedWindowBridge(
         sram_window,
@@ -952,7 +1210,8 @@ static inline void TransformerLayerTopManagedAttnBridge(
 // 1) optional attention shell call
 // 2) FFN top-fed descriptor selection / preload fallback
 // 3) residual add write-back into x_out_base_word
-// 4) sublayer-1 LayerNorm handoff
+// 4) sublayer-1 LayerNorm handoff, or the fused tail into the next layer's Q/K/V
+//    when Top passes next_qkv_fuse
 static inline void TransformerLayer(
     u32_t* sram,
     const CfgRegs& cfg,
@@ -972,7 +1231,8 @@ static inline void TransformerLayer(
     const u32_t* attn_out_topfed_payload_words = 0,
     u32_t attn_out_topfed_payload_words_valid = (u32_t)0u,
     bool attn_compat_shell_enable = true,
-    TransformerLayerW2SeamProbe* w2_seam_probe = 0
+    TransformerLayerW2SeamProbe* w2_seam_probe = 0,
+    TransformerLayerNextQkvFuseDesc* next_qkv_fuse = 0
 ) {
     uint32_t d_model = (uint32_t)cfg.d_model.to_uint();
     uint32_t n_heads = (uint32_t)cfg.n_heads.to_uint();
@@ -1417,13 +1677,6 @@ static inline void TransformerLayer(
     uint32_t w2_base = (uint32_t)sc.ffn.w2_out_base_word.to_uint();
     uint32_t add2_base = (uint32_t)sc.ffn.add2_base_word.to_uint();
     uint32_t words = (uint32_t)FFN_X_WORDS;
-    // Write-back boundary: residual output becomes LayerNorm input.
-    TRANSFORMER_LAYER_FFN_RESIDUAL_ADD_LOOP: for (uint32_t i = 0; i < words; ++i) {
-        fp32_t x = fp32_from_bits(sram[residual_base + i]);
-        fp32_t y = fp32_from_bits(sram[w2_base + i]);
-        sram[add2_base + i] = bits_from_fp32(x + y);
-    }
-
     uint32_t gamma_base = (uint32_t)sc.ffn.ln_gamma_base_word.to_uint();
     uint32_t beta_base = (uint32_t)sc.ffn.ln_beta_base_word.to_uint();
     if (!sublayer1_norm_preloaded_by_top) {
@@ -1438,10 +1691,29 @@ static inline void TransformerLayer(
         );
     }
 
-    LayerNormCfg ln_cfg;
-    ln_cfg.token_count = (u32_t)FFN_TOKEN_COUNT;
-    ln_cfg.d_model = (u32_t)d_model;
-    ln_cfg.eps_bits = LN_EPS_BITS;
+    const LayerNormCfg ln_cfg = make_layernorm_cfg(
+        (u32_t)FFN_TOKEN_COUNT, (u32_t)d_model, LN_EPS_BITS, (u32_t)LN_MODE_DEFAULT);
+
+    // Fused tail: Top asked for the next layer's Q/K/V straight from this layer's rows.
+    if (next_qkv_fuse != 0 &&
+        transformer_layer_fused_tail_next_qkv(
+            sram,
+            ln_cfg,
+            residual_base,
+            w2_base,
+            (uint32_t)x_out_base_word.to_uint(),
+            gamma_base,
+            beta_base,
+            *next_qkv_fuse)) {
+        return;
+    }
+
+    // Write-back boundary: residual output becomes LayerNorm input.
+    TRANSFORMER_LAYER_FFN_RESIDUAL_ADD_LOOP: for (uint32_t i = 0; i < words; ++i) {
+        fp32_t x = fp32_from_bits(sram[residual_base + i]);
+        fp32_t y = fp32_from_bits(sram[w2_base + i]);
+        sram[add2_base + i] = bits_from_fp32(x + y);
+    }
 
     LayerNormBlock(
         sram,
@@ -0,0 +1,148 @@
+// M24: fused Phase-B engine (score + online softmax + V accumulation in one pass).
+// Checks the fused engine against the split AE/AF pair for dense keys and for the
+// src_mask CSR key lists, that it leaves the score span untouched, and that the
+// Top fused gate reproduces the split-path INFER logits on every layer.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "tb_top_infer_common.h"
+
+namespace {
+
+using namespace top_infer_tb;
+
+void compare_outputs(const sram_vec_t& a, const sram_vec_t& b, const aecct::AttnScratch& sc, uint32_t out_base) {
+    compare_rows(a, b, (uint32_t)sc.pre_concat_base_word.to_uint(), "pre_concat");
+    compare_rows(a, b, (uint32_t)sc.post_concat_base_word.to_uint(), "post_concat");
+    compare_rows(a, b, out_base, "attn_out");
+}
+
+void run_fused_all_tokens(sram_vec_t& sram, const aecct::AttnScratch& sc, uint32_t out_base, bool use_csr) {
+    const aecct::AttnCfg cfg = make_cfg();
+    aecct::u32_t* view = sram.data();
+    uint32_t visited_total = 0u;
+    for (uint32_t t = 0u; t < kTokens; ++t) {
+        aecct::u32_t visited = 0u;
+        if (!aecct::attn_phaseb_fused_score_softmax_out(view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)out_base, use_csr, (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W, &visited)) {
+            fail("fused engine rejected token");
+        }
+        visited_total += (uint32_t)visited.to_uint();
+    }
+    if (!use_csr && visited_total != kTokens * kTokens * kHeads) {
+        fail("fused dense key visit count mismatch");
+    }
+    const uint32_t score_base = (uint32_t)sc.score_base_word.to_uint();
+    for (uint32_t i = 0u; i < kHeads * kTokens; ++i) {
+        if ((uint32_t)sram[score_base + i].to_uint() != kScoreSentinel) {
+            fail("fused engine touched the score span");
+        }
+    }
+}
+
+void test_dense_matches_split() {
+    const aecct::AttnScratch sc = aecct::default_attn_scratch();
+    const aecct::AttnCfg cfg = make_cfg();
+    const uint32_t out_base = (uint32_t)aecct::ATTN_OUT_BASE_WORD_DEFAULT;
+    sram_vec_t split(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    fill_qkv(split, sc, 0xC0FFEEu);
+    fill_score_sentinel(split, sc);
+    sram_vec_t fused = split;
+
+    aecct::u32_t* view = split.data();
+    for (uint32_t t = 0u; t < kTokens; ++t) {
+        bool fb = true;
+        if (!aecct::attn_phaseb_top_managed_qk_score_mainline(view, cfg, sc, (aecct::u32_t)t, fb) || fb) {
+            fail("split AE rejected token");
+        }
+        fb = true;
+        if (!aecct::attn_phaseb_top_managed_softmax_out_mainline(view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)out_base, fb) || fb) {
+            fail("split AF rejected token");
+        }
+    }
+    run_fused_all_tokens(fused, sc, out_base, false);
+    compare_outputs(split, fused, sc, out_base);
+}
+
+void test_csr_matches_sparse_pair() {
+    const aecct::AttnScratch sc = aecct::default_attn_scratch();
+    const aecct::AttnCfg cfg = make_cfg();
+    const uint32_t out_base = (uint32_t)aecct::ATTN_OUT_BASE_WORD_DEFAULT;
+    sram_vec_t split(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    fill_mask(split, 0x31337u, 1u);
+    aecct::u32_t* view = split.data();
+    if (!aecct::attn_mask_csr_build(view, (aecct::u32_t)sram_map::PARAM_BASE_DEFAULT,
+            (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W)) {
+        fail("CSR build rejected");
+    }
+    fill_qkv(split, sc, 0xF00Du);
+    fill_score_sentinel(split, sc);
+    sram_vec_t fused = split;
+
+    for (uint32_t t = 0u; t < kTokens; ++t) {
+        if (!aecct::attn_phaseb_sparse_qk_score(view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W)) {
+            fail("sparse AE rejected token");
+        }
+        if (!aecct::attn_phaseb_sparse_softmax_out(view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)out_base, (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W)) {
+            fail("sparse AF rejected token");
+        }
+    }
+    run_fused_all_tokens(fused, sc, out_base, true);
+    compare_outputs(split, fused, sc, out_base);
+}
+
+void run_top_infer(
+    const param_vec_t& param,
+    uint32_t n_layers,
+    bool fused_enable,
+    bool sparse_enable,
+    uint32_t* logits
+) {
+    TopSession hx;
+    hx.fresh_session(n_layers,
+        (fused_enable ? (uint32_t)CFG_FEAT_ATTN_FUSED : 0u) |
+        (sparse_enable ? (uint32_t)CFG_FEAT_ATTN_SPARSE : 0u),
+        &param);
+    hx.infer(0u, logits);
+    if (!aecct::top_peek_p11ae_mainline_score_path_taken() ||
+        !aecct::top_peek_p11af_mainline_softmax_output_path_taken()) {
+        fail("managed AE/AF mainline not taken");
+    }
+    const uint32_t fused_tokens = (uint32_t)aecct::top_peek_attn_fused_token_count().to_uint();
+    if (fused_tokens != (fused_enable ? kTokens * n_layers : 0u)) {
+        fail("fused token count mismatch");
+    }
+}
+
+// Phase-B features move every layer onto the managed path, so the fused gate is
+// bit-exact with the default run only where the default already uses managed AE/AF:
+// a single-layer config. With both layers, fused+sparse must match sparse.
+void test_top_wiring() {
+    param_vec_t param;
+    build_param_image(param, 0x24u, 0x4242u);
+    uint32_t split_logits[kLogitWords];
+    uint32_t fused_logits[kLogitWords];
+    run_top_infer(param, 1u, false, false, split_logits);
+    run_top_infer(param, 1u, true, false, fused_logits);
+    expect_same_logits(split_logits, fused_logits, "dense fused");
+    run_top_infer(param, (uint32_t)N_LAYERS, true, false, fused_logits);
+    run_top_infer(param, (uint32_t)N_LAYERS, false, true, split_logits);
+    run_top_infer(param, (uint32_t)N_LAYERS, true, true, fused_logits);
+    expect_same_logits(split_logits, fused_logits, "sparse fused");
+}
+
+} // namespace
+
+int main() {
+    test_dense_matches_split();
+    test_csr_matches_sparse_pair();
+    test_top_wiring();
+    std::printf("PASS: tb_attn_fused_score_softmax_m24\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+// M28: bitmap-skipping Phase-B attention over the src_mask bitpack.
+// Checks the per-row allowed-key words against the ring masks, the bitmap AE/AF
+// pair against the CSR sparse pair (outputs and visited key counts), that masked
+// score slots are never written, that a fully masked row yields a zero context,
+// and the LOAD_W latch plus opt-in INFER wiring in Top.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "tb_top_infer_common.h"
+
+namespace {
+
+using namespace top_infer_tb;
+
+void test_row_words_match_rings() {
+    sram_vec_t sram(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    fill_mask(sram, 0xA5A5u, 1u);
+    aecct::u32_t mask_words[SRC_MASK_WORDS_BITPACK];
+    snapshot_mask(sram, mask_words);
+    for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        for (uint32_t i = 0u; i < kTokens; ++i) {
+            for (uint32_t j0 = 0u; j0 < kTokens; j0 += 32u) {
+                const uint32_t got = aecct::attn_mask_bitmap_row_word(mask_words, r, i, j0);
+                for (uint32_t b = 0u; b < 32u; ++b) {
+                    const uint32_t j = j0 + b;
+                    const bool expect = (j < kTokens) && mask_allows(mask_words, r, i, j);
+                    if ((((got >> b) & 1u) != 0u) != expect) {
+                        std::printf("ERROR: row word ring=%u i=%u j=%u\n", (unsigned)r, (unsigned)i, (unsigned)j);
+                        std::exit(1);
+                    }
+                }
+            }
+        }
+    }
+    for (uint32_t b = 0u; b < 32u; ++b) {
+        if (aecct::ctz_u32(1u << b) != b || aecct::ctz_u32(0xFFFFFFFFu << b) != b) {
+            fail("ctz_u32 mismatch");
+        }
+    }
+}
+
+// Bitmap and CSR pairs must visit the same keys and produce identical contexts.
+void check_bitmap_matches_csr(uint32_t mask_seed, uint32_t density_shift, const char* tag) {
+    const aecct::AttnScratch sc = aecct::default_attn_scratch();
+    const aecct::AttnCfg cfg = make_cfg();
+    const uint32_t out_base = (uint32_t)aecct::ATTN_OUT_BASE_WORD_DEFAULT;
+    sram_vec_t seed(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    fill_mask(seed, mask_seed, density_shift);
+    aecct::u32_t mask_words[SRC_MASK_WORDS_BITPACK];
+    snapshot_mask(seed, mask_words);
+    aecct::u32_t* seed_view = seed.data();
+    if (!aecct::attn_mask_csr_build(seed_view, (aecct::u32_t)sram_map::PARAM_BASE_DEFAULT,
+            (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W)) {
+        fail("CSR build rejected");
+    }
+    fill_qkv(seed, sc, mask_seed ^ 0xBEEFu);
+    fill_score_sentinel(seed, sc);
+
+    sram_vec_t csr = seed;
+    sram_vec_t bmp = seed;
+    aecct::u32_t* csr_view = csr.data();
+    aecct::u32_t* bmp_view = bmp.data();
+    const uint32_t score_base = (uint32_t)sc.score_base_word.to_uint();
+    for (uint32_t t = 0u; t < kTokens; ++t) {
+        aecct::u32_t csr_visited = 0u;
+        aecct::u32_t bmp_visited = 0u;
+        if (!aecct::attn_phaseb_sparse_qk_score(csr_view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W, &csr_visited) ||
+            !aecct::attn_phaseb_bitmap_qk_score(bmp_view, cfg, sc, (aecct::u32_t)t, mask_words, &bmp_visited)) {
+            fail("AE rejected token");
+        }
+        if (csr_visited != bmp_visited) {
+            std::printf("ERROR: %s token %u visited csr=%u bitmap=%u\n", tag, (unsigned)t,
+                (unsigned)csr_visited.to_uint(), (unsigned)bmp_visited.to_uint());
+            std::exit(1);
+        }
+        // Score rows are rewritten per token, so compare before the next AE.
+        compare_rows(csr, bmp, score_base, tag, kHeads * kTokens);
+        // Score slots are shared across tokens, so only the first token sees pristine sentinels.
+        if (t == 0u) {
+            for (uint32_t h = 0u; h < kHeads; ++h) {
+                const uint32_t ring = aecct::attn_mask_csr_ring_from_head_group(
+                    aecct::attn_phaseb_head_group_id_from_head_idx(h));
+                for (uint32_t j = 0u; j < kTokens; ++j) {
+                    if (!mask_allows(mask_words, ring, t, j) &&
+                        (uint32_t)bmp[score_base + h * kTokens + j].to_uint() != kScoreSentinel) {
+                        fail("masked score slot written by bitmap AE");
+                    }
+                }
+            }
+        }
+        if (!aecct::attn_phaseb_sparse_softmax_out(csr_view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)out_base, (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W) ||
+            !aecct::attn_phaseb_bitmap_softmax_out(bmp_view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)out_base, mask_words)) {
+            fail("AF rejected token");
+        }
+    }
+    compare_rows(csr, bmp, (uint32_t)sc.pre_concat_base_word.to_uint(), tag);
+    compare_rows(csr, bmp, (uint32_t)sc.post_concat_base_word.to_uint(), tag);
+    compare_rows(csr, bmp, out_base, tag);
+}
+
+// Every key masked: no dot products, no score writes, zero context.
+void test_all_masked() {
+    const aecct::AttnScratch sc = aecct::default_attn_scratch();
+    const aecct::AttnCfg cfg = make_cfg();
+    const uint32_t out_base = (uint32_t)aecct::ATTN_OUT_BASE_WORD_DEFAULT;
+    sram_vec_t sram(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    aecct::u32_t mask_words[SRC_MASK_WORDS_BITPACK];
+    for (uint32_t w = 0u; w < SRC_MASK_WORDS_BITPACK; ++w) {
+        mask_words[w] = (aecct::u32_t)0xFFFFFFFFu;
+    }
+    fill_qkv(sram, sc, 0x777u);
+    fill_score_sentinel(sram, sc);
+    for (uint32_t i = 0u; i < kTokens * kDModel; ++i) {
+        sram[out_base + i] = (aecct::u32_t)kScoreSentinel;
+    }
+    aecct::u32_t* view = sram.data();
+    for (uint32_t t = 0u; t < kTokens; ++t) {
+        aecct::u32_t visited = 1u;
+        if (!aecct::attn_phaseb_bitmap_qk_score(view, cfg, sc, (aecct::u32_t)t, mask_words, &visited) ||
+            !aecct::attn_phaseb_bitmap_softmax_out(view, cfg, sc, (aecct::u32_t)t, (aecct::u32_t)out_base, mask_words)) {
+            fail("all-masked bitmap pair rejected token");
+        }
+        if (visited != 0u) {
+            fail("all-masked row visited keys");
+        }
+    }
+    const uint32_t score_base = (uint32_t)sc.score_base_word.to_uint();
+    for (uint32_t i = 0u; i < kHeads * kTokens; ++i) {
+        if ((uint32_t)sram[score_base + i].to_uint() != kScoreSentinel) {
+            fail("all-masked score slot written");
+        }
+    }
+    const uint32_t zero_bits = (uint32_t)aecct::quant_bits_from_acc(aecct::quant_acc_t(0)).to_uint();
+    for (uint32_t i = 0u; i < kTokens * kDModel; ++i) {
+        if ((uint32_t)sram[out_base + i].to_uint() != zero_bits) {
+            fail("all-masked context not zero");
+        }
+    }
+    if (aecct::attn_phaseb_bitmap_qk_score(view, cfg, sc, (aecct::u32_t)0u, 0)) {
+        fail("bitmap AE accepted a null mask");
+    }
+}
+
+// Returns the bitmap token count; sparse_enable/bitmap_enable select the AE/AF pair.
+uint32_t run_top_infer(const param_vec_t& param, bool sparse_enable, bool bitmap_enable, uint32_t* logits) {
+    TopSession hx;
+    hx.configure(N_LAYERS,
+        (sparse_enable ? (uint32_t)CFG_FEAT_ATTN_SPARSE : 0u) |
+        (bitmap_enable ? (uint32_t)CFG_FEAT_ATTN_MASK_BITMAP : 0u));
+    hx.load_w_begin();
+    if (aecct::top_peek_attn_mask_bits_valid()) {
+        fail("mask bits must be invalid while LOAD_W is in flight");
+    }
+    hx.stream_param(&param);
+    if (!aecct::top_peek_attn_mask_bits_valid()) {
+        fail("mask bits not latched at LOAD_W completion");
+    }
+    const uint32_t mask_off = kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+    for (uint32_t w = 0u; w < SRC_MASK_WORDS_BITPACK; ++w) {
+        if ((uint32_t)aecct::top_regs().attn_mask_bits_words[w].to_uint() != param[mask_off + w]) {
+            fail("latched mask word mismatch");
+        }
+    }
+    hx.set_outmode();
+    hx.infer(0u, logits);
+    return (uint32_t)aecct::top_peek_attn_bitmap_token_count().to_uint();
+}
+
+void test_top_wiring() {
+    param_vec_t param;
+    build_param_image(param, 0x28u, 0x1357u);
+    uint32_t sparse_logits[kLogitWords];
+    uint32_t bitmap_logits[kLogitWords];
+    if (run_top_infer(param, true, false, sparse_logits) != 0u) {
+        fail("bitmap path taken while disabled");
+    }
+    // The bitmap gate wins over the CSR gate when both are set.
+    const uint32_t bitmap_tokens = run_top_infer(param, true, true, bitmap_logits);
+    if (bitmap_tokens != kTokens * (uint32_t)N_LAYERS ||
+        aecct::top_peek_attn_sparse_token_count() != 0u ||
+        !aecct::top_peek_p11ae_mainline_score_path_taken() ||
+        !aecct::top_peek_p11af_mainline_softmax_output_path_taken()) {
+        fail("bitmap AE/AF not taken on every layer");
+    }
+    expect_same_logits(sparse_logits, bitmap_logits, "bitmap vs sparse");
+    std::printf("[m28] bitmap_tokens=%u\n", (unsigned)bitmap_tokens);
+}
+
+} // namespace
+
+int main() {
+    test_row_words_match_rings();
+    check_bitmap_matches_csr(0x2468u, 1u, "bitmap vs csr (half masked)");
+    check_bitmap_matches_csr(0x9E37u, 3u, "bitmap vs csr (mostly masked)");
+    check_bitmap_matches_csr(0x4242u, 0u, "bitmap vs csr (unmasked)");
+    test_all_masked();
+    test_top_wiring();
+    std::printf("PASS: tb_attn_mask_bitmap_m28\n");
+    return 0;
+}
@@ -0,0 +1,238 @@
+// M32: load-time ring mask bitmaps.
+// Checks that LOAD_W completion expands the latched src_mask bitpack into
+// SCR_ATTN_RING_BITMAP (one-ring / second-ring allowed keys, one word per 32
+// keys), that the bitmaps list exactly the CSR keys, that LOAD_W accept drops
+// them and that SET_W_BASE reselecting a resident slot rebuilds them.
+
+#define AECCT_PARAM_SLOT_COUNT 2
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "Top.h"
+
+namespace {
+
+typedef std::vector<uint32_t> param_vec_t;
+
+const uint32_t kRowWords = sram_map::ATTN_RING_BITMAP_ROW_WORDS;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+void expect_rsp(aecct::u16_t rsp, uint8_t kind, uint8_t payload, const char* tag) {
+    if (aecct::unpack_ctrl_rsp_kind(rsp) != kind || aecct::unpack_ctrl_rsp_payload(rsp) != payload) {
+        std::printf("ERROR: %s rsp kind=%u payload=%u\n", tag,
+            (unsigned)aecct::unpack_ctrl_rsp_kind(rsp), (unsigned)aecct::unpack_ctrl_rsp_payload(rsp));
+        std::exit(1);
+    }
+}
+
+struct Harness {
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+
+    void cmd(uint8_t opcode) {
+        ctrl_cmd.write(aecct::pack_ctrl_cmd(opcode));
+        aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+    }
+
+    aecct::u16_t last_rsp() {
+        aecct::u16_t last = 0;
+        aecct::u16_t w;
+        while (ctrl_rsp.nb_read(w)) {
+            last = w;
+        }
+        return last;
+    }
+
+    void session() {
+        cmd((uint8_t)aecct::OP_SOFT_RESET);
+        uint32_t cfg_words[EXP_LEN_CFG_WORDS];
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            cfg_words[i] = 0u;
+        }
+        cfg_words[CFG_CODE_N] = CODE_N;
+        cfg_words[CFG_CODE_K] = CODE_K;
+        cfg_words[CFG_CODE_C] = CODE_C;
+        cfg_words[CFG_N_NODES] = N_NODES;
+        cfg_words[CFG_D_MODEL] = D_MODEL;
+        cfg_words[CFG_N_HEAD] = N_HEAD;
+        cfg_words[CFG_N_LAYERS] = N_LAYERS;
+        cfg_words[CFG_D_FFN] = D_FFN;
+        cfg_words[CFG_ENABLE_LPE] = 1u;
+        cfg_words[CFG_ENABLE_LPE_TOKEN] = 1u;
+        cfg_words[CFG_OUT_MODE] = 1u;
+        cmd((uint8_t)aecct::OP_CFG_BEGIN);
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            data_in.write((aecct::u32_t)cfg_words[i]);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        cmd((uint8_t)aecct::OP_CFG_COMMIT);
+        (void)last_rsp();
+    }
+
+    aecct::u16_t set_w_base(uint32_t base) {
+        data_in.write((aecct::u32_t)base);
+        cmd((uint8_t)aecct::OP_SET_W_BASE);
+        return last_rsp();
+    }
+
+    aecct::u16_t load_w(const param_vec_t& param) {
+        cmd((uint8_t)aecct::OP_LOAD_W);
+        for (uint32_t i = 0; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+            data_in.write((aecct::u32_t)param[i]);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        return last_rsp();
+    }
+};
+
+// Random src_mask over a zero image; mask_shift thins the masked pairs.
+void build_image(param_vec_t& param, uint32_t seed, uint32_t mask_shift) {
+    param.assign((uint32_t)EXP_LEN_PARAM_WORDS, 0u);
+    const uint32_t mask_off = kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+    uint32_t s = seed;
+    for (uint32_t i = 0u; i < N_NODES * N_NODES; ++i) {
+        s = s * 1664525u + 1013904223u;
+        if (((s >> 16) & ((1u << mask_shift) - 1u)) == 0u) {
+            param[mask_off + (i >> 5)] |= (1u << (i & 31u));
+        }
+    }
+}
+
+bool expected_allowed(const param_vec_t& param, uint32_t ring, uint32_t i, uint32_t j) {
+    const uint32_t mask_off = kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+    const uint32_t bit = i * N_NODES + j;
+    const bool masked = ((param[mask_off + (bit >> 5)] >> (bit & 31u)) & 1u) != 0u;
+    return aecct::attn_mask_ring_allows(ring, i, j) && !masked;
+}
+
+// Every ring row word, padding bits past N_NODES included.
+void expect_bitmaps(const param_vec_t& param, const char* tag) {
+    if (!aecct::top_peek_attn_ring_bitmap_valid()) {
+        std::printf("ERROR: %s ring bitmaps not valid\n", tag);
+        std::exit(1);
+    }
+    const aecct::u32_t* sram = aecct::top_sram();
+    for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        for (uint32_t i = 0u; i < N_NODES; ++i) {
+            const uint32_t row_base =
+                aecct::attn_mask_ring_bitmap_row_base_word(sram_map::BASE_SCR_ATTN_RING_BITMAP_W, r, i);
+            for (uint32_t c = 0u; c < kRowWords; ++c) {
+                uint32_t expect = 0u;
+                for (uint32_t b = 0u; b < 32u; ++b) {
+                    const uint32_t j = c * 32u + b;
+                    if (j < N_NODES && expected_allowed(param, r, i, j)) {
+                        expect |= (1u << b);
+                    }
+                }
+                const uint32_t got = (uint32_t)sram[row_base + c].to_uint();
+                if (got != expect) {
+                    std::printf("ERROR: %s ring=%u row=%u word=%u got=0x%08X expect=0x%08X\n", tag,
+                        (unsigned)r, (unsigned)i, (unsigned)c, (unsigned)got, (unsigned)expect);
+                    std::exit(1);
+                }
+            }
+        }
+    }
+}
+
+// The bitmaps and the CSR describe the same keys in the same ascending order.
+void expect_bitmaps_match_csr(const char* tag) {
+    const aecct::u32_t* sram = aecct::top_sram();
+    for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        const uint32_t ring_base = aecct::attn_mask_csr_ring_base_word(sram_map::BASE_SCR_ATTN_CSR_W, r);
+        const uint32_t col_base = ring_base + sram_map::ATTN_CSR_ROW_PTR_WORDS;
+        for (uint32_t i = 0u; i < N_NODES; ++i) {
+            uint32_t e = (uint32_t)sram[ring_base + i].to_uint();
+            const uint32_t e_end = (uint32_t)sram[ring_base + i + 1u].to_uint();
+            const uint32_t row_base =
+                aecct::attn_mask_ring_bitmap_row_base_word(sram_map::BASE_SCR_ATTN_RING_BITMAP_W, r, i);
+            for (uint32_t c = 0u; c < kRowWords; ++c) {
+                for (uint32_t w = (uint32_t)sram[row_base + c].to_uint(); w != 0u; w &= (w - 1u)) {
+                    const uint32_t j = c * 32u + aecct::ctz_u32(w);
+                    if (e >= e_end || aecct::attn_mask_csr_key(sram, col_base, e) != j) {
+                        std::printf("ERROR: %s ring=%u row=%u key=%u not in CSR order\n", tag,
+                            (unsigned)r, (unsigned)i, (unsigned)j);
+                        std::exit(1);
+                    }
+                    ++e;
+                }
+            }
+            if (e != e_end) {
+                std::printf("ERROR: %s ring=%u row=%u CSR has extra keys\n", tag, (unsigned)r, (unsigned)i);
+                std::exit(1);
+            }
+        }
+    }
+}
+
+void scribble_bitmaps() {
+    aecct::u32_t* sram = aecct::top_sram();
+    for (uint32_t i = 0u; i < sram_map::SIZE_SCR_ATTN_RING_BITMAP_W; ++i) {
+        sram[sram_map::BASE_SCR_ATTN_RING_BITMAP_W + i] = (aecct::u32_t)0xDEADBEEFu;
+    }
+}
+
+} // namespace
+
+int main() {
+    static_assert(sram_map::BASE_SCR_ATTN_RING_BITMAP_W + sram_map::SIZE_SCR_ATTN_RING_BITMAP_W <=
+        sram_map::BASE_SCRATCH_W + sram_map::SIZE_SCRATCH_W, "ring bitmaps must stay inside SCRATCH");
+
+    Harness hx;
+    param_vec_t img0;
+    param_vec_t img1;
+    build_image(img0, 0x1234u, 1u);
+    build_image(img1, 0xBEEFu, 3u);
+    const uint32_t slot0 = sram_map::param_slot_base_w(0u);
+    const uint32_t slot1 = sram_map::param_slot_base_w(1u);
+    const uint8_t kOk = (uint8_t)aecct::RSP_OK;
+    const uint8_t kDone = (uint8_t)aecct::RSP_DONE;
+
+    hx.session();
+    if (aecct::top_peek_attn_ring_bitmap_valid()) {
+        fail("ring bitmaps valid after reset");
+    }
+
+    expect_rsp(hx.set_w_base(slot0), kOk, (uint8_t)aecct::OP_SET_W_BASE, "SET_W_BASE slot0");
+    expect_rsp(hx.load_w(img0), kDone, (uint8_t)aecct::OP_LOAD_W, "LOAD_W slot0");
+    expect_bitmaps(img0, "slot0 commit");
+    expect_bitmaps_match_csr("slot0 commit");
+
+    // Slot 1 commit rebuilds the bitmaps for its own src_mask.
+    expect_rsp(hx.set_w_base(slot1), kOk, (uint8_t)aecct::OP_SET_W_BASE, "SET_W_BASE slot1");
+    if (aecct::top_peek_attn_ring_bitmap_valid()) {
+        fail("empty slot inherited ring bitmaps");
+    }
+    expect_rsp(hx.load_w(img1), kDone, (uint8_t)aecct::OP_LOAD_W, "LOAD_W slot1");
+    expect_bitmaps(img1, "slot1 commit");
+    expect_bitmaps_match_csr("slot1 commit");
+
+    // Reselecting slot 0 re-expands its latched bitpack without a LOAD_W.
+    scribble_bitmaps();
+    expect_rsp(hx.set_w_base(slot0), kOk, (uint8_t)aecct::OP_SET_W_BASE, "reselect slot0");
+    expect_bitmaps(img0, "slot0 reselect");
+
+    // LOAD_W accept drops the bitmaps until the new image commits.
+    hx.cmd((uint8_t)aecct::OP_LOAD_W);
+    expect_rsp(hx.last_rsp(), kOk, (uint8_t)aecct::OP_LOAD_W, "LOAD_W accept");
+    if (aecct::top_peek_attn_ring_bitmap_valid()) {
+        fail("ring bitmaps valid during PARAM_RX");
+    }
+
+    std::printf("PASS: tb_attn_ring_bitmap_m32\n");
+    return 0;
+}
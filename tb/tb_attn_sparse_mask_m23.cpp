@@ -0,0 +1,329 @@
+// M23: sparse Phase-B attention over the src_mask CSR.
+// Checks the SCR_ATTN_CSR build against the ring masks, sparse AE/AF against the
+// dense mainline with full key lists, sparse AE/AF against a masked online-softmax
+// oracle, and the LOAD_W build plus opt-in INFER wiring in Top.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "tb_top_infer_common.h"
+
+namespace {
+
+using namespace top_infer_tb;
+
+void check_csr_matches_mask(const sram_vec_t& sram, const uint32_t* mask_words, const aecct::u32_t* nnz) {
+    const uint32_t csr_base = (uint32_t)sram_map::BASE_SCR_ATTN_CSR_W;
+    for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        const uint32_t ring_base = aecct::attn_mask_csr_ring_base_word(csr_base, r);
+        const uint32_t col_base = ring_base + sram_map::ATTN_CSR_ROW_PTR_WORDS;
+        uint32_t e = 0u;
+        for (uint32_t i = 0u; i < kTokens; ++i) {
+            if ((uint32_t)sram[ring_base + i].to_uint() != e) {
+                std::printf("ERROR: ring %u row_ptr[%u] mismatch\n", (unsigned)r, (unsigned)i);
+                std::exit(1);
+            }
+            for (uint32_t j = 0u; j < kTokens; ++j) {
+                if (!mask_allows(mask_words, r, i, j)) {
+                    continue;
+                }
+                if (aecct::attn_mask_csr_key(sram.data(), col_base, e) != j) {
+                    std::printf("ERROR: ring %u row %u key %u mismatch\n", (unsigned)r, (unsigned)i, (unsigned)j);
+                    std::exit(1);
+                }
+                ++e;
+            }
+        }
+        if ((uint32_t)sram[ring_base + kTokens].to_uint() != e || (uint32_t)nnz[r].to_uint() != e) {
+            std::printf("ERROR: ring %u nnz mismatch\n", (unsigned)r);
+            std::exit(1);
+        }
+    }
+}
+
+// Every row lists all keys in ascending order, for both rings.
+void write_full_csr(sram_vec_t& sram) {
+    const uint32_t csr_base = (uint32_t)sram_map::BASE_SCR_ATTN_CSR_W;
+    for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        const uint32_t ring_base = aecct::attn_mask_csr_ring_base_word(csr_base, r);
+        const uint32_t col_base = ring_base + sram_map::ATTN_CSR_ROW_PTR_WORDS;
+        for (uint32_t i = 0u; i <= kTokens; ++i) {
+            sram[ring_base + i] = (aecct::u32_t)(i * kTokens);
+        }
+        for (uint32_t w = 0u; w < sram_map::ATTN_CSR_COL_WORDS; ++w) {
+            uint32_t pack = 0u;
+            for (uint32_t lane = 0u; lane < 4u; ++lane) {
+                const uint32_t e = w * 4u + lane;
+                if (e < kTokens * kTokens) {
+                    pack |= ((e % kTokens) << (lane * 8u));
+                }
+            }
+            sram[col_base + w] = (aecct::u32_t)pack;
+        }
+    }
+}
+
+void run_sparse_all_tokens(sram_vec_t& sram, const aecct::AttnScratch& sc, uint32_t out_base) {
+    const aecct::AttnCfg cfg = make_cfg();
+    aecct::u32_t* view = sram.data();
+    for (uint32_t t = 0u; t < kTokens; ++t) {
+        if (!aecct::attn_phaseb_sparse_qk_score(view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W)) {
+            fail("sparse AE rejected token");
+        }
+        if (!aecct::attn_phaseb_sparse_softmax_out(view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)out_base, (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W)) {
+            fail("sparse AF rejected token");
+        }
+    }
+}
+
+// Masked dense online softmax using the same fixed-point chain as the design.
+void masked_oracle(
+    const sram_vec_t& sram,
+    const aecct::AttnScratch& sc,
+    const uint32_t* mask_words,
+    uint32_t t,
+    uint32_t h,
+    uint32_t* out_bits
+) {
+    const uint32_t ring = aecct::attn_mask_csr_ring_from_head_group(aecct::attn_phaseb_head_group_id_from_head_idx(h));
+    const uint32_t q_row = (uint32_t)sc.q_base_word.to_uint() + t * kDModel + h * kDHead;
+    const aecct::quant_acc_t inv_sqrt_d_head = aecct::attn_phaseb_inv_sqrt_d_head(kDHead);
+    softmax_score_t running_max = softmax_score_t(0);
+    softmax_sum_t running_l = softmax_sum_t(0);
+    aecct::quant_acc_t acc[kDHead];
+    bool have_state = false;
+    for (uint32_t j = 0u; j < kTokens; ++j) {
+        if (!mask_allows(mask_words, ring, t, j)) {
+            continue;
+        }
+        const uint32_t k_row = (uint32_t)sc.k_base_word.to_uint() + j * kDModel + h * kDHead;
+        const uint32_t v_row = (uint32_t)sc.v_base_word.to_uint() + j * kDModel + h * kDHead;
+        aecct::quant_acc_t dot = aecct::quant_acc_t(0);
+        for (uint32_t d = 0u; d < kDHead; ++d) {
+            dot += aecct::quant_acc_t(aecct::quant_act_from_bits(sram[q_row + d])) *
+                aecct::quant_acc_t(aecct::quant_act_from_bits(sram[k_row + d]));
+        }
+        const aecct::u32_t score_bits = aecct::quant_bits_from_acc(dot * inv_sqrt_d_head);
+        const softmax_score_t score = aecct::fp32_from_bits(score_bits)
+            .template convert_to_ac_fixed<18, 6, true, AC_RND, AC_SAT>(false);
+        if (!have_state) {
+            running_max = score;
+            running_l = softmax_sum_t(1);
+            for (uint32_t d = 0u; d < kDHead; ++d) {
+                acc[d] = aecct::quant_acc_t(aecct::quant_act_from_bits(sram[v_row + d]));
+            }
+            have_state = true;
+        } else if (score > running_max) {
+            const softmax_exp_t alpha = softmax_exp_lut(softmax_x_t(running_max - score));
+            running_l = softmax_sum_t(running_l * softmax_sum_t(alpha)) + softmax_sum_t(1);
+            for (uint32_t d = 0u; d < kDHead; ++d) {
+                acc[d] = aecct::quant_acc_t(acc[d] * aecct::quant_acc_t(alpha)) +
+                    aecct::quant_acc_t(aecct::quant_act_from_bits(sram[v_row + d]));
+            }
+            running_max = score;
+        } else {
+            const softmax_exp_t beta = softmax_exp_lut(softmax_x_t(score - running_max));
+            running_l += softmax_sum_t(beta);
+            for (uint32_t d = 0u; d < kDHead; ++d) {
+                acc[d] += aecct::quant_acc_t(beta) *
+                    aecct::quant_acc_t(aecct::quant_act_from_bits(sram[v_row + d]));
+            }
+        }
+    }
+    const softmax_inv_t inv_l = have_state ? softmax_rcp_lut(running_l) : softmax_inv_t(0);
+    for (uint32_t d = 0u; d < kDHead; ++d) {
+        out_bits[d] = have_state ?
+            (uint32_t)aecct::quant_bits_from_acc(acc[d] * aecct::quant_acc_t(inv_l)).to_uint() :
+            (uint32_t)aecct::quant_bits_from_acc(aecct::quant_acc_t(0)).to_uint();
+    }
+}
+
+void test_csr_build() {
+    sram_vec_t sram(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    uint32_t mask_words[SRC_MASK_WORDS_BITPACK];
+    for (uint32_t shift = 0u; shift < 4u; ++shift) {
+        fill_mask(sram, 0x1234u + shift, shift);
+        snapshot_mask(sram, mask_words);
+        aecct::u32_t nnz[sram_map::ATTN_CSR_RINGS];
+        aecct::u32_t* view = sram.data();
+        if (!aecct::attn_mask_csr_build(view, (aecct::u32_t)sram_map::PARAM_BASE_DEFAULT,
+                (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W, nnz)) {
+            fail("CSR build rejected");
+        }
+        check_csr_matches_mask(sram, mask_words, nnz);
+    }
+}
+
+void test_full_csr_matches_dense() {
+    const aecct::AttnScratch sc = aecct::default_attn_scratch();
+    const aecct::AttnCfg cfg = make_cfg();
+    const uint32_t out_base = (uint32_t)aecct::ATTN_OUT_BASE_WORD_DEFAULT;
+    sram_vec_t dense(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    fill_qkv(dense, sc, 0xBEEFu);
+    sram_vec_t sparse = dense;
+
+    aecct::u32_t* view = dense.data();
+    for (uint32_t t = 0u; t < kTokens; ++t) {
+        bool fb = true;
+        if (!aecct::attn_phaseb_top_managed_qk_score_mainline(view, cfg, sc, (aecct::u32_t)t, fb) || fb) {
+            fail("dense AE rejected token");
+        }
+        fb = true;
+        if (!aecct::attn_phaseb_top_managed_softmax_out_mainline(view, cfg, sc, (aecct::u32_t)t,
+                (aecct::u32_t)out_base, fb) || fb) {
+            fail("dense AF rejected token");
+        }
+    }
+
+    write_full_csr(sparse);
+    run_sparse_all_tokens(sparse, sc, out_base);
+    compare_rows(dense, sparse, (uint32_t)sc.pre_concat_base_word.to_uint(), "full-CSR pre_concat");
+    compare_rows(dense, sparse, (uint32_t)sc.post_concat_base_word.to_uint(), "full-CSR post_concat");
+    compare_rows(dense, sparse, out_base, "full-CSR attn_out");
+}
+
+void test_masked_matches_oracle() {
+    const aecct::AttnScratch sc = aecct::default_attn_scratch();
+    const uint32_t out_base = (uint32_t)aecct::ATTN_OUT_BASE_WORD_DEFAULT;
+    sram_vec_t sram(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    uint32_t mask_words[SRC_MASK_WORDS_BITPACK];
+    fill_mask(sram, 0x77u, 1u);
+    // Mask every key of query 3 so both rings hit the empty-row path.
+    for (uint32_t j = 0u; j < kTokens; ++j) {
+        const uint32_t bit = 3u * kTokens + j;
+        sram[mask_base_word() + (bit >> 5)] =
+            (aecct::u32_t)((uint32_t)sram[mask_base_word() + (bit >> 5)].to_uint() | (1u << (bit & 31u)));
+    }
+    snapshot_mask(sram, mask_words);
+    aecct::u32_t nnz[sram_map::ATTN_CSR_RINGS];
+    aecct::u32_t* view = sram.data();
+    aecct::attn_mask_csr_build(view, (aecct::u32_t)sram_map::PARAM_BASE_DEFAULT,
+        (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W, nnz);
+    // Q/K/V are written after the CSR is built, as in INFER.
+    fill_qkv(sram, sc, 0x5EEDu);
+    run_sparse_all_tokens(sram, sc, out_base);
+
+    for (uint32_t t = 0u; t < kTokens; ++t) {
+        for (uint32_t h = 0u; h < kHeads; ++h) {
+            uint32_t exp_bits[kDHead];
+            masked_oracle(sram, sc, mask_words, t, h, exp_bits);
+            for (uint32_t d = 0u; d < kDHead; ++d) {
+                const uint32_t off = t * kDModel + h * kDHead + d;
+                if ((uint32_t)sram[out_base + off].to_uint() != exp_bits[d] ||
+                    (uint32_t)sram[(uint32_t)sc.post_concat_base_word.to_uint() + off].to_uint() != exp_bits[d]) {
+                    std::printf("ERROR: masked sparse mismatch token=%u head=%u d=%u\n",
+                        (unsigned)t, (unsigned)h, (unsigned)d);
+                    std::exit(1);
+                }
+            }
+        }
+    }
+}
+
+// Fresh session on the image; checks the LOAD_W CSR build before INFER and returns
+// the sparse token count.
+uint32_t run_top_infer(const param_vec_t& param, uint32_t features, uint32_t* logits) {
+    TopSession hx;
+    hx.configure((uint32_t)N_LAYERS, features);
+    hx.load_w_begin();
+    if (aecct::top_peek_attn_mask_csr_valid()) {
+        fail("CSR must be invalid while LOAD_W is in flight");
+    }
+    hx.stream_param(&param);
+    if (!aecct::top_peek_attn_mask_csr_valid()) {
+        fail("CSR not built at LOAD_W completion");
+    }
+
+    uint32_t mask_words[SRC_MASK_WORDS_BITPACK];
+    const uint32_t mask_off = kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+    for (uint32_t w = 0u; w < SRC_MASK_WORDS_BITPACK; ++w) {
+        mask_words[w] = param[mask_off + w];
+    }
+    for (uint32_t r = 0u; r < sram_map::ATTN_CSR_RINGS; ++r) {
+        uint32_t nnz = 0u;
+        for (uint32_t i = 0u; i < kTokens; ++i) {
+            for (uint32_t j = 0u; j < kTokens; ++j) {
+                nnz += mask_allows(mask_words, r, i, j) ? 1u : 0u;
+            }
+        }
+        if ((uint32_t)aecct::top_peek_attn_mask_csr_nnz(r).to_uint() != nnz) {
+            fail("Top CSR nnz mismatch");
+        }
+    }
+
+    hx.set_outmode();
+    hx.infer(0u, logits);
+    return (uint32_t)aecct::top_peek_attn_sparse_token_count().to_uint();
+}
+
+// Every Phase-B feature moves all layers onto the managed path, so each mode must
+// visit N_LAYERS * N_NODES query tokens. Sparse CSR, ring bitmap and fused+CSR filter
+// keys through different tables and loops; with the same src_mask their logits must
+// agree bit-exactly and differ from the unmasked managed run (ATTN_FUSED alone).
+void test_top_wiring() {
+    param_vec_t param;
+    build_param_image(param, 0x38u, 0x2468u);
+    const uint32_t layer_tokens = kTokens * (uint32_t)N_LAYERS;
+    static uint32_t dense_logits[kLogitWords];
+    static uint32_t unmasked_logits[kLogitWords];
+    static uint32_t sparse_logits[kLogitWords];
+    static uint32_t bitmap_logits[kLogitWords];
+    static uint32_t fused_sparse_logits[kLogitWords];
+    if (run_top_infer(param, 0u, dense_logits) != 0u) {
+        fail("sparse path taken while disabled");
+    }
+
+    run_top_infer(param, (uint32_t)CFG_FEAT_ATTN_FUSED, unmasked_logits);
+    if ((uint32_t)aecct::top_peek_attn_fused_token_count().to_uint() != layer_tokens) {
+        fail("fused AE/AF not taken on every layer");
+    }
+
+    const uint32_t sparse_tokens = run_top_infer(param, (uint32_t)CFG_FEAT_ATTN_SPARSE, sparse_logits);
+    if (sparse_tokens != layer_tokens ||
+        !aecct::top_peek_p11ae_mainline_score_path_taken() ||
+        !aecct::top_peek_p11af_mainline_softmax_output_path_taken()) {
+        fail("sparse AE/AF not taken on every layer");
+    }
+
+    run_top_infer(param, (uint32_t)CFG_FEAT_ATTN_MASK_BITMAP, bitmap_logits);
+    if ((uint32_t)aecct::top_peek_attn_bitmap_token_count().to_uint() != layer_tokens) {
+        fail("bitmap AE/AF not taken on every layer");
+    }
+
+    const uint32_t fused_sparse_tokens = run_top_infer(
+        param, (uint32_t)(CFG_FEAT_ATTN_FUSED | CFG_FEAT_ATTN_SPARSE), fused_sparse_logits);
+    if (fused_sparse_tokens != layer_tokens) {
+        fail("fused+sparse AE/AF not taken on every layer");
+    }
+
+    if (count_logit_diffs(sparse_logits, bitmap_logits) != 0u) {
+        fail("sparse vs bitmap logits mismatch");
+    }
+    if (count_logit_diffs(sparse_logits, fused_sparse_logits) != 0u) {
+        fail("sparse vs fused+sparse logits mismatch");
+    }
+    const uint32_t masked_diffs = count_logit_diffs(sparse_logits, unmasked_logits);
+    if (masked_diffs == 0u) {
+        fail("src_mask did not change the logits");
+    }
+    std::printf("[m23] sparse_tokens=%u nnz_one=%u nnz_second=%u masked_vs_unmasked_diffs=%u\n",
+        (unsigned)sparse_tokens,
+        (unsigned)aecct::top_peek_attn_mask_csr_nnz(0u).to_uint(),
+        (unsigned)aecct::top_peek_attn_mask_csr_nnz(1u).to_uint(),
+        (unsigned)masked_diffs);
+}
+
+} // namespace
+
+int main() {
+    test_csr_build();
+    test_full_csr_matches_dense();
+    test_masked_matches_oracle();
+    test_top_wiring();
+    std::printf("PASS: tb_attn_sparse_mask_m23\n");
+    return 0;
+}
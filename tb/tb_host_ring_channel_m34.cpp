@@ -0,0 +1,215 @@
+// M34: host ring-buffer channel.
+// Builds with AECCT_HOST_RING_CHANNEL so data_ch_t / ctrl_ch_t and the Preproc
+// packet channels use HostRingChannel. Checks ac_channel semantics (FIFO order,
+// size / empty / available, nb_read / nb_peek on empty, operator[], growth past
+// the initial depth, reset, init constructors), runs a LOAD_W through Top on the
+// ring channels, and times the ring against the std::deque ac_channel for a bulk
+// stream and a one-in / one-out pattern like Top's per-call traffic.
+
+#define AECCT_HOST_RING_CHANNEL
+#define AECCT_HOST_RING_CHANNEL_DEPTH 64u
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "Top.h"
+#include "blocks/PreprocTransportTypes.h"
+
+namespace {
+
+// Same payload as u32_t, but not specialized, so ac_channel keeps its deque.
+struct DequeWord {
+    aecct::u32_t w;
+};
+
+const uint32_t kBenchWords = 1u << 20;
+const uint32_t kBenchRounds = 8u;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+void check_semantics() {
+    aecct::data_ch_t ch;
+    aecct::u32_t w = 0;
+    if (!ch.empty() || ch.size() != 0u || ch.nb_read(w) || ch.nb_peek(w) || ch.available(1u)) {
+        fail("fresh channel not empty");
+    }
+    const uint32_t n = 5u * AECCT_HOST_RING_CHANNEL_DEPTH + 3u;
+    for (uint32_t i = 0u; i < n; ++i) {
+        if (!ch.nb_write((aecct::u32_t)(i * 3u + 1u))) {
+            fail("nb_write refused");
+        }
+        if (i == 10u) {
+            aecct::u32_t first;
+            ch.read(first);
+            if ((uint32_t)first.to_uint() != 1u) {
+                fail("read order before growth");
+            }
+        }
+    }
+    if (ch.size() != n - 1u || !ch.available(n - 1u) || ch.available(n)) {
+        fail("size after growth");
+    }
+    if ((uint32_t)ch[0].to_uint() != 4u || (uint32_t)ch[n - 2u].to_uint() != (n - 1u) * 3u + 1u) {
+        fail("operator[] after growth");
+    }
+    if ((uint32_t)ch.peek().to_uint() != 4u) {
+        fail("peek");
+    }
+    for (uint32_t i = 1u; i < n; ++i) {
+        if (!ch.nb_read(w) || (uint32_t)w.to_uint() != i * 3u + 1u) {
+            fail("FIFO order after growth");
+        }
+    }
+    if (!ch.empty() || ch.nb_read(w)) {
+        fail("drained channel not empty");
+    }
+    ch.write((aecct::u32_t)9u);
+    ch.reset();
+    if (!ch.empty()) {
+        fail("reset left data");
+    }
+    (void)ch.get_size_call_count();
+    (void)ch.size();
+    if (ch.get_size_call_count() != 1) {
+        fail("size call count");
+    }
+
+    aecct::ctrl_ch_t init_ch(3, (aecct::u16_t)0x55u);
+    if (init_ch.size() != 3u || (uint32_t)init_ch.read().to_uint() != 0x55u) {
+        fail("init constructor");
+    }
+
+    aecct::preproc_x_out_ch_t pkt_ch;
+    aecct::PreprocXOutPacket pkt = aecct::PreprocXOutPacket();
+    pkt_ch.write(pkt);
+    if (pkt_ch.size() != 1u || !pkt_ch.nb_read(pkt) || !pkt_ch.empty()) {
+        fail("Preproc packet channel");
+    }
+}
+
+void cmd(aecct::ctrl_ch_t& ctrl_cmd, aecct::ctrl_ch_t& ctrl_rsp, aecct::data_ch_t& data_in,
+         aecct::data_ch_t& data_out, uint8_t opcode) {
+    ctrl_cmd.write(aecct::pack_ctrl_cmd(opcode));
+    aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+}
+
+void check_top_load_w() {
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+    cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_SOFT_RESET);
+    uint32_t cfg_words[EXP_LEN_CFG_WORDS];
+    for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+        cfg_words[i] = 0u;
+    }
+    cfg_words[CFG_CODE_N] = CODE_N;
+    cfg_words[CFG_CODE_K] = CODE_K;
+    cfg_words[CFG_CODE_C] = CODE_C;
+    cfg_words[CFG_N_NODES] = N_NODES;
+    cfg_words[CFG_D_MODEL] = D_MODEL;
+    cfg_words[CFG_N_HEAD] = N_HEAD;
+    cfg_words[CFG_N_LAYERS] = N_LAYERS;
+    cfg_words[CFG_D_FFN] = D_FFN;
+    cfg_words[CFG_ENABLE_LPE] = 1u;
+    cfg_words[CFG_ENABLE_LPE_TOKEN] = 1u;
+    cfg_words[CFG_OUT_MODE] = 1u;
+    cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_CFG_BEGIN);
+    for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+        data_in.write((aecct::u32_t)cfg_words[i]);
+        aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+    }
+    cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_CFG_COMMIT);
+    data_in.write((aecct::u32_t)sram_map::PARAM_BASE_DEFAULT);
+    cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_SET_W_BASE);
+    cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_LOAD_W);
+    // Whole image queued up front: the ring grows well past its initial depth.
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        data_in.write((aecct::u32_t)(0x3F800000u ^ (i * 2654435761u & 0x007FFFFFu)));
+    }
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+    }
+    aecct::u16_t rsp = 0;
+    aecct::u16_t w;
+    while (ctrl_rsp.nb_read(w)) {
+        rsp = w;
+    }
+    if (aecct::unpack_ctrl_rsp_kind(rsp) != (uint8_t)aecct::RSP_DONE || !data_in.empty()) {
+        fail("LOAD_W over ring channels");
+    }
+    const aecct::u32_t* sram = aecct::top_sram();
+    const uint32_t last = (uint32_t)EXP_LEN_PARAM_WORDS - 1u;
+    if ((uint32_t)sram[sram_map::PARAM_BASE_DEFAULT + last].to_uint() !=
+        (0x3F800000u ^ (last * 2654435761u & 0x007FFFFFu))) {
+        fail("LOAD_W word mismatch");
+    }
+}
+
+template<typename Chan, typename Elem>
+double bench_bulk(uint32_t& sink) {
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (uint32_t r = 0u; r < kBenchRounds; ++r) {
+        Chan ch;
+        Elem e;
+        for (uint32_t i = 0u; i < kBenchWords; ++i) {
+            e.w = (aecct::u32_t)i;
+            ch.write(e);
+        }
+        while (ch.nb_read(e)) {
+            sink += (uint32_t)e.w.to_uint();
+        }
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+template<typename Chan, typename Elem>
+double bench_pingpong(uint32_t& sink) {
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    Chan ch;
+    Elem e;
+    for (uint32_t i = 0u; i < kBenchRounds * kBenchWords; ++i) {
+        e.w = (aecct::u32_t)i;
+        ch.write(e);
+        if (!ch.empty() && ch.nb_read(e)) {
+            sink += (uint32_t)e.w.to_uint();
+        }
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Adapts data_ch_t to the .w element shape the bench templates use.
+struct RingWordChan {
+    aecct::data_ch_t ch;
+    void write(const DequeWord& e) { ch.write(e.w); }
+    bool nb_read(DequeWord& e) { return ch.nb_read(e.w); }
+    bool empty() { return ch.empty(); }
+};
+
+} // namespace
+
+int main() {
+    check_semantics();
+    check_top_load_w();
+
+    uint32_t sink = 0u;
+    const double deque_bulk = bench_bulk<ac_channel<DequeWord>, DequeWord>(sink);
+    const double ring_bulk = bench_bulk<RingWordChan, DequeWord>(sink);
+    const double deque_pp = bench_pingpong<ac_channel<DequeWord>, DequeWord>(sink);
+    const double ring_pp = bench_pingpong<RingWordChan, DequeWord>(sink);
+    std::printf("[m34] %u x %u words: bulk deque=%.1f ms ring=%.1f ms | ping-pong deque=%.1f ms ring=%.1f ms (sink=%08X)\n",
+        (unsigned)kBenchRounds, (unsigned)kBenchWords, deque_bulk, ring_bulk, deque_pp, ring_pp, (unsigned)sink);
+
+    std::printf("PASS: tb_host_ring_channel_m34\n");
+    return 0;
+}
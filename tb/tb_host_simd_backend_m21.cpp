@@ -0,0 +1,100 @@
+// M21: host SIMD/integer backend equivalence against the scalar ac_fixed path.
+// Built with AECCT_HOST_SIMD_ENABLE so the block hooks take the host backend; every
+// comparison below is against an inline scalar loop, so both sides must be bit-exact.
+
+#ifndef AECCT_HOST_SIMD_ENABLE
+#define AECCT_HOST_SIMD_ENABLE 1
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "AecctTypes.h"
+#include "QuantDesc.h"
+#include "blocks/FFNLayer0.h"
+#include "blocks/HostSimdMac.h"
+
+namespace {
+
+static void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+static uint32_t lcg_next(uint32_t& s) {
+    s = s * 1664525u + 1013904223u;
+    return s;
+}
+
+static int64_t acc_raw(const aecct::quant_acc_t& v) {
+    return (int64_t)v.template slc<32>(0).to_int();
+}
+
+static void check_self_check() {
+    const uint32_t mismatches = aecct::host_simd_self_check(0x51D0u, 4000u);
+    if (mismatches != 0u) {
+        std::printf("ERROR: host_simd_self_check mismatches=%u\n", (unsigned)mismatches);
+        std::exit(1);
+    }
+}
+
+// FFN tile hook: full tiles, short tiles, and accumulators pinned near both rails.
+static void check_ffn_mac_tile() {
+    uint32_t s = 0xFF1u;
+    for (uint32_t round = 0u; round < 20000u; ++round) {
+        aecct::FfnTopManagedTileMeta meta;
+        const uint32_t valid = 1u + (lcg_next(s) % (uint32_t)aecct::ATTN_TOP_MANAGED_WORK_TILE_WORDS);
+        meta.tile_valid_words = (aecct::u16_t)valid;
+        aecct::u32_t x_tile[aecct::ATTN_TOP_MANAGED_WORK_TILE_WORDS];
+        aecct::u32_t w_tile[aecct::ATTN_TOP_MANAGED_WORK_TILE_WORDS];
+        for (uint32_t i = 0u; i < valid; ++i) {
+            x_tile[i] = aecct::host_simd_self_check_word(s);
+            w_tile[i] = aecct::host_simd_self_check_word(s);
+        }
+        const int64_t seed_raw = (round & 3u) == 0u ?
+            ((round & 4u) ? (int64_t)2147000000ll : (int64_t)-2147000000ll) :
+            (int64_t)((int32_t)lcg_next(s) >> 4);
+        const aecct::quant_acc_t acc0 = aecct::host_simd_acc_from_raw(seed_raw);
+
+        aecct::quant_acc_t ref = acc0;
+        for (uint32_t i = 0u; i < valid; ++i) {
+            const aecct::quant_act_t xv = aecct::quant_act_from_bits(x_tile[i]);
+            const aecct::quant_w_t wv = aecct::quant_act_from_bits(w_tile[i]);
+            ref += aecct::quant_acc_t(xv) * aecct::quant_acc_t(wv);
+        }
+        const aecct::quant_acc_t got = aecct::ffn_block_mac_tile(meta, x_tile, w_tile, acc0);
+        if (acc_raw(ref) != acc_raw(got)) {
+            std::printf("ERROR: ffn_block_mac_tile mismatch round=%u ref=%lld got=%lld\n",
+                (unsigned)round, (long long)acc_raw(ref), (long long)acc_raw(got));
+            std::exit(1);
+        }
+    }
+}
+
+// Long dot (d_model-sized) that crosses the int32 rail mid-row must replay clipping in order.
+static void check_dot_saturation_replay() {
+    const uint32_t n = 32u;
+    aecct::u32_t a[32];
+    aecct::u32_t b[32];
+    for (uint32_t i = 0u; i < n; ++i) {
+        a[i] = (aecct::u32_t)0x41F80000u;                          // 31.0
+        b[i] = (i < 24u) ? (aecct::u32_t)0x41F80000u : (aecct::u32_t)0xC1F80000u;
+    }
+    const aecct::quant_acc_t acc0 = 0;
+    const aecct::quant_acc_t ref = aecct::host_simd_dot_act_scalar(a, b, n, acc0);
+    const aecct::quant_acc_t got = aecct::host_simd_dot_act(a, b, n, acc0);
+    if (acc_raw(ref) != acc_raw(got)) {
+        fail("saturating dot replay mismatch");
+    }
+}
+
+} // namespace
+
+int main() {
+    check_self_check();
+    check_ffn_mac_tile();
+    check_dot_saturation_replay();
+    std::printf("PASS: tb_host_simd_backend_m21\n");
+    return 0;
+}
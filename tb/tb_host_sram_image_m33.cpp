@@ -0,0 +1,209 @@
+// M33: host SRAM image.
+// Binds Top to a file-mapped HostSramImage, loads a PARAM image through LOAD_W
+// and checks the words land in the mapping. Snapshots W_REGION into a buffer
+// image, scribbles over it, diffs and restores it, runs a SramView block entry
+// point (attn_mask_csr_build) on the image, and reopens the file as a
+// checkpoint to resume with the same SRAM state.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "Top.h"
+
+namespace {
+
+typedef std::vector<uint32_t> param_vec_t;
+
+const uint32_t kParamWords = (uint32_t)EXP_LEN_PARAM_WORDS;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+void expect_rsp(aecct::u16_t rsp, uint8_t kind, uint8_t payload, const char* tag) {
+    if (aecct::unpack_ctrl_rsp_kind(rsp) != kind || aecct::unpack_ctrl_rsp_payload(rsp) != payload) {
+        std::printf("ERROR: %s rsp kind=%u payload=%u\n", tag,
+            (unsigned)aecct::unpack_ctrl_rsp_kind(rsp), (unsigned)aecct::unpack_ctrl_rsp_payload(rsp));
+        std::exit(1);
+    }
+}
+
+struct Harness {
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+
+    void cmd(uint8_t opcode) {
+        ctrl_cmd.write(aecct::pack_ctrl_cmd(opcode));
+        aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+    }
+
+    aecct::u16_t last_rsp() {
+        aecct::u16_t last = 0;
+        aecct::u16_t w;
+        while (ctrl_rsp.nb_read(w)) {
+            last = w;
+        }
+        return last;
+    }
+
+    void session() {
+        cmd((uint8_t)aecct::OP_SOFT_RESET);
+        uint32_t cfg_words[EXP_LEN_CFG_WORDS];
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            cfg_words[i] = 0u;
+        }
+        cfg_words[CFG_CODE_N] = CODE_N;
+        cfg_words[CFG_CODE_K] = CODE_K;
+        cfg_words[CFG_CODE_C] = CODE_C;
+        cfg_words[CFG_N_NODES] = N_NODES;
+        cfg_words[CFG_D_MODEL] = D_MODEL;
+        cfg_words[CFG_N_HEAD] = N_HEAD;
+        cfg_words[CFG_N_LAYERS] = N_LAYERS;
+        cfg_words[CFG_D_FFN] = D_FFN;
+        cfg_words[CFG_ENABLE_LPE] = 1u;
+        cfg_words[CFG_ENABLE_LPE_TOKEN] = 1u;
+        cfg_words[CFG_OUT_MODE] = 1u;
+        cmd((uint8_t)aecct::OP_CFG_BEGIN);
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            data_in.write((aecct::u32_t)cfg_words[i]);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        cmd((uint8_t)aecct::OP_CFG_COMMIT);
+        data_in.write((aecct::u32_t)sram_map::PARAM_BASE_DEFAULT);
+        cmd((uint8_t)aecct::OP_SET_W_BASE);
+        (void)last_rsp();
+    }
+
+    aecct::u16_t load_w(const param_vec_t& param) {
+        cmd((uint8_t)aecct::OP_LOAD_W);
+        for (uint32_t i = 0; i < kParamWords; ++i) {
+            data_in.write((aecct::u32_t)param[i]);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        return last_rsp();
+    }
+
+    uint32_t read_word(uint32_t addr) {
+        data_in.write((aecct::u32_t)addr);
+        data_in.write((aecct::u32_t)1u);
+        cmd((uint8_t)aecct::OP_READ_MEM);
+        expect_rsp(last_rsp(), (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_READ_MEM, "READ_MEM");
+        aecct::u32_t w;
+        if (!data_out.nb_read(w)) {
+            fail("READ_MEM returned no word");
+        }
+        return (uint32_t)w.to_uint();
+    }
+};
+
+void build_image(param_vec_t& param, uint32_t seed) {
+    param.assign(kParamWords, 0u);
+    for (uint32_t i = 0u; i < kParamWords; ++i) {
+        param[i] = 0x3C000000u | (((i + seed) * 2654435761u) & 0x003FFFFFu);
+    }
+}
+
+void expect_param(const aecct::HostSramImage& img, const param_vec_t& param, const char* tag) {
+    for (uint32_t i = 0u; i < kParamWords; ++i) {
+        if ((uint32_t)img[sram_map::PARAM_BASE_DEFAULT + i].to_uint() != param[i]) {
+            std::printf("ERROR: %s PARAM word %u\n", tag, (unsigned)i);
+            std::exit(1);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "tb_host_sram_image_m33.sram";
+    std::remove(path.c_str());
+
+    aecct::HostSramImage live;
+    if (!aecct::host_sram_image_open_file(live, path.c_str())) {
+        std::printf("SKIP: file-mapped SRAM image unavailable on this host\n");
+        std::printf("PASS: tb_host_sram_image_m33\n");
+        return 0;
+    }
+    if (!aecct::top_sram_bind(live) || aecct::top_sram() != live.words) {
+        fail("top_sram_bind did not take the mapped image");
+    }
+
+    Harness hx;
+    param_vec_t param;
+    build_image(param, 33u);
+    hx.session();
+    expect_rsp(hx.load_w(param), (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_LOAD_W, "LOAD_W");
+    expect_param(live, param, "mapped");
+
+    // Snapshot / diff / restore W_REGION through a buffer image.
+    std::vector<aecct::u32_t> snap_buf(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    aecct::HostSramImage snap;
+    if (!aecct::host_sram_image_attach(snap, snap_buf.data(), (uint32_t)snap_buf.size()) ||
+        !aecct::host_sram_image_snapshot(snap, live, sram_map::W_REGION_BASE, sram_map::W_REGION_WORDS)) {
+        fail("snapshot failed");
+    }
+    if (aecct::host_sram_image_diff(snap, live, sram_map::W_REGION_BASE, sram_map::W_REGION_WORDS) != 0u) {
+        fail("snapshot differs from live image");
+    }
+    const uint32_t poke = sram_map::PARAM_BASE_DEFAULT + 17u;
+    live[poke] = (aecct::u32_t)(param[17] ^ 0xFFFFFFFFu);
+    live[poke + 5u] = (aecct::u32_t)(param[22] ^ 0x1u);
+    uint32_t first = 0u;
+    if (aecct::host_sram_image_diff(snap, live, sram_map::W_REGION_BASE, sram_map::W_REGION_WORDS, &first) != 2u ||
+        first != poke) {
+        fail("diff did not find the two scribbled words");
+    }
+    if (hx.read_word(poke) != (param[17] ^ 0xFFFFFFFFu)) {
+        fail("READ_MEM does not see the mapped image");
+    }
+    if (!aecct::host_sram_image_restore(live, snap, sram_map::W_REGION_BASE, sram_map::W_REGION_WORDS) ||
+        hx.read_word(poke) != param[17]) {
+        fail("restore did not reach Top");
+    }
+    if (aecct::host_sram_image_diff(snap, live, 0u, sram_map::SRAM_WORDS_TOTAL + 1u) != sram_map::SRAM_WORDS_TOTAL + 2u) {
+        fail("out-of-range diff accepted");
+    }
+
+    // SramView entry point on the image matches Top's own CSR build.
+    aecct::HostSramImage csr_img;
+    std::vector<aecct::u32_t> csr_buf(snap_buf);
+    aecct::host_sram_image_attach(csr_img, csr_buf.data(), (uint32_t)csr_buf.size());
+    aecct::host_sram_image_copy(csr_img, live, sram_map::PARAM_BASE_DEFAULT, kParamWords);
+    if (!aecct::attn_mask_csr_build(csr_img, (aecct::u32_t)sram_map::PARAM_BASE_DEFAULT,
+            (aecct::u32_t)sram_map::BASE_SCR_ATTN_CSR_W) ||
+        aecct::host_sram_image_diff(csr_img, live, sram_map::BASE_SCR_ATTN_CSR_W, sram_map::SIZE_SCR_ATTN_CSR_W) != 0u) {
+        fail("CSR built on the image differs from Top");
+    }
+
+    // Checkpoint, then resume from a fresh mapping of the same file.
+    if (!aecct::host_sram_image_sync(live)) {
+        fail("sync failed");
+    }
+    aecct::top_sram_unbind();
+    aecct::host_sram_image_close(live);
+    aecct::HostSramImage resumed;
+    if (!aecct::host_sram_image_open_file(resumed, path.c_str()) || !aecct::top_sram_bind(resumed)) {
+        fail("reopen failed");
+    }
+    expect_param(resumed, param, "resumed");
+    if (hx.read_word(sram_map::PARAM_BASE_DEFAULT + kParamWords - 1u) != param[kParamWords - 1u]) {
+        fail("Top does not read the resumed image");
+    }
+
+    aecct::top_sram_unbind();
+    aecct::host_sram_image_close(resumed);
+    std::remove(path.c_str());
+    std::printf("PASS: tb_host_sram_image_m33\n");
+    return 0;
+}
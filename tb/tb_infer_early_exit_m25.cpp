@@ -0,0 +1,296 @@
+// M25: zero-syndrome INFER early exit.
+// Codewords whose hard decision satisfies every BCH check skip the layers and
+// FinalHead: logits stream as |y| and x_pred as hard(y). Non-codewords, and every
+// codeword while the gate is off, still take the full pipeline. The H rows are
+// latched at LOAD_W, so the check stays valid after a full-path codeword has
+// overlaid W_REGION with attention scratch. Also covers the overlapped batch.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "tb_top_infer_common.h"
+#include "weights.h"
+
+namespace {
+
+using namespace top_infer_tb;
+
+const uint32_t kInWords = (uint32_t)EXP_LEN_INFER_IN_WORDS;
+const uint32_t kOutWords = kLogitWords;
+const uint32_t kBatchCount = 4u;
+const uint32_t kDrainTickLimit = 64u;
+
+struct Codeword {
+    uint32_t y[EXP_LEN_INFER_IN_WORDS];
+};
+
+bool h_bit(uint32_t c, uint32_t v) {
+    return h_H[c * (uint32_t)CODE_N + v].to_uint() != 0;
+}
+
+// Hash W image with the real parity-check matrix packed at BCH_H_BITPACK.
+void build_h_param_image(param_vec_t& param) {
+    param.assign((uint32_t)EXP_LEN_PARAM_WORDS, 0u);
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        param[i] = default_param_word(i);
+    }
+    const uint32_t h_off = kParamMeta[kWeightIdToParamId[(uint32_t)BCH_H_BITPACK]].offset_w;
+    for (uint32_t w = 0u; w < (uint32_t)H_WORDS_BITPACK; ++w) {
+        param[h_off + w] = 0u;
+    }
+    for (uint32_t c = 0u; c < (uint32_t)CODE_C; ++c) {
+        for (uint32_t v = 0u; v < (uint32_t)CODE_N; ++v) {
+            if (h_bit(c, v)) {
+                const uint32_t bit = c * (uint32_t)CODE_N + v;
+                param[h_off + (bit >> 5)] |= (1u << (bit & 31u));
+            }
+        }
+    }
+}
+
+// Random codeword: free bits from the seed, pivot bits solved from rref(H).
+void make_codeword_bits(uint32_t seed, uint8_t* x) {
+    uint8_t m[CODE_C][CODE_N];
+    for (uint32_t c = 0u; c < (uint32_t)CODE_C; ++c) {
+        for (uint32_t v = 0u; v < (uint32_t)CODE_N; ++v) {
+            m[c][v] = h_bit(c, v) ? 1u : 0u;
+        }
+    }
+    int pivot_col[CODE_C];
+    bool is_pivot[CODE_N];
+    for (uint32_t v = 0u; v < (uint32_t)CODE_N; ++v) {
+        is_pivot[v] = false;
+    }
+    uint32_t rank = 0u;
+    for (uint32_t v = 0u; v < (uint32_t)CODE_N && rank < (uint32_t)CODE_C; ++v) {
+        uint32_t r = rank;
+        while (r < (uint32_t)CODE_C && m[r][v] == 0u) {
+            ++r;
+        }
+        if (r == (uint32_t)CODE_C) {
+            continue;
+        }
+        for (uint32_t k = 0u; k < (uint32_t)CODE_N; ++k) {
+            const uint8_t t = m[r][k];
+            m[r][k] = m[rank][k];
+            m[rank][k] = t;
+        }
+        for (uint32_t q = 0u; q < (uint32_t)CODE_C; ++q) {
+            if (q != rank && m[q][v] != 0u) {
+                for (uint32_t k = 0u; k < (uint32_t)CODE_N; ++k) {
+                    m[q][k] ^= m[rank][k];
+                }
+            }
+        }
+        pivot_col[rank] = (int)v;
+        is_pivot[v] = true;
+        ++rank;
+    }
+    for (uint32_t v = 0u; v < (uint32_t)CODE_N; ++v) {
+        x[v] = is_pivot[v] ? 0u : (uint8_t)((lcg_next(seed) >> 16) & 1u);
+    }
+    for (uint32_t r = 0u; r < rank; ++r) {
+        uint8_t p = 0u;
+        for (uint32_t v = 0u; v < (uint32_t)CODE_N; ++v) {
+            if (!is_pivot[v] && m[r][v] != 0u) {
+                p ^= x[v];
+            }
+        }
+        x[pivot_col[r]] = p;
+    }
+}
+
+bool syndrome_is_zero(const uint8_t* x) {
+    for (uint32_t c = 0u; c < (uint32_t)CODE_C; ++c) {
+        uint32_t p = 0u;
+        for (uint32_t v = 0u; v < (uint32_t)CODE_N; ++v) {
+            if (h_bit(c, v)) {
+                p ^= x[v];
+            }
+        }
+        if (p != 0u) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// BPSK y for a bit pattern (bit 1 -> negative), magnitudes from the seed.
+Codeword make_y(const uint8_t* x, uint32_t seed) {
+    Codeword cw;
+    for (uint32_t v = 0u; v < kInWords; ++v) {
+        const float mag = 0.125f + (float)((lcg_next(seed) >> 20) & 63u) * 0.03125f;
+        cw.y[v] = f32_to_bits((x[v] != 0u) ? -mag : mag);
+    }
+    return cw;
+}
+
+Codeword make_valid(uint32_t seed) {
+    uint8_t x[CODE_N];
+    make_codeword_bits(seed, x);
+    if (!syndrome_is_zero(x)) {
+        fail("generated codeword has a non-zero syndrome");
+    }
+    return make_y(x, seed ^ 0x5A5Au);
+}
+
+Codeword make_invalid(uint32_t seed) {
+    uint8_t x[CODE_N];
+    make_codeword_bits(seed, x);
+    x[seed % (uint32_t)CODE_N] ^= 1u;
+    if (syndrome_is_zero(x)) {
+        fail("single flip kept a zero syndrome");
+    }
+    return make_y(x, seed ^ 0xA5A5u);
+}
+
+void expected_bypass(const Codeword& cw, uint32_t outmode, uint32_t* out) {
+    for (uint32_t i = 0u; i < kOutWords; ++i) {
+        const bool hard = (cw.y[i] >> 31) != 0u;
+        out[i] = (outmode == 0u) ? f32_to_bits(hard ? 1.0f : 0.0f) : (cw.y[i] & 0x7FFFFFFFu);
+    }
+}
+
+void expect_words(const uint32_t* got, const uint32_t* exp, const char* tag) {
+    for (uint32_t i = 0u; i < kOutWords; ++i) {
+        if (got[i] != exp[i]) {
+            std::printf("ERROR: %s word %u got=0x%08X expect=0x%08X\n",
+                tag, (unsigned)i, (unsigned)got[i], (unsigned)exp[i]);
+            std::exit(1);
+        }
+    }
+}
+
+struct Harness : TopSession {
+    void session(const param_vec_t& param, uint32_t outmode, bool early_exit) {
+        fresh_session(N_LAYERS, early_exit ? (uint32_t)CFG_FEAT_INFER_EARLY_EXIT : 0u, &param,
+            (uint32_t)sram_map::PARAM_BASE_DEFAULT, outmode);
+    }
+
+    void batch(const Codeword* cws, uint32_t (*out)[EXP_LEN_OUT_LOGITS_WORDS], bool overlap) {
+        const uint32_t ovl_bit = overlap ? (1u << aecct::INFER_BATCH_ARG_OVERLAP_BIT) : 0u;
+        cmd_arg((uint8_t)aecct::OP_INFER_BATCH, kBatchCount | ovl_bit);
+        drain_rsp(ctrl_rsp);
+        static uint32_t words[kBatchCount * EXP_LEN_OUT_LOGITS_WORDS + 1u];
+        const uint32_t cap = kBatchCount * kOutWords + 1u;
+        uint32_t n = 0u;
+        for (uint32_t c = 0u; c < kBatchCount; ++c) {
+            for (uint32_t i = 0u; i < kInWords; ++i) {
+                data_in.write((aecct::u32_t)cws[c].y[i]);
+                tick();
+                n += drain_data_words(data_out, &words[n], cap - n);
+            }
+        }
+        uint32_t ticks = 0u;
+        while (aecct::top_peek_state() != aecct::ST_IDLE) {
+            if (ticks++ == kDrainTickLimit) {
+                fail("batch did not finish");
+            }
+            tick();
+        }
+        n += drain_data_words(data_out, &words[n], cap - n);
+        drain_rsp(ctrl_rsp);
+        if (n != kBatchCount * kOutWords) {
+            fail("batch output length mismatch");
+        }
+        for (uint32_t c = 0u; c < kBatchCount; ++c) {
+            for (uint32_t i = 0u; i < kOutWords; ++i) {
+                out[c][i] = words[c * kOutWords + i];
+            }
+        }
+    }
+};
+
+uint32_t early_exit_count() {
+    return (uint32_t)aecct::top_peek_infer_early_exit_count().to_uint();
+}
+
+void test_single_infer(const param_vec_t& param) {
+    Harness hx;
+    const Codeword valid = make_valid(0x1234u);
+    const Codeword invalid = make_invalid(0x1234u);
+    uint32_t got[EXP_LEN_OUT_LOGITS_WORDS];
+    uint32_t exp[EXP_LEN_OUT_LOGITS_WORDS];
+
+    for (uint32_t outmode = 0u; outmode < 2u; ++outmode) {
+        hx.session(param, outmode, true);
+        hx.infer_words(valid.y, got);
+        expected_bypass(valid, outmode, exp);
+        expect_words(got, exp, (outmode == 0u) ? "bypass x_pred" : "bypass logits");
+        if (early_exit_count() != 1u) {
+            fail("valid codeword did not take the early exit");
+        }
+    }
+
+    // Gate off: the same codeword runs the full pipeline.
+    hx.session(param, 1u, false);
+    hx.infer_words(valid.y, got);
+    if (early_exit_count() != 0u) {
+        fail("early exit taken while disabled");
+    }
+
+    // A non-codeword under the gate matches the ungated pipeline bit for bit.
+    uint32_t full_invalid[EXP_LEN_OUT_LOGITS_WORDS];
+    hx.session(param, 1u, false);
+    hx.infer_words(invalid.y, full_invalid);
+    hx.session(param, 1u, true);
+    hx.infer_words(invalid.y, got);
+    expect_words(got, full_invalid, "non-codeword gated");
+    if (early_exit_count() != 0u) {
+        fail("non-codeword took the early exit");
+    }
+
+    // A full-path codeword in between does not disturb the latched H.
+    hx.infer_words(valid.y, got);
+    expected_bypass(valid, 1u, exp);
+    expect_words(got, exp, "bypass after full path");
+    if (early_exit_count() != 1u) {
+        fail("latched H did not survive a full-path codeword");
+    }
+}
+
+void test_batches(const param_vec_t& param) {
+    Harness hx;
+    Codeword cws[kBatchCount];
+    cws[0] = make_valid(0x1111u);
+    cws[1] = make_invalid(0x2222u);
+    cws[2] = make_valid(0x3333u);
+    cws[3] = make_invalid(0x4444u);
+
+    // Serial batch under the gate is the reference.
+    static uint32_t serial[kBatchCount][EXP_LEN_OUT_LOGITS_WORDS];
+    hx.session(param, 1u, true);
+    hx.batch(cws, serial, false);
+    if (early_exit_count() != 2u) {
+        fail("serial batch early exit count mismatch");
+    }
+
+    static uint32_t ovl[kBatchCount][EXP_LEN_OUT_LOGITS_WORDS];
+    hx.session(param, 1u, true);
+    hx.batch(cws, ovl, true);
+    for (uint32_t c = 0u; c < kBatchCount; ++c) {
+        uint32_t exp[EXP_LEN_OUT_LOGITS_WORDS];
+        if ((c & 1u) == 0u) {
+            expected_bypass(cws[c], 1u, exp);
+            expect_words(ovl[c], exp, "overlap bypass");
+        } else {
+            expect_words(ovl[c], serial[c], "overlap full path");
+        }
+    }
+    if (early_exit_count() != 2u) {
+        fail("overlap early exit count mismatch");
+    }
+}
+
+} // namespace
+
+int main() {
+    param_vec_t param;
+    build_h_param_image(param);
+    test_single_infer(param);
+    test_batches(param);
+    std::printf("PASS: tb_infer_early_exit_m25\n");
+    return 0;
+}
@@ -0,0 +1,183 @@
+// M36: LayerNorm inverse-sqrt LUT modes.
+// Built with AECCT_LN_INV_SQRT_MODE=LN_INV_SQRT_LUT_NR1. Reports the relative error
+// of the LUT seed and of LUT + one Newton step against the fp32 sqrt + divide path
+// over var + eps in [1e-5, 1e4], and the LayerNorm output error of both modes
+// against fp32 over random rows. Checks LayerNormBlock picks the configured mode.
+
+#define AECCT_LN_INV_SQRT_MODE 2
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "AecctTypes.h"
+#include "AecctUtil.h"
+#include "LayerNormDesc.h"
+#include "blocks/LayerNormBlock.h"
+
+namespace {
+
+const uint32_t kSweepPoints = 200000u;
+const uint32_t kRows = 256u;
+const uint32_t kD = (uint32_t)aecct::LN_D_MODEL;
+
+// Bounds from the LUT geometry: seed error <= 1/(4 * 2^MANT_BITS); one Newton
+// step squares it (x1.5) plus fp32 rounding.
+const double kSeedRelTol = 1.0e-3;
+const double kNr1RelTol = 2.5e-6;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+uint32_t lcg_next(uint32_t& s) {
+    s = s * 1664525u + 1013904223u;
+    return s;
+}
+
+double to_double(const aecct::fp32_t& v) {
+    const uint32_t bits = (uint32_t)aecct::bits_from_fp32(v).to_uint();
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return (double)f;
+}
+
+aecct::u32_t bits_of(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return (aecct::u32_t)bits;
+}
+
+struct ErrStat {
+    double max_err;
+    double sum_err;
+    uint32_t n;
+
+    ErrStat() : max_err(0.0), sum_err(0.0), n(0u) {}
+    void add(double e) {
+        if (e > max_err) { max_err = e; }
+        sum_err += e;
+        ++n;
+    }
+    double mean() const { return (n != 0u) ? sum_err / (double)n : 0.0; }
+};
+
+void sweep_inv_std(ErrStat& seed, ErrStat& nr1) {
+    const double lo = std::log(1.0e-5);
+    const double hi = std::log(1.0e4);
+    for (uint32_t i = 0u; i < kSweepPoints; ++i) {
+        const float v = (float)std::exp(lo + (hi - lo) * (double)i / (double)(kSweepPoints - 1u));
+        const aecct::fp32_t x = aecct::fp32_from_bits(bits_of(v));
+        const double ref = to_double(aecct::layernorm_inv_std_mode<aecct::LN_INV_SQRT_FP32>(x));
+        seed.add(std::fabs(to_double(aecct::layernorm_inv_std_mode<aecct::LN_INV_SQRT_LUT>(x)) / ref - 1.0));
+        nr1.add(std::fabs(to_double(aecct::layernorm_inv_std_mode<aecct::LN_INV_SQRT_LUT_NR1>(x)) / ref - 1.0));
+    }
+}
+
+// Same arithmetic as the LayerNorm core with the inverse sqrt chosen by MODE.
+template<unsigned MODE>
+void layernorm_row(const std::vector<aecct::u32_t>& row, const std::vector<aecct::u32_t>& gamma,
+    const std::vector<aecct::u32_t>& beta, std::vector<aecct::u32_t>& out) {
+    aecct::fp32_t sum = aecct::fp32_zero();
+    aecct::fp32_t sq_sum = aecct::fp32_zero();
+    for (uint32_t c = 0u; c < kD; ++c) {
+        const aecct::fp32_t x = aecct::fp32_from_bits(row[c]);
+        sum += x;
+        sq_sum += (x * x);
+    }
+    const aecct::fp32_t n_den((ac_int<32, true>)kD);
+    const aecct::fp32_t mean = sum / n_den;
+    const aecct::fp32_t var = (sq_sum / n_den) - (mean * mean);
+    const aecct::fp32_t eps = aecct::fp32_from_bits(aecct::LN_EPS_BITS);
+    aecct::fp32_t var_plus_eps = var + eps;
+    if (var_plus_eps <= aecct::fp32_zero()) {
+        var_plus_eps = eps;
+    }
+    const aecct::fp32_t inv_std = aecct::layernorm_inv_std_mode<MODE>(var_plus_eps);
+    out.resize(kD);
+    for (uint32_t c = 0u; c < kD; ++c) {
+        const aecct::fp32_t x = aecct::fp32_from_bits(row[c]);
+        const aecct::fp32_t y =
+            ((x - mean) * inv_std) * aecct::fp32_from_bits(gamma[c]) + aecct::fp32_from_bits(beta[c]);
+        out[c] = aecct::bits_from_fp32(y);
+    }
+}
+
+} // namespace
+
+int main() {
+    static_assert(aecct::LN_INV_SQRT_MODE == (unsigned)aecct::LN_INV_SQRT_LUT_NR1, "TB builds the NR1 mode");
+
+    ErrStat seed_rel;
+    ErrStat nr1_rel;
+    sweep_inv_std(seed_rel, nr1_rel);
+    std::printf("[m36] inv_std rel err vs fp32 over %u points in [1e-5, 1e4]: LUT max=%.3e mean=%.3e | LUT+NR1 max=%.3e mean=%.3e\n",
+        (unsigned)kSweepPoints, seed_rel.max_err, seed_rel.mean(), nr1_rel.max_err, nr1_rel.mean());
+    if (seed_rel.max_err > kSeedRelTol) {
+        fail("LUT seed error above bound");
+    }
+    if (nr1_rel.max_err > kNr1RelTol) {
+        fail("LUT + Newton error above bound");
+    }
+
+    // Random rows at several scales through a layout with gamma/beta behind X.
+    const uint32_t x_base = 0u;
+    const uint32_t y_base = kRows * kD;
+    const uint32_t g_base = 2u * kRows * kD;
+    const uint32_t b_base = g_base + kD;
+    std::vector<aecct::u32_t> sram(b_base + kD, (aecct::u32_t)0u);
+    std::vector<aecct::u32_t> gamma(kD);
+    std::vector<aecct::u32_t> beta(kD);
+    uint32_t s = 0x36u;
+    for (uint32_t c = 0u; c < kD; ++c) {
+        gamma[c] = bits_of(0.5f + (float)(lcg_next(s) >> 24) / 256.0f);
+        beta[c] = bits_of(((float)(lcg_next(s) >> 24) - 128.0f) / 256.0f);
+        sram[g_base + c] = gamma[c];
+        sram[b_base + c] = beta[c];
+    }
+    std::vector<std::vector<aecct::u32_t> > rows(kRows, std::vector<aecct::u32_t>(kD));
+    for (uint32_t r = 0u; r < kRows; ++r) {
+        const float scale = std::ldexp(1.0f, (int)(r % 16u) - 8);
+        for (uint32_t c = 0u; c < kD; ++c) {
+            const float u = ((float)(lcg_next(s) >> 8) / 16777216.0f) - 0.5f;
+            rows[r][c] = bits_of(u * scale + 0.25f * scale);
+            sram[x_base + r * kD + c] = rows[r][c];
+        }
+    }
+
+    aecct::LayerNormCfg cfg;
+    cfg.token_count = (aecct::u32_t)kRows;
+    cfg.d_model = (aecct::u32_t)kD;
+    cfg.eps_bits = aecct::LN_EPS_BITS;
+    aecct::LayerNormBlock(sram.data(), cfg, (aecct::u32_t)x_base, (aecct::u32_t)y_base,
+        (aecct::u32_t)g_base, (aecct::u32_t)b_base);
+
+    ErrStat seed_abs;
+    ErrStat nr1_abs;
+    std::vector<aecct::u32_t> y_fp32;
+    std::vector<aecct::u32_t> y_seed;
+    std::vector<aecct::u32_t> y_nr1;
+    for (uint32_t r = 0u; r < kRows; ++r) {
+        layernorm_row<aecct::LN_INV_SQRT_FP32>(rows[r], gamma, beta, y_fp32);
+        layernorm_row<aecct::LN_INV_SQRT_LUT>(rows[r], gamma, beta, y_seed);
+        layernorm_row<aecct::LN_INV_SQRT_LUT_NR1>(rows[r], gamma, beta, y_nr1);
+        for (uint32_t c = 0u; c < kD; ++c) {
+            if (sram[y_base + r * kD + c] != y_nr1[c]) {
+                std::printf("ERROR: LayerNormBlock row %u col %u is not the LUT+NR1 result\n", (unsigned)r, (unsigned)c);
+                return 1;
+            }
+            const double ref = to_double(aecct::fp32_from_bits(y_fp32[c]));
+            seed_abs.add(std::fabs(to_double(aecct::fp32_from_bits(y_seed[c])) - ref));
+            nr1_abs.add(std::fabs(to_double(aecct::fp32_from_bits(y_nr1[c])) - ref));
+        }
+    }
+    std::printf("[m36] LN output abs err vs fp32 over %u rows x %u: LUT max=%.3e mean=%.3e | LUT+NR1 max=%.3e mean=%.3e\n",
+        (unsigned)kRows, (unsigned)kD, seed_abs.max_err, seed_abs.mean(), nr1_abs.max_err, nr1_abs.mean());
+
+    std::printf("PASS: tb_layernorm_inv_sqrt_lut_m36\n");
+    return 0;
+}
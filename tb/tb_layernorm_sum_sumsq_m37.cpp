@@ -0,0 +1,205 @@
+// M37: single-pass LayerNorm (LN_MODE_SUM_SUMSQ).
+// Runs the same rows through LayerNormBlock in LN_MODE_TWO_PASS and
+// LN_MODE_SUM_SUMSQ and reports the output error of both against a double
+// LayerNorm. Rows cover several scales, a large common offset (real activations
+// reach ~2e3, far past quant_act_t) and a constant row. A counting SramView
+// checks that the single-pass mode reads each X word once and the two-pass mode twice.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "AecctTypes.h"
+#include "AecctUtil.h"
+#include "LayerNormDesc.h"
+#include "blocks/LayerNormBlock.h"
+
+namespace {
+
+const uint32_t kRows = 256u;
+const uint32_t kD = (uint32_t)aecct::LN_D_MODEL;
+const uint32_t kXBase = 0u;
+const uint32_t kYBase = kRows * kD;
+const uint32_t kGBase = 2u * kRows * kD;
+const uint32_t kBBase = kGBase + kD;
+const uint32_t kWords = kBBase + kD;
+
+// Output abs error vs double LN, scaled by max(1, |y_ref|).
+const double kSumSumsqTol = 5.0e-6;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+uint32_t lcg_next(uint32_t& s) {
+    s = s * 1664525u + 1013904223u;
+    return s;
+}
+
+aecct::u32_t bits_of(float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return (aecct::u32_t)bits;
+}
+
+double to_double(aecct::u32_t w) {
+    const uint32_t bits = (uint32_t)w.to_uint();
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return (double)f;
+}
+
+// SramView that counts reads of every word.
+struct CountingSram {
+    struct Ref {
+        CountingSram* owner;
+        uint32_t idx;
+        operator aecct::u32_t() const {
+            ++owner->reads[idx];
+            return owner->words[idx];
+        }
+        Ref& operator=(const aecct::u32_t& v) {
+            owner->words[idx] = v;
+            return *this;
+        }
+    };
+
+    std::vector<aecct::u32_t> words;
+    std::vector<uint32_t> reads;
+
+    explicit CountingSram(const std::vector<aecct::u32_t>& init) : words(init), reads(init.size(), 0u) {}
+    Ref operator[](uint32_t idx) {
+        Ref r;
+        r.owner = this;
+        r.idx = idx;
+        return r;
+    }
+};
+
+aecct::LayerNormCfg make_cfg(aecct::LayerNormMode mode) {
+    return aecct::make_layernorm_cfg(
+        (aecct::u32_t)kRows, (aecct::u32_t)kD, aecct::LN_EPS_BITS, (aecct::u32_t)mode);
+}
+
+// Same contract LayerNormBlock builds for a full-window run.
+aecct::LayerNormBlockContract make_contract() {
+    aecct::LayerNormBlockContract contract;
+    aecct::clear_layernorm_contract(contract);
+    contract.start = true;
+    contract.phase_id = aecct::PHASE_END_LN;
+    contract.x_work_base_word = (aecct::u32_t)kXBase;
+    contract.gamma_base_word = (aecct::u32_t)kGBase;
+    contract.beta_base_word = (aecct::u32_t)kBBase;
+    contract.token_range = aecct::make_token_range((aecct::u32_t)0u, (aecct::u32_t)kRows);
+    contract.tile_range = aecct::make_tile_range((aecct::u32_t)0u,
+        (aecct::u32_t)aecct::attn_top_managed_tile_count(kD, (uint32_t)aecct::ATTN_TOP_MANAGED_WORK_TILE_WORDS));
+    return contract;
+}
+
+void run_mode(const std::vector<aecct::u32_t>& init, aecct::LayerNormMode mode, std::vector<aecct::u32_t>& out) {
+    out = init;
+    aecct::LayerNormBlock(out.data(), make_cfg(mode), (aecct::u32_t)kXBase, (aecct::u32_t)kYBase,
+        (aecct::u32_t)kGBase, (aecct::u32_t)kBBase);
+}
+
+void check_x_reads(const std::vector<aecct::u32_t>& init, const std::vector<aecct::u32_t>& expect,
+    aecct::LayerNormMode mode, uint32_t reads_per_word) {
+    CountingSram view(init);
+    aecct::LayerNormBlockCoreWindow<CountingSram>(view, make_cfg(mode), (aecct::u32_t)kXBase,
+        (aecct::u32_t)kYBase, make_contract());
+    for (uint32_t i = 0u; i < kRows * kD; ++i) {
+        if (view.reads[kXBase + i] != reads_per_word) {
+            std::printf("ERROR: mode %u read X word %u %u times, expected %u\n",
+                (unsigned)mode, (unsigned)i, (unsigned)view.reads[kXBase + i], (unsigned)reads_per_word);
+            std::exit(1);
+        }
+        if (view.words[kYBase + i] != expect[kYBase + i]) {
+            std::printf("ERROR: mode %u counting-view output differs at word %u\n", (unsigned)mode, (unsigned)i);
+            std::exit(1);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::vector<aecct::u32_t> init(kWords, (aecct::u32_t)0u);
+    std::vector<double> gamma(kD);
+    std::vector<double> beta(kD);
+    uint32_t s = 0x37u;
+    for (uint32_t c = 0u; c < kD; ++c) {
+        const float g = 0.5f + (float)(lcg_next(s) >> 24) / 256.0f;
+        const float b = ((float)(lcg_next(s) >> 24) - 128.0f) / 256.0f;
+        init[kGBase + c] = bits_of(g);
+        init[kBBase + c] = bits_of(b);
+        gamma[c] = (double)g;
+        beta[c] = (double)b;
+    }
+    // Rows r % 4: 0/1 zero-centred at scale 2^(-8..7), 2 offset 2000 +- scale, 3 mixed sign offset.
+    for (uint32_t r = 0u; r < kRows; ++r) {
+        const float scale = std::ldexp(1.0f, (int)((r / 4u) % 16u) - 8);
+        const float offset = ((r % 4u) == 2u) ? 2000.0f : (((r % 4u) == 3u) ? -37.5f * scale : 0.0f);
+        for (uint32_t c = 0u; c < kD; ++c) {
+            const float u = ((float)(lcg_next(s) >> 8) / 16777216.0f) - 0.5f;
+            init[kXBase + r * kD + c] = bits_of(offset + u * scale);
+        }
+    }
+    // Constant row.
+    for (uint32_t c = 0u; c < kD; ++c) {
+        init[kXBase + (kRows - 1u) * kD + c] = bits_of(3.25f);
+    }
+
+    std::vector<aecct::u32_t> y_two_pass;
+    std::vector<aecct::u32_t> y_sum_sumsq;
+    run_mode(init, aecct::LN_MODE_TWO_PASS, y_two_pass);
+    run_mode(init, aecct::LN_MODE_SUM_SUMSQ, y_sum_sumsq);
+
+    double two_pass_max = 0.0;
+    double sum_sumsq_max = 0.0;
+    double sum_sumsq_sum = 0.0;
+    const double eps = to_double(aecct::LN_EPS_BITS);
+    for (uint32_t r = 0u; r < kRows; ++r) {
+        double mean = 0.0;
+        for (uint32_t c = 0u; c < kD; ++c) {
+            mean += to_double(init[kXBase + r * kD + c]);
+        }
+        mean /= (double)kD;
+        double var = 0.0;
+        for (uint32_t c = 0u; c < kD; ++c) {
+            const double d = to_double(init[kXBase + r * kD + c]) - mean;
+            var += d * d;
+        }
+        var /= (double)kD;
+        const double inv_std = 1.0 / std::sqrt(var + eps);
+        for (uint32_t c = 0u; c < kD; ++c) {
+            const uint32_t w = kYBase + r * kD + c;
+            const double ref = (to_double(init[kXBase + r * kD + c]) - mean) * inv_std * gamma[c] + beta[c];
+            const double norm = (std::fabs(ref) > 1.0) ? std::fabs(ref) : 1.0;
+            const double e_two = std::fabs(to_double(y_two_pass[w]) - ref) / norm;
+            const double e_one = std::fabs(to_double(y_sum_sumsq[w]) - ref) / norm;
+            if (e_two > two_pass_max) { two_pass_max = e_two; }
+            if (e_one > sum_sumsq_max) { sum_sumsq_max = e_one; }
+            sum_sumsq_sum += e_one;
+        }
+    }
+    std::printf("[m37] LN output err vs double over %u rows x %u: TWO_PASS max=%.3e | SUM_SUMSQ max=%.3e mean=%.3e\n",
+        (unsigned)kRows, (unsigned)kD, two_pass_max, sum_sumsq_max, sum_sumsq_sum / (double)(kRows * kD));
+    if (sum_sumsq_max > kSumSumsqTol) {
+        fail("SUM_SUMSQ output error above bound");
+    }
+    for (uint32_t c = 0u; c < kD; ++c) {
+        if (y_sum_sumsq[kYBase + (kRows - 1u) * kD + c] != init[kBBase + c]) {
+            fail("constant row did not normalize to beta");
+        }
+    }
+
+    check_x_reads(init, y_two_pass, aecct::LN_MODE_TWO_PASS, 2u);
+    check_x_reads(init, y_sum_sumsq, aecct::LN_MODE_SUM_SUMSQ, 1u);
+
+    std::printf("PASS: tb_layernorm_sum_sumsq_m37\n");
+    return 0;
+}
@@ -0,0 +1,251 @@
+// M38: fused layer tail into the next layer's Q/K/V.
+// With layer 1 on the managed-attention path, layer 0's tail runs residual add,
+// sublayer LayerNorm, mid LayerNorm and the ternary WQ/WK/WV per token on one
+// register row. Block level: the fused tail leaves SRAM and the mid snapshot exactly
+// as the split sequence (residual loop, LayerNormBlock, mid LN, Top-managed Q and K/V
+// builders) and reads each residual/W2 word once. Top level, from CFG_FEATURES only: INFER
+// logits match the split managed path, AD/AC/AE/AF mainline stays latched, a
+// single-layer config has nothing to fuse, and the perf model drops the add2 write
+// and the LayerNorm and Q/K/V X re-reads. PARAM sits in slot 1.
+
+#define AECCT_PARAM_SLOT_COUNT 2
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "tb_top_infer_common.h"
+
+namespace {
+
+using namespace top_infer_tb;
+
+const uint64_t kXWords = (uint64_t)N_NODES * D_MODEL;
+
+// SramView that counts reads of every word.
+struct CountingSram {
+    struct Ref {
+        CountingSram* owner;
+        uint32_t idx;
+        operator aecct::u32_t() const {
+            ++owner->reads[idx];
+            return owner->words[idx];
+        }
+        Ref& operator=(const aecct::u32_t& v) {
+            owner->words[idx] = v;
+            return *this;
+        }
+    };
+
+    std::vector<aecct::u32_t> words;
+    std::vector<uint32_t> reads;
+
+    explicit CountingSram(const std::vector<aecct::u32_t>& init) : words(init), reads(init.size(), 0u) {}
+    Ref operator[](uint32_t idx) {
+        Ref r;
+        r.owner = this;
+        r.idx = idx;
+        return r;
+    }
+};
+
+// Layer-0 tail into layer 1 outside Top: same bases the INFER loop hands the block.
+void test_block_matches_split() {
+    p11aeaf_tb::QkvPayloadSet payloads;
+    if (!p11aeaf_tb::prepare_qkv_payload_set(payloads)) {
+        fail("prepare_qkv_payload_set failed");
+    }
+    const uint32_t param_base = sram_map::param_slot_base_w(1u);
+    const uint32_t x_in_base = (uint32_t)aecct::LN_X_OUT_BASE_WORD;
+    const uint32_t x_out_base = (uint32_t)aecct::alternate_x_page((aecct::u32_t)x_in_base).to_uint();
+    const aecct::LayerScratch sc = aecct::make_layer_scratch((aecct::u32_t)x_in_base);
+    const uint32_t residual_base = (uint32_t)sc.attn_out_base_word.to_uint();
+    const uint32_t w2_base = (uint32_t)sc.ffn.w2_out_base_word.to_uint();
+    const uint32_t add2_base = (uint32_t)sc.ffn.add2_base_word.to_uint();
+    const uint32_t gamma_base = (uint32_t)sc.ffn.ln_gamma_base_word.to_uint();
+    const uint32_t beta_base = (uint32_t)sc.ffn.ln_beta_base_word.to_uint();
+    uint32_t mid_gamma_base = 0u;
+    uint32_t mid_beta_base = 0u;
+    aecct::top_mid_or_end_norm_param_bases(true, param_base, mid_gamma_base, mid_beta_base);
+
+    sram_vec_t init(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    p11aeaf_tb::load_qkv_payload_set_to_sram(init, payloads, param_base);
+    uint32_t s = 0x380u;
+    for (uint32_t c = 0u; c < (uint32_t)D_MODEL; ++c) {
+        init[gamma_base + c] = (aecct::u32_t)f32_to_bits(1.0f + 0.25f * lcg_unit(s));
+        init[beta_base + c] = (aecct::u32_t)f32_to_bits(0.25f * lcg_unit(s));
+        init[mid_gamma_base + c] = (aecct::u32_t)f32_to_bits(1.0f + 0.25f * lcg_unit(s));
+        init[mid_beta_base + c] = (aecct::u32_t)f32_to_bits(0.25f * lcg_unit(s));
+    }
+    for (uint32_t i = 0u; i < (uint32_t)kXWords; ++i) {
+        init[residual_base + i] = (aecct::u32_t)f32_to_bits(2.0f * lcg_unit(s));
+        init[w2_base + i] = (aecct::u32_t)f32_to_bits(lcg_unit(s));
+    }
+
+    aecct::CfgRegs cfg;
+    cfg.d_model = (aecct::u32_t)D_MODEL;
+    cfg.n_heads = (aecct::u32_t)N_HEAD;
+    const aecct::LayerNormCfg ln_cfg = aecct::make_layernorm_cfg(
+        (aecct::u32_t)N_NODES, (aecct::u32_t)D_MODEL, aecct::LN_EPS_BITS, (aecct::u32_t)aecct::LN_MODE_DEFAULT);
+    const aecct::LayerParamBase pb = aecct::make_layer_param_base((aecct::u32_t)param_base, (aecct::u32_t)1u);
+
+    // Split: residual loop, sublayer LN, mid LN + snapshot, then layer 1's Q and K/V builders.
+    sram_vec_t split = init;
+    std::vector<aecct::u32_t> split_snapshot((uint32_t)kXWords, (aecct::u32_t)0u);
+    for (uint32_t i = 0u; i < (uint32_t)kXWords; ++i) {
+        const aecct::fp32_t x = aecct::fp32_from_bits(split[residual_base + i]);
+        const aecct::fp32_t y = aecct::fp32_from_bits(split[w2_base + i]);
+        split[add2_base + i] = aecct::bits_from_fp32(x + y);
+    }
+    aecct::LayerNormBlock(split.data(), ln_cfg, (aecct::u32_t)add2_base, (aecct::u32_t)x_out_base,
+        (aecct::u32_t)gamma_base, (aecct::u32_t)beta_base);
+    aecct::run_mid_or_end_layernorm(true, cfg, split.data(), (aecct::u32_t)param_base,
+        (aecct::u32_t)x_out_base, (aecct::u32_t)x_in_base);
+    for (uint32_t i = 0u; i < (uint32_t)kXWords; ++i) {
+        split_snapshot[i] = split[x_in_base + i];
+    }
+    bool q_fallback = true;
+    bool kv_fallback = true;
+    if (!aecct::run_p11ad_layer0_top_managed_q(split.data(), cfg, (aecct::u32_t)x_in_base, sc, pb, q_fallback) ||
+        !aecct::run_p11ac_layer0_top_managed_kv(split.data(), cfg, (aecct::u32_t)x_in_base, sc, pb, kv_fallback)) {
+        fail("split Q/K/V builders rejected");
+    }
+
+    // Fused.
+    std::vector<aecct::u32_t> fused_snapshot((uint32_t)kXWords, (aecct::u32_t)0u);
+    aecct::TransformerLayerNextQkvFuseDesc fuse = aecct::make_transformer_layer_next_qkv_fuse_desc();
+    fuse.enable = true;
+    fuse.mid_norm_enable = true;
+    fuse.mid_gamma_base_word = (aecct::u32_t)mid_gamma_base;
+    fuse.mid_beta_base_word = (aecct::u32_t)mid_beta_base;
+    fuse.mid_x_out_base_word = (aecct::u32_t)x_in_base;
+    fuse.mid_snapshot = fused_snapshot.data();
+    fuse.next_param_base_word = pb.param_base_word;
+    fuse.next_attn = sc.attn;
+    CountingSram view(init);
+    if (!aecct::transformer_layer_fused_tail_next_qkv(view, ln_cfg, residual_base, w2_base, x_out_base,
+            gamma_base, beta_base, fuse) || !fuse.done || !fuse.qkv_done) {
+        fail("fused tail rejected");
+    }
+
+    // Mid LN gamma/beta staging in SCR_WORK is the only split-only write.
+    const uint32_t staging_begin = (uint32_t)aecct::LN_GAMMA_BASE_WORD;
+    const uint32_t staging_end = (uint32_t)aecct::LN_BETA_BASE_WORD + (uint32_t)D_MODEL;
+    for (uint32_t i = 0u; i < (uint32_t)sram_map::SRAM_WORDS_TOTAL; ++i) {
+        if (i >= staging_begin && i < staging_end) {
+            continue;
+        }
+        if (view.words[i] != split[i]) {
+            std::printf("ERROR: fused tail SRAM differs from split at word %u\n", (unsigned)i);
+            std::exit(1);
+        }
+    }
+    for (uint32_t i = 0u; i < (uint32_t)kXWords; ++i) {
+        if (fused_snapshot[i] != split_snapshot[i]) {
+            fail("fused mid snapshot differs from split");
+        }
+        if (view.reads[residual_base + i] != 1u || view.reads[w2_base + i] != 1u) {
+            fail("fused tail re-read a residual or W2 word");
+        }
+        if (view.reads[x_out_base + i] != 0u) {
+            fail("fused tail read back its LayerNorm output");
+        }
+    }
+}
+
+struct InferResult {
+    uint32_t logits[kLogitWords];
+    std::vector<uint32_t> final_x;
+    uint32_t fused_layers;
+    uint64_t sram_rd;
+    uint64_t sram_wr;
+};
+
+// Host-only session: CFG_FEATURES alone decides which layers run managed attention.
+void run_top_infer(const param_vec_t& param, uint32_t n_layers, uint32_t features, InferResult& r) {
+    TopSession hx;
+    hx.fresh_session(n_layers, features, &param, sram_map::param_slot_base_w(1u));
+    const uint32_t fused_before = (uint32_t)aecct::top_peek_ln_qkv_fused_layer_count().to_uint();
+    hx.infer(0u, r.logits);
+    if (!aecct::top_peek_p11ad_mainline_q_path_taken() || !aecct::top_peek_p11ac_mainline_path_taken() ||
+        !aecct::top_peek_p11ae_mainline_score_path_taken() ||
+        !aecct::top_peek_p11af_mainline_softmax_output_path_taken()) {
+        fail("managed attention mainline not taken");
+    }
+    if ((uint32_t)aecct::top_peek_p11bc_managed_attention_last_layer_id().to_uint() != n_layers - 1u) {
+        fail("managed attention did not reach the last layer");
+    }
+    const uint32_t final_x_base = (uint32_t)aecct::top_peek_infer_final_x_base_word().to_uint();
+    r.final_x.assign((uint32_t)kXWords, 0u);
+    for (uint32_t i = 0u; i < (uint32_t)kXWords; ++i) {
+        r.final_x[i] = (uint32_t)aecct::top_sram()[final_x_base + i].to_uint();
+    }
+    r.fused_layers = (uint32_t)aecct::top_peek_ln_qkv_fused_layer_count().to_uint() - fused_before;
+
+    r.sram_rd = 0u;
+    r.sram_wr = 0u;
+    const aecct::TopPerfCounters& perf = aecct::top_perf();
+    for (unsigned p = 0u; p < aecct::PERF_PHASE_COUNT; ++p) {
+        for (unsigned s = 0u; s < (unsigned)aecct::PERF_SUB_COUNT; ++s) {
+            r.sram_rd += perf.cell[p][s].sram_rd;
+            r.sram_wr += perf.cell[p][s].sram_wr;
+        }
+    }
+}
+
+void expect_same_result(const InferResult& a, const InferResult& b, const char* tag) {
+    expect_same_logits(a.logits, b.logits, tag);
+    for (uint32_t i = 0u; i < (uint32_t)kXWords; ++i) {
+        if (a.final_x[i] != b.final_x[i]) {
+            std::printf("ERROR: %s final X mismatch at %u\n", tag, (unsigned)i);
+            std::exit(1);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    test_block_matches_split();
+
+    param_vec_t param;
+    build_param_image(param, 0x38u, 0x3838u);
+    const uint32_t kLnQkv = (uint32_t)CFG_FEAT_LN_QKV_FUSED;
+    const uint32_t kAttnFused = (uint32_t)CFG_FEAT_ATTN_FUSED;
+
+    // ATTN_FUSED alone puts every layer on the managed path without a fused tail:
+    // the split reference for the layer 0 -> 1 boundary.
+    static InferResult split;
+    static InferResult fused;
+    run_top_infer(param, (uint32_t)N_LAYERS, kAttnFused, split);
+    run_top_infer(param, (uint32_t)N_LAYERS, kAttnFused | kLnQkv, fused);
+    expect_same_result(split, fused, "host fused tail");
+    expect_u64(split.fused_layers, 0u, "split fused_layers");
+    expect_u64(fused.fused_layers, (uint64_t)N_LAYERS - 1u, "fused fused_layers");
+
+    // Layer-0 tail: add2 write and both LayerNorm X passes; mid LN: its X passes;
+    // layer 1: the Q, K and V X reads.
+    expect_u64(split.sram_rd - fused.sram_rd, 7u * kXWords, "perf sram_rd saved");
+    expect_u64(split.sram_wr - fused.sram_wr, kXWords, "perf sram_wr saved");
+    std::printf("[m38] INFER sram_rd %llu -> %llu, sram_wr %llu -> %llu\n",
+        (unsigned long long)split.sram_rd, (unsigned long long)fused.sram_rd,
+        (unsigned long long)split.sram_wr, (unsigned long long)fused.sram_wr);
+
+    // LN_QKV_FUSED alone: managed dense AE/AF on every layer, same as fused AE/AF.
+    static InferResult ln_only;
+    run_top_infer(param, (uint32_t)N_LAYERS, kLnQkv, ln_only);
+    expect_same_result(split, ln_only, "LN_QKV_FUSED alone");
+    expect_u64(ln_only.fused_layers, (uint64_t)N_LAYERS - 1u, "LN_QKV_FUSED alone fused_layers");
+
+    // A single layer has no previous tail to fuse into; the bit leaves INFER untouched.
+    static InferResult split0;
+    static InferResult fused0;
+    run_top_infer(param, 1u, 0u, split0);
+    run_top_infer(param, 1u, kLnQkv, fused0);
+    expect_same_result(split0, fused0, "single layer");
+    expect_u64(fused0.fused_layers, 0u, "single layer fused_layers");
+
+    std::printf("PASS: tb_ln_qkv_fused_tail_m38\n");
+    return 0;
+}
@@ -0,0 +1,338 @@
+// M30: resident PARAM slots.
+// Builds with three slots, loads two images into slots 1 and 2 and checks that
+// SET_W_BASE reselects each without re-streaming (src_mask / H latches, CSR
+// ownership, checksums), that PARAM_SLOT_TABLE reports the populated slots
+// through READ_MEM, that a LOAD_W straddling two slots invalidates both, that
+// INFER leaves every slot resident, and that INFER from slot 1 matches slot 0
+// bit-exactly for the same image.
+
+#define AECCT_PARAM_SLOT_COUNT 3
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "Top.h"
+
+namespace {
+
+typedef std::vector<uint32_t> param_vec_t;
+
+const uint32_t kSlots = sram_map::PARAM_SLOT_COUNT;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+void expect_u32(uint32_t got, uint32_t exp, const char* tag) {
+    if (got != exp) {
+        std::printf("ERROR: %s got=0x%08X expect=0x%08X\n", tag, (unsigned)got, (unsigned)exp);
+        std::exit(1);
+    }
+}
+
+void expect_rsp(aecct::u16_t rsp, uint8_t kind, uint8_t payload, const char* tag) {
+    if (aecct::unpack_ctrl_rsp_kind(rsp) != kind || aecct::unpack_ctrl_rsp_payload(rsp) != payload) {
+        std::printf("ERROR: %s rsp kind=%u payload=%u\n", tag,
+            (unsigned)aecct::unpack_ctrl_rsp_kind(rsp), (unsigned)aecct::unpack_ctrl_rsp_payload(rsp));
+        std::exit(1);
+    }
+}
+
+struct Harness {
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+
+    void cmd(uint8_t opcode) {
+        ctrl_cmd.write(aecct::pack_ctrl_cmd(opcode));
+        aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+    }
+
+    aecct::u16_t last_rsp() {
+        aecct::u16_t last = 0;
+        aecct::u16_t w;
+        while (ctrl_rsp.nb_read(w)) {
+            last = w;
+        }
+        return last;
+    }
+
+    void session() {
+        cmd((uint8_t)aecct::OP_SOFT_RESET);
+        uint32_t cfg_words[EXP_LEN_CFG_WORDS];
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            cfg_words[i] = 0u;
+        }
+        cfg_words[CFG_CODE_N] = CODE_N;
+        cfg_words[CFG_CODE_K] = CODE_K;
+        cfg_words[CFG_CODE_C] = CODE_C;
+        cfg_words[CFG_N_NODES] = N_NODES;
+        cfg_words[CFG_D_MODEL] = D_MODEL;
+        cfg_words[CFG_N_HEAD] = N_HEAD;
+        cfg_words[CFG_N_LAYERS] = N_LAYERS;
+        cfg_words[CFG_D_FFN] = D_FFN;
+        cfg_words[CFG_ENABLE_LPE] = 1u;
+        cfg_words[CFG_ENABLE_LPE_TOKEN] = 1u;
+        cfg_words[CFG_OUT_MODE] = 1u;
+        cmd((uint8_t)aecct::OP_CFG_BEGIN);
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            data_in.write((aecct::u32_t)cfg_words[i]);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        cmd((uint8_t)aecct::OP_CFG_COMMIT);
+        (void)last_rsp();
+    }
+
+    aecct::u16_t set_w_base(uint32_t base) {
+        data_in.write((aecct::u32_t)base);
+        cmd((uint8_t)aecct::OP_SET_W_BASE);
+        return last_rsp();
+    }
+
+    aecct::u16_t load_w(const param_vec_t& param) {
+        cmd((uint8_t)aecct::OP_LOAD_W);
+        for (uint32_t i = 0; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+            data_in.write((aecct::u32_t)param[i]);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        return last_rsp();
+    }
+
+    // Streams one INFER payload (OP_INFER already accepted) and collects the logits.
+    void finish_infer(uint32_t seed, std::vector<uint32_t>& logits) {
+        for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_INFER_IN_WORDS; ++i) {
+            const int32_t sv = (int32_t)(((i + seed) * 7u) & 31u) - 16;
+            const float f = ((float)sv) * 0.0625f;
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            data_in.write((aecct::u32_t)bits);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        expect_rsp(last_rsp(), (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_INFER, "INFER done");
+        logits.clear();
+        aecct::u32_t w;
+        while (data_out.nb_read(w)) {
+            logits.push_back((uint32_t)w.to_uint());
+        }
+        if (logits.size() != (size_t)EXP_LEN_OUT_LOGITS_WORDS) {
+            fail("INFER logits length mismatch");
+        }
+    }
+
+    void read_mem(uint32_t addr, uint32_t len, std::vector<uint32_t>& out) {
+        data_in.write((aecct::u32_t)addr);
+        data_in.write((aecct::u32_t)len);
+        cmd((uint8_t)aecct::OP_READ_MEM);
+        expect_rsp(last_rsp(), (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_READ_MEM, "READ_MEM");
+        out.clear();
+        aecct::u32_t w;
+        while (data_out.nb_read(w)) {
+            out.push_back((uint32_t)w.to_uint());
+        }
+        if (out.size() != len) {
+            fail("READ_MEM length mismatch");
+        }
+    }
+};
+
+void build_image(param_vec_t& param, uint32_t seed) {
+    param.assign((uint32_t)EXP_LEN_PARAM_WORDS, 0u);
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        param[i] = 0x3C000000u | (((i + seed) * 2654435761u) & 0x003FFFFFu) | ((i * 40503u) << 26);
+    }
+}
+
+// INFER-safe image: every word decodes as a small finite float.
+void build_infer_image(param_vec_t& param, uint32_t seed) {
+    param.assign((uint32_t)EXP_LEN_PARAM_WORDS, 0u);
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        param[i] = 0x3C000000u | (((i + seed) * 2654435761u) & 0x003FFFFFu);
+    }
+}
+
+uint32_t host_checksum(const param_vec_t& param) {
+    aecct::u32_t c = 0u;
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        c = aecct::param_stream_checksum_step(c, (aecct::u32_t)param[i]);
+    }
+    return (uint32_t)c.to_uint();
+}
+
+void expect_latches(const param_vec_t& param, const char* tag) {
+    const aecct::TopRegs& regs = aecct::top_regs();
+    if (!regs.attn_mask_bits_valid || !regs.infer_syndrome_h_valid) {
+        std::printf("ERROR: %s latches not valid\n", tag);
+        std::exit(1);
+    }
+    const uint32_t mask_off = kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+    for (uint32_t w = 0u; w < (uint32_t)SRC_MASK_WORDS_BITPACK; ++w) {
+        expect_u32((uint32_t)regs.attn_mask_bits_words[w].to_uint(), param[mask_off + w], tag);
+    }
+    const uint32_t h_off = kParamMeta[kWeightIdToParamId[(uint32_t)BCH_H_BITPACK]].offset_w;
+    for (uint32_t w = 0u; w < (uint32_t)H_WORDS_BITPACK; ++w) {
+        expect_u32((uint32_t)regs.infer_syndrome_h_words[w].to_uint(), param[h_off + w], tag);
+    }
+}
+
+// Checks PARAM_SLOT_TABLE as seen through READ_MEM.
+void expect_table(Harness& hx, uint32_t populated, uint32_t active, const uint32_t* sums, const char* tag) {
+    std::vector<uint32_t> t;
+    hx.read_mem(sram_map::BASE_PARAM_SLOT_TABLE_W,
+        sram_map::PARAM_SLOT_TABLE_HDR_WORDS + sram_map::PARAM_SLOT_TABLE_ENTRY_WORDS * kSlots, t);
+    expect_u32(t[0], kSlots, tag);
+    expect_u32(t[1], populated, tag);
+    expect_u32(t[2], active, tag);
+    for (uint32_t k = 0u; k < kSlots; ++k) {
+        const uint32_t entry = sram_map::PARAM_SLOT_TABLE_HDR_WORDS + k * sram_map::PARAM_SLOT_TABLE_ENTRY_WORDS;
+        expect_u32(t[entry], sram_map::param_slot_base_w(k), tag);
+        expect_u32(t[entry + 1u], ((populated >> k) & 1u) ? sums[k] : 0u, tag);
+    }
+}
+
+} // namespace
+
+int main() {
+    Harness hx;
+    param_vec_t img0;
+    param_vec_t img_a;
+    param_vec_t img_b;
+    build_infer_image(img0, 0u);
+    build_image(img_a, 1001u);
+    build_image(img_b, 2002u);
+    uint32_t sums[kSlots] = {host_checksum(img0), host_checksum(img_a), host_checksum(img_b)};
+    const uint32_t slot1 = sram_map::param_slot_base_w(1u);
+    const uint32_t slot2 = sram_map::param_slot_base_w(2u);
+    const uint8_t kOk = (uint8_t)aecct::RSP_OK;
+    const uint8_t kDone = (uint8_t)aecct::RSP_DONE;
+    const uint8_t kErr = (uint8_t)aecct::RSP_ERR;
+
+    hx.session();
+    expect_table(hx, 0u, kSlots, sums, "empty table");
+
+    // Populate slots 1 and 2.
+    expect_rsp(hx.set_w_base(slot1), kOk, (uint8_t)aecct::OP_SET_W_BASE, "SET_W_BASE slot1");
+    expect_rsp(hx.load_w(img_a), kDone, (uint8_t)aecct::OP_LOAD_W, "LOAD_W slot1");
+    expect_table(hx, 0x2u, 1u, sums, "slot1 loaded");
+    expect_rsp(hx.set_w_base(slot2), kOk, (uint8_t)aecct::OP_SET_W_BASE, "SET_W_BASE slot2");
+    if (aecct::top_regs().attn_mask_bits_valid) {
+        fail("empty slot inherited src_mask latch");
+    }
+    expect_rsp(hx.load_w(img_b), kDone, (uint8_t)aecct::OP_LOAD_W, "LOAD_W slot2");
+    expect_table(hx, 0x6u, 2u, sums, "slot2 loaded");
+    expect_latches(img_b, "slot2 commit latches");
+    const bool csr_ok = aecct::top_peek_attn_mask_csr_valid();
+    expect_u32((uint32_t)aecct::top_peek_param_slot_checksum(2u).to_uint(), sums[2], "slot2 checksum");
+
+    // Reselect slot 1: no PARAM words move, latches come from the slot.
+    expect_rsp(hx.set_w_base(slot1), kOk, (uint8_t)aecct::OP_SET_W_BASE, "reselect slot1");
+    expect_u32((uint32_t)aecct::top_peek_param_slot_select_count().to_uint(), 1u, "select count");
+    expect_u32((uint32_t)aecct::top_peek_param_count(), (uint32_t)EXP_LEN_PARAM_WORDS, "no re-stream");
+    expect_latches(img_a, "slot1 reselect latches");
+    if (aecct::top_peek_attn_mask_csr_valid()) {
+        fail("CSR built for slot 2 reported valid on slot 1");
+    }
+    if (aecct::ternary_row_mask_cache_ready(aecct::top_peek_w_row_cache(), (aecct::u32_t)slot1,
+            (QuantLinearMatrixId)0u)) {
+        fail("row cache built for slot 2 hit on slot 1");
+    }
+    expect_table(hx, 0x6u, 1u, sums, "slot1 active");
+
+    // Back to slot 2: the CSR in SCR_ATTN_CSR still belongs to it.
+    expect_rsp(hx.set_w_base(slot2), kOk, (uint8_t)aecct::OP_SET_W_BASE, "reselect slot2");
+    expect_latches(img_b, "slot2 reselect latches");
+    if (aecct::top_peek_attn_mask_csr_valid() != csr_ok) {
+        fail("slot2 CSR validity not restored");
+    }
+
+    // Slot 0 is populated by a LOAD_W at PARAM_BASE_DEFAULT.
+    expect_rsp(hx.set_w_base((uint32_t)sram_map::PARAM_BASE_DEFAULT), kOk, (uint8_t)aecct::OP_SET_W_BASE,
+        "SET_W_BASE slot0");
+    expect_rsp(hx.load_w(img0), kDone, (uint8_t)aecct::OP_LOAD_W, "LOAD_W slot0");
+    expect_table(hx, 0x7u, 0u, sums, "slot0 loaded");
+
+    // A LOAD_W straddling slots 1 and 2 overwrites both.
+    const uint32_t straddle = slot1 + (uint32_t)aecct::PARAM_ALIGN_WORDS * 4u;
+    expect_rsp(hx.set_w_base(straddle), kOk, (uint8_t)aecct::OP_SET_W_BASE, "SET_W_BASE straddle");
+    expect_rsp(hx.load_w(img_a), kDone, (uint8_t)aecct::OP_LOAD_W, "LOAD_W straddle");
+    expect_table(hx, 0x1u, kSlots, sums, "straddle invalidates slots 1 and 2");
+    expect_rsp(hx.set_w_base(slot2), kOk, (uint8_t)aecct::OP_SET_W_BASE, "SET_W_BASE stale slot2");
+    if (aecct::top_regs().attn_mask_bits_valid || aecct::top_regs().infer_syndrome_h_valid) {
+        fail("stale slot restored latches");
+    }
+
+    // The slot table itself is outside W_REGION.
+    expect_rsp(hx.set_w_base(sram_map::BASE_PARAM_SLOT_TABLE_W), kErr, (uint8_t)aecct::ERR_PARAM_BASE_RANGE,
+        "SET_W_BASE into slot table");
+
+    // INFER scratch lives outside W_REGION, so slot 0 stays resident.
+    hx.data_in.write((aecct::u32_t)1u);
+    hx.cmd((uint8_t)aecct::OP_SET_OUTMODE);
+    expect_rsp(hx.last_rsp(), kDone, (uint8_t)aecct::OP_SET_OUTMODE, "SET_OUTMODE logits");
+    expect_rsp(hx.set_w_base((uint32_t)sram_map::PARAM_BASE_DEFAULT), kOk, (uint8_t)aecct::OP_SET_W_BASE,
+        "reselect slot0");
+    expect_latches(img0, "slot0 reselect latches");
+    hx.cmd((uint8_t)aecct::OP_INFER);
+    expect_rsp(hx.last_rsp(), kOk, (uint8_t)aecct::OP_INFER, "INFER accept");
+    if (!aecct::top_peek_param_slot_valid(0u)) {
+        fail("slot 0 retired by INFER");
+    }
+    // Top is now waiting for the INFER payload, so peek the table words directly.
+    expect_u32((uint32_t)aecct::top_sram()[sram_map::BASE_PARAM_SLOT_TABLE_W + 1u].to_uint(), 0x1u,
+        "slot0 resident bitmap");
+    std::vector<uint32_t> logits_slot0;
+    hx.finish_infer(3u, logits_slot0);
+
+    // The same image in slot 1 must decode exactly like it did from slot 0, even after
+    // slot 0 is reloaded with a different image: every PARAM read follows the active base.
+    param_vec_t img_c;
+    build_infer_image(img_c, 77u);
+    expect_rsp(hx.set_w_base(slot1), kOk, (uint8_t)aecct::OP_SET_W_BASE, "SET_W_BASE slot1 for img0");
+    expect_rsp(hx.load_w(img0), kDone, (uint8_t)aecct::OP_LOAD_W, "LOAD_W img0 into slot1");
+    expect_rsp(hx.set_w_base((uint32_t)sram_map::PARAM_BASE_DEFAULT), kOk, (uint8_t)aecct::OP_SET_W_BASE,
+        "SET_W_BASE slot0 for img_c");
+    expect_rsp(hx.load_w(img_c), kDone, (uint8_t)aecct::OP_LOAD_W, "LOAD_W img_c into slot0");
+    expect_rsp(hx.set_w_base(slot1), kOk, (uint8_t)aecct::OP_SET_W_BASE, "reselect slot1");
+    std::vector<uint32_t> logits_slot1;
+    hx.cmd((uint8_t)aecct::OP_INFER);
+    expect_rsp(hx.last_rsp(), kOk, (uint8_t)aecct::OP_INFER, "slot1 INFER accept");
+    hx.finish_infer(3u, logits_slot1);
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+        expect_u32(logits_slot1[i], logits_slot0[i], "slot1 INFER vs slot0 INFER of img0");
+    }
+
+    // An INFER from slot 0 (img_c) in between leaves slot 1 reproducing bit-exactly.
+    expect_rsp(hx.set_w_base((uint32_t)sram_map::PARAM_BASE_DEFAULT), kOk, (uint8_t)aecct::OP_SET_W_BASE,
+        "reselect slot0 img_c");
+    std::vector<uint32_t> logits_c;
+    hx.cmd((uint8_t)aecct::OP_INFER);
+    expect_rsp(hx.last_rsp(), kOk, (uint8_t)aecct::OP_INFER, "slot0 img_c INFER accept");
+    hx.finish_infer(3u, logits_c);
+    bool img_c_differs = false;
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+        if (logits_c[i] != logits_slot0[i]) { img_c_differs = true; }
+    }
+    if (!img_c_differs) {
+        fail("img_c and img0 produced identical logits; slot check is not discriminating");
+    }
+    expect_rsp(hx.set_w_base(slot1), kOk, (uint8_t)aecct::OP_SET_W_BASE, "reselect slot1 again");
+    std::vector<uint32_t> logits_again;
+    hx.cmd((uint8_t)aecct::OP_INFER);
+    expect_rsp(hx.last_rsp(), kOk, (uint8_t)aecct::OP_INFER, "slot1 INFER again accept");
+    hx.finish_infer(3u, logits_again);
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+        expect_u32(logits_again[i], logits_slot0[i], "slot1 INFER after slot0 INFER");
+    }
+
+    std::printf("PASS: tb_param_slots_m30\n");
+    return 0;
+}
@@ -0,0 +1,300 @@
+// M29: streaming LOAD_W check and in-stream ternary repack.
+// Checks the rolling checksum against a host recomputation, the streamed
+// row-mask cache against the commit-time build, strict-mode rejection of
+// ternary reserved codes and BITPACK padding (including the INFER block until
+// a good reload), and that the legacy path still accepts a bad image. The
+// strict / repack modes are selected only through the OP_LOAD_W_EX flags word.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "Top.h"
+
+namespace {
+
+typedef std::vector<uint32_t> param_vec_t;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+void expect_u32(uint32_t got, uint32_t exp, const char* tag) {
+    if (got != exp) {
+        std::printf("ERROR: %s got=0x%08X expect=0x%08X\n", tag, (unsigned)got, (unsigned)exp);
+        std::exit(1);
+    }
+}
+
+struct Harness {
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+    uint32_t load_flags;
+
+    void cmd(uint8_t opcode) {
+        ctrl_cmd.write(aecct::pack_ctrl_cmd(opcode));
+        aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+    }
+
+    void cmd_arg(uint8_t opcode, uint32_t arg0) {
+        data_in.write((aecct::u32_t)arg0);
+        cmd(opcode);
+    }
+
+    aecct::u16_t last_rsp() {
+        aecct::u16_t last = 0;
+        aecct::u16_t w;
+        while (ctrl_rsp.nb_read(w)) {
+            last = w;
+        }
+        return last;
+    }
+
+    uint32_t drain_data(uint32_t* first) {
+        uint32_t n = 0u;
+        aecct::u32_t w;
+        while (data_out.nb_read(w)) {
+            if (n == 0u && first != 0) {
+                *first = (uint32_t)w.to_uint();
+            }
+            ++n;
+        }
+        return n;
+    }
+
+    // SOFT_RESET + CFG + SET_W_BASE; later load_w() calls carry the check flags.
+    void fresh_session(bool strict, bool repack) {
+        cmd((uint8_t)aecct::OP_SOFT_RESET);
+        uint32_t cfg_words[EXP_LEN_CFG_WORDS];
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            cfg_words[i] = 0u;
+        }
+        cfg_words[CFG_CODE_N] = CODE_N;
+        cfg_words[CFG_CODE_K] = CODE_K;
+        cfg_words[CFG_CODE_C] = CODE_C;
+        cfg_words[CFG_N_NODES] = N_NODES;
+        cfg_words[CFG_D_MODEL] = D_MODEL;
+        cfg_words[CFG_N_HEAD] = N_HEAD;
+        cfg_words[CFG_N_LAYERS] = N_LAYERS;
+        cfg_words[CFG_D_FFN] = D_FFN;
+        cfg_words[CFG_ENABLE_LPE] = 1u;
+        cfg_words[CFG_ENABLE_LPE_TOKEN] = 1u;
+        cfg_words[CFG_OUT_MODE] = 1u;
+        cmd((uint8_t)aecct::OP_CFG_BEGIN);
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            data_in.write((aecct::u32_t)cfg_words[i]);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        cmd((uint8_t)aecct::OP_CFG_COMMIT);
+        cmd_arg((uint8_t)aecct::OP_SET_W_BASE, (uint32_t)sram_map::PARAM_BASE_DEFAULT);
+        (void)last_rsp();
+        load_flags = (strict ? (1u << aecct::LOAD_W_ARG_STRICT_BIT) : 0u) |
+            (repack ? (1u << aecct::LOAD_W_ARG_REPACK_BIT) : 0u);
+    }
+
+    // Plain LOAD_W when no flag is set, LOAD_W_EX otherwise.
+    uint8_t load_op() const {
+        return (load_flags == 0u) ? (uint8_t)aecct::OP_LOAD_W : (uint8_t)aecct::OP_LOAD_W_EX;
+    }
+
+    // Returns the final ctrl_rsp word of the LOAD_W transaction.
+    aecct::u16_t load_w(const param_vec_t& param) {
+        if (load_flags == 0u) {
+            cmd((uint8_t)aecct::OP_LOAD_W);
+        } else {
+            cmd_arg((uint8_t)aecct::OP_LOAD_W_EX, load_flags);
+        }
+        for (uint32_t i = 0; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+            data_in.write((aecct::u32_t)param[i]);
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        return last_rsp();
+    }
+};
+
+// Hash image made well-formed: BITPACK padding cleared, ternary reserved codes
+// (0b10) turned into 0b11.
+void build_good_image(param_vec_t& param) {
+    param.assign((uint32_t)EXP_LEN_PARAM_WORDS, 0u);
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        param[i] = 0x3C000000u | ((i * 2654435761u) & 0x003FFFFFu) | ((i * 40503u) << 26);
+    }
+    for (uint32_t p = 0u; p < PARAM_COUNT; ++p) {
+        const ParamMeta& m = kParamMeta[p];
+        if (m.dtype == (uint32_t)PARAM_DTYPE_BITPACK && m.valid_bits < 32u) {
+            param[m.offset_w + m.len_w - 1u] &= ((1u << m.valid_bits) - 1u);
+        }
+    }
+    for (uint32_t q = 0u; q < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++q) {
+        const QuantLinearMeta& qm = kQuantLinearMeta[q];
+        const uint32_t off = kParamMeta[qm.weight_param_id].offset_w;
+        for (uint32_t w = 0u; w < qm.payload_words_2b; ++w) {
+            param[off + w] |= aecct::param_stream_ternary_rsvd_lanes(param[off + w]);
+        }
+    }
+}
+
+uint32_t host_checksum(const param_vec_t& param) {
+    aecct::u32_t c = 0u;
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        c = aecct::param_stream_checksum_step(c, (aecct::u32_t)param[i]);
+    }
+    return (uint32_t)c.to_uint();
+}
+
+// Word index of a ternary payload word in matrix q, with one slot forced to 0b10.
+uint32_t corrupt_ternary(param_vec_t& param, uint32_t q, uint32_t word, uint32_t slot) {
+    const uint32_t idx = kParamMeta[kQuantLinearMeta[q].weight_param_id].offset_w + word;
+    param[idx] = (param[idx] & ~(3u << (slot * 2u))) | (2u << (slot * 2u));
+    return idx;
+}
+
+void expect_rsp(aecct::u16_t rsp, uint8_t kind, uint8_t payload, const char* tag) {
+    if (aecct::unpack_ctrl_rsp_kind(rsp) != kind || aecct::unpack_ctrl_rsp_payload(rsp) != payload) {
+        std::printf("ERROR: %s rsp kind=%u payload=%u\n", tag,
+            (unsigned)aecct::unpack_ctrl_rsp_kind(rsp), (unsigned)aecct::unpack_ctrl_rsp_payload(rsp));
+        std::exit(1);
+    }
+}
+
+void compare_caches(const aecct::TernaryRowMaskCache& a, const aecct::TernaryRowMaskCache& b, const char* tag) {
+    if (a.param_base_word != b.param_base_word) {
+        fail("row cache base mismatch");
+    }
+    for (uint32_t m = 0u; m < aecct::TERNARY_ROW_MASK_CACHED_MATRIX_COUNT; ++m) {
+        if (a.matrix_valid[m] != b.matrix_valid[m]) {
+            std::printf("ERROR: %s matrix %u valid mismatch\n", tag, (unsigned)m);
+            std::exit(1);
+        }
+        if (!a.matrix_valid[m]) {
+            continue;
+        }
+        if (a.inv_sw_bits[m] != b.inv_sw_bits[m]) {
+            std::printf("ERROR: %s matrix %u inv_sw mismatch\n", tag, (unsigned)m);
+            std::exit(1);
+        }
+        const QuantLinearMeta& qm = kQuantLinearMeta[m];
+        const uint32_t base = aecct::ternary_row_mask_matrix_base(m);
+        const uint32_t words = qm.rows * aecct::ternary_row_mask_chunks(qm.cols);
+        for (uint32_t i = 0u; i < words; ++i) {
+            if (a.pos_mask[base + i] != b.pos_mask[base + i] || a.neg_mask[base + i] != b.neg_mask[base + i]) {
+                std::printf("ERROR: %s matrix %u chunk %u mismatch\n", tag, (unsigned)m, (unsigned)i);
+                std::exit(1);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    Harness hx;
+    hx.load_flags = 0u;
+    param_vec_t good;
+    build_good_image(good);
+    const uint32_t good_sum = host_checksum(good);
+    static aecct::TernaryRowMaskCache built_cache;
+    static aecct::TernaryRowMaskCache built_bad_cache;
+
+    // Case A: legacy path; checksum is tracked, no extra data word, cache built at commit.
+    hx.fresh_session(false, false);
+    expect_rsp(hx.load_w(good), (uint8_t)aecct::RSP_DONE, hx.load_op(), "legacy good");
+    if (hx.drain_data(0) != 0u) {
+        fail("legacy LOAD_W emitted data words");
+    }
+    expect_u32(aecct::top_peek_param_check().checksum.to_uint(), good_sum, "legacy checksum");
+    if (aecct::top_peek_param_check().error) {
+        fail("good image flagged");
+    }
+    expect_u32(aecct::top_peek_w_row_cache_build_count().to_uint(), 1u, "legacy build_count");
+    built_cache = aecct::top_peek_w_row_cache();
+
+    // Case B: strict + repack; DONE carries the checksum and the cache needs no second pass.
+    hx.fresh_session(true, true);
+    expect_rsp(hx.load_w(good), (uint8_t)aecct::RSP_DONE, hx.load_op(), "strict good");
+    uint32_t sum_word = 0u;
+    if (hx.drain_data(&sum_word) != 1u) {
+        fail("strict LOAD_W must emit exactly one checksum word");
+    }
+    expect_u32(sum_word, good_sum, "strict checksum word");
+    expect_u32(aecct::top_peek_w_row_cache_build_count().to_uint(), 0u, "repack build_count");
+    expect_u32(aecct::top_peek_param_stream_repack_count().to_uint(), 1u, "repack_count");
+    compare_caches(built_cache, aecct::top_peek_w_row_cache(), "repack vs build");
+
+    // Case C: strict rejects a reserved code; INFER stays blocked until a good reload.
+    param_vec_t bad = good;
+    const uint32_t bad_idx = corrupt_ternary(bad, (uint32_t)QLM_L0_WV, 37u, 5u);
+    expect_rsp(hx.load_w(bad), (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_PARAM_TERNARY_CODE, "strict ternary");
+    if (hx.drain_data(0) != 0u) {
+        fail("rejected LOAD_W emitted data words");
+    }
+    expect_u32(aecct::top_peek_param_check().ternary_error_count.to_uint(), 1u, "ternary_error_count");
+    expect_u32(aecct::top_peek_param_check().first_error_word.to_uint(), bad_idx, "first_error_word");
+    if (!aecct::top_peek_param_image_rejected() || aecct::top_peek_accepted_commit_record_valid() ||
+        aecct::top_peek_attn_mask_bits_valid()) {
+        fail("rejected image left commit state behind");
+    }
+    for (uint32_t m = 0u; m < aecct::TERNARY_ROW_MASK_CACHED_MATRIX_COUNT; ++m) {
+        if (aecct::top_peek_w_row_cache().matrix_valid[m]) {
+            fail("rejected image left a valid row cache matrix");
+        }
+    }
+    hx.cmd((uint8_t)aecct::OP_INFER);
+    expect_rsp(hx.last_rsp(), (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_BAD_STATE, "INFER after reject");
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, 2u);
+    expect_rsp(hx.last_rsp(), (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_BAD_STATE, "INFER_BATCH after reject");
+    expect_rsp(hx.load_w(good), (uint8_t)aecct::RSP_DONE, hx.load_op(), "strict reload");
+    (void)hx.drain_data(0);
+    if (aecct::top_peek_param_image_rejected()) {
+        fail("good reload did not clear the reject");
+    }
+    hx.cmd((uint8_t)aecct::OP_INFER);
+    expect_rsp(hx.last_rsp(), (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_INFER, "INFER after reload");
+    hx.cmd((uint8_t)aecct::OP_SOFT_RESET);
+    (void)hx.last_rsp();
+
+    // Case D: strict rejects nonzero BITPACK padding in BCH_H.
+    hx.fresh_session(true, false);
+    param_vec_t bad_pad = good;
+    const ParamMeta& h_meta = kParamMeta[kWeightIdToParamId[(uint32_t)BCH_H_BITPACK]];
+    bad_pad[h_meta.offset_w + h_meta.len_w - 1u] |= (1u << h_meta.valid_bits);
+    expect_rsp(hx.load_w(bad_pad), (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_BITPACK_PAD, "strict pad");
+    expect_u32(aecct::top_peek_param_check().pad_error_count.to_uint(), 1u, "pad_error_count");
+    expect_u32(aecct::top_peek_param_check().ternary_error_count.to_uint(), 0u, "pad ternary_error_count");
+
+    // Case E: legacy accepts the bad image; the commit-time build drops the matrix.
+    hx.fresh_session(false, false);
+    expect_rsp(hx.load_w(bad), (uint8_t)aecct::RSP_DONE, hx.load_op(), "legacy bad");
+    if (!aecct::top_peek_param_check().error || aecct::top_peek_param_image_rejected()) {
+        fail("legacy bad image tracking mismatch");
+    }
+    built_bad_cache = aecct::top_peek_w_row_cache();
+    if (built_bad_cache.matrix_valid[(uint32_t)QLM_L0_WV]) {
+        fail("built cache kept the corrupt matrix");
+    }
+
+    // Case F: repack without strict matches the build on the same bad image.
+    hx.fresh_session(false, true);
+    expect_rsp(hx.load_w(bad), (uint8_t)aecct::RSP_DONE, hx.load_op(), "repack bad");
+    compare_caches(built_bad_cache, aecct::top_peek_w_row_cache(), "repack vs build (bad)");
+
+    // Case G: undefined LOAD_W_EX flag bits are rejected before PARAM_RX.
+    hx.fresh_session(false, false);
+    hx.cmd_arg((uint8_t)aecct::OP_LOAD_W_EX, aecct::LOAD_W_ARG_DEFINED_MASK + 1u);
+    expect_rsp(hx.last_rsp(), (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_BAD_ARG, "LOAD_W_EX bad flags");
+    if (aecct::top_peek_state() != aecct::ST_IDLE) {
+        fail("bad LOAD_W_EX flags left IDLE");
+    }
+
+    std::printf("PASS: checksum=0x%08X bad_word=%u\n", (unsigned)good_sum, (unsigned)bad_idx);
+    std::printf("PASS: tb_param_stream_check_m29\n");
+    return 0;
+}
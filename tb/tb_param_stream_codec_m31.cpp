@@ -0,0 +1,216 @@
+// M31: compressed LOAD_W stream.
+// Packs the real weights.h PARAM image, encodes it (RAW / RUN / HI16 packets)
+// and streams it through OP_LOAD_W_EX with the compressed flag. Checks the
+// decoded W_REGION image and stream checksum match a raw LOAD_W, that the bf16
+// pre-pass lands exactly the rounded image, that compressed + strict reports
+// the raw checksum on data_out, and that malformed headers abort LOAD_W.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "Top.h"
+#include "weights_streamer.h"
+
+namespace {
+
+typedef std::vector<uint32_t> word_vec_t;
+
+const uint32_t kParamWords = (uint32_t)EXP_LEN_PARAM_WORDS;
+const uint32_t kTickLimit = 4u * (uint32_t)EXP_LEN_PARAM_WORDS;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+void expect_rsp(aecct::u16_t rsp, uint8_t kind, uint8_t payload, const char* tag) {
+    if (aecct::unpack_ctrl_rsp_kind(rsp) != kind || aecct::unpack_ctrl_rsp_payload(rsp) != payload) {
+        std::printf("ERROR: %s rsp kind=%u payload=%u\n", tag,
+            (unsigned)aecct::unpack_ctrl_rsp_kind(rsp), (unsigned)aecct::unpack_ctrl_rsp_payload(rsp));
+        std::exit(1);
+    }
+}
+
+struct Harness {
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+    uint32_t load_flags;
+
+    void tick() { aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out); }
+
+    void cmd(uint8_t opcode) {
+        ctrl_cmd.write(aecct::pack_ctrl_cmd(opcode));
+        tick();
+    }
+
+    aecct::u16_t last_rsp() {
+        aecct::u16_t last = 0;
+        aecct::u16_t w;
+        while (ctrl_rsp.nb_read(w)) {
+            last = w;
+        }
+        return last;
+    }
+
+    void session(bool compressed) {
+        cmd((uint8_t)aecct::OP_SOFT_RESET);
+        uint32_t cfg_words[EXP_LEN_CFG_WORDS];
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            cfg_words[i] = 0u;
+        }
+        cfg_words[CFG_CODE_N] = CODE_N;
+        cfg_words[CFG_CODE_K] = CODE_K;
+        cfg_words[CFG_CODE_C] = CODE_C;
+        cfg_words[CFG_N_NODES] = N_NODES;
+        cfg_words[CFG_D_MODEL] = D_MODEL;
+        cfg_words[CFG_N_HEAD] = N_HEAD;
+        cfg_words[CFG_N_LAYERS] = N_LAYERS;
+        cfg_words[CFG_D_FFN] = D_FFN;
+        cfg_words[CFG_ENABLE_LPE] = 1u;
+        cfg_words[CFG_ENABLE_LPE_TOKEN] = 1u;
+        cfg_words[CFG_OUT_MODE] = 1u;
+        cmd((uint8_t)aecct::OP_CFG_BEGIN);
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            data_in.write((aecct::u32_t)cfg_words[i]);
+            tick();
+        }
+        cmd((uint8_t)aecct::OP_CFG_COMMIT);
+        data_in.write((aecct::u32_t)sram_map::PARAM_BASE_DEFAULT);
+        cmd((uint8_t)aecct::OP_SET_W_BASE);
+        (void)last_rsp();
+        load_flags = compressed ? (1u << aecct::LOAD_W_ARG_COMPRESSED_BIT) : 0u;
+    }
+
+    uint8_t load_op() const {
+        return (load_flags == 0u) ? (uint8_t)aecct::OP_LOAD_W : (uint8_t)aecct::OP_LOAD_W_EX;
+    }
+
+    // Streams wire words one per tick, then keeps ticking until LOAD_W answers DONE/ERR.
+    aecct::u16_t load_w(const word_vec_t& wire) {
+        if (load_flags == 0u) {
+            cmd((uint8_t)aecct::OP_LOAD_W);
+        } else {
+            data_in.write((aecct::u32_t)load_flags);
+            cmd((uint8_t)aecct::OP_LOAD_W_EX);
+        }
+        expect_rsp(last_rsp(), (uint8_t)aecct::RSP_OK, load_op(), "LOAD_W accept");
+        for (uint32_t i = 0u; i < (uint32_t)wire.size(); ++i) {
+            data_in.write((aecct::u32_t)wire[i]);
+            tick();
+        }
+        for (uint32_t t = 0u; t < kTickLimit && ctrl_rsp.empty(); ++t) {
+            tick();
+        }
+        return last_rsp();
+    }
+};
+
+void expect_image(const word_vec_t& exp, const char* tag) {
+    const aecct::u32_t* sram = aecct::top_sram();
+    for (uint32_t i = 0u; i < kParamWords; ++i) {
+        if ((uint32_t)sram[sram_map::PARAM_BASE_DEFAULT + i].to_uint() != exp[i]) {
+            std::printf("ERROR: %s word %u got=0x%08X expect=0x%08X\n", tag, (unsigned)i,
+                (unsigned)sram[sram_map::PARAM_BASE_DEFAULT + i].to_uint(), (unsigned)exp[i]);
+            std::exit(1);
+        }
+    }
+}
+
+void encode(const word_vec_t& raw, word_vec_t& wire) {
+    wire.assign(2u * kParamWords, 0u);
+    const uint32_t n = tb_param_stream_encode(raw.data(), kParamWords, wire.data(), (uint32_t)wire.size());
+    if (n == 0u) {
+        fail("encoder overflow");
+    }
+    wire.resize(n);
+}
+
+} // namespace
+
+int main() {
+    Harness hx;
+    hx.load_flags = 0u;
+    word_vec_t raw(kParamWords, 0u);
+    if (!tb_build_unified_param_words(raw.data())) {
+        fail("PARAM image build failed");
+    }
+    const uint8_t kDone = (uint8_t)aecct::RSP_DONE;
+    const uint8_t kErr = (uint8_t)aecct::RSP_ERR;
+
+    // Reference: raw LOAD_W.
+    hx.session(false);
+    expect_rsp(hx.load_w(raw), kDone, (uint8_t)aecct::OP_LOAD_W, "raw LOAD_W");
+    const uint32_t raw_sum = (uint32_t)aecct::top_peek_param_check().checksum.to_uint();
+
+    // Lossless packets land the same image and checksum.
+    word_vec_t wire;
+    encode(raw, wire);
+    hx.session(true);
+    expect_rsp(hx.load_w(wire), kDone, hx.load_op(), "compressed LOAD_W");
+    expect_image(raw, "lossless");
+    if ((uint32_t)aecct::top_peek_param_check().checksum.to_uint() != raw_sum) {
+        fail("compressed checksum differs from raw");
+    }
+    if ((uint32_t)aecct::top_peek_param_stream_wire_words().to_uint() != (uint32_t)wire.size()) {
+        fail("wire word count mismatch");
+    }
+    if (!aecct::top_peek_w_row_cache().matrix_valid[0]) {
+        fail("row cache not built from decoded image");
+    }
+    const uint32_t lossless_words = (uint32_t)wire.size();
+
+    // Host-only view: compressed + strict in one flags word, checksum back on data_out.
+    hx.session(true);
+    hx.load_flags |= 1u << aecct::LOAD_W_ARG_STRICT_BIT;
+    expect_rsp(hx.load_w(wire), kDone, (uint8_t)aecct::OP_LOAD_W_EX, "compressed strict LOAD_W");
+    aecct::u32_t sum_word;
+    if (!hx.data_out.nb_read(sum_word) || (uint32_t)sum_word.to_uint() != raw_sum || !hx.data_out.empty()) {
+        fail("compressed strict LOAD_W checksum word mismatch");
+    }
+
+    // bf16 pre-pass on plain fp32 tensors; ternary / inv_s_w / BITPACK stay exact.
+    word_vec_t rounded = raw;
+    tb_param_words_round_bf16(rounded.data());
+    encode(rounded, wire);
+    hx.session(true);
+    expect_rsp(hx.load_w(wire), kDone, hx.load_op(), "bf16 LOAD_W");
+    expect_image(rounded, "bf16");
+    const uint32_t mask_off = kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+    for (uint32_t w = 0u; w < (uint32_t)SRC_MASK_WORDS_BITPACK; ++w) {
+        if (rounded[mask_off + w] != raw[mask_off + w]) {
+            fail("bf16 pre-pass touched src_mask");
+        }
+    }
+    const uint32_t bf16_words = (uint32_t)wire.size();
+    if (!(bf16_words < lossless_words && lossless_words < kParamWords)) {
+        fail("compressed stream not shorter");
+    }
+
+    // Reserved packet kind.
+    word_vec_t bad(1u, aecct::pack_param_packet_header(aecct::PARAM_PKT_RSVD, 4u));
+    hx.session(true);
+    expect_rsp(hx.load_w(bad), kErr, (uint8_t)aecct::ERR_BAD_ARG, "reserved kind");
+    if (aecct::top_regs().state != aecct::ST_IDLE) {
+        fail("reserved kind left PARAM_RX");
+    }
+
+    // Packet longer than the words still owed.
+    bad.assign(1u, aecct::pack_param_packet_header(aecct::PARAM_PKT_RUN, kParamWords + 1u));
+    bad.push_back(0u);
+    hx.session(true);
+    expect_rsp(hx.load_w(bad), kErr, (uint8_t)aecct::ERR_PARAM_LEN_MISMATCH, "packet overrun");
+
+    std::printf("wire words: raw=%u lossless=%u bf16=%u\n",
+        (unsigned)kParamWords, (unsigned)lossless_words, (unsigned)bf16_words);
+    std::printf("PASS: tb_param_stream_codec_m31\n");
+    return 0;
+}
@@ -0,0 +1,217 @@
+// M20: multiplier-free ternary row kernels vs the original x * w MAC.
+// Covers the SRAM row kernel, the fixed-shape split kernels, and an FF2 row that
+// saturates quant_acc_t mid-row so clipping order must match the MAC exactly.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "AecctTypes.h"
+#include "AecctUtil.h"
+#include "QuantDesc.h"
+#include "blocks/TernaryLinearLive.h"
+#include "blocks/TernaryLiveQkvLeafKernel.h"
+#include "gen/SramMap.h"
+#include "gen/WeightStreamOrder.h"
+
+namespace {
+
+static const uint32_t kParamBase = (uint32_t)sram_map::PARAM_BASE_DEFAULT;
+static const uint32_t kXRowBase = (uint32_t)sram_map::BASE_SCRATCH_W;
+static const uint32_t kOutBase = kXRowBase + 256u;
+static const uint32_t kOutActQBase = kOutBase + 64u;
+
+static void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+static uint32_t f32_to_bits(float f) {
+    union {
+        float f;
+        uint32_t u;
+    } cvt;
+    cvt.f = f;
+    return cvt.u;
+}
+
+static uint32_t lcg_next(uint32_t& s) {
+    s = s * 1664525u + 1013904223u;
+    return s;
+}
+
+static void put_code(std::vector<aecct::u32_t>& sram, QuantLinearMatrixId matrix_id, uint32_t elem_idx, uint32_t code) {
+    const QuantLinearMeta meta = kQuantLinearMeta[(uint32_t)matrix_id];
+    const uint32_t addr = kParamBase + kParamMeta[meta.weight_param_id].offset_w + (elem_idx >> 4);
+    const uint32_t shift = (elem_idx & 15u) * 2u;
+    const uint32_t word = (uint32_t)sram[addr].to_uint();
+    sram[addr] = (aecct::u32_t)((word & ~(0x3u << shift)) | (code << shift));
+}
+
+static void fill_param_image(std::vector<aecct::u32_t>& sram, uint32_t seed) {
+    uint32_t s = seed;
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        const QuantLinearMeta meta = kQuantLinearMeta[m];
+        for (uint32_t e = 0u; e < meta.num_weights; ++e) {
+            const uint32_t pick = (lcg_next(s) >> 16) % 3u;
+            const uint32_t code = (pick == 0u) ? (uint32_t)TERNARY_CODE_ZERO :
+                                  (pick == 1u) ? (uint32_t)TERNARY_CODE_POS :
+                                                 (uint32_t)TERNARY_CODE_NEG;
+            put_code(sram, (QuantLinearMatrixId)m, e, code);
+        }
+        sram[kParamBase + kParamMeta[meta.inv_sw_param_id].offset_w] =
+            (aecct::u32_t)f32_to_bits(0.5f + 0.0625f * (float)m);
+    }
+}
+
+static void fill_x_row(std::vector<aecct::u32_t>& sram, uint32_t cols, uint32_t seed, bool near_max) {
+    uint32_t s = seed;
+    for (uint32_t i = 0u; i < cols; ++i) {
+        float v = 0.0f;
+        if (near_max) {
+            v = 31.5f - 0.25f * (float)(i & 3u);
+        } else {
+            const int32_t sv = (int32_t)((lcg_next(s) >> 18) & 1023u) - 512;
+            v = (float)sv * 0.0546875f;
+        }
+        sram[kXRowBase + i] = (aecct::u32_t)f32_to_bits(v);
+    }
+}
+
+// Original decode-weight-then-multiply MAC; the equivalence oracle.
+static aecct::u32_t oracle_q_elem(const std::vector<aecct::u32_t>& sram, QuantLinearMatrixId matrix_id, uint32_t out_idx) {
+    const QuantLinearMeta meta = kQuantLinearMeta[(uint32_t)matrix_id];
+    const aecct::u32_t inv_sw_bits = sram[kParamBase + kParamMeta[meta.inv_sw_param_id].offset_w];
+    const aecct::quant_acc_t inv_sw = aecct::fp32_from_bits(inv_sw_bits)
+        .template convert_to_ac_fixed<32, 12, true, AC_RND, AC_SAT>(false);
+    aecct::quant_acc_t acc = 0;
+    for (uint32_t in = 0u; in < meta.cols; ++in) {
+        aecct::quant_w_t w = 0;
+        if (!aecct::ternary_linear_live_decode_weight(sram.data(), (aecct::u32_t)kParamBase, matrix_id, out_idx, in, w)) {
+            fail("oracle decode failed");
+        }
+        const aecct::quant_act_t x = aecct::quant_act_from_bits(sram[kXRowBase + in]);
+        acc += aecct::quant_acc_t(x) * aecct::quant_acc_t(w);
+    }
+    return aecct::quant_bits_from_acc(acc / inv_sw);
+}
+
+static void check_compute_q_elem(std::vector<aecct::u32_t>& sram, bool near_max) {
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        const QuantLinearMatrixId matrix_id = (QuantLinearMatrixId)m;
+        const QuantLinearMeta meta = kQuantLinearMeta[m];
+        fill_x_row(sram, meta.cols, 0x99u + m, near_max);
+        for (uint32_t r = 0u; r < meta.rows; ++r) {
+            aecct::u32_t q = 0u;
+            aecct::u32_t inv = 0u;
+            if (!aecct::ternary_linear_live_compute_q_elem(
+                    sram.data(), (aecct::u32_t)kParamBase, matrix_id, (aecct::u32_t)kXRowBase, r, q, inv)) {
+                fail("compute_q_elem failed");
+            }
+            const aecct::u32_t ref = oracle_q_elem(sram, matrix_id, r);
+            if (q != ref) {
+                std::printf("ERROR: compute_q_elem mismatch m=%u r=%u got=0x%08X ref=0x%08X\n",
+                    (unsigned)m, (unsigned)r, (unsigned)q.to_uint(), (unsigned)ref.to_uint());
+                std::exit(1);
+            }
+        }
+    }
+}
+
+static void check_row_kernels(std::vector<aecct::u32_t>& sram, bool near_max) {
+    const QuantLinearMatrixId ids[3] = { QLM_L0_WQ, QLM_L0_WK, QLM_L0_WV };
+    fill_x_row(sram, aecct::kTernaryLiveL0WqCols, 0x5150u, near_max);
+    aecct::u32_t x_row[aecct::kTernaryLiveL0WqCols];
+    for (uint32_t i = 0u; i < aecct::kTernaryLiveL0WqCols; ++i) {
+        x_row[i] = sram[kXRowBase + i];
+    }
+    for (uint32_t k = 0u; k < 3u; ++k) {
+        const QuantLinearMeta meta = kQuantLinearMeta[(uint32_t)ids[k]];
+        aecct::u32_t impl_inv = 0u;
+        if (!aecct::ternary_live_qkv_materialize_row_kernel_impl(
+                sram.data(), (aecct::u32_t)kParamBase, ids[k], (aecct::u32_t)kXRowBase,
+                (aecct::u32_t)kOutBase, (aecct::u32_t)kOutActQBase, impl_inv)) {
+            fail("row kernel impl failed");
+        }
+
+        const uint32_t payload_base = kParamBase + kParamMeta[meta.weight_param_id].offset_w;
+        aecct::u32_t payload[aecct::kTernaryLiveL0WqPayloadWords];
+        for (uint32_t i = 0u; i < aecct::kTernaryLiveL0WqPayloadWords; ++i) {
+            payload[i] = sram[payload_base + i];
+        }
+        aecct::u32_t split_out[aecct::kTernaryLiveL0WqRows];
+        aecct::u32_t split_act[aecct::kTernaryLiveL0WqRows];
+        aecct::u32_t split_inv = 0u;
+        bool split_ok = false;
+        if (ids[k] == QLM_L0_WQ) {
+            split_ok = aecct::ternary_live_l0_wq_materialize_row_kernel_split(
+                x_row, payload, impl_inv, split_out, split_act, split_inv);
+        } else if (ids[k] == QLM_L0_WK) {
+            split_ok = aecct::ternary_live_l0_wk_materialize_row_kernel_split(
+                x_row, payload, impl_inv, split_out, split_act, split_inv);
+        } else {
+            split_ok = aecct::ternary_live_l0_wv_materialize_row_kernel_split(
+                x_row, payload, impl_inv, split_out, split_act, split_inv);
+        }
+        if (!split_ok || split_inv != impl_inv) {
+            fail("split kernel failed or inv_s_w mismatch");
+        }
+
+        for (uint32_t r = 0u; r < meta.rows; ++r) {
+            const aecct::u32_t ref = oracle_q_elem(sram, ids[k], r);
+            if (sram[kOutBase + r] != ref || sram[kOutActQBase + r] != ref ||
+                split_out[r] != ref || split_act[r] != ref) {
+                std::printf("ERROR: row kernel mismatch k=%u r=%u ref=0x%08X impl=0x%08X split=0x%08X\n",
+                    (unsigned)k, (unsigned)r, (unsigned)ref.to_uint(),
+                    (unsigned)sram[kOutBase + r].to_uint(), (unsigned)split_out[r].to_uint());
+                std::exit(1);
+            }
+        }
+    }
+}
+
+// FF2 row 0: all +1, clips high. Row 1: +1 then -1, clips high then walks back down.
+static void force_ff2_saturating_rows(std::vector<aecct::u32_t>& sram) {
+    const QuantLinearMeta meta = kQuantLinearMeta[(uint32_t)QLM_L0_WFF2];
+    for (uint32_t in = 0u; in < meta.cols; ++in) {
+        put_code(sram, QLM_L0_WFF2, in, (uint32_t)TERNARY_CODE_POS);
+        put_code(sram, QLM_L0_WFF2, meta.cols + in,
+            (in < 96u) ? (uint32_t)TERNARY_CODE_POS : (uint32_t)TERNARY_CODE_NEG);
+    }
+}
+
+} // namespace
+
+int main() {
+    static std::vector<aecct::u32_t> sram((size_t)sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+
+    fill_param_image(sram, 0xACE1u);
+    check_compute_q_elem(sram, false);
+    check_row_kernels(sram, false);
+    check_row_kernels(sram, true);
+
+    force_ff2_saturating_rows(sram);
+    check_compute_q_elem(sram, true);
+
+    // Reserved code must still fail the split kernel.
+    aecct::u32_t x_row[aecct::kTernaryLiveL0WqCols];
+    aecct::u32_t payload[aecct::kTernaryLiveL0WqPayloadWords];
+    aecct::u32_t out_row[aecct::kTernaryLiveL0WqRows];
+    aecct::u32_t out_act[aecct::kTernaryLiveL0WqRows];
+    aecct::u32_t out_inv = 0u;
+    for (uint32_t i = 0u; i < aecct::kTernaryLiveL0WqCols; ++i) {
+        x_row[i] = (aecct::u32_t)f32_to_bits(1.0f);
+    }
+    for (uint32_t i = 0u; i < aecct::kTernaryLiveL0WqPayloadWords; ++i) {
+        payload[i] = (aecct::u32_t)0u;
+    }
+    payload[3] = (aecct::u32_t)((uint32_t)TERNARY_CODE_RSVD << 10);
+    if (aecct::ternary_live_l0_wq_materialize_row_kernel_split(
+            x_row, payload, (aecct::u32_t)f32_to_bits(1.0f), out_row, out_act, out_inv)) {
+        fail("split kernel accepted a reserved ternary code");
+    }
+
+    std::printf("PASS: tb_ternary_addsub_kernel_m20\n");
+    return 0;
+}
@@ -0,0 +1,371 @@
+// M19: post-LOAD_W ternary row-mask cache equivalence.
+// Checks row-mask decode against per-element decode, cached vs SRAM-decoded row math,
+// cached QKV kernel vs split kernel, reserved-code isolation, and Top LOAD_W build.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "AecctUtil.h"
+#include "QuantDesc.h"
+#include "blocks/TernaryLinearLive.h"
+#include "blocks/TernaryLiveQkvLeafKernel.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "gen/WeightStreamOrder.h"
+#include "Top.h"
+
+namespace {
+
+static const uint32_t kParamBase = (uint32_t)sram_map::PARAM_BASE_DEFAULT;
+static const uint32_t kXRowBase = (uint32_t)sram_map::BASE_SCRATCH_W;
+
+static void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+static uint32_t f32_to_bits(float f) {
+    union {
+        float f;
+        uint32_t u;
+    } cvt;
+    cvt.f = f;
+    return cvt.u;
+}
+
+static uint32_t lcg_next(uint32_t& s) {
+    s = s * 1664525u + 1013904223u;
+    return s;
+}
+
+// Packs legal ternary codes for every matrix plus a non-zero inv_s_w.
+static void fill_param_image(std::vector<aecct::u32_t>& sram, uint32_t seed) {
+    uint32_t s = seed;
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        const QuantLinearMeta meta = kQuantLinearMeta[m];
+        const uint32_t payload_base = kParamBase + kParamMeta[meta.weight_param_id].offset_w;
+        for (uint32_t w = 0u; w < meta.payload_words_2b; ++w) {
+            uint32_t word = 0u;
+            for (uint32_t slot = 0u; slot < 16u; ++slot) {
+                const uint32_t pick = (lcg_next(s) >> 16) % 3u;
+                const uint32_t code = (pick == 0u) ? (uint32_t)TERNARY_CODE_ZERO :
+                                      (pick == 1u) ? (uint32_t)TERNARY_CODE_POS :
+                                                     (uint32_t)TERNARY_CODE_NEG;
+                word |= (code << (slot * 2u));
+            }
+            sram[payload_base + w] = (aecct::u32_t)word;
+        }
+        sram[kParamBase + kParamMeta[meta.inv_sw_param_id].offset_w] =
+            (aecct::u32_t)f32_to_bits(0.25f + 0.125f * (float)(m + 1u));
+    }
+}
+
+static void fill_x_row(std::vector<aecct::u32_t>& sram, uint32_t cols, uint32_t seed) {
+    uint32_t s = seed;
+    for (uint32_t i = 0u; i < cols; ++i) {
+        const int32_t sv = (int32_t)((lcg_next(s) >> 20) & 63u) - 32;
+        sram[kXRowBase + i] = (aecct::u32_t)f32_to_bits((float)sv * 0.03125f);
+    }
+}
+
+// Original per-element decode + MAC, kept here as the equivalence oracle.
+static bool reference_q_elem(
+    const aecct::u32_t* sram,
+    QuantLinearMatrixId matrix_id,
+    uint32_t out_idx,
+    aecct::u32_t& out_q_bits
+) {
+    const QuantLinearMeta meta = aecct::ternary_linear_live_meta(matrix_id);
+    aecct::u32_t inv_sw_bits = 0u;
+    if (!aecct::ternary_linear_live_read_inv_sw_bits(sram, (aecct::u32_t)kParamBase, matrix_id, inv_sw_bits)) {
+        return false;
+    }
+    const aecct::quant_acc_t inv_sw = aecct::fp32_from_bits(inv_sw_bits)
+        .template convert_to_ac_fixed<32, 12, true, AC_RND, AC_SAT>(false);
+    aecct::quant_acc_t acc = 0;
+    for (uint32_t in = 0u; in < meta.cols; ++in) {
+        aecct::quant_w_t w = 0;
+        if (!aecct::ternary_linear_live_decode_weight(sram, (aecct::u32_t)kParamBase, matrix_id, out_idx, in, w)) {
+            return false;
+        }
+        const aecct::quant_act_t x = aecct::quant_act_from_bits(sram[kXRowBase + in]);
+        acc += aecct::quant_acc_t(x) * aecct::quant_acc_t(w);
+    }
+    out_q_bits = aecct::quant_bits_from_acc(acc / inv_sw);
+    return true;
+}
+
+// Weight at column in_idx of a cached row: +1 from pos, -1 from neg, else 0.
+static aecct::quant_w_t row_mask_weight(
+    const aecct::u32_t pos[aecct::TERNARY_ROW_MASK_MAX_CHUNKS],
+    const aecct::u32_t neg[aecct::TERNARY_ROW_MASK_MAX_CHUNKS],
+    uint32_t in_idx
+) {
+    const uint32_t chunk = in_idx / aecct::TERNARY_ROW_MASK_CHUNK_COLS;
+    const uint32_t bit = in_idx & (aecct::TERNARY_ROW_MASK_CHUNK_COLS - 1u);
+    if ((((uint32_t)pos[chunk].to_uint()) >> bit) & 1u) {
+        return aecct::quant_w_t(1);
+    }
+    if ((((uint32_t)neg[chunk].to_uint()) >> bit) & 1u) {
+        return aecct::quant_w_t(-1);
+    }
+    return aecct::quant_w_t(0);
+}
+
+static void check_cache_equivalence(std::vector<aecct::u32_t>& sram, aecct::TernaryRowMaskCache& cache) {
+    if (!aecct::ternary_row_mask_cache_build(cache, sram.data(), (aecct::u32_t)kParamBase)) {
+        fail("cache build rejected a legal param image");
+    }
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        const QuantLinearMatrixId matrix_id = (QuantLinearMatrixId)m;
+        const QuantLinearMeta meta = kQuantLinearMeta[m];
+        const bool ready = aecct::ternary_row_mask_cache_ready(cache, (aecct::u32_t)kParamBase, matrix_id);
+        if (ready != aecct::ternary_row_mask_cached(m)) {
+            std::printf("ERROR: cache ready=%u for matrix %u after legal build\n", (unsigned)ready, (unsigned)m);
+            std::exit(1);
+        }
+        if (!ready) {
+            continue;
+        }
+        fill_x_row(sram, meta.cols, 0x1234u + m);
+        for (uint32_t r = 0u; r < meta.rows; ++r) {
+            aecct::u32_t pos[aecct::TERNARY_ROW_MASK_MAX_CHUNKS];
+            aecct::u32_t neg[aecct::TERNARY_ROW_MASK_MAX_CHUNKS];
+            aecct::ternary_row_mask_cache_row(cache, matrix_id, r, pos, neg);
+            for (uint32_t in = 0u; in < meta.cols; ++in) {
+                aecct::quant_w_t w_ref = 0;
+                if (!aecct::ternary_linear_live_decode_weight(
+                        sram.data(), (aecct::u32_t)kParamBase, matrix_id, r, in, w_ref)) {
+                    fail("per-element decode failed on legal image");
+                }
+                if (row_mask_weight(pos, neg, in) != w_ref) {
+                    std::printf("ERROR: mask weight mismatch m=%u r=%u in=%u\n", (unsigned)m, (unsigned)r, (unsigned)in);
+                    std::exit(1);
+                }
+            }
+
+            aecct::u32_t q_ref = 0u;
+            aecct::u32_t q_sram = 0u;
+            aecct::u32_t q_cached = 0u;
+            aecct::u32_t inv_sram = 0u;
+            aecct::u32_t inv_cached = 0u;
+            if (!reference_q_elem(sram.data(), matrix_id, r, q_ref)) {
+                fail("reference q elem failed");
+            }
+            if (!aecct::ternary_linear_live_compute_q_elem(
+                    sram.data(), (aecct::u32_t)kParamBase, matrix_id, (aecct::u32_t)kXRowBase, r, q_sram, inv_sram)) {
+                fail("row-decoded compute_q_elem failed");
+            }
+            if (!aecct::ternary_linear_live_compute_q_elem_cached(
+                    cache, sram.data(), (aecct::u32_t)kParamBase, matrix_id, (aecct::u32_t)kXRowBase, r,
+                    q_cached, inv_cached)) {
+                fail("cached compute_q_elem failed");
+            }
+            if (q_sram != q_ref || q_cached != q_ref || inv_cached != inv_sram) {
+                std::printf("ERROR: q mismatch m=%u r=%u ref=0x%08X sram=0x%08X cached=0x%08X\n",
+                    (unsigned)m, (unsigned)r, (unsigned)q_ref.to_uint(),
+                    (unsigned)q_sram.to_uint(), (unsigned)q_cached.to_uint());
+                std::exit(1);
+            }
+        }
+    }
+}
+
+static void check_qkv_kernel_equivalence(std::vector<aecct::u32_t>& sram, const aecct::TernaryRowMaskCache& cache) {
+    const QuantLinearMatrixId ids[3] = { QLM_L0_WQ, QLM_L0_WK, QLM_L0_WV };
+    aecct::u32_t x_row[aecct::kTernaryLiveL0WqCols];
+    fill_x_row(sram, aecct::kTernaryLiveL0WqCols, 0x77u);
+    for (uint32_t i = 0u; i < aecct::kTernaryLiveL0WqCols; ++i) {
+        x_row[i] = sram[kXRowBase + i];
+    }
+    for (uint32_t k = 0u; k < 3u; ++k) {
+        const QuantLinearMeta meta = kQuantLinearMeta[(uint32_t)ids[k]];
+        const uint32_t payload_base = kParamBase + kParamMeta[meta.weight_param_id].offset_w;
+        aecct::u32_t payload[aecct::kTernaryLiveL0WqPayloadWords];
+        for (uint32_t i = 0u; i < aecct::kTernaryLiveL0WqPayloadWords; ++i) {
+            payload[i] = sram[payload_base + i];
+        }
+        const aecct::u32_t inv_sw_bits = sram[kParamBase + kParamMeta[meta.inv_sw_param_id].offset_w];
+
+        aecct::u32_t split_out[aecct::kTernaryLiveL0WqRows];
+        aecct::u32_t split_act[aecct::kTernaryLiveL0WqRows];
+        aecct::u32_t split_inv = 0u;
+        bool split_ok = false;
+        if (ids[k] == QLM_L0_WQ) {
+            split_ok = aecct::ternary_live_l0_wq_materialize_row_kernel_split(
+                x_row, payload, inv_sw_bits, split_out, split_act, split_inv);
+        } else if (ids[k] == QLM_L0_WK) {
+            split_ok = aecct::ternary_live_l0_wk_materialize_row_kernel_split(
+                x_row, payload, inv_sw_bits, split_out, split_act, split_inv);
+        } else {
+            split_ok = aecct::ternary_live_l0_wv_materialize_row_kernel_split(
+                x_row, payload, inv_sw_bits, split_out, split_act, split_inv);
+        }
+        aecct::u32_t cached_out[aecct::kTernaryLiveL0WqRows];
+        aecct::u32_t cached_act[aecct::kTernaryLiveL0WqRows];
+        aecct::u32_t cached_inv = 0u;
+        const bool cached_ok = aecct::ternary_live_qkv_materialize_row_kernel_cached(
+            cache, (aecct::u32_t)kParamBase, ids[k], x_row, cached_out, cached_act, cached_inv);
+        if (!split_ok || !cached_ok || split_inv != cached_inv) {
+            fail("cached QKV kernel status/inv_s_w mismatch vs split kernel");
+        }
+        for (uint32_t i = 0u; i < aecct::kTernaryLiveL0WqRows; ++i) {
+            if (split_out[i] != cached_out[i] || split_act[i] != cached_act[i]) {
+                std::printf("ERROR: cached QKV kernel mismatch k=%u i=%u\n", (unsigned)k, (unsigned)i);
+                std::exit(1);
+            }
+        }
+    }
+    aecct::u32_t stale_out[aecct::kTernaryLiveL0WqRows];
+    aecct::u32_t stale_act[aecct::kTernaryLiveL0WqRows];
+    aecct::u32_t stale_inv = 0u;
+    if (aecct::ternary_live_qkv_materialize_row_kernel_cached(
+            cache, (aecct::u32_t)(kParamBase + 1u), QLM_L0_WQ, x_row, stale_out, stale_act, stale_inv)) {
+        fail("cached QKV kernel accepted a param base it was not built for");
+    }
+}
+
+static uint32_t poison_payload_word(std::vector<aecct::u32_t>& sram, QuantLinearMatrixId matrix_id, uint32_t& saved) {
+    const QuantLinearMeta meta = kQuantLinearMeta[(uint32_t)matrix_id];
+    const uint32_t idx = kParamBase + kParamMeta[meta.weight_param_id].offset_w + meta.payload_words_2b / 2u;
+    saved = (uint32_t)sram[idx].to_uint();
+    sram[idx] = (aecct::u32_t)((saved & ~(0x3u << 6)) | ((uint32_t)TERNARY_CODE_RSVD << 6));
+    return idx;
+}
+
+// A reserved code poisons only its own cached matrix; matrices outside the cache
+// (O/FF1/FF2, layer 1) do not affect the build.
+static void check_reserved_code_isolation(std::vector<aecct::u32_t>& sram, aecct::TernaryRowMaskCache& cache) {
+    uint32_t saved = 0u;
+    uint32_t idx = poison_payload_word(sram, QLM_L0_WFF2, saved);
+    if (!aecct::ternary_row_mask_cache_build(cache, sram.data(), (aecct::u32_t)kParamBase)) {
+        fail("cache build rejected a reserved code outside the cached matrices");
+    }
+    sram[idx] = (aecct::u32_t)saved;
+
+    idx = poison_payload_word(sram, QLM_L0_WK, saved);
+    if (aecct::ternary_row_mask_cache_build(cache, sram.data(), (aecct::u32_t)kParamBase)) {
+        fail("cache build accepted a reserved ternary code");
+    }
+    for (uint32_t m = 0u; m < (uint32_t)QUANT_LINEAR_MATRIX_COUNT; ++m) {
+        const bool ready = aecct::ternary_row_mask_cache_ready(cache, (aecct::u32_t)kParamBase, (QuantLinearMatrixId)m);
+        if (ready != (aecct::ternary_row_mask_cached(m) && m != (uint32_t)QLM_L0_WK)) {
+            std::printf("ERROR: reserved-code isolation mismatch m=%u ready=%u\n", (unsigned)m, (unsigned)ready);
+            std::exit(1);
+        }
+    }
+    sram[idx] = (aecct::u32_t)saved;
+
+    aecct::ternary_row_mask_cache_invalidate(cache);
+    if (aecct::ternary_row_mask_cache_ready(cache, (aecct::u32_t)kParamBase, QLM_L0_WQ)) {
+        fail("cache still ready after invalidate");
+    }
+}
+
+static void tick(
+    aecct::ctrl_ch_t& ctrl_cmd,
+    aecct::ctrl_ch_t& ctrl_rsp,
+    aecct::data_ch_t& data_in,
+    aecct::data_ch_t& data_out
+) {
+    aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+}
+
+static void expect_rsp(aecct::ctrl_ch_t& ctrl_rsp, uint8_t kind_exp, uint8_t payload_exp, const char* tag) {
+    aecct::u16_t w;
+    if (!ctrl_rsp.nb_read(w)) {
+        std::printf("ERROR: %s expected ctrl response but channel empty\n", tag);
+        std::exit(1);
+    }
+    const uint8_t kind = aecct::unpack_ctrl_rsp_kind(w);
+    const uint8_t payload = aecct::unpack_ctrl_rsp_payload(w);
+    if (kind != kind_exp || payload != payload_exp) {
+        std::printf("ERROR: %s ctrl response mismatch. kind=%u payload=%u expect_kind=%u expect_payload=%u\n",
+            tag, (unsigned)kind, (unsigned)payload, (unsigned)kind_exp, (unsigned)payload_exp);
+        std::exit(1);
+    }
+}
+
+static void drain_rsp(aecct::ctrl_ch_t& ctrl_rsp) {
+    aecct::u16_t w;
+    while (ctrl_rsp.nb_read(w)) {
+    }
+}
+
+// Top path: LOAD_W DONE builds the cache from the streamed image at the active W base.
+static void check_top_load_w_build(const std::vector<aecct::u32_t>& image) {
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+
+    ctrl_cmd.write(aecct::pack_ctrl_cmd((uint8_t)aecct::OP_SOFT_RESET));
+    tick(ctrl_cmd, ctrl_rsp, data_in, data_out);
+    expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_SOFT_RESET, "soft_reset");
+    if ((uint32_t)aecct::top_peek_w_row_cache_build_count().to_uint() != 0u) {
+        fail("row cache build count not cleared by SOFT_RESET");
+    }
+
+    data_in.write((aecct::u32_t)kParamBase);
+    ctrl_cmd.write(aecct::pack_ctrl_cmd((uint8_t)aecct::OP_SET_W_BASE));
+    tick(ctrl_cmd, ctrl_rsp, data_in, data_out);
+    drain_rsp(ctrl_rsp);
+
+    for (uint32_t pass = 0u; pass < 2u; ++pass) {
+        ctrl_cmd.write(aecct::pack_ctrl_cmd((uint8_t)aecct::OP_LOAD_W));
+        tick(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_LOAD_W, "load_w_begin");
+        if (aecct::ternary_row_mask_cache_ready(aecct::top_peek_w_row_cache(), (aecct::u32_t)kParamBase, QLM_L0_WQ)) {
+            fail("row cache still ready while LOAD_W is in flight");
+        }
+        for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+            data_in.write(image[kParamBase + i]);
+            tick(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_LOAD_W, "load_w_done");
+        if ((uint32_t)aecct::top_peek_w_row_cache_build_count().to_uint() != pass + 1u) {
+            fail("row cache build count mismatch after LOAD_W");
+        }
+    }
+
+    aecct::TernaryRowMaskCache expect_cache;
+    if (!aecct::ternary_row_mask_cache_build(expect_cache, image.data(), (aecct::u32_t)kParamBase)) {
+        fail("reference cache build failed");
+    }
+    const aecct::TernaryRowMaskCache& top_cache = aecct::top_peek_w_row_cache();
+    for (uint32_t m = 0u; m < aecct::TERNARY_ROW_MASK_CACHED_MATRIX_COUNT; ++m) {
+        if (!aecct::ternary_row_mask_cache_ready(top_cache, (aecct::u32_t)kParamBase, (QuantLinearMatrixId)m) ||
+            top_cache.inv_sw_bits[m] != expect_cache.inv_sw_bits[m]) {
+            std::printf("ERROR: Top row cache matrix %u not ready or inv_s_w mismatch\n", (unsigned)m);
+            std::exit(1);
+        }
+    }
+    for (uint32_t i = 0u; i < aecct::TERNARY_ROW_MASK_TOTAL_CHUNKS; ++i) {
+        if (top_cache.pos_mask[i] != expect_cache.pos_mask[i] || top_cache.neg_mask[i] != expect_cache.neg_mask[i]) {
+            std::printf("ERROR: Top row cache chunk %u mismatch\n", (unsigned)i);
+            std::exit(1);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    static std::vector<aecct::u32_t> sram((size_t)sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    static aecct::TernaryRowMaskCache cache;
+
+    fill_param_image(sram, 0xC0FFEEu);
+    check_cache_equivalence(sram, cache);
+    check_qkv_kernel_equivalence(sram, cache);
+    check_reserved_code_isolation(sram, cache);
+    check_top_load_w_build(sram);
+
+    std::printf("row_cache_total_chunks=%u\n", (unsigned)aecct::TERNARY_ROW_MASK_TOTAL_CHUNKS);
+    std::printf("PASS: tb_ternary_row_cache_m19\n");
+    return 0;
+}
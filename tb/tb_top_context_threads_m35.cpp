@@ -0,0 +1,245 @@
+// M35: re-entrant TopContext.
+// Runs the same decoder sessions (CFG, LOAD_W of a per-instance PARAM image,
+// INFER of a few codewords) once in sequence on the default instance through the
+// 4-channel top(), then on independent TopContext instances, one std::thread
+// each. Every instance must stream the same logits as its sequential reference,
+// and the parallel run must leave the default instance untouched.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "Top.h"
+
+namespace {
+
+typedef std::vector<uint32_t> word_vec_t;
+
+const uint32_t kInstances = 4u;
+const uint32_t kCodewords = 2u;
+const uint32_t kParamWords = (uint32_t)EXP_LEN_PARAM_WORDS;
+const uint32_t kInWords = (uint32_t)EXP_LEN_INFER_IN_WORDS;
+const uint32_t kOutWords = (uint32_t)EXP_LEN_OUT_LOGITS_WORDS;
+
+void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+uint32_t lcg_next(uint32_t& s) {
+    s = s * 1664525u + 1013904223u;
+    return s;
+}
+
+struct Job {
+    word_vec_t param;
+    word_vec_t y;        // kCodewords x kInWords
+    word_vec_t logits;   // kCodewords x kOutWords
+    bool ok;
+};
+
+void build_job(Job& job, uint32_t seed) {
+    job.param.assign(kParamWords, 0u);
+    for (uint32_t i = 0u; i < kParamWords; ++i) {
+        job.param[i] = 0x3C000000u | (((i + seed) * 2654435761u) & 0x003FFFFFu);
+    }
+    uint32_t s = seed ^ 0x9E3779B9u;
+    job.y.assign(kCodewords * kInWords, 0u);
+    for (uint32_t i = 0u; i < kCodewords * kInWords; ++i) {
+        // +-(0.125 .. 2.09), random sign.
+        const uint32_t r = lcg_next(s);
+        job.y[i] = ((r & 0x80000000u) ? 0xBE000000u : 0x3E000000u) + ((r >> 8) & 0x00FFFFFFu);
+    }
+    job.logits.assign(kCodewords * kOutWords, 0u);
+    job.ok = false;
+}
+
+// ctx == 0 drives the default instance through the 4-channel top().
+struct Decoder {
+    aecct::TopContext* ctx;
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+
+    explicit Decoder(aecct::TopContext* c) : ctx(c) {}
+
+    void tick() {
+        if (ctx != 0) {
+            aecct::top(*ctx, ctrl_cmd, ctrl_rsp, data_in, data_out);
+        } else {
+            aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out);
+        }
+    }
+
+    void cmd(uint8_t op) {
+        ctrl_cmd.write(aecct::pack_ctrl_cmd(op));
+        tick();
+    }
+
+    void cmd_arg(uint8_t op, uint32_t arg) {
+        data_in.write((aecct::u32_t)arg);
+        cmd(op);
+    }
+
+    aecct::u16_t last_rsp() {
+        aecct::u16_t last = 0;
+        aecct::u16_t w;
+        while (ctrl_rsp.nb_read(w)) {
+            last = w;
+        }
+        return last;
+    }
+
+    bool run(Job& job) {
+        cmd((uint8_t)aecct::OP_SOFT_RESET);
+        uint32_t cfg_words[EXP_LEN_CFG_WORDS];
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            cfg_words[i] = 0u;
+        }
+        cfg_words[CFG_CODE_N] = CODE_N;
+        cfg_words[CFG_CODE_K] = CODE_K;
+        cfg_words[CFG_CODE_C] = CODE_C;
+        cfg_words[CFG_N_NODES] = N_NODES;
+        cfg_words[CFG_D_MODEL] = D_MODEL;
+        cfg_words[CFG_N_HEAD] = N_HEAD;
+        cfg_words[CFG_N_LAYERS] = N_LAYERS;
+        cfg_words[CFG_D_FFN] = D_FFN;
+        cfg_words[CFG_ENABLE_LPE] = 1u;
+        cfg_words[CFG_ENABLE_LPE_TOKEN] = 1u;
+        cfg_words[CFG_OUT_MODE] = 1u;
+        cmd((uint8_t)aecct::OP_CFG_BEGIN);
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            data_in.write((aecct::u32_t)cfg_words[i]);
+            tick();
+        }
+        cmd((uint8_t)aecct::OP_CFG_COMMIT);
+        cmd_arg((uint8_t)aecct::OP_SET_W_BASE, (uint32_t)sram_map::PARAM_BASE_DEFAULT);
+        cmd((uint8_t)aecct::OP_LOAD_W);
+        for (uint32_t i = 0u; i < kParamWords; ++i) {
+            data_in.write((aecct::u32_t)job.param[i]);
+            tick();
+        }
+        if (aecct::unpack_ctrl_rsp_kind(last_rsp()) != (uint8_t)aecct::RSP_DONE) {
+            return false;
+        }
+        cmd_arg((uint8_t)aecct::OP_SET_OUTMODE, 1u);
+        (void)last_rsp();
+        for (uint32_t c = 0u; c < kCodewords; ++c) {
+            cmd((uint8_t)aecct::OP_INFER);
+            for (uint32_t i = 0u; i < kInWords; ++i) {
+                data_in.write((aecct::u32_t)job.y[c * kInWords + i]);
+                tick();
+            }
+            uint32_t n = 0u;
+            aecct::u32_t w;
+            while (data_out.nb_read(w)) {
+                if (n < kOutWords) {
+                    job.logits[c * kOutWords + n] = (uint32_t)w.to_uint();
+                }
+                ++n;
+            }
+            if (n != kOutWords || aecct::unpack_ctrl_rsp_kind(last_rsp()) != (uint8_t)aecct::RSP_DONE) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void run_on_context(aecct::TopContext* ctx, Job* job) {
+    Decoder dec(ctx);
+    job->ok = dec.run(*job);
+}
+
+double elapsed_ms(const std::chrono::steady_clock::time_point& t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+int main() {
+    std::vector<Job> ref(kInstances);
+    std::vector<Job> par(kInstances);
+    for (uint32_t k = 0u; k < kInstances; ++k) {
+        build_job(ref[k], 0x35000u + k * 7919u);
+        build_job(par[k], 0x35000u + k * 7919u);
+    }
+
+    // Sequential reference on the default instance.
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (uint32_t k = 0u; k < kInstances; ++k) {
+        run_on_context(0, &ref[k]);
+        if (!ref[k].ok) {
+            fail("default-instance session failed");
+        }
+    }
+    const double seq_ms = elapsed_ms(t0);
+    for (uint32_t k = 1u; k < kInstances; ++k) {
+        if (ref[k].logits == ref[0].logits) {
+            fail("distinct PARAM images produced identical logits");
+        }
+    }
+    const unsigned default_param_count = aecct::top_peek_param_count();
+    const aecct::TopState default_state = aecct::top_peek_state();
+    const std::vector<aecct::u32_t> default_sram_before(aecct::top_sram(), aecct::top_sram() + sram_map::SRAM_WORDS_TOTAL);
+
+    // Same sessions, one context per thread.
+    std::vector<aecct::TopContext*> ctxs(kInstances);
+    for (uint32_t k = 0u; k < kInstances; ++k) {
+        ctxs[k] = new aecct::TopContext();
+    }
+    t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t k = 0u; k < kInstances; ++k) {
+        threads.push_back(std::thread(run_on_context, ctxs[k], &par[k]));
+    }
+    for (uint32_t k = 0u; k < kInstances; ++k) {
+        threads[k].join();
+    }
+    const double par_ms = elapsed_ms(t0);
+
+    for (uint32_t k = 0u; k < kInstances; ++k) {
+        if (!par[k].ok) {
+            std::printf("ERROR: context %u session failed\n", (unsigned)k);
+            return 1;
+        }
+        for (uint32_t i = 0u; i < kCodewords * kOutWords; ++i) {
+            if (par[k].logits[i] != ref[k].logits[i]) {
+                std::printf("ERROR: context %u logit %u got=0x%08X expect=0x%08X\n",
+                    (unsigned)k, (unsigned)i, (unsigned)par[k].logits[i], (unsigned)ref[k].logits[i]);
+                return 1;
+            }
+        }
+        if (ctxs[k]->regs.state != aecct::ST_IDLE || !ctxs[k]->regs.w_base_set) {
+            std::printf("ERROR: context %u did not end its session in ST_IDLE\n", (unsigned)k);
+            return 1;
+        }
+    }
+    if (aecct::top_peek_param_count() != default_param_count || aecct::top_peek_state() != default_state) {
+        fail("parallel contexts touched the default registers");
+    }
+    const aecct::u32_t* default_sram = aecct::top_sram();
+    for (uint32_t i = 0u; i < sram_map::SRAM_WORDS_TOTAL; ++i) {
+        if (default_sram[i] != default_sram_before[i]) {
+            std::printf("ERROR: parallel contexts touched default SRAM word %u\n", (unsigned)i);
+            return 1;
+        }
+    }
+
+    for (uint32_t k = 0u; k < kInstances; ++k) {
+        delete ctxs[k];
+    }
+    std::printf("[m35] %u instances x %u codewords: sequential=%.1f ms threaded=%.1f ms\n",
+        (unsigned)kInstances, (unsigned)kCodewords, seq_ms, par_ms);
+    std::printf("PASS: tb_top_context_threads_m35\n");
+    return 0;
+}
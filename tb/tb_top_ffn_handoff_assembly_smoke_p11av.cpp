@@ -228,7 +228,8 @@ static bool run_mainline_path_case(
     const aecct::LayerScratch sc = aecct::make_layer_scratch(x_in_base);
     const uint32_t w1_out_base = (uint32_t)sc.ffn.w1_out_base_word.to_uint();
     const uint32_t w2_out_base = (uint32_t)sc.ffn.w2_out_base_word.to_uint();
-    const uint32_t compare_words = 16u;
+    // Whole W2 output tensor (and the same span of W1 output): early token rows can be zero on both paths.
+    const uint32_t compare_words = (uint32_t)aecct::FFN_W2_OUT_WORDS;
     uint32_t w1_change_count = 0u;
     uint32_t w2_change_count = 0u;
     MAINLINE_COMPARE_LOOP: for (uint32_t i = 0u; i < compare_words; ++i) {
@@ -0,0 +1,128 @@
+// M17: batched multi-codeword INFER (OP_INFER_BATCH) protocol smoke.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "tb_top_infer_common.h"
+
+using namespace top_infer_tb;
+
+static const uint32_t kBatchCount = 10u;
+
+int main() {
+    TopSession hx;
+
+    static uint32_t logits_single[kBatchCount][EXP_LEN_OUT_LOGITS_WORDS];
+    static uint32_t logits_batch[EXP_LEN_OUT_LOGITS_WORDS];
+
+    // Case A: INFER_BATCH before CFG_COMMIT is rejected.
+    hx.cmd((uint8_t)aecct::OP_SOFT_RESET);
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_SOFT_RESET, "soft_reset");
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, 2u);
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_BAD_STATE, "batch_no_cfg");
+
+    // Case B: back-to-back single INFERs from one W image are the per-codeword reference.
+    hx.fresh_session();
+    for (uint32_t cw = 0u; cw <= kBatchCount; ++cw) {
+        // The extra pass re-runs codeword 0 after the others: INFER must leave PARAM intact.
+        const uint32_t src_cw = (cw == kBatchCount) ? 0u : cw;
+        uint32_t* dst = (cw == kBatchCount) ? logits_batch : logits_single[cw];
+        hx.cmd((uint8_t)aecct::OP_INFER);
+        expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_INFER, "infer_begin");
+        hx.stream_codeword_checked(src_cw, true, (uint8_t)aecct::OP_INFER);
+        if (drain_data_words(hx.data_out, dst, (uint32_t)EXP_LEN_OUT_LOGITS_WORDS) !=
+            (uint32_t)EXP_LEN_OUT_LOGITS_WORDS) {
+            std::printf("ERROR: single INFER codeword %u logits length mismatch\n", (unsigned)src_cw);
+            return 1;
+        }
+    }
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+        if (logits_batch[i] != logits_single[0][i]) {
+            std::printf("ERROR: repeated single INFER logits[%u]=0x%08X first=0x%08X\n",
+                (unsigned)i, (unsigned)logits_batch[i], (unsigned)logits_single[0][i]);
+            return 1;
+        }
+    }
+    bool any_cw_differs = false;
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+        if (logits_single[1][i] != logits_single[0][i]) { any_cw_differs = true; }
+    }
+    if (!any_cw_differs) {
+        std::printf("ERROR: codewords 0 and 1 produced identical logits; reference is not discriminating\n");
+        return 1;
+    }
+
+    // Case C: illegal batch counts.
+    hx.fresh_session();
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, 0u);
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_BAD_ARG, "batch_count_zero");
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH,
+        (uint32_t)aecct::INFER_BATCH_MAX_CODEWORDS + 1u);
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_BAD_ARG, "batch_count_over");
+    if (aecct::top_peek_state() != aecct::ST_IDLE) {
+        std::printf("ERROR: illegal batch count left Top outside IDLE\n");
+        return 1;
+    }
+
+    // Case D: one handshake, kBatchCount payloads, one DONE.
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, kBatchCount);
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_INFER_BATCH, "batch_begin");
+    for (uint32_t cw = 0u; cw < kBatchCount; ++cw) {
+        const bool last = (cw + 1u == kBatchCount);
+        hx.stream_codeword_checked(cw, last, (uint8_t)aecct::OP_INFER_BATCH);
+        const uint32_t got_words =
+            drain_data_words(hx.data_out, logits_batch, (uint32_t)EXP_LEN_OUT_LOGITS_WORDS);
+        if (got_words != (uint32_t)EXP_LEN_OUT_LOGITS_WORDS) {
+            std::printf("ERROR: batch codeword %u logits length=%u expect=%u\n",
+                (unsigned)cw, (unsigned)got_words, (unsigned)EXP_LEN_OUT_LOGITS_WORDS);
+            return 1;
+        }
+        if ((unsigned)aecct::top_peek_infer_batch_done_count().to_uint() != (unsigned)(cw + 1u)) {
+            std::printf("ERROR: batch done_count=%u expect=%u\n",
+                (unsigned)aecct::top_peek_infer_batch_done_count().to_uint(), (unsigned)(cw + 1u));
+            return 1;
+        }
+        for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+            if (logits_batch[i] != logits_single[cw][i]) {
+                std::printf("ERROR: batch codeword %u logits[%u]=0x%08X single=0x%08X\n",
+                    (unsigned)cw, (unsigned)i, (unsigned)logits_batch[i], (unsigned)logits_single[cw][i]);
+                return 1;
+            }
+        }
+        if (!last && aecct::top_peek_state() != aecct::ST_INFER_RX) {
+            std::printf("ERROR: batch left INFER_RX after codeword %u\n", (unsigned)cw);
+            return 1;
+        }
+    }
+    if (aecct::top_peek_state() != aecct::ST_IDLE || aecct::top_peek_infer_batch_active()) {
+        std::printf("ERROR: batch did not return to IDLE\n");
+        return 1;
+    }
+    const uint32_t tiles_expected =
+        (kBatchCount + (uint32_t)aecct::INFER_BATCH_TILE_CODEWORDS - 1u) /
+        (uint32_t)aecct::INFER_BATCH_TILE_CODEWORDS;
+    if ((uint32_t)aecct::top_peek_infer_batch_ln_affine_fetch_count().to_uint() != tiles_expected) {
+        std::printf("ERROR: batch affine fetch_count=%u expect=%u\n",
+            (unsigned)aecct::top_peek_infer_batch_ln_affine_fetch_count().to_uint(),
+            (unsigned)tiles_expected);
+        return 1;
+    }
+    std::printf("PASS: batch codewords=%u tiles=%u every codeword exact-bit match vs single INFER\n",
+        (unsigned)kBatchCount, (unsigned)tiles_expected);
+
+    // Case E: OUTMODE_NONE batch streams nothing and still closes with one DONE.
+    hx.cmd_arg((uint8_t)aecct::OP_SET_OUTMODE, 2u);
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_SET_OUTMODE, "set_outmode_none");
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, 2u);
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_INFER_BATCH, "batch_none_begin");
+    hx.stream_codeword_checked(0u, false, (uint8_t)aecct::OP_INFER_BATCH);
+    hx.stream_codeword_checked(1u, true, (uint8_t)aecct::OP_INFER_BATCH);
+    if (drain_data_words(hx.data_out, 0, 0u) != 0u) {
+        std::printf("ERROR: OUTMODE_NONE batch produced hx.data_out words\n");
+        return 1;
+    }
+
+    std::printf("PASS: tb_top_infer_batch_m17\n");
+    return 0;
+}
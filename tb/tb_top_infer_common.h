@@ -0,0 +1,421 @@
+#pragma once
+// Shared host fixtures for the Top INFER testbenches (M17-M38): ctrl/data channel
+// checks, a Top session driver (CFG -> LOAD_W -> SET_OUTMODE -> INFER), the signed
+// random PARAM image with the live WQ/WK/WV payloads, and the Phase-B scratch
+// helpers (src_mask, Q/K/V rows, AttnCfg) used by the attention block checks.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "AecctProtocol.h"
+#include "AecctTypes.h"
+#include "gen/ModelDesc.h"
+#include "gen/ModelShapes.h"
+#include "gen/SramMap.h"
+#include "Top.h"
+#include "tb_p11aeaf_common.h"
+
+namespace top_infer_tb {
+
+typedef std::vector<aecct::u32_t> sram_vec_t;
+typedef std::vector<uint32_t> param_vec_t;
+
+static const uint32_t kTokens = N_NODES;
+static const uint32_t kDModel = D_MODEL;
+static const uint32_t kHeads = N_HEAD;
+static const uint32_t kDHead = D_MODEL / N_HEAD;
+static const uint32_t kLogitWords = (uint32_t)EXP_LEN_OUT_LOGITS_WORDS;
+static const uint32_t kScoreSentinel = 0x7FC0DEADu;
+
+using p11aeaf_tb::f32_to_bits;
+
+static inline void fail(const char* msg) {
+    std::printf("ERROR: %s\n", msg);
+    std::exit(1);
+}
+
+static inline void expect_u64(uint64_t got, uint64_t exp, const char* tag) {
+    if (got != exp) {
+        std::printf("ERROR: %s got=%llu expect=%llu\n", tag, (unsigned long long)got, (unsigned long long)exp);
+        std::exit(1);
+    }
+}
+
+static inline uint32_t lcg_next(uint32_t& s) {
+    s = s * 1664525u + 1013904223u;
+    return s;
+}
+
+// Uniform in (-1, 1).
+static inline float lcg_unit(uint32_t& s) {
+    return ((float)(lcg_next(s) >> 8) / 8388608.0f) - 1.0f;
+}
+
+// ---- ctrl / data channels ----
+
+static inline void expect_rsp(aecct::ctrl_ch_t& ctrl_rsp, uint8_t kind_exp, uint8_t payload_exp, const char* tag) {
+    aecct::u16_t w;
+    if (!ctrl_rsp.nb_read(w)) {
+        std::printf("ERROR: %s expected ctrl response but channel empty\n", tag);
+        std::exit(1);
+    }
+    const uint8_t kind = aecct::unpack_ctrl_rsp_kind(w);
+    const uint8_t payload = aecct::unpack_ctrl_rsp_payload(w);
+    if (kind != kind_exp || payload != payload_exp) {
+        std::printf("ERROR: %s ctrl response mismatch. kind=%u payload=%u expect_kind=%u expect_payload=%u\n",
+            tag, (unsigned)kind, (unsigned)payload, (unsigned)kind_exp, (unsigned)payload_exp);
+        std::exit(1);
+    }
+}
+
+static inline void expect_rsp_kind_either(
+    aecct::ctrl_ch_t& ctrl_rsp,
+    uint8_t kind_exp0,
+    uint8_t kind_exp1,
+    uint8_t payload_exp,
+    const char* tag
+) {
+    aecct::u16_t w;
+    if (!ctrl_rsp.nb_read(w)) {
+        std::printf("ERROR: %s expected ctrl response but channel empty\n", tag);
+        std::exit(1);
+    }
+    const uint8_t kind = aecct::unpack_ctrl_rsp_kind(w);
+    const uint8_t payload = aecct::unpack_ctrl_rsp_payload(w);
+    if ((kind != kind_exp0 && kind != kind_exp1) || payload != payload_exp) {
+        std::printf(
+            "ERROR: %s ctrl response mismatch. kind=%u payload=%u expect_kind=%u|%u expect_payload=%u\n",
+            tag,
+            (unsigned)kind,
+            (unsigned)payload,
+            (unsigned)kind_exp0,
+            (unsigned)kind_exp1,
+            (unsigned)payload_exp);
+        std::exit(1);
+    }
+}
+
+static inline void expect_no_rsp(aecct::ctrl_ch_t& ctrl_rsp, const char* tag) {
+    aecct::u16_t w;
+    if (ctrl_rsp.nb_read(w)) {
+        std::printf("ERROR: %s unexpected ctrl response. kind=%u payload=%u\n",
+            tag,
+            (unsigned)aecct::unpack_ctrl_rsp_kind(w),
+            (unsigned)aecct::unpack_ctrl_rsp_payload(w));
+        std::exit(1);
+    }
+}
+
+static inline void drain_rsp(aecct::ctrl_ch_t& ctrl_rsp) {
+    aecct::u16_t w;
+    while (ctrl_rsp.nb_read(w)) {
+    }
+}
+
+// Returns the number of words drained; the first max_words land in dst when non-null.
+static inline uint32_t drain_data_words(aecct::data_ch_t& data_out, uint32_t* dst = 0, uint32_t max_words = 0u) {
+    uint32_t n = 0u;
+    aecct::u32_t w;
+    while (data_out.nb_read(w)) {
+        if (dst != 0 && n < max_words) {
+            dst[n] = (uint32_t)w.to_uint();
+        }
+        ++n;
+    }
+    return n;
+}
+
+static inline uint32_t count_logit_diffs(const uint32_t* a, const uint32_t* b) {
+    uint32_t n = 0u;
+    for (uint32_t i = 0u; i < kLogitWords; ++i) {
+        n += (a[i] != b[i]) ? 1u : 0u;
+    }
+    return n;
+}
+
+static inline void expect_same_logits(const uint32_t* a, const uint32_t* b, const char* tag) {
+    for (uint32_t i = 0u; i < kLogitWords; ++i) {
+        if (a[i] != b[i]) {
+            std::printf("ERROR: %s logits[%u] 0x%08X vs 0x%08X\n",
+                tag, (unsigned)i, (unsigned)a[i], (unsigned)b[i]);
+            std::exit(1);
+        }
+    }
+}
+
+// ---- Top session driver ----
+
+// Finite hash PARAM word (exponent 0x3C) for sessions that do not need a real image.
+static inline uint32_t default_param_word(uint32_t i) {
+    return 0x3C000000u | ((i * 2654435761u) & 0x003FFFFFu);
+}
+
+// input_y word i of test codeword cw: multiples of 1/16 in [-1, 1).
+static inline uint32_t codeword_word(uint32_t cw, uint32_t i) {
+    const int32_t sv = (int32_t)((i * 7u + cw * 13u) & 31u) - 16;
+    return f32_to_bits(((float)sv) * 0.0625f);
+}
+
+struct TopSession {
+    aecct::ctrl_ch_t ctrl_cmd;
+    aecct::ctrl_ch_t ctrl_rsp;
+    aecct::data_ch_t data_in;
+    aecct::data_ch_t data_out;
+
+    void tick() { aecct::top(ctrl_cmd, ctrl_rsp, data_in, data_out); }
+
+    void cmd(uint8_t opcode) {
+        ctrl_cmd.write(aecct::pack_ctrl_cmd(opcode));
+        tick();
+    }
+
+    void cmd_arg(uint8_t opcode, uint32_t arg0) {
+        data_in.write((aecct::u32_t)arg0);
+        cmd(opcode);
+    }
+
+    // SOFT_RESET, then CFG_BEGIN / CFG words / CFG_COMMIT; every response is checked.
+    void configure(uint32_t n_layers = N_LAYERS, uint32_t features = 0u, uint32_t outmode = 1u) {
+        cmd((uint8_t)aecct::OP_SOFT_RESET);
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_SOFT_RESET, "soft_reset");
+
+        uint32_t cfg_words[EXP_LEN_CFG_WORDS];
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            cfg_words[i] = 0u;
+        }
+        cfg_words[CFG_CODE_N] = CODE_N;
+        cfg_words[CFG_CODE_K] = CODE_K;
+        cfg_words[CFG_CODE_C] = CODE_C;
+        cfg_words[CFG_N_NODES] = N_NODES;
+        cfg_words[CFG_D_MODEL] = D_MODEL;
+        cfg_words[CFG_N_HEAD] = N_HEAD;
+        cfg_words[CFG_N_LAYERS] = n_layers;
+        cfg_words[CFG_D_FFN] = D_FFN;
+        cfg_words[CFG_ENABLE_LPE] = 1u;
+        cfg_words[CFG_ENABLE_LPE_TOKEN] = 1u;
+        cfg_words[CFG_OUT_MODE] = outmode;
+        cfg_words[CFG_FEATURES] = features;
+
+        cmd((uint8_t)aecct::OP_CFG_BEGIN);
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_CFG_BEGIN, "cfg_begin");
+        for (unsigned i = 0; i < (unsigned)EXP_LEN_CFG_WORDS; ++i) {
+            data_in.write((aecct::u32_t)cfg_words[i]);
+            tick();
+            expect_no_rsp(ctrl_rsp, "cfg_ingest");
+        }
+        cmd((uint8_t)aecct::OP_CFG_COMMIT);
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_CFG_COMMIT, "cfg_commit");
+    }
+
+    // SET_W_BASE + LOAD_W; the PARAM words follow through stream_param.
+    void load_w_begin(uint32_t param_base_word = (uint32_t)sram_map::PARAM_BASE_DEFAULT) {
+        cmd_arg((uint8_t)aecct::OP_SET_W_BASE, param_base_word);
+        expect_rsp_kind_either(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::RSP_OK,
+            (uint8_t)aecct::OP_SET_W_BASE, "set_w_base");
+        cmd((uint8_t)aecct::OP_LOAD_W);
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_LOAD_W, "load_w_begin");
+    }
+
+    // A null param streams default_param_word.
+    void stream_param(const param_vec_t* param) {
+        for (uint32_t i = 0; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+            data_in.write((aecct::u32_t)(param != 0 ? (*param)[i] : default_param_word(i)));
+            tick();
+        }
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_LOAD_W, "load_w_done");
+    }
+
+    void set_outmode(uint32_t outmode = 1u) {
+        cmd_arg((uint8_t)aecct::OP_SET_OUTMODE, outmode);
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_SET_OUTMODE, "set_outmode");
+    }
+
+    // Fresh CFG + LOAD_W + SET_OUTMODE session.
+    void fresh_session(
+        uint32_t n_layers = N_LAYERS,
+        uint32_t features = 0u,
+        const param_vec_t* param = 0,
+        uint32_t param_base_word = (uint32_t)sram_map::PARAM_BASE_DEFAULT,
+        uint32_t outmode = 1u
+    ) {
+        configure(n_layers, features, outmode);
+        load_w_begin(param_base_word);
+        stream_param(param);
+        set_outmode(outmode);
+    }
+
+    // Writes codeword cw one word per top() call; responses are left queued.
+    void stream_codeword(uint32_t cw) {
+        for (uint32_t i = 0; i < (uint32_t)EXP_LEN_INFER_IN_WORDS; ++i) {
+            data_in.write((aecct::u32_t)codeword_word(cw, i));
+            tick();
+        }
+    }
+
+    // Codeword cw with a ctrl check after every word: silence, except DONE(final_opcode)
+    // after the last word when expect_final_rsp.
+    void stream_codeword_checked(uint32_t cw, bool expect_final_rsp, uint8_t final_opcode) {
+        const uint32_t in_words = (uint32_t)EXP_LEN_INFER_IN_WORDS;
+        for (uint32_t i = 0; i < in_words; ++i) {
+            data_in.write((aecct::u32_t)codeword_word(cw, i));
+            tick();
+            if (i + 1u < in_words || !expect_final_rsp) {
+                expect_no_rsp(ctrl_rsp, "infer_ingest");
+            }
+            else {
+                expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, final_opcode, "infer_done");
+            }
+        }
+    }
+
+    // One INFER of input_y; logits (may be null) get exactly kLogitWords words.
+    void infer_words(const uint32_t* y, uint32_t* logits) {
+        cmd((uint8_t)aecct::OP_INFER);
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_INFER, "infer_begin");
+        for (uint32_t i = 0; i < (uint32_t)EXP_LEN_INFER_IN_WORDS; ++i) {
+            data_in.write((aecct::u32_t)y[i]);
+            tick();
+        }
+        expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_INFER, "infer_done");
+        if (drain_data_words(data_out, logits, kLogitWords) != kLogitWords) {
+            fail("INFER logits length mismatch");
+        }
+    }
+
+    // One INFER of codeword cw.
+    void infer(uint32_t cw, uint32_t* logits) {
+        uint32_t y[EXP_LEN_INFER_IN_WORDS];
+        for (uint32_t i = 0; i < (uint32_t)EXP_LEN_INFER_IN_WORDS; ++i) {
+            y[i] = codeword_word(cw, i);
+        }
+        infer_words(y, logits);
+    }
+};
+
+// ---- PARAM image / Phase-B scratch ----
+
+static inline uint32_t mask_base_word(uint32_t param_base_word = (uint32_t)sram_map::PARAM_BASE_DEFAULT) {
+    return param_base_word + kParamMeta[kWeightIdToParamId[(uint32_t)SRC_MASK]].offset_w;
+}
+
+// src_mask bitpack; density_shift ANDs that many LCG words, so larger shifts mask more keys.
+static inline void fill_mask(
+    sram_vec_t& sram,
+    uint32_t seed,
+    uint32_t density_shift,
+    uint32_t param_base_word = (uint32_t)sram_map::PARAM_BASE_DEFAULT
+) {
+    const uint32_t base = mask_base_word(param_base_word);
+    for (uint32_t w = 0u; w < SRC_MASK_WORDS_BITPACK; ++w) {
+        uint32_t bits = 0xFFFFFFFFu;
+        for (uint32_t k = 0u; k < density_shift; ++k) {
+            bits &= lcg_next(seed);
+        }
+        sram[base + w] = (aecct::u32_t)(~bits);
+    }
+}
+
+static inline void snapshot_mask(const sram_vec_t& sram, uint32_t* mask_words) {
+    const uint32_t base = mask_base_word();
+    for (uint32_t w = 0u; w < SRC_MASK_WORDS_BITPACK; ++w) {
+        mask_words[w] = (uint32_t)sram[base + w].to_uint();
+    }
+}
+
+// Key j is visible to query i on ring: ring-allowed and not set in src_mask.
+static inline bool mask_allows(const uint32_t* mask_words, uint32_t ring, uint32_t i, uint32_t j) {
+    const uint32_t bit = i * kTokens + j;
+    const bool masked = ((mask_words[bit >> 5] >> (bit & 31u)) & 1u) != 0u;
+    return aecct::attn_mask_ring_allows(ring, i, j) && !masked;
+}
+
+// u32_t views for the bitmap AE/AF, which read the mask words directly.
+static inline void snapshot_mask(const sram_vec_t& sram, aecct::u32_t* mask_words) {
+    const uint32_t base = mask_base_word();
+    for (uint32_t w = 0u; w < SRC_MASK_WORDS_BITPACK; ++w) {
+        mask_words[w] = sram[base + w];
+    }
+}
+
+static inline bool mask_allows(const aecct::u32_t* mask_words, uint32_t ring, uint32_t i, uint32_t j) {
+    const uint32_t bit = i * kTokens + j;
+    const bool masked = (((uint32_t)mask_words[bit >> 5].to_uint() >> (bit & 31u)) & 1u) != 0u;
+    return aecct::attn_mask_ring_allows(ring, i, j) && !masked;
+}
+
+// Signed pseudo-random words in (-1, 1) for every parameter so every layer carries
+// signal into the logits, the live WQ/WK/WV payloads on top to keep the managed
+// Q/K/V prebuild on its mainline, and a pseudo-random src_mask.
+static inline void build_param_image(
+    param_vec_t& param,
+    uint32_t fill_seed,
+    uint32_t mask_seed,
+    uint32_t mask_density_shift = 1u
+) {
+    p11aeaf_tb::QkvPayloadSet payloads;
+    if (!p11aeaf_tb::prepare_qkv_payload_set(payloads)) {
+        fail("prepare_qkv_payload_set failed");
+    }
+    const uint32_t param_base = (uint32_t)sram_map::PARAM_BASE_DEFAULT;
+    sram_vec_t seed(sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
+    uint32_t s = fill_seed;
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        seed[param_base + i] = (aecct::u32_t)f32_to_bits(lcg_unit(s));
+    }
+    p11aeaf_tb::load_qkv_payload_set_to_sram(seed, payloads, param_base);
+    fill_mask(seed, mask_seed, mask_density_shift);
+    param.assign((uint32_t)EXP_LEN_PARAM_WORDS, 0u);
+    for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+        param[i] = (uint32_t)seed[param_base + i].to_uint();
+    }
+}
+
+// Q/K/V rows in multiples of 1/16 over [-2, 2).
+static inline void fill_qkv(sram_vec_t& sram, const aecct::AttnScratch& sc, uint32_t seed) {
+    const uint32_t bases[3] = {
+        (uint32_t)sc.q_base_word.to_uint(),
+        (uint32_t)sc.k_base_word.to_uint(),
+        (uint32_t)sc.v_base_word.to_uint()
+    };
+    for (uint32_t b = 0u; b < 3u; ++b) {
+        for (uint32_t i = 0u; i < kTokens * kDModel; ++i) {
+            const int32_t sv = (int32_t)((lcg_next(seed) >> 11) & 63u) - 32;
+            sram[bases[b] + i] = (aecct::u32_t)f32_to_bits(((float)sv) * 0.0625f);
+        }
+    }
+}
+
+static inline void fill_score_sentinel(sram_vec_t& sram, const aecct::AttnScratch& sc) {
+    const uint32_t base = (uint32_t)sc.score_base_word.to_uint();
+    for (uint32_t i = 0u; i < kHeads * kTokens; ++i) {
+        sram[base + i] = (aecct::u32_t)kScoreSentinel;
+    }
+}
+
+static inline aecct::AttnCfg make_cfg(uint32_t heads = kHeads) {
+    aecct::AttnCfg cfg;
+    cfg.token_count = (aecct::u32_t)kTokens;
+    cfg.d_model = (aecct::u32_t)kDModel;
+    cfg.n_heads = (aecct::u32_t)heads;
+    cfg.d_head = (aecct::u32_t)(kDModel / heads);
+    return cfg;
+}
+
+static inline void compare_rows(
+    const sram_vec_t& a,
+    const sram_vec_t& b,
+    uint32_t base,
+    const char* tag,
+    uint32_t words = kTokens * kDModel
+) {
+    for (uint32_t i = 0u; i < words; ++i) {
+        if (a[base + i] != b[base + i]) {
+            std::printf("ERROR: %s mismatch at word %u\n", tag, (unsigned)i);
+            std::exit(1);
+        }
+    }
+}
+
+} // namespace top_infer_tb
@@ -0,0 +1,183 @@
+// M18: overlapped INFER_BATCH (IO input ping/pong, INFER_OVL state) smoke.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "tb_top_infer_common.h"
+
+using namespace top_infer_tb;
+
+static const uint32_t kBatchCount = 4u;
+static const uint32_t kDrainTickLimit = 64u;
+
+// Overlapped batch. Paced: the host pushes one word per tick without waiting for
+// compute. Burst: the host queues every codeword up front, so Top drains RX as fast
+// as its per-stage budget allows.
+// Returns the number of ticks spent after the last host write until DONE.
+static uint32_t run_overlap_batch(
+    TopSession& hx,
+    uint32_t (*logits)[EXP_LEN_OUT_LOGITS_WORDS],
+    bool burst
+) {
+    const uint32_t arg = kBatchCount | (1u << aecct::INFER_BATCH_ARG_OVERLAP_BIT);
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, arg);
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_INFER_BATCH, "ovl_batch_begin");
+    if (!aecct::top_peek_infer_ovl_enable()) {
+        std::printf("ERROR: overlap bit not latched\n");
+        std::exit(1);
+    }
+
+    static uint32_t stream_words[kBatchCount * EXP_LEN_OUT_LOGITS_WORDS + 1u];
+    uint32_t stream_count = 0u;
+    const uint32_t in_words = (uint32_t)EXP_LEN_INFER_IN_WORDS;
+    for (uint32_t cw = 0u; cw < kBatchCount; ++cw) {
+        for (uint32_t i = 0u; i < in_words; ++i) {
+            hx.data_in.write((aecct::u32_t)codeword_word(cw, i));
+            if (burst) {
+                continue;
+            }
+            hx.tick();
+            expect_no_rsp(hx.ctrl_rsp, "ovl_ingest");
+            stream_count += drain_data_words(
+                hx.data_out,
+                &stream_words[stream_count],
+                (uint32_t)(kBatchCount * EXP_LEN_OUT_LOGITS_WORDS + 1u) - stream_count);
+        }
+    }
+
+    const uint32_t tick_limit = burst ? (in_words + kDrainTickLimit) : kDrainTickLimit;
+    uint32_t drain_ticks = 0u;
+    aecct::u16_t rsp;
+    while (!hx.ctrl_rsp.nb_read(rsp)) {
+        if (drain_ticks == tick_limit) {
+            std::printf("ERROR: overlapped batch did not finish within %u ticks\n", (unsigned)tick_limit);
+            std::exit(1);
+        }
+        hx.tick();
+        ++drain_ticks;
+        stream_count += drain_data_words(
+            hx.data_out,
+            &stream_words[stream_count],
+            (uint32_t)(kBatchCount * EXP_LEN_OUT_LOGITS_WORDS + 1u) - stream_count);
+    }
+    if (aecct::unpack_ctrl_rsp_kind(rsp) != (uint8_t)aecct::RSP_DONE ||
+        aecct::unpack_ctrl_rsp_payload(rsp) != (uint8_t)aecct::OP_INFER_BATCH) {
+        std::printf("ERROR: overlapped batch closing rsp kind=%u payload=%u\n",
+            (unsigned)aecct::unpack_ctrl_rsp_kind(rsp), (unsigned)aecct::unpack_ctrl_rsp_payload(rsp));
+        std::exit(1);
+    }
+    stream_count += drain_data_words(
+        hx.data_out,
+        &stream_words[stream_count],
+        (uint32_t)(kBatchCount * EXP_LEN_OUT_LOGITS_WORDS + 1u) - stream_count);
+    if (stream_count != kBatchCount * (uint32_t)EXP_LEN_OUT_LOGITS_WORDS) {
+        std::printf("ERROR: overlapped batch streamed %u words expect=%u\n",
+            (unsigned)stream_count, (unsigned)(kBatchCount * (uint32_t)EXP_LEN_OUT_LOGITS_WORDS));
+        std::exit(1);
+    }
+    for (uint32_t cw = 0u; cw < kBatchCount; ++cw) {
+        for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+            logits[cw][i] = stream_words[cw * (uint32_t)EXP_LEN_OUT_LOGITS_WORDS + i];
+        }
+    }
+    return drain_ticks;
+}
+
+static bool check_ovl_logits(
+    const uint32_t (*got)[EXP_LEN_OUT_LOGITS_WORDS],
+    const uint32_t (*exp)[EXP_LEN_OUT_LOGITS_WORDS],
+    const char* tag
+) {
+    for (uint32_t cw = 0u; cw < kBatchCount; ++cw) {
+        for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+            if (got[cw][i] != exp[cw][i]) {
+                std::printf("ERROR: %s overlapped codeword %u logits[%u]=0x%08X single=0x%08X\n",
+                    tag, (unsigned)cw, (unsigned)i, (unsigned)got[cw][i], (unsigned)exp[cw][i]);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool check_ovl_idle() {
+    if (aecct::top_peek_state() != aecct::ST_IDLE || aecct::top_peek_infer_ovl_enable() ||
+        (uint32_t)aecct::top_peek_infer_ovl_stage().to_uint() != (uint32_t)aecct::OVL_STAGE_IDLE) {
+        std::printf("ERROR: overlapped batch did not return to IDLE\n");
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    TopSession hx;
+
+    static uint32_t logits_single[kBatchCount][EXP_LEN_OUT_LOGITS_WORDS];
+    static uint32_t logits_ovl[kBatchCount][EXP_LEN_OUT_LOGITS_WORDS];
+
+    // Case A: reserved arg bits are rejected.
+    hx.fresh_session();
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH,
+        kBatchCount | (1u << (aecct::INFER_BATCH_ARG_OVERLAP_BIT + 1u)));
+    expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_BAD_ARG, "ovl_arg_reserved");
+
+    // Case B: back-to-back single INFERs from one fresh W image are the reference.
+    for (uint32_t cw = 0u; cw < kBatchCount; ++cw) {
+        hx.cmd((uint8_t)aecct::OP_INFER);
+        expect_rsp(hx.ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_INFER, "single_infer_begin");
+        hx.stream_codeword_checked(cw, true, (uint8_t)aecct::OP_INFER);
+        if (drain_data_words(hx.data_out, logits_single[cw], (uint32_t)EXP_LEN_OUT_LOGITS_WORDS) !=
+            (uint32_t)EXP_LEN_OUT_LOGITS_WORDS) {
+            std::printf("ERROR: single INFER codeword %u logits length mismatch\n", (unsigned)cw);
+            return 1;
+        }
+    }
+
+    // Case C: paced host, one word per tick; ingest of codeword N+1 runs while N computes.
+    hx.fresh_session();
+    const uint32_t drain_ticks = run_overlap_batch(hx, logits_ovl, false);
+    if (!check_ovl_logits(logits_ovl, logits_single, "paced")) {
+        return 1;
+    }
+    const uint32_t launches = (uint32_t)aecct::top_peek_infer_ovl_launch_count().to_uint();
+    const uint32_t overlapped_words = (uint32_t)aecct::top_peek_infer_ovl_rx_overlapped_word_count().to_uint();
+    const uint32_t stalls = (uint32_t)aecct::top_peek_infer_ovl_rx_stall_count().to_uint();
+    if (launches != kBatchCount) {
+        std::printf("ERROR: overlapped launch_count=%u expect=%u\n", (unsigned)launches, (unsigned)kBatchCount);
+        return 1;
+    }
+    if (overlapped_words == 0u || stalls != 0u) {
+        std::printf("ERROR: overlapped rx words=%u stalls=%u (expect >0 and 0)\n",
+            (unsigned)overlapped_words, (unsigned)stalls);
+        return 1;
+    }
+    if (!check_ovl_idle()) {
+        return 1;
+    }
+    std::printf("PASS: paced overlapped batch codewords=%u overlapped_rx_words=%u stalls=%u tail_ticks=%u\n",
+        (unsigned)kBatchCount, (unsigned)overlapped_words, (unsigned)stalls, (unsigned)drain_ticks);
+
+    // Case D: burst host. Every codeword after the first lands entirely while the previous
+    // one is still computing, so all of its words count as overlapped.
+    hx.fresh_session();
+    const uint32_t burst_ticks = run_overlap_batch(hx, logits_ovl, true);
+    if (!check_ovl_logits(logits_ovl, logits_single, "burst")) {
+        return 1;
+    }
+    const uint32_t burst_overlapped = (uint32_t)aecct::top_peek_infer_ovl_rx_overlapped_word_count().to_uint();
+    const uint32_t burst_expected = (kBatchCount - 1u) * (uint32_t)EXP_LEN_INFER_IN_WORDS;
+    if (burst_overlapped != burst_expected) {
+        std::printf("ERROR: burst overlapped rx words=%u expect=%u\n",
+            (unsigned)burst_overlapped, (unsigned)burst_expected);
+        return 1;
+    }
+    if (!check_ovl_idle()) {
+        return 1;
+    }
+    std::printf("PASS: burst overlapped batch overlapped_rx_words=%u/%u ticks=%u single-vs-overlap exact-bit match\n",
+        (unsigned)burst_overlapped, (unsigned)(kBatchCount * (uint32_t)EXP_LEN_INFER_IN_WORDS), (unsigned)burst_ticks);
+
+    std::printf("PASS: tb_top_infer_overlap_m18\n");
+    return 0;
+}
@@ -175,6 +175,20 @@ int main() {
     expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_CFG_ILLEGAL);
     expect_state(aecct::ST_IDLE);
 
+    // Case 3b: undefined CFG_FEATURES bit -> ERR_CFG_ILLEGAL.
+    drive_cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_SOFT_RESET);
+    expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_SOFT_RESET);
+
+    build_valid_cfg(cfg);
+    cfg[CFG_FEATURES] = CFG_FEATURES_DEFINED_MASK + 1u;
+
+    drive_cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_CFG_BEGIN);
+    expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_OK, (uint8_t)aecct::OP_CFG_BEGIN);
+    send_cfg_words(ctrl_cmd, ctrl_rsp, data_in, data_out, cfg, CFG_WORDS_EXPECTED);
+    drive_cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_CFG_COMMIT);
+    expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_ERR, (uint8_t)aecct::ERR_CFG_ILLEGAL);
+    expect_state(aecct::ST_IDLE);
+
     // Case 4?垓?????憛?ST_CFG_RX ?啾撮餈?INFER/LOAD_W??
     drive_cmd(ctrl_cmd, ctrl_rsp, data_in, data_out, (uint8_t)aecct::OP_SOFT_RESET);
     expect_rsp(ctrl_rsp, (uint8_t)aecct::RSP_DONE, (uint8_t)aecct::OP_SOFT_RESET);
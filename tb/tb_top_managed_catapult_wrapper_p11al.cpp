@@ -176,6 +176,19 @@ private:
         payloads.wk_inv_sw_bits = wk_inv_sw_bits_;
         payloads.wv_inv_sw_bits = wv_inv_sw_bits_;
         p11aeaf_tb::load_qkv_payload_set_to_sram(sram, payloads, (uint32_t)sram_map::W_REGION_BASE);
+        // Mirror the wrapper's identity LayerNorm gamma windows.
+        const uint32_t gamma_ids[3] = {
+            (uint32_t)DECODER_LAYERS_0_SUBLAYER_0_NORM_WEIGHT,
+            (uint32_t)DECODER_LAYERS_0_SUBLAYER_1_NORM_WEIGHT,
+            (uint32_t)DECODER_NORM_WEIGHT
+        };
+        for (uint32_t g = 0u; g < 3u; ++g) {
+            const uint32_t gamma_base =
+                (uint32_t)sram_map::W_REGION_BASE + kParamMeta[kWeightIdToParamId[gamma_ids[g]]].offset_w;
+            for (uint32_t c = 0u; c < (uint32_t)aecct::LN_D_MODEL; ++c) {
+                sram[gamma_base + c] = (aecct::u32_t)0x3F800000u;
+            }
+        }
 
         aecct::TopRegs regs;
         regs.clear();
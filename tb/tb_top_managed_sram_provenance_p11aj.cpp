@@ -426,6 +426,8 @@ private:
         sram_vec.assign((uint32_t)sram_map::SRAM_WORDS_TOTAL, (aecct::u32_t)0u);
         init_full_x_rows(sram_vec);
         p11aeaf_tb::load_qkv_payload_set_to_sram(sram_vec, payloads_, param_base_);
+        // Identity sublayer/end norms keep final_x observable (all-zero gamma would zero it).
+        apply_bridge_probe_norm_params(sram_vec);
     }
 
     void init_top_regs_for_layers(
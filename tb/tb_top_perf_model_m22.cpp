@@ -0,0 +1,194 @@
+// M22: host-side Top performance accounting and cycle cost model.
+// Runs one INFER and a 2-codeword INFER_BATCH from fresh sessions and checks the
+// per-phase/subphase counts against the model shapes and the cost model arithmetic.
+// Sparse and fused Phase-B sessions check the attention cells against the CSR nnz.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "tb_top_infer_common.h"
+
+using namespace top_infer_tb;
+
+static void check_single_infer_counts(const aecct::TopPerfCounters& c) {
+    const uint64_t t = (uint64_t)N_NODES;
+    const uint64_t x = t * (uint64_t)D_MODEL;
+
+    const aecct::TopPerfCounts& pre = c.cell[aecct::PHASE_PREPROC][aecct::PERF_SUB_BLOCK];
+    expect_u64(pre.calls, 2u, "preproc calls (embed + pre-LN)");
+    expect_u64(pre.ch_in, (uint64_t)EXP_LEN_INFER_IN_WORDS, "preproc ch_in");
+
+    for (unsigned p = (unsigned)aecct::PHASE_LAYER0; p <= (unsigned)aecct::PHASE_LAYER1; p += 2u) {
+        const aecct::TopPerfCounts* cell = c.cell[p];
+        expect_u64(cell[aecct::PERF_SUB_Q].calls, 1u, "layer q calls");
+        expect_u64(cell[aecct::PERF_SUB_Q].mac, x * (uint64_t)D_MODEL, "layer q mac");
+        expect_u64(cell[aecct::PERF_SUB_K].mac, x * (uint64_t)D_MODEL, "layer k mac");
+        expect_u64(cell[aecct::PERF_SUB_V].sram_wr, x, "layer v sram_wr");
+        expect_u64(cell[aecct::PERF_SUB_SCORE].mac, t * t * (uint64_t)D_MODEL, "layer score mac");
+        expect_u64(cell[aecct::PERF_SUB_SCORE].sram_wr, (uint64_t)N_HEAD * t * t, "layer score sram_wr");
+        expect_u64(cell[aecct::PERF_SUB_SOFTMAX].lut, (uint64_t)N_HEAD * t * (t + 1u), "layer softmax lut");
+        expect_u64(cell[aecct::PERF_SUB_SOFTMAX].mac, t * t * (uint64_t)D_MODEL, "layer softmax mac");
+        expect_u64(cell[aecct::PERF_SUB_SOFTMAX].steps, (uint64_t)N_HEAD * t * t, "layer softmax steps");
+        expect_u64(cell[aecct::PERF_SUB_OUT].mac, x * (uint64_t)D_MODEL, "layer out mac");
+        expect_u64(cell[aecct::PERF_SUB_FUSED].calls, 0u, "layer fused calls");
+        expect_u64(cell[aecct::PERF_SUB_FFN].mac, 3u * x + 2u * x * (uint64_t)D_FFN, "layer ffn mac");
+        expect_u64(cell[aecct::PERF_SUB_BLOCK].calls, 0u, "layer block calls");
+    }
+
+    expect_u64(c.cell[aecct::PHASE_MID_LN][aecct::PERF_SUB_BLOCK].calls, 1u, "mid LN calls");
+    expect_u64(c.cell[aecct::PHASE_END_LN][aecct::PERF_SUB_BLOCK].calls, 1u, "end LN calls");
+    expect_u64(c.cell[aecct::PHASE_END_LN][aecct::PERF_SUB_BLOCK].sram_wr, x, "end LN sram_wr");
+
+    const aecct::TopPerfCounts& fh = c.cell[aecct::PHASE_FINAL_HEAD][aecct::PERF_SUB_BLOCK];
+    expect_u64(fh.ch_out, (uint64_t)EXP_LEN_OUT_LOGITS_WORDS, "final head ch_out");
+    expect_u64(fh.mac, (uint64_t)EXP_LEN_OUT_LOGITS_WORDS * t, "final head mac");
+}
+
+static void check_cost_model(const aecct::TopPerfCounters& c) {
+    const aecct::TopPerfCounts& q = c.cell[aecct::PHASE_LAYER0][aecct::PERF_SUB_Q];
+    aecct::TopPerfCostModel m = aecct::make_top_perf_cost_model();
+
+    // Baseline overlapped units: the slowest resource of Q is the single MAC lane.
+    expect_u64(aecct::top_perf_estimate_cycles(q, m), q.mac, "q cycles baseline");
+
+    m.mac_lanes = 16u;
+    const uint64_t rd_bound = q.sram_rd;
+    const uint64_t mac_bound = (q.mac + 15u) / 16u;
+    expect_u64(aecct::top_perf_estimate_cycles(q, m),
+        (rd_bound > mac_bound) ? rd_bound : mac_bound, "q cycles with 16 MAC lanes");
+
+    m.overlap_units = false;
+    m.call_overhead_cycles = 10u;
+    expect_u64(aecct::top_perf_estimate_cycles(q, m),
+        q.sram_rd + q.sram_wr + mac_bound + q.calls * 10u, "q cycles serialized");
+
+    // Widening every resource must never cost more.
+    const aecct::TopPerfCostModel base = aecct::make_top_perf_cost_model();
+    aecct::TopPerfCostModel wide = base;
+    wide.sram_rd_ports = 2u;
+    wide.sram_wr_ports = 2u;
+    wide.mac_lanes = 32u;
+    wide.lut_ports = 4u;
+    const uint64_t base_total = aecct::top_perf_estimate_total_cycles(c, base);
+    const uint64_t wide_total = aecct::top_perf_estimate_total_cycles(c, wide);
+    if (base_total == 0u || wide_total >= base_total) {
+        fail("wider cost model did not reduce the total estimate");
+    }
+    uint64_t phase_sum = 0u;
+    for (unsigned p = 0u; p < aecct::PERF_PHASE_COUNT; ++p) {
+        phase_sum += aecct::top_perf_estimate_phase_cycles(c, base, p);
+    }
+    expect_u64(phase_sum, base_total, "phase cycles sum to total");
+    aecct::top_perf_print(c, base);
+}
+
+// (key, head) pairs the CSR keeps per layer: each head walks its ring's lists.
+static uint64_t csr_pairs_per_layer() {
+    uint64_t pairs = 0u;
+    for (uint32_t h = 0u; h < (uint32_t)N_HEAD; ++h) {
+        const uint32_t ring = aecct::attn_mask_csr_ring_from_head_group(aecct::attn_phaseb_head_group_id_from_head_idx(h));
+        pairs += (uint64_t)aecct::top_peek_attn_mask_csr_nnz(ring).to_uint();
+    }
+    return pairs;
+}
+
+// The managed target layer (LAYER0) is charged at the seam Top took; LAYER1 stays dense.
+static void check_sparse_infer_counts(const aecct::TopPerfCounters& c, bool fused) {
+    const uint64_t t = (uint64_t)N_NODES;
+    const uint64_t d_head = (uint64_t)(D_MODEL / N_HEAD);
+    const uint64_t pairs = csr_pairs_per_layer();
+    if (pairs == 0u || pairs >= (uint64_t)N_HEAD * t * t) {
+        fail("CSR does not thin the key set");
+    }
+    // Phase-B features put every layer on the managed path.
+    for (unsigned p = (unsigned)aecct::PHASE_LAYER0; p <= (unsigned)aecct::PHASE_LAYER1; p += 2u) {
+        const aecct::TopPerfCounts* l = c.cell[p];
+        if (fused) {
+            const aecct::TopPerfCounts& f = l[aecct::PERF_SUB_FUSED];
+            expect_u64(f.calls, 1u, "fused calls");
+            expect_u64(f.mac, 2u * pairs * d_head, "fused mac");
+            expect_u64(f.lut, pairs + t * (uint64_t)N_HEAD, "fused lut");
+            if (f.steps == 0u || f.steps > pairs) {
+                fail("fused steps outside (0, pairs]");
+            }
+            expect_u64(l[aecct::PERF_SUB_SCORE].calls, 0u, "fused score calls");
+            expect_u64(l[aecct::PERF_SUB_SOFTMAX].calls, 0u, "fused softmax calls");
+        } else {
+            const aecct::TopPerfCounts& sc = l[aecct::PERF_SUB_SCORE];
+            expect_u64(sc.mac, pairs * d_head, "sparse score mac");
+            expect_u64(sc.sram_wr, pairs, "sparse score sram_wr");
+            expect_u64(l[aecct::PERF_SUB_SOFTMAX].mac, pairs * d_head, "sparse softmax mac");
+            expect_u64(l[aecct::PERF_SUB_SOFTMAX].steps, pairs, "sparse softmax steps");
+            expect_u64(l[aecct::PERF_SUB_FUSED].calls, 0u, "sparse fused calls");
+        }
+        expect_u64(l[aecct::PERF_SUB_Q].mac, t * (uint64_t)D_MODEL * (uint64_t)D_MODEL, "managed layer q mac");
+    }
+}
+
+static aecct::TopPerfCounters run_feature_infer(TopSession& hx, const param_vec_t& param, uint32_t features) {
+    hx.fresh_session(N_LAYERS, features, &param);
+    hx.infer(0u, 0);
+    return aecct::top_perf();
+}
+
+int main() {
+    TopSession hx;
+
+    // Soft reset clears the counters; CFG and LOAD_W charge no phase.
+    hx.fresh_session();
+    if (aecct::top_perf_estimate_total_cycles(aecct::top_perf(), aecct::make_top_perf_cost_model()) != 0u) {
+        fail("counters not clear after soft reset + load");
+    }
+
+    hx.infer(0u, 0);
+    const aecct::TopPerfCounters single = aecct::top_perf();
+    check_single_infer_counts(single);
+    check_cost_model(single);
+
+    // Batched INFER charges each codeword once per subphase.
+    hx.fresh_session();
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, 2u);
+    hx.stream_codeword(0u);
+    hx.stream_codeword(1u);
+    drain_rsp(hx.ctrl_rsp);
+    (void)drain_data_words(hx.data_out);
+    const aecct::TopPerfCounters& batch = aecct::top_perf();
+    for (unsigned p = 0u; p < aecct::PERF_PHASE_COUNT; ++p) {
+        for (unsigned s = 0u; s < (unsigned)aecct::PERF_SUB_COUNT; ++s) {
+            expect_u64(batch.cell[p][s].calls, 2u * single.cell[p][s].calls, "batch calls");
+            expect_u64(batch.cell[p][s].mac, 2u * single.cell[p][s].mac, "batch mac");
+            expect_u64(batch.cell[p][s].ch_in, 2u * single.cell[p][s].ch_in, "batch ch_in");
+        }
+    }
+
+    // Sparse AE/AF and fused Phase-B are charged from the keys they visited.
+    // Live Q/K/V payloads and a random src_mask, so the managed layers run Phase-B row by row in Top.
+    param_vec_t managed_param;
+    build_param_image(managed_param, 0x22u, 0x4242u);
+    const aecct::TopPerfCounters dense = run_feature_infer(hx, managed_param, 0u);
+    if (!aecct::top_peek_p11ae_mainline_score_path_taken() ||
+        !aecct::top_peek_p11af_mainline_softmax_output_path_taken()) {
+        fail("managed AE/AF mainline not taken");
+    }
+    check_single_infer_counts(dense);
+    const aecct::TopPerfCounters sparse = run_feature_infer(hx, managed_param, (uint32_t)CFG_FEAT_ATTN_SPARSE);
+    if ((uint32_t)aecct::top_peek_attn_sparse_token_count().to_uint() != (uint32_t)(N_NODES * N_LAYERS)) {
+        fail("sparse Phase-B not taken");
+    }
+    check_sparse_infer_counts(sparse, false);
+    const aecct::TopPerfCounters fused = run_feature_infer(hx, managed_param,
+        (uint32_t)CFG_FEAT_ATTN_SPARSE | (uint32_t)CFG_FEAT_ATTN_FUSED);
+    if ((uint32_t)aecct::top_peek_attn_fused_token_count().to_uint() != (uint32_t)(N_NODES * N_LAYERS)) {
+        fail("fused Phase-B not taken");
+    }
+    check_sparse_infer_counts(fused, true);
+    if (aecct::top_perf_estimate_phase_cycles(fused, aecct::make_top_perf_cost_model(), aecct::PHASE_LAYER0) >=
+        aecct::top_perf_estimate_phase_cycles(dense, aecct::make_top_perf_cost_model(), aecct::PHASE_LAYER0)) {
+        fail("sparse fused layer not cheaper than dense");
+    }
+
+    std::printf("PASS: tb_top_perf_model_m22\n");
+    return 0;
+}
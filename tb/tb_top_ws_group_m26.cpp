@@ -0,0 +1,81 @@
+// M26: batched INFER consumes the FFN weights in place from W_REGION.
+// Each layer's top-fed FFN descriptor points at the PARAM words for the whole batch,
+// so no codeword stages them and Top keeps no weight copy. Checks that every batch
+// codeword matches back-to-back single INFERs, the in-place bind count, and that the
+// perf model still charges the W_REGION weight reads once per codeword.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "tb_top_infer_common.h"
+
+using namespace top_infer_tb;
+
+static const uint32_t kBatchCount = 10u;
+
+int main() {
+    TopSession hx;
+    static uint32_t logits_single[kBatchCount][EXP_LEN_OUT_LOGITS_WORDS];
+    static uint32_t logits_batch[EXP_LEN_OUT_LOGITS_WORDS];
+
+    // Case A: back-to-back single INFERs are the reference and never bind in place.
+    hx.fresh_session();
+    aecct::TopPerfCounters single;
+    for (uint32_t cw = 0u; cw < kBatchCount; ++cw) {
+        hx.infer(cw, logits_single[cw]);
+        expect_u64(aecct::top_peek_infer_batch_ffn_inplace_count().to_uint(), 0u, "single inplace_count");
+        if (cw == 0u) {
+            single = aecct::top_perf();
+        }
+    }
+
+    // Case B: every layer of every codeword reads its FFN weights in place.
+    hx.fresh_session();
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, kBatchCount);
+    for (uint32_t cw = 0u; cw < kBatchCount; ++cw) {
+        hx.stream_codeword(cw);
+        const uint32_t got =
+            drain_data_words(hx.data_out, logits_batch, (uint32_t)EXP_LEN_OUT_LOGITS_WORDS);
+        if (got != (uint32_t)EXP_LEN_OUT_LOGITS_WORDS) {
+            fail("batch logits length mismatch");
+        }
+        for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_OUT_LOGITS_WORDS; ++i) {
+            if (logits_batch[i] != logits_single[cw][i]) {
+                std::printf("ERROR: batch codeword %u logits[%u]=0x%08X single=0x%08X\n",
+                    (unsigned)cw, (unsigned)i, (unsigned)logits_batch[i], (unsigned)logits_single[cw][i]);
+                return 1;
+            }
+        }
+    }
+    drain_rsp(hx.ctrl_rsp);
+    if (aecct::top_peek_state() != aecct::ST_IDLE) {
+        fail("batch did not return to IDLE");
+    }
+    expect_u64(aecct::top_peek_infer_batch_ffn_inplace_count().to_uint(),
+        (uint64_t)kBatchCount * N_LAYERS, "batch inplace_count");
+
+    // Reading in place still reads W_REGION: FFN traffic scales with the codeword count.
+    const aecct::TopPerfCounters& batch = aecct::top_perf();
+    const unsigned layer_phases[2] = { (unsigned)aecct::PHASE_LAYER0, (unsigned)aecct::PHASE_LAYER1 };
+    for (unsigned l = 0u; l < 2u; ++l) {
+        const aecct::TopPerfCounts& b = batch.cell[layer_phases[l]][aecct::PERF_SUB_FFN];
+        const aecct::TopPerfCounts& s = single.cell[layer_phases[l]][aecct::PERF_SUB_FFN];
+        expect_u64(b.mac, (uint64_t)kBatchCount * s.mac, "batch ffn mac");
+        expect_u64(b.sram_rd, (uint64_t)kBatchCount * s.sram_rd, "batch ffn sram_rd");
+        expect_u64(b.sram_wr, (uint64_t)kBatchCount * s.sram_wr, "batch ffn sram_wr");
+    }
+
+    // Case C: a new batch session restarts the count.
+    hx.cmd_arg((uint8_t)aecct::OP_INFER_BATCH, 2u);
+    hx.stream_codeword(0u);
+    hx.stream_codeword(1u);
+    drain_rsp(hx.ctrl_rsp);
+    (void)drain_data_words(hx.data_out, 0, 0u);
+    expect_u64(aecct::top_peek_infer_batch_ffn_inplace_count().to_uint(), 2u * N_LAYERS, "rebatch inplace_count");
+
+    std::printf("PASS: batch codewords=%u ffn in-place binds=%u\n",
+        (unsigned)kBatchCount, (unsigned)(kBatchCount * N_LAYERS));
+    std::printf("PASS: tb_top_ws_group_m26\n");
+    return 0;
+}
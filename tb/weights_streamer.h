@@ -22,6 +22,8 @@
 #include "ac_int.h"
 
 #include "AecctUtil.h"
+#include "ParamStreamCheck.h"
+#include "ParamStreamCodec.h"
 #include "gen/ModelShapes.h"
 #include "gen/SramMap.h"
 #include "gen/WeightStreamOrder.h"
@@ -98,7 +100,7 @@ static inline const double* tb_lookup_weight_fp64(const WeightId id, uint32_t &o
   switch (id) {
     case BCH_H_BITPACK: out_numel = 0u; return (const double*)0;
     case SRC_EMBED: out_numel = (uint32_t)w_src_embed_numel; return w_src_embed;
-    case SRC_MASK: out_numel = (uint32_t)w_src_mask_numel; return w_src_mask;
+    case SRC_MASK: out_numel = 0u; return (const double*)0; // bitpack: tb_lookup_weight_bits
     case QUANT_SX_8: out_numel = 8u; return tb_quant_sx_8;
     case DECODER_LAYERS_0_SELF_ATTN_LINEARS_0_WEIGHT: out_numel = (uint32_t)w_decoder_layers_0_self_attn_linears_0_weight_numel; return w_decoder_layers_0_self_attn_linears_0_weight;
     case DECODER_LAYERS_0_SELF_ATTN_LINEARS_0_DELTA: out_numel = (uint32_t)w_decoder_layers_0_self_attn_linears_0_delta_numel; return w_decoder_layers_0_self_attn_linears_0_delta;
@@ -338,6 +340,178 @@ static inline void tb_emit_bitpack_words(ac_channel<TDATA> &data_in,
   }
 }
 
+// ------------------------------------------------------------
+// v12 PARAM image builder (ternary payloads packed 2-bit, inv_s_w carriers)
+// ------------------------------------------------------------
+// Fills out[EXP_LEN_PARAM_WORDS] from weights.h in kParamMeta layout; every word
+// past a tensor's payload is zero. Returns false on a non-ternary weight or s_w == 0.
+static inline bool tb_build_unified_param_words(uint32_t *out) {
+  for (uint32_t i = 0u; i < (uint32_t)EXP_LEN_PARAM_WORDS; ++i) {
+    out[i] = 0u;
+  }
+  for (uint32_t p = 0u; p < (uint32_t)BIAS_COUNT; ++p) {
+    uint32_t numel = 0u;
+    const double *ptr = tb_lookup_bias_fp64((BiasId)p, numel);
+    for (uint32_t i = 0u; ptr && i < numel && i < kParamMeta[p].len_w; ++i) {
+      out[kParamMeta[p].offset_w + i] = tb_fp32_bits_from_double(ptr[i]);
+    }
+  }
+  for (uint32_t w = 0u; w < (uint32_t)WEIGHT_COUNT; ++w) {
+    const WeightId wid = (WeightId)w;
+    const ParamMeta meta = kParamMeta[kWeightIdToParamId[w]];
+    uint32_t *dst = out + meta.offset_w;
+    if (meta.dtype == (uint32_t)PARAM_DTYPE_BITPACK) {
+      uint32_t num_bits = 0u;
+      const ac_int<1,false> *bits = tb_lookup_weight_bits(wid, num_bits);
+      for (uint32_t b = 0u; bits && b < num_bits && (b >> 5) < meta.len_w; ++b) {
+        dst[b >> 5] |= ((uint32_t)bits[b].to_int() & 1u) << (b & 31u);
+      }
+      continue;
+    }
+    uint32_t numel = 0u;
+    const double *ptr = tb_lookup_weight_fp64(wid, numel);
+    if (!ptr) {
+      continue;
+    }
+    const uint32_t q = aecct::param_stream_ternary_matrix(meta.id);
+    if (q < (uint32_t)QUANT_LINEAR_MATRIX_COUNT) {
+      uint32_t words = 0u;
+      uint32_t last_valid = 0u;
+      if (!tb_pack_ternary_words_from_fp64(ptr, numel, kQuantLinearMeta[q].num_weights,
+                                           dst, meta.len_w, words, last_valid)) {
+        return false;
+      }
+    } else if (is_quant_linear_inv_sw_weight_slot(wid)) {
+      for (uint32_t i = 0u; i < numel && i < meta.len_w; ++i) {
+        if (ptr[i] == 0.0) {
+          return false;
+        }
+        dst[i] = tb_fp32_bits_from_double(1.0 / ptr[i]);
+      }
+    } else {
+      for (uint32_t i = 0u; i < numel && i < meta.len_w; ++i) {
+        dst[i] = tb_fp32_bits_from_double(ptr[i]);
+      }
+    }
+  }
+  return true;
+}
+
+// ------------------------------------------------------------
+// Compressed PARAM stream encoder (ParamStreamCodec.h packets)
+// ------------------------------------------------------------
+// The encoder is lossless; tb_param_words_round_bf16 is the separate, lossy
+// pre-pass that makes fp32 tensors HI16-packable.
+static const uint32_t TB_PARAM_RUN_MIN = 3u;  // shorter repeats stay RAW / HI16
+static const uint32_t TB_PARAM_HI16_MIN = 4u; // shorter half-word stretches stay RAW
+
+// fp32 -> bf16 round-to-nearest-even, returned as fp32 bits with a zero low half.
+// Inf/NaN keep their upper half.
+static inline uint32_t tb_fp32_bits_round_bf16(const uint32_t bits) {
+  if ((bits & 0x7F800000u) == 0x7F800000u) {
+    return bits & 0xFFFF0000u;
+  }
+  const uint32_t lsb = (bits >> 16) & 1u;
+  return (bits + 0x7FFFu + lsb) & 0xFFFF0000u;
+}
+
+// Rounds every plain fp32 PARAM segment to bf16 in place. Ternary payloads,
+// inv_s_w carriers and BITPACK segments are left untouched.
+static inline void tb_param_words_round_bf16(uint32_t *words) {
+  for (uint32_t p = 0u; p < (uint32_t)PARAM_COUNT; ++p) {
+    const ParamMeta meta = kParamMeta[p];
+    if (meta.dtype == (uint32_t)PARAM_DTYPE_BITPACK ||
+        aecct::param_stream_ternary_matrix(meta.id) < (uint32_t)QUANT_LINEAR_MATRIX_COUNT ||
+        aecct::param_stream_inv_sw_matrix(meta.id) < (uint32_t)QUANT_LINEAR_MATRIX_COUNT) {
+      continue;
+    }
+    for (uint32_t i = 0u; i < meta.len_w; ++i) {
+      words[meta.offset_w + i] = tb_fp32_bits_round_bf16(words[meta.offset_w + i]);
+    }
+  }
+}
+
+static inline uint32_t tb_param_run_at(const uint32_t *words, const uint32_t n, const uint32_t i,
+                                       const uint32_t limit) {
+  uint32_t r = 1u;
+  while ((i + r) < n && r < limit && words[i + r] == words[i]) {
+    ++r;
+  }
+  return r;
+}
+
+static inline uint32_t tb_param_hi16_at(const uint32_t *words, const uint32_t n, const uint32_t i,
+                                        const uint32_t limit) {
+  uint32_t h = 0u;
+  while ((i + h) < n && h < limit && (words[i + h] & 0xFFFFu) == 0u) {
+    ++h;
+  }
+  return h;
+}
+
+static inline bool tb_param_put(uint32_t *out, const uint32_t out_cap, uint32_t &pos, const uint32_t w) {
+  if (pos >= out_cap) {
+    return false;
+  }
+  out[pos++] = w;
+  return true;
+}
+
+// Encodes n PARAM words into packets: RUN for >= TB_PARAM_RUN_MIN repeats, HI16 for
+// >= TB_PARAM_HI16_MIN words with a zero low half, RAW otherwise.
+// Returns the wire word count, or 0 when out_cap is too small.
+static inline uint32_t tb_param_stream_encode(const uint32_t *words, const uint32_t n,
+                                              uint32_t *out, const uint32_t out_cap) {
+  uint32_t pos = 0u;
+  uint32_t i = 0u;
+  while (i < n) {
+    const uint32_t run = tb_param_run_at(words, n, i, aecct::PARAM_PKT_COUNT_MAX);
+    if (run >= TB_PARAM_RUN_MIN) {
+      if (!tb_param_put(out, out_cap, pos, aecct::pack_param_packet_header(aecct::PARAM_PKT_RUN, run)) ||
+          !tb_param_put(out, out_cap, pos, words[i])) {
+        return 0u;
+      }
+      i += run;
+      continue;
+    }
+    if (tb_param_hi16_at(words, n, i, TB_PARAM_HI16_MIN) >= TB_PARAM_HI16_MIN) {
+      uint32_t h = 0u;
+      while ((i + h) < n && (words[i + h] & 0xFFFFu) == 0u &&
+             tb_param_run_at(words, n, i + h, TB_PARAM_RUN_MIN) < TB_PARAM_RUN_MIN) {
+        ++h;
+      }
+      if (!tb_param_put(out, out_cap, pos, aecct::pack_param_packet_header(aecct::PARAM_PKT_HI16, h))) {
+        return 0u;
+      }
+      for (uint32_t k = 0u; k < h; k += 2u) {
+        const uint32_t lo = words[i + k] >> 16;
+        const uint32_t hi = ((k + 1u) < h) ? (words[i + k + 1u] & 0xFFFF0000u) : 0u;
+        if (!tb_param_put(out, out_cap, pos, hi | lo)) {
+          return 0u;
+        }
+      }
+      i += h;
+      continue;
+    }
+    uint32_t r = 1u;
+    while ((i + r) < n &&
+           tb_param_run_at(words, n, i + r, TB_PARAM_RUN_MIN) < TB_PARAM_RUN_MIN &&
+           tb_param_hi16_at(words, n, i + r, TB_PARAM_HI16_MIN) < TB_PARAM_HI16_MIN) {
+      ++r;
+    }
+    if (!tb_param_put(out, out_cap, pos, aecct::pack_param_packet_header(aecct::PARAM_PKT_RAW, r))) {
+      return 0u;
+    }
+    for (uint32_t k = 0u; k < r; ++k) {
+      if (!tb_param_put(out, out_cap, pos, words[i + k])) {
+        return 0u;
+      }
+    }
+    i += r;
+  }
+  return pos;
+}
+
 // ------------------------------------------------------------
 // High-level: v11.4 command helpers (with optional rsp checking)
 // ------------------------------------------------------------
@@ -1,6 +1,7 @@
 ﻿#!/usr/bin/env python3
 import argparse
 import math
+import struct
 from pathlib import Path
 
 
@@ -97,11 +98,67 @@ def gen_invsqrt_header(path: Path, lut_size: int, x_min: float, x_max: float) ->
     path.write_text("\n".join(lines), encoding="utf-8")
 
 
+def f32_bits(x: float) -> int:
+    return struct.unpack("<I", struct.pack("<f", x))[0]
+
+
+def gen_ln_invsqrt_lut(path: Path, mant_bits: int) -> None:
+    # Seed for 1/sqrt(x), x = m * 2^(2k), m in [1, 4): entry {odd exponent, top
+    # mantissa bits} covers one m bin; the minimax value 2 / (sqrt(lo) + sqrt(hi))
+    # balances the relative error at both bin edges.
+    bins = 1 << mant_bits
+    vals = []
+    for odd in range(2):
+        scale = 2.0 if odd else 1.0
+        for j in range(bins):
+            lo = scale * (1.0 + float(j) / float(bins))
+            hi = scale * (1.0 + float(j + 1) / float(bins))
+            vals.append(2.0 / (math.sqrt(lo) + math.sqrt(hi)))
+
+    lines = []
+    lines.append("#pragma once")
+    lines.append("// AUTO-GENERATED by tools/gen_ref_lut.py --target layernorm")
+    lines.append("// LayerNorm 1/sqrt seed LUT. x = m * 2^(2k), m in [1, 4); index is")
+    lines.append("// {exponent parity, top LN_INV_SQRT_LUT_MANT_BITS mantissa bits}; entry is the")
+    lines.append("// minimax 1/sqrt(m) of the bin as IEEE754 binary32 bits.")
+    lines.append("")
+    lines.append("#include <cstdint>")
+    lines.append("")
+    lines.append("namespace aecct {")
+    lines.append("")
+    lines.append(f"static const unsigned LN_INV_SQRT_LUT_MANT_BITS = {mant_bits}u;")
+    lines.append(f"static const unsigned LN_INV_SQRT_LUT_SIZE = {2 * bins}u;")
+    lines.append("")
+    lines.append(f"static const uint32_t kLnInvSqrtLutBits[{2 * bins}] = {{")
+    for i in range(0, len(vals), 8):
+        row = ", ".join(f"0x{f32_bits(v):08X}u" for v in vals[i:i + 8])
+        comma = "," if i + 8 < len(vals) else ""
+        lines.append(f"    {row}{comma}")
+    lines.append("};")
+    lines.append("")
+    lines.append("} // namespace aecct")
+    lines.append("")
+    path.write_text("\n".join(lines), encoding="utf-8")
+
+
 def main() -> int:
     parser = argparse.ArgumentParser(description="Generate ref softmax/inv_sqrt LUT headers")
     parser.add_argument("--repo", type=Path, default=Path(__file__).resolve().parents[1])
+    parser.add_argument(
+        "--target",
+        choices=("ref", "layernorm"),
+        default="ref",
+        help="ref: AECCT_ac_ref softmax/inv_sqrt headers; layernorm: design-side LN inv_sqrt LUT",
+    )
     args = parser.parse_args()
 
+    if args.target == "layernorm":
+        out_path = args.repo / "include" / "LayerNormInvSqrtLut.h"
+        gen_ln_invsqrt_lut(out_path, mant_bits=8)
+        print("generated:")
+        print(out_path)
+        return 0
+
     out_dir = args.repo / "AECCT_ac_ref" / "include"
     out_dir.mkdir(parents=True, exist_ok=True)
 